@@ -0,0 +1,63 @@
+//
+// generator.cpp
+// ~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/asio/awaitable_generator.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/signal_set.hpp>
+#include <boost/asio/write.hpp>
+#include <cstdio>
+#include <optional>
+
+using boost::asio::ip::tcp;
+using boost::asio::awaitable;
+using boost::asio::awaitable_generator;
+using boost::asio::co_spawn;
+using boost::asio::detached;
+using boost::asio::use_awaitable;
+
+awaitable_generator<tcp::socket> connections(tcp::acceptor& acceptor)
+{
+  for (;;)
+  {
+    co_yield co_await acceptor.async_accept(use_awaitable);
+  }
+}
+
+awaitable<void> listener(tcp::acceptor acceptor)
+{
+  auto incoming = connections(acceptor);
+  while (std::optional<tcp::socket> s = co_await incoming.next())
+  {
+    co_await boost::asio::async_write(*s, boost::asio::buffer("hello\r\n", 7), use_awaitable);
+  }
+}
+
+int main()
+{
+  try
+  {
+    boost::asio::io_context io_context(1);
+
+    boost::asio::signal_set signals(io_context, SIGINT, SIGTERM);
+    signals.async_wait([&](auto, auto){ io_context.stop(); });
+
+    tcp::acceptor acceptor(io_context, {tcp::v4(), 55555});
+    co_spawn(io_context, listener(std::move(acceptor)), detached);
+
+    io_context.run();
+  }
+  catch (std::exception& e)
+  {
+    std::printf("Exception: %s\n", e.what());
+  }
+}
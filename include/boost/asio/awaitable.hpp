@@ -25,6 +25,7 @@
 # include <experimental/coroutine>
 #endif // defined(BOOST_ASIO_HAS_STD_COROUTINE)
 
+#include <utility>
 #include <boost/asio/any_io_executor.hpp>
 
 #include <boost/asio/detail/push_options.hpp>
@@ -43,6 +44,8 @@ using std::experimental::suspend_always;
 
 template <typename> class awaitable_thread;
 template <typename, typename> class awaitable_frame;
+template <typename, typename> class awaitable_generator_frame;
+template <typename, typename> class awaitable_generator_next;
 
 } // namespace detail
 
@@ -98,6 +101,15 @@ public:
     frame_->push_frame(&h.promise());
   }
 
+  // Support for co_await keyword within an awaitable_generator.
+  template <class U>
+  void await_suspend(
+      detail::coroutine_handle<
+        detail::awaitable_generator_frame<U, Executor>> h)
+  {
+    frame_->push_frame(&h.promise());
+  }
+
   // Support for co_await keyword.
   T await_resume()
   {
@@ -0,0 +1,160 @@
+//
+// awaitable_generator.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_AWAITABLE_GENERATOR_HPP
+#define BOOST_ASIO_AWAITABLE_GENERATOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if (defined(BOOST_ASIO_HAS_CO_AWAIT) && defined(BOOST_ASIO_HAS_STD_OPTIONAL)) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <optional>
+#include <utility>
+#include <boost/asio/awaitable.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+/// The return type of a coroutine that produces a sequence of values.
+/**
+ * An awaitable_generator is a coroutine that uses @c co_yield to produce
+ * values lazily, and which may also @c co_await asynchronous operations and
+ * other awaitables between values. The generator does not start running until
+ * its first value is requested, and runs only while a value is being
+ * requested.
+ *
+ * A value is requested by awaiting the object returned by next() from within
+ * an awaitable coroutine. The generator runs as part of the consumer's thread
+ * of execution, on the same executor, until it yields a value or returns. A
+ * yielded value is moved into storage within the generator's frame, and moved
+ * out again when the consumer resumes, so that no intermediate allocation is
+ * performed per value. The generator's frame is allocated in the same way as
+ * the frames of awaitable coroutines.
+ *
+ * An exception that escapes the generator is rethrown to the consumer that
+ * requested the next value, after which the generator has finished.
+ *
+ * @par Example
+ * @code boost::asio::awaitable_generator<tcp::socket> connections(
+ *     tcp::acceptor& acceptor)
+ * {
+ *   for (;;)
+ *     co_yield co_await acceptor.async_accept(boost::asio::use_awaitable);
+ * }
+ *
+ * boost::asio::awaitable<void> listener(tcp::acceptor acceptor)
+ * {
+ *   auto gen = connections(acceptor);
+ *   while (std::optional<tcp::socket> socket = co_await gen.next())
+ *     ...
+ * } @endcode
+ */
+template <typename T, typename Executor = any_io_executor>
+class awaitable_generator
+{
+public:
+  /// The type of the values produced by the generator.
+  typedef T value_type;
+
+  /// The executor type that will be used for the coroutine.
+  typedef Executor executor_type;
+
+  /// Default constructor.
+  constexpr awaitable_generator() noexcept
+    : frame_(nullptr)
+  {
+  }
+
+  /// Move constructor.
+  awaitable_generator(awaitable_generator&& other) noexcept
+    : frame_(std::exchange(other.frame_, nullptr))
+  {
+  }
+
+  /// Move assignment.
+  awaitable_generator& operator=(awaitable_generator&& other) noexcept
+  {
+    if (this != &other)
+    {
+      if (frame_)
+        frame_->destroy();
+      frame_ = std::exchange(other.frame_, nullptr);
+    }
+    return *this;
+  }
+
+  /// Destructor. Destroys the generator's coroutine frame.
+  ~awaitable_generator()
+  {
+    if (frame_)
+      frame_->destroy();
+  }
+
+  /// Checks if the object refers to a generator.
+  bool valid() const noexcept
+  {
+    return !!frame_;
+  }
+
+  /// Request the next value from the generator.
+  /**
+   * @returns An object that, when awaited from within an awaitable coroutine
+   * using the same executor type, resumes the generator and produces a
+   * <tt>std::optional<T></tt>. The optional is empty if the generator has
+   * finished.
+   *
+   * The generator must be valid, and only one request may be outstanding at a
+   * time.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  unspecified next() noexcept;
+#else // defined(GENERATING_DOCUMENTATION)
+  detail::awaitable_generator_next<T, Executor> next() noexcept
+  {
+    return detail::awaitable_generator_next<T, Executor>(frame_);
+  }
+#endif // defined(GENERATING_DOCUMENTATION)
+
+private:
+  template <typename, typename> friend class detail::awaitable_generator_frame;
+
+  // Not copy constructible or copy assignable.
+  awaitable_generator(const awaitable_generator&) = delete;
+  awaitable_generator& operator=(const awaitable_generator&) = delete;
+
+  // Construct the generator from a coroutine's frame object.
+  explicit awaitable_generator(
+      detail::awaitable_generator_frame<T, Executor>* f)
+    : frame_(f)
+  {
+  }
+
+  detail::awaitable_generator_frame<T, Executor>* frame_;
+};
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#include <boost/asio/impl/awaitable_generator.hpp>
+
+#endif // (defined(BOOST_ASIO_HAS_CO_AWAIT)
+       //     && defined(BOOST_ASIO_HAS_STD_OPTIONAL))
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // BOOST_ASIO_AWAITABLE_GENERATOR_HPP
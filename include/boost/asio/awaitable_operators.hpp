@@ -0,0 +1,180 @@
+//
+// awaitable_operators.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_AWAITABLE_OPERATORS_HPP
+#define BOOST_ASIO_AWAITABLE_OPERATORS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if (defined(BOOST_ASIO_HAS_CO_AWAIT) && defined(BOOST_ASIO_HAS_STD_VARIANT)) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <tuple>
+#include <variant>
+#include <boost/asio/awaitable.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+/// Operators for running awaitable operations concurrently.
+/**
+ * The operators in this namespace start two awaitable operations concurrently
+ * within the calling coroutine's executor, and combine their results. Each
+ * operand runs as a separate thread of execution, so that an operation that
+ * is waiting does not prevent the other from making progress. The operations
+ * are started immediately, without first being posted to the executor.
+ *
+ * Expressions may be chained. For example, <tt>a && b && c</tt> waits for all
+ * three operations and produces a <tt>std::tuple</tt> of their results, and
+ * <tt>a || b || c</tt> waits for the first to complete successfully and
+ * produces a <tt>std::variant</tt> whose index identifies that operation.
+ *
+ * Each operand is given its own cancellation slot, and cancellation of the
+ * calling coroutine's operation is forwarded to both operands. When the
+ * executor is multithreaded the operands should run on a strand, as a
+ * cancellation signal may be emitted from the thread that completes the
+ * other operand.
+ *
+ * @par Example
+ * @code using namespace boost::asio::awaitable_operators;
+ *
+ * std::variant<std::size_t, std::monostate> result = co_await (
+ *     sock.async_read_some(buffer, use_awaitable)
+ *       || timer.async_wait(use_awaitable)); @endcode
+ */
+namespace awaitable_operators {
+
+/// Wait for both operations to complete.
+/**
+ * If either operation exits with an exception, the exception is rethrown once
+ * both have completed. When both operations exit with an exception, the
+ * exception of the left hand operand is rethrown.
+ */
+template <typename Executor>
+awaitable<void, Executor> operator&&(
+    awaitable<void, Executor> t, awaitable<void, Executor> u);
+
+/// Wait for both operations to complete.
+/**
+ * @returns The result of the left hand operand.
+ */
+template <typename T, typename Executor>
+awaitable<T, Executor> operator&&(
+    awaitable<T, Executor> t, awaitable<void, Executor> u);
+
+/// Wait for both operations to complete.
+/**
+ * @returns The result of the right hand operand.
+ */
+template <typename U, typename Executor>
+awaitable<U, Executor> operator&&(
+    awaitable<void, Executor> t, awaitable<U, Executor> u);
+
+/// Wait for both operations to complete.
+/**
+ * @returns A tuple containing the results of both operands.
+ */
+template <typename T, typename U, typename Executor>
+awaitable<std::tuple<T, U>, Executor> operator&&(
+    awaitable<T, Executor> t, awaitable<U, Executor> u);
+
+/// Wait for both operations to complete.
+/**
+ * @returns The tuple produced by the left hand operand.
+ */
+template <typename... T, typename Executor>
+awaitable<std::tuple<T...>, Executor> operator&&(
+    awaitable<std::tuple<T...>, Executor> t, awaitable<void, Executor> u);
+
+/// Wait for both operations to complete.
+/**
+ * @returns The tuple produced by the left hand operand, extended with the
+ * result of the right hand operand.
+ */
+template <typename... T, typename U, typename Executor>
+awaitable<std::tuple<T..., U>, Executor> operator&&(
+    awaitable<std::tuple<T...>, Executor> t, awaitable<U, Executor> u);
+
+/// Wait for one of the operations to complete successfully.
+/**
+ * When either operation completes without an exception, terminal
+ * cancellation is requested for the other operation. The coroutine is resumed
+ * once both operations have completed, and the result of the cancelled
+ * operation is discarded. If both operations exit with an exception, the
+ * exception of the left hand operand is rethrown.
+ *
+ * @returns A variant whose index identifies the operation that completed.
+ */
+template <typename Executor>
+awaitable<std::variant<std::monostate, std::monostate>, Executor> operator||(
+    awaitable<void, Executor> t, awaitable<void, Executor> u);
+
+/// Wait for one of the operations to complete successfully.
+/**
+ * @returns A variant whose index identifies the operation that completed.
+ */
+template <typename T, typename Executor>
+awaitable<std::variant<T, std::monostate>, Executor> operator||(
+    awaitable<T, Executor> t, awaitable<void, Executor> u);
+
+/// Wait for one of the operations to complete successfully.
+/**
+ * @returns A variant whose index identifies the operation that completed.
+ */
+template <typename U, typename Executor>
+awaitable<std::variant<std::monostate, U>, Executor> operator||(
+    awaitable<void, Executor> t, awaitable<U, Executor> u);
+
+/// Wait for one of the operations to complete successfully.
+/**
+ * @returns A variant whose index identifies the operation that completed.
+ */
+template <typename T, typename U, typename Executor>
+awaitable<std::variant<T, U>, Executor> operator||(
+    awaitable<T, Executor> t, awaitable<U, Executor> u);
+
+/// Wait for one of the operations to complete successfully.
+/**
+ * @returns The variant produced by the left hand operand, or a variant
+ * holding @c std::monostate at the next index if the right hand operand
+ * completed.
+ */
+template <typename... T, typename Executor>
+awaitable<std::variant<T..., std::monostate>, Executor> operator||(
+    awaitable<std::variant<T...>, Executor> t, awaitable<void, Executor> u);
+
+/// Wait for one of the operations to complete successfully.
+/**
+ * @returns The variant produced by the left hand operand, or a variant
+ * holding the result of the right hand operand at the next index.
+ */
+template <typename... T, typename U, typename Executor>
+awaitable<std::variant<T..., U>, Executor> operator||(
+    awaitable<std::variant<T...>, Executor> t, awaitable<U, Executor> u);
+
+} // namespace awaitable_operators
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#include <boost/asio/impl/awaitable_operators.hpp>
+
+#endif // (defined(BOOST_ASIO_HAS_CO_AWAIT)
+       //     && defined(BOOST_ASIO_HAS_STD_VARIANT))
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // BOOST_ASIO_AWAITABLE_OPERATORS_HPP
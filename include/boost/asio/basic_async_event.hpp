@@ -0,0 +1,274 @@
+//
+// basic_async_event.hpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_BASIC_ASYNC_EVENT_HPP
+#define BOOST_ASIO_BASIC_ASYNC_EVENT_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if (defined(BOOST_ASIO_HAS_MOVE) \
+    && defined(BOOST_ASIO_HAS_STD_ATOMIC)) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <cstddef>
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/execution_context.hpp>
+#include <boost/asio/detail/async_sync_service.hpp>
+#include <boost/asio/detail/non_const_lvalue.hpp>
+#include <boost/asio/detail/type_traits.hpp>
+#include <boost/asio/execution/context.hpp>
+#include <boost/asio/execution/executor.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+/// Provides a manual-reset event for asynchronous operations.
+/**
+ * The basic_async_event class template allows asynchronous operations, such
+ * as coroutines, to wait for a condition to be signalled, without blocking the
+ * threads that run them. The event is either set or clear. async_wait()
+ * completes as soon as the event is set. Setting the event using set()
+ * releases all waiting operations, and the event remains set until it is
+ * cleared using reset().
+ *
+ * Waiting on an event that is set, and setting or clearing an event that has
+ * no waiters, use a single atomic operation and do not acquire any lock.
+ *
+ * Completion handlers are never invoked from within the initiating function.
+ * They are posted to the event's I/O executor, and dispatched from there to
+ * the handler's associated executor.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe.
+ *
+ * @par Example
+ * @code boost::asio::async_event ready(my_context);
+ *
+ * // In each consumer:
+ * co_await ready.async_wait(boost::asio::use_awaitable);
+ *
+ * // In the producer:
+ * ready.set(); @endcode
+ */
+template <typename Executor = any_io_executor>
+class basic_async_event
+{
+private:
+  typedef detail::async_sync_service service_type;
+
+public:
+  /// The type of the executor associated with the object.
+  typedef Executor executor_type;
+
+  /// Rebinds the event type to another executor.
+  template <typename Executor1>
+  struct rebind_executor
+  {
+    /// The event type when rebound to the specified executor.
+    typedef basic_async_event<Executor1> other;
+  };
+
+  /// Construct an event.
+  /**
+   * @param ex The I/O executor that the event will use, by default, to
+   * dispatch handlers for any asynchronous operations performed on the event.
+   *
+   * @param initially_set Whether the event is initially set.
+   */
+  explicit basic_async_event(const executor_type& ex,
+      bool initially_set = false)
+    : service_(&boost::asio::use_service<service_type>(
+          basic_async_event::get_context(ex))),
+      executor_(ex)
+  {
+    service_->construct(impl_, initially_set ? 1 : 0);
+  }
+
+  /// Construct an event.
+  /**
+   * @param context An execution context which provides the I/O executor that
+   * the event will use, by default, to dispatch handlers for any asynchronous
+   * operations performed on the event.
+   *
+   * @param initially_set Whether the event is initially set.
+   */
+  template <typename ExecutionContext>
+  explicit basic_async_event(ExecutionContext& context,
+      bool initially_set = false,
+      typename enable_if<
+        is_convertible<ExecutionContext&, execution_context&>::value
+      >::type* = 0)
+    : service_(&boost::asio::use_service<service_type>(context)),
+      executor_(context.get_executor())
+  {
+    service_->construct(impl_, initially_set ? 1 : 0);
+  }
+
+  /// Destroys the event.
+  /**
+   * Pending wait operations are cancelled, and complete with the
+   * boost::asio::error::operation_aborted error.
+   */
+  ~basic_async_event()
+  {
+    service_->destroy(impl_);
+  }
+
+  /// Get the executor associated with the object.
+  executor_type get_executor() BOOST_ASIO_NOEXCEPT
+  {
+    return executor_;
+  }
+
+  /// Determine whether the event is set.
+  bool is_set() const BOOST_ASIO_NOEXCEPT
+  {
+    return service_->value(impl_) != 0;
+  }
+
+  /// Set the event.
+  /**
+   * All waiting operations complete successfully. Subsequent wait operations
+   * complete immediately until the event is reset.
+   */
+  void set()
+  {
+    service_->set_bits(impl_, 1);
+  }
+
+  /// Clear the event.
+  void reset()
+  {
+    service_->clear_bits(impl_, 1);
+  }
+
+  /// Cancel all waiting operations.
+  /**
+   * Each pending wait operation completes with the
+   * boost::asio::error::operation_aborted error. The state of the event is
+   * unaffected.
+   */
+  void cancel()
+  {
+    service_->cancel(impl_);
+  }
+
+  /// Start an asynchronous wait for the event to be set.
+  /**
+   * This function is used to asynchronously wait for the event to be set. The
+   * function call always returns immediately.
+   *
+   * @param handler The handler to be called when the event has been set.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error // Result of operation.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using boost::asio::post().
+   */
+  template <
+      BOOST_ASIO_COMPLETION_TOKEN_FOR(void (boost::system::error_code))
+        WaitHandler BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(WaitHandler,
+      void (boost::system::error_code))
+  async_wait(
+      BOOST_ASIO_MOVE_ARG(WaitHandler) handler
+        BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<WaitHandler, void (boost::system::error_code)>(
+        initiate_async_wait(this), handler);
+  }
+
+private:
+  // Disallow copying and assignment.
+  basic_async_event(const basic_async_event&) BOOST_ASIO_DELETED;
+  basic_async_event& operator=(const basic_async_event&) BOOST_ASIO_DELETED;
+
+  // Helper function to get an executor's context.
+  template <typename T>
+  static execution_context& get_context(const T& t,
+      typename enable_if<execution::is_executor<T>::value>::type* = 0)
+  {
+    return boost::asio::query(t, execution::context);
+  }
+
+  // Helper function to get an executor's context.
+  template <typename T>
+  static execution_context& get_context(const T& t,
+      typename enable_if<!execution::is_executor<T>::value>::type* = 0)
+  {
+    return t.context();
+  }
+
+  // A wait succeeds when the event is set.
+  static bool try_wait_state(std::size_t state, std::size_t& next)
+  {
+    next = state;
+    return (state / service_type::value_unit) != 0;
+  }
+
+  class initiate_async_wait
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_wait(basic_async_event* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const BOOST_ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WaitHandler>
+    void operator()(BOOST_ASIO_MOVE_ARG(WaitHandler) handler) const
+    {
+      detail::non_const_lvalue<WaitHandler> handler2(handler);
+      self_->service_->async_wait(self_->impl_,
+          &basic_async_event::try_wait_state, handler2.value,
+          self_->executor_, "async_event", "async_wait");
+    }
+
+  private:
+    basic_async_event* self_;
+  };
+
+  service_type* service_;
+  mutable service_type::implementation_type impl_;
+  executor_type executor_;
+};
+
+/// Typedef for the typical usage of an asynchronous event.
+typedef basic_async_event<> async_event;
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // (defined(BOOST_ASIO_HAS_MOVE)
+       //     && defined(BOOST_ASIO_HAS_STD_ATOMIC))
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // BOOST_ASIO_BASIC_ASYNC_EVENT_HPP
@@ -0,0 +1,308 @@
+//
+// basic_async_latch.hpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_BASIC_ASYNC_LATCH_HPP
+#define BOOST_ASIO_BASIC_ASYNC_LATCH_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if (defined(BOOST_ASIO_HAS_MOVE) \
+    && defined(BOOST_ASIO_HAS_STD_ATOMIC)) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <cstddef>
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/execution_context.hpp>
+#include <boost/asio/detail/async_sync_service.hpp>
+#include <boost/asio/detail/non_const_lvalue.hpp>
+#include <boost/asio/detail/type_traits.hpp>
+#include <boost/asio/execution/context.hpp>
+#include <boost/asio/execution/executor.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+/// Provides a single-use countdown for asynchronous operations.
+/**
+ * The basic_async_latch class template allows asynchronous operations, such
+ * as coroutines, to wait until a set of events has happened, without blocking
+ * the threads that run them. The latch is created with a count of the events
+ * that are expected. The count is decreased using count_down(), and
+ * async_wait() completes once it has reached zero. The latch cannot be reset.
+ *
+ * async_arrive_and_wait() decreases the count and then waits. When each of a
+ * fixed group of operations arrives in this way, the latch acts as a one-time
+ * barrier that releases the whole group once the last member has arrived.
+ *
+ * Waiting on a latch that has reached zero, and counting down without
+ * reaching zero, use a single atomic operation and do not acquire any lock.
+ *
+ * Completion handlers are never invoked from within the initiating function.
+ * They are posted to the latch's I/O executor, and dispatched from there to
+ * the handler's associated executor.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe.
+ *
+ * @par Example
+ * @code boost::asio::async_latch started(my_context, worker_count);
+ *
+ * // In each worker:
+ * co_await started.async_arrive_and_wait(boost::asio::use_awaitable); @endcode
+ */
+template <typename Executor = any_io_executor>
+class basic_async_latch
+{
+private:
+  typedef detail::async_sync_service service_type;
+
+public:
+  /// The type of the executor associated with the object.
+  typedef Executor executor_type;
+
+  /// Rebinds the latch type to another executor.
+  template <typename Executor1>
+  struct rebind_executor
+  {
+    /// The latch type when rebound to the specified executor.
+    typedef basic_async_latch<Executor1> other;
+  };
+
+  /// Construct a latch.
+  /**
+   * @param ex The I/O executor that the latch will use, by default, to
+   * dispatch handlers for any asynchronous operations performed on the latch.
+   *
+   * @param count The initial value of the count.
+   */
+  basic_async_latch(const executor_type& ex, std::size_t count)
+    : service_(&boost::asio::use_service<service_type>(
+          basic_async_latch::get_context(ex))),
+      executor_(ex)
+  {
+    service_->construct(impl_, count);
+  }
+
+  /// Construct a latch.
+  /**
+   * @param context An execution context which provides the I/O executor that
+   * the latch will use, by default, to dispatch handlers for any asynchronous
+   * operations performed on the latch.
+   *
+   * @param count The initial value of the count.
+   */
+  template <typename ExecutionContext>
+  basic_async_latch(ExecutionContext& context, std::size_t count,
+      typename enable_if<
+        is_convertible<ExecutionContext&, execution_context&>::value
+      >::type* = 0)
+    : service_(&boost::asio::use_service<service_type>(context)),
+      executor_(context.get_executor())
+  {
+    service_->construct(impl_, count);
+  }
+
+  /// Destroys the latch.
+  /**
+   * Pending wait operations are cancelled, and complete with the
+   * boost::asio::error::operation_aborted error.
+   */
+  ~basic_async_latch()
+  {
+    service_->destroy(impl_);
+  }
+
+  /// Get the executor associated with the object.
+  executor_type get_executor() BOOST_ASIO_NOEXCEPT
+  {
+    return executor_;
+  }
+
+  /// Get the current value of the count.
+  std::size_t count() const BOOST_ASIO_NOEXCEPT
+  {
+    return service_->value(impl_);
+  }
+
+  /// Determine whether the count has reached zero.
+  bool try_wait() const BOOST_ASIO_NOEXCEPT
+  {
+    return service_->value(impl_) == 0;
+  }
+
+  /// Decrease the count.
+  /**
+   * If the count reaches zero, all waiting operations complete successfully.
+   *
+   * @param n The amount by which to decrease the count. It must not exceed
+   * the current count.
+   */
+  void count_down(std::size_t n = 1)
+  {
+    service_->count_down(impl_, n);
+  }
+
+  /// Cancel all waiting operations.
+  /**
+   * Each pending wait operation completes with the
+   * boost::asio::error::operation_aborted error. The count is unaffected.
+   */
+  void cancel()
+  {
+    service_->cancel(impl_);
+  }
+
+  /// Start an asynchronous wait for the count to reach zero.
+  /**
+   * This function is used to asynchronously wait for the count to reach zero.
+   * The function call always returns immediately.
+   *
+   * @param handler The handler to be called when the count has reached zero.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error // Result of operation.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using boost::asio::post().
+   */
+  template <
+      BOOST_ASIO_COMPLETION_TOKEN_FOR(void (boost::system::error_code))
+        WaitHandler BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(WaitHandler,
+      void (boost::system::error_code))
+  async_wait(
+      BOOST_ASIO_MOVE_ARG(WaitHandler) handler
+        BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<WaitHandler, void (boost::system::error_code)>(
+        initiate_async_wait(this), handler, std::size_t(0));
+  }
+
+  /// Decrease the count by one, then wait for it to reach zero.
+  /**
+   * This function is used to decrease the count and asynchronously wait for
+   * it to reach zero. The count is decreased when the operation is initiated.
+   * The function call always returns immediately.
+   *
+   * @param handler The handler to be called when the count has reached zero.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error // Result of operation.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using boost::asio::post().
+   */
+  template <
+      BOOST_ASIO_COMPLETION_TOKEN_FOR(void (boost::system::error_code))
+        WaitHandler BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(WaitHandler,
+      void (boost::system::error_code))
+  async_arrive_and_wait(
+      BOOST_ASIO_MOVE_ARG(WaitHandler) handler
+        BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<WaitHandler, void (boost::system::error_code)>(
+        initiate_async_wait(this), handler, std::size_t(1));
+  }
+
+private:
+  // Disallow copying and assignment.
+  basic_async_latch(const basic_async_latch&) BOOST_ASIO_DELETED;
+  basic_async_latch& operator=(const basic_async_latch&) BOOST_ASIO_DELETED;
+
+  // Helper function to get an executor's context.
+  template <typename T>
+  static execution_context& get_context(const T& t,
+      typename enable_if<execution::is_executor<T>::value>::type* = 0)
+  {
+    return boost::asio::query(t, execution::context);
+  }
+
+  // Helper function to get an executor's context.
+  template <typename T>
+  static execution_context& get_context(const T& t,
+      typename enable_if<!execution::is_executor<T>::value>::type* = 0)
+  {
+    return t.context();
+  }
+
+  // A wait succeeds when the count has reached zero.
+  static bool try_wait_state(std::size_t state, std::size_t& next)
+  {
+    next = state;
+    return state / service_type::value_unit == 0;
+  }
+
+  class initiate_async_wait
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_wait(basic_async_latch* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const BOOST_ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WaitHandler>
+    void operator()(BOOST_ASIO_MOVE_ARG(WaitHandler) handler,
+        std::size_t arrivals) const
+    {
+      if (arrivals > 0)
+        self_->service_->count_down(self_->impl_, arrivals);
+
+      detail::non_const_lvalue<WaitHandler> handler2(handler);
+      self_->service_->async_wait(self_->impl_,
+          &basic_async_latch::try_wait_state, handler2.value,
+          self_->executor_, "async_latch",
+          arrivals > 0 ? "async_arrive_and_wait" : "async_wait");
+    }
+
+  private:
+    basic_async_latch* self_;
+  };
+
+  service_type* service_;
+  mutable service_type::implementation_type impl_;
+  executor_type executor_;
+};
+
+/// Typedef for the typical usage of an asynchronous latch.
+typedef basic_async_latch<> async_latch;
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // (defined(BOOST_ASIO_HAS_MOVE)
+       //     && defined(BOOST_ASIO_HAS_STD_ATOMIC))
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // BOOST_ASIO_BASIC_ASYNC_LATCH_HPP
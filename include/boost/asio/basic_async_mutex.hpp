@@ -0,0 +1,271 @@
+//
+// basic_async_mutex.hpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_BASIC_ASYNC_MUTEX_HPP
+#define BOOST_ASIO_BASIC_ASYNC_MUTEX_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if (defined(BOOST_ASIO_HAS_MOVE) \
+    && defined(BOOST_ASIO_HAS_STD_ATOMIC)) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <cstddef>
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/execution_context.hpp>
+#include <boost/asio/detail/async_sync_service.hpp>
+#include <boost/asio/detail/non_const_lvalue.hpp>
+#include <boost/asio/detail/type_traits.hpp>
+#include <boost/asio/execution/context.hpp>
+#include <boost/asio/execution/executor.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+/// Provides mutual exclusion between asynchronous operations.
+/**
+ * The basic_async_mutex class template protects state that is shared between
+ * asynchronous operations, such as coroutines, without blocking the threads
+ * that run them. Ownership is requested using async_lock(), which completes
+ * once the mutex has been acquired, and is given up by calling unlock().
+ *
+ * While the mutex is held, further lock operations are queued. Unlocking the
+ * mutex hands ownership directly to the first of them, in the order in which
+ * they were started. Locking an unowned mutex, and unlocking a mutex that has
+ * no waiters, use a single atomic operation and do not acquire any lock.
+ *
+ * Completion handlers are never invoked from within the initiating function.
+ * They are posted to the mutex's I/O executor, and dispatched from there to
+ * the handler's associated executor.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe.
+ *
+ * @par Example
+ * @code boost::asio::async_mutex mutex(my_context);
+ *
+ * co_await mutex.async_lock(boost::asio::use_awaitable);
+ * ... // Access the shared state.
+ * mutex.unlock(); @endcode
+ */
+template <typename Executor = any_io_executor>
+class basic_async_mutex
+{
+private:
+  typedef detail::async_sync_service service_type;
+
+public:
+  /// The type of the executor associated with the object.
+  typedef Executor executor_type;
+
+  /// Rebinds the mutex type to another executor.
+  template <typename Executor1>
+  struct rebind_executor
+  {
+    /// The mutex type when rebound to the specified executor.
+    typedef basic_async_mutex<Executor1> other;
+  };
+
+  /// Construct an unlocked mutex.
+  /**
+   * @param ex The I/O executor that the mutex will use, by default, to
+   * dispatch handlers for any asynchronous operations performed on the mutex.
+   */
+  explicit basic_async_mutex(const executor_type& ex)
+    : service_(&boost::asio::use_service<service_type>(
+          basic_async_mutex::get_context(ex))),
+      executor_(ex)
+  {
+    service_->construct(impl_, 0);
+  }
+
+  /// Construct an unlocked mutex.
+  /**
+   * @param context An execution context which provides the I/O executor that
+   * the mutex will use, by default, to dispatch handlers for any asynchronous
+   * operations performed on the mutex.
+   */
+  template <typename ExecutionContext>
+  explicit basic_async_mutex(ExecutionContext& context,
+      typename enable_if<
+        is_convertible<ExecutionContext&, execution_context&>::value
+      >::type* = 0)
+    : service_(&boost::asio::use_service<service_type>(context)),
+      executor_(context.get_executor())
+  {
+    service_->construct(impl_, 0);
+  }
+
+  /// Destroys the mutex.
+  /**
+   * Pending lock operations are cancelled, and complete with the
+   * boost::asio::error::operation_aborted error.
+   */
+  ~basic_async_mutex()
+  {
+    service_->destroy(impl_);
+  }
+
+  /// Get the executor associated with the object.
+  executor_type get_executor() BOOST_ASIO_NOEXCEPT
+  {
+    return executor_;
+  }
+
+  /// Determine whether the mutex is currently owned.
+  bool is_locked() const BOOST_ASIO_NOEXCEPT
+  {
+    return service_->value(impl_) != 0;
+  }
+
+  /// Try to acquire the mutex without waiting.
+  /**
+   * @returns @c true if the mutex was acquired.
+   */
+  bool try_lock()
+  {
+    return service_->try_complete(impl_, &basic_async_mutex::try_lock_state);
+  }
+
+  /// Release the mutex.
+  /**
+   * If lock operations are waiting, ownership passes to the first of them.
+   * The mutex must be owned by the caller.
+   */
+  void unlock()
+  {
+    service_->unlock(impl_);
+  }
+
+  /// Cancel all waiting lock operations.
+  /**
+   * Each pending lock operation completes with the
+   * boost::asio::error::operation_aborted error. The mutex's ownership is
+   * unaffected.
+   */
+  void cancel()
+  {
+    service_->cancel(impl_);
+  }
+
+  /// Start an asynchronous operation to acquire the mutex.
+  /**
+   * This function is used to asynchronously acquire the mutex. The function
+   * call always returns immediately.
+   *
+   * @param handler The handler to be called when the mutex has been acquired.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error // Result of operation.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using boost::asio::post().
+   *
+   * On success, the caller owns the mutex and must release it using unlock().
+   */
+  template <
+      BOOST_ASIO_COMPLETION_TOKEN_FOR(void (boost::system::error_code))
+        LockHandler BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(LockHandler,
+      void (boost::system::error_code))
+  async_lock(
+      BOOST_ASIO_MOVE_ARG(LockHandler) handler
+        BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<LockHandler, void (boost::system::error_code)>(
+        initiate_async_lock(this), handler);
+  }
+
+private:
+  // Disallow copying and assignment.
+  basic_async_mutex(const basic_async_mutex&) BOOST_ASIO_DELETED;
+  basic_async_mutex& operator=(const basic_async_mutex&) BOOST_ASIO_DELETED;
+
+  // Helper function to get an executor's context.
+  template <typename T>
+  static execution_context& get_context(const T& t,
+      typename enable_if<execution::is_executor<T>::value>::type* = 0)
+  {
+    return boost::asio::query(t, execution::context);
+  }
+
+  // Helper function to get an executor's context.
+  template <typename T>
+  static execution_context& get_context(const T& t,
+      typename enable_if<!execution::is_executor<T>::value>::type* = 0)
+  {
+    return t.context();
+  }
+
+  // A lock succeeds when the mutex is unowned and there are no waiters.
+  static bool try_lock_state(std::size_t state, std::size_t& next)
+  {
+    next = service_type::value_unit;
+    return state == 0;
+  }
+
+  class initiate_async_lock
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_lock(basic_async_mutex* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const BOOST_ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename LockHandler>
+    void operator()(BOOST_ASIO_MOVE_ARG(LockHandler) handler) const
+    {
+      detail::non_const_lvalue<LockHandler> handler2(handler);
+      self_->service_->async_wait(self_->impl_,
+          &basic_async_mutex::try_lock_state, handler2.value,
+          self_->executor_, "async_mutex", "async_lock");
+    }
+
+  private:
+    basic_async_mutex* self_;
+  };
+
+  service_type* service_;
+  mutable service_type::implementation_type impl_;
+  executor_type executor_;
+};
+
+/// Typedef for the typical usage of an asynchronous mutex.
+typedef basic_async_mutex<> async_mutex;
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // (defined(BOOST_ASIO_HAS_MOVE)
+       //     && defined(BOOST_ASIO_HAS_STD_ATOMIC))
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // BOOST_ASIO_BASIC_ASYNC_MUTEX_HPP
@@ -0,0 +1,284 @@
+//
+// basic_async_semaphore.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_BASIC_ASYNC_SEMAPHORE_HPP
+#define BOOST_ASIO_BASIC_ASYNC_SEMAPHORE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if (defined(BOOST_ASIO_HAS_MOVE) \
+    && defined(BOOST_ASIO_HAS_STD_ATOMIC)) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <cstddef>
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/execution_context.hpp>
+#include <boost/asio/detail/async_sync_service.hpp>
+#include <boost/asio/detail/non_const_lvalue.hpp>
+#include <boost/asio/detail/type_traits.hpp>
+#include <boost/asio/execution/context.hpp>
+#include <boost/asio/execution/executor.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+/// Provides a counting semaphore for asynchronous operations.
+/**
+ * The basic_async_semaphore class template limits the number of asynchronous
+ * operations, such as coroutines, that may use a resource at the same time,
+ * without blocking the threads that run them. The semaphore holds a count of
+ * available permits. A permit is obtained using async_acquire(), which waits
+ * while no permits are available, and is returned by calling release().
+ *
+ * Permits that are released while acquire operations are waiting are handed
+ * directly to those operations, in the order in which they were started.
+ * Acquiring an available permit, and releasing a permit when there are no
+ * waiters, use a single atomic operation and do not acquire any lock.
+ *
+ * Completion handlers are never invoked from within the initiating function.
+ * They are posted to the semaphore's I/O executor, and dispatched from there
+ * to the handler's associated executor.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe.
+ *
+ * @par Example
+ * @code boost::asio::async_semaphore connections(my_context, 8);
+ *
+ * co_await connections.async_acquire(boost::asio::use_awaitable);
+ * ... // Use one of the connections.
+ * connections.release(); @endcode
+ */
+template <typename Executor = any_io_executor>
+class basic_async_semaphore
+{
+private:
+  typedef detail::async_sync_service service_type;
+
+public:
+  /// The type of the executor associated with the object.
+  typedef Executor executor_type;
+
+  /// Rebinds the semaphore type to another executor.
+  template <typename Executor1>
+  struct rebind_executor
+  {
+    /// The semaphore type when rebound to the specified executor.
+    typedef basic_async_semaphore<Executor1> other;
+  };
+
+  /// Construct a semaphore.
+  /**
+   * @param ex The I/O executor that the semaphore will use, by default, to
+   * dispatch handlers for any asynchronous operations performed on the
+   * semaphore.
+   *
+   * @param initial_count The number of permits that are initially available.
+   */
+  explicit basic_async_semaphore(const executor_type& ex,
+      std::size_t initial_count = 0)
+    : service_(&boost::asio::use_service<service_type>(
+          basic_async_semaphore::get_context(ex))),
+      executor_(ex)
+  {
+    service_->construct(impl_, initial_count);
+  }
+
+  /// Construct a semaphore.
+  /**
+   * @param context An execution context which provides the I/O executor that
+   * the semaphore will use, by default, to dispatch handlers for any
+   * asynchronous operations performed on the semaphore.
+   *
+   * @param initial_count The number of permits that are initially available.
+   */
+  template <typename ExecutionContext>
+  explicit basic_async_semaphore(ExecutionContext& context,
+      std::size_t initial_count = 0,
+      typename enable_if<
+        is_convertible<ExecutionContext&, execution_context&>::value
+      >::type* = 0)
+    : service_(&boost::asio::use_service<service_type>(context)),
+      executor_(context.get_executor())
+  {
+    service_->construct(impl_, initial_count);
+  }
+
+  /// Destroys the semaphore.
+  /**
+   * Pending acquire operations are cancelled, and complete with the
+   * boost::asio::error::operation_aborted error.
+   */
+  ~basic_async_semaphore()
+  {
+    service_->destroy(impl_);
+  }
+
+  /// Get the executor associated with the object.
+  executor_type get_executor() BOOST_ASIO_NOEXCEPT
+  {
+    return executor_;
+  }
+
+  /// Get the number of permits that are currently available.
+  std::size_t available() const BOOST_ASIO_NOEXCEPT
+  {
+    return service_->value(impl_);
+  }
+
+  /// Try to obtain a permit without waiting.
+  /**
+   * @returns @c true if a permit was obtained.
+   */
+  bool try_acquire()
+  {
+    return service_->try_complete(impl_,
+        &basic_async_semaphore::try_acquire_state);
+  }
+
+  /// Return permits to the semaphore.
+  /**
+   * Each permit is handed to a waiting acquire operation, if there is one, or
+   * otherwise becomes available.
+   *
+   * @param n The number of permits to return.
+   */
+  void release(std::size_t n = 1)
+  {
+    service_->release(impl_, n);
+  }
+
+  /// Cancel all waiting acquire operations.
+  /**
+   * Each pending acquire operation completes with the
+   * boost::asio::error::operation_aborted error. The number of available
+   * permits is unaffected.
+   */
+  void cancel()
+  {
+    service_->cancel(impl_);
+  }
+
+  /// Start an asynchronous operation to obtain a permit.
+  /**
+   * This function is used to asynchronously obtain a permit from the
+   * semaphore. The function call always returns immediately.
+   *
+   * @param handler The handler to be called when a permit has been obtained.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error // Result of operation.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using boost::asio::post().
+   *
+   * On success, the caller holds a permit and must return it using release().
+   */
+  template <
+      BOOST_ASIO_COMPLETION_TOKEN_FOR(void (boost::system::error_code))
+        AcquireHandler BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(AcquireHandler,
+      void (boost::system::error_code))
+  async_acquire(
+      BOOST_ASIO_MOVE_ARG(AcquireHandler) handler
+        BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<AcquireHandler, void (boost::system::error_code)>(
+        initiate_async_acquire(this), handler);
+  }
+
+private:
+  // Disallow copying and assignment.
+  basic_async_semaphore(const basic_async_semaphore&) BOOST_ASIO_DELETED;
+  basic_async_semaphore& operator=(
+      const basic_async_semaphore&) BOOST_ASIO_DELETED;
+
+  // Helper function to get an executor's context.
+  template <typename T>
+  static execution_context& get_context(const T& t,
+      typename enable_if<execution::is_executor<T>::value>::type* = 0)
+  {
+    return boost::asio::query(t, execution::context);
+  }
+
+  // Helper function to get an executor's context.
+  template <typename T>
+  static execution_context& get_context(const T& t,
+      typename enable_if<!execution::is_executor<T>::value>::type* = 0)
+  {
+    return t.context();
+  }
+
+  // An acquire succeeds when a permit is available. There are never waiters
+  // while permits are available.
+  static bool try_acquire_state(std::size_t state, std::size_t& next)
+  {
+    next = state - service_type::value_unit;
+    return state >= service_type::value_unit;
+  }
+
+  class initiate_async_acquire
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_acquire(basic_async_semaphore* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const BOOST_ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename AcquireHandler>
+    void operator()(BOOST_ASIO_MOVE_ARG(AcquireHandler) handler) const
+    {
+      detail::non_const_lvalue<AcquireHandler> handler2(handler);
+      self_->service_->async_wait(self_->impl_,
+          &basic_async_semaphore::try_acquire_state, handler2.value,
+          self_->executor_, "async_semaphore", "async_acquire");
+    }
+
+  private:
+    basic_async_semaphore* self_;
+  };
+
+  service_type* service_;
+  mutable service_type::implementation_type impl_;
+  executor_type executor_;
+};
+
+/// Typedef for the typical usage of an asynchronous semaphore.
+typedef basic_async_semaphore<> async_semaphore;
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // (defined(BOOST_ASIO_HAS_MOVE)
+       //     && defined(BOOST_ASIO_HAS_STD_ATOMIC))
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // BOOST_ASIO_BASIC_ASYNC_SEMAPHORE_HPP
@@ -0,0 +1,396 @@
+//
+// basic_channel.hpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_BASIC_CHANNEL_HPP
+#define BOOST_ASIO_BASIC_CHANNEL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if (defined(BOOST_ASIO_HAS_MOVE) \
+    && defined(BOOST_ASIO_HAS_VARIADIC_TEMPLATES)) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <cstddef>
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/execution_context.hpp>
+#include <boost/asio/detail/channel_message.hpp>
+#include <boost/asio/detail/channel_service.hpp>
+#include <boost/asio/detail/non_const_lvalue.hpp>
+#include <boost/asio/detail/null_mutex.hpp>
+#include <boost/asio/detail/type_traits.hpp>
+#include <boost/asio/execution/context.hpp>
+#include <boost/asio/execution/executor.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+template <typename Executor, typename Signature>
+class basic_channel;
+
+/// Provides message passing between asynchronous operations.
+/**
+ * The basic_channel class template carries messages from senders to
+ * receivers, all of which run on executors. A message is sent using
+ * async_send() and received using async_receive(). The receive handler is
+ * passed the message as its second argument.
+ *
+ * The @c Signature template parameter is the signature of the receive
+ * handler. It must be either <tt>void(boost::system::error_code)</tt>, for a
+ * channel that carries notifications without a value, or
+ * <tt>void(boost::system::error_code, T)</tt>, for a channel that carries
+ * values of type @c T. @c T must be move constructible. When a receive
+ * operation fails, the handler is passed a value-initialised @c T.
+ *
+ * The channel buffers at most @c max_buffer_size messages, where the maximum
+ * is specified on construction. A send completes as soon as a receiver takes
+ * the message or the message is buffered. Otherwise, the send waits for space
+ * to become available, providing back-pressure to the sender. When a receiver
+ * is already waiting, the message is handed over directly, without passing
+ * through the buffer. Storage for the buffer is allocated once, when the
+ * channel is constructed.
+ *
+ * Completion handlers are never invoked from within the initiating function.
+ * They are posted to the channel's I/O executor, and dispatched from there to
+ * the handler's associated executor.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * The channel performs no locking. Use boost::asio::basic_concurrent_channel
+ * when the senders and receivers may run concurrently.
+ *
+ * @par Example
+ * @code boost::asio::basic_channel<boost::asio::any_io_executor,
+ *     void(boost::system::error_code, std::string)> ch(my_context, 16);
+ *
+ * ch.async_send("hello", send_handler);
+ * ch.async_receive(
+ *     [](boost::system::error_code ec, std::string message)
+ *     {
+ *       ...
+ *     }); @endcode
+ */
+template <typename Executor, typename... Args>
+class basic_channel<Executor, void (boost::system::error_code, Args...)>
+{
+private:
+  typedef detail::channel_message<
+    void (boost::system::error_code, Args...)> message_type;
+
+  typedef detail::channel_service<detail::null_mutex> service_type;
+
+public:
+  /// The type of the executor associated with the object.
+  typedef Executor executor_type;
+
+  /// Rebinds the channel type to another executor.
+  template <typename Executor1>
+  struct rebind_executor
+  {
+    /// The channel type when rebound to the specified executor.
+    typedef basic_channel<Executor1,
+      void (boost::system::error_code, Args...)> other;
+  };
+
+  /// Construct a channel.
+  /**
+   * @param ex The I/O executor that the channel will use, by default, to
+   * dispatch handlers for any asynchronous operations performed on the
+   * channel.
+   *
+   * @param max_buffer_size The maximum number of messages that may be
+   * buffered in the channel. When zero, each send waits for a receiver.
+   */
+  explicit basic_channel(const executor_type& ex,
+      std::size_t max_buffer_size = 0)
+    : service_(&boost::asio::use_service<service_type>(
+          basic_channel::get_context(ex))),
+      executor_(ex)
+  {
+    service_->construct(impl_, max_buffer_size);
+  }
+
+  /// Construct a channel.
+  /**
+   * @param context An execution context which provides the I/O executor that
+   * the channel will use, by default, to dispatch handlers for any
+   * asynchronous operations performed on the channel.
+   *
+   * @param max_buffer_size The maximum number of messages that may be
+   * buffered in the channel. When zero, each send waits for a receiver.
+   */
+  template <typename ExecutionContext>
+  explicit basic_channel(ExecutionContext& context,
+      std::size_t max_buffer_size = 0,
+      typename enable_if<
+        is_convertible<ExecutionContext&, execution_context&>::value
+      >::type* = 0)
+    : service_(&boost::asio::use_service<service_type>(context)),
+      executor_(context.get_executor())
+  {
+    service_->construct(impl_, max_buffer_size);
+  }
+
+  /// Destroys the channel.
+  /**
+   * Any pending asynchronous operations are cancelled, as if by calling
+   * cancel(). Buffered messages are discarded.
+   */
+  ~basic_channel()
+  {
+    service_->destroy(impl_);
+  }
+
+  /// Get the executor associated with the object.
+  executor_type get_executor() BOOST_ASIO_NOEXCEPT
+  {
+    return executor_;
+  }
+
+  /// Get the maximum number of messages that may be buffered.
+  std::size_t capacity() const BOOST_ASIO_NOEXCEPT
+  {
+    return service_->capacity(impl_);
+  }
+
+  /// Determine whether the channel is open.
+  bool is_open() const BOOST_ASIO_NOEXCEPT
+  {
+    return service_->is_open(impl_);
+  }
+
+  /// Determine whether a message can be received without waiting.
+  bool ready() const BOOST_ASIO_NOEXCEPT
+  {
+    return service_->ready(impl_);
+  }
+
+  /// Close the channel.
+  /**
+   * Pending send operations, and any subsequent sends, complete with the
+   * boost::asio::error::channel_closed error. Messages that are already
+   * buffered may still be received. Once the buffer is empty, receive
+   * operations also complete with the boost::asio::error::channel_closed
+   * error.
+   */
+  void close()
+  {
+    service_->close(impl_);
+  }
+
+  /// Cancel all pending asynchronous operations.
+  /**
+   * Pending send and receive operations complete with the
+   * boost::asio::error::operation_aborted error. Buffered messages are
+   * unaffected.
+   */
+  void cancel()
+  {
+    service_->cancel(impl_);
+  }
+
+  /// Reset the channel to its initial state.
+  /**
+   * Buffered messages are discarded, pending asynchronous operations are
+   * cancelled, and a closed channel is reopened.
+   */
+  void reset()
+  {
+    service_->reset(impl_);
+  }
+
+  /// Try to send a message without waiting.
+  /**
+   * @returns @c true if the message was handed to a waiting receiver or
+   * buffered, or @c false if the channel is closed or full.
+   */
+  bool try_send(Args... args)
+  {
+    message_type m(BOOST_ASIO_MOVE_CAST(Args)(args)...);
+    return service_->try_send(impl_, m);
+  }
+
+  /// Try to receive a message without waiting.
+  /**
+   * If a message is available, the handler is invoked from within this
+   * function, as if by a call to <tt>handler(error_code(), message)</tt>.
+   *
+   * @returns @c true if a message was received, otherwise @c false.
+   */
+  template <typename Handler>
+  bool try_receive(BOOST_ASIO_MOVE_ARG(Handler) handler)
+  {
+    typename decay<Handler>::type handler2(
+        BOOST_ASIO_MOVE_CAST(Handler)(handler));
+    return service_->try_receive(impl_, handler2);
+  }
+
+  /// Start an asynchronous send.
+  /**
+   * This function is used to asynchronously send a message on the channel.
+   * The function call always returns immediately.
+   *
+   * @param args The message to be sent.
+   *
+   * @param handler The handler to be called when the send operation
+   * completes. The function signature of the handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error // Result of operation.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using boost::asio::post().
+   */
+  template <
+      BOOST_ASIO_COMPLETION_TOKEN_FOR(void (boost::system::error_code))
+        SendHandler BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(SendHandler,
+      void (boost::system::error_code))
+  async_send(Args... args,
+      BOOST_ASIO_MOVE_ARG(SendHandler) handler
+        BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<SendHandler, void (boost::system::error_code)>(
+        initiate_async_send(this), handler,
+        message_type(BOOST_ASIO_MOVE_CAST(Args)(args)...));
+  }
+
+  /// Start an asynchronous receive.
+  /**
+   * This function is used to asynchronously receive a message from the
+   * channel. The function call always returns immediately.
+   *
+   * @param handler The handler to be called when the receive operation
+   * completes. The function signature of the handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   T message // The received message, if any.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using boost::asio::post().
+   */
+  template <
+      BOOST_ASIO_COMPLETION_TOKEN_FOR(void (boost::system::error_code,
+        Args...)) ReceiveHandler
+          BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(ReceiveHandler,
+      void (boost::system::error_code, Args...))
+  async_receive(
+      BOOST_ASIO_MOVE_ARG(ReceiveHandler) handler
+        BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<ReceiveHandler,
+      void (boost::system::error_code, Args...)>(
+        initiate_async_receive(this), handler);
+  }
+
+private:
+  // Disallow copying and assignment.
+  basic_channel(const basic_channel&) BOOST_ASIO_DELETED;
+  basic_channel& operator=(const basic_channel&) BOOST_ASIO_DELETED;
+
+  // Helper function to get an executor's context.
+  template <typename T>
+  static execution_context& get_context(const T& t,
+      typename enable_if<execution::is_executor<T>::value>::type* = 0)
+  {
+    return boost::asio::query(t, execution::context);
+  }
+
+  // Helper function to get an executor's context.
+  template <typename T>
+  static execution_context& get_context(const T& t,
+      typename enable_if<!execution::is_executor<T>::value>::type* = 0)
+  {
+    return t.context();
+  }
+
+  class initiate_async_send
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_send(basic_channel* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const BOOST_ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename SendHandler>
+    void operator()(BOOST_ASIO_MOVE_ARG(SendHandler) handler,
+        message_type&& m) const
+    {
+      detail::non_const_lvalue<SendHandler> handler2(handler);
+      self_->service_->async_send(self_->impl_,
+          m, handler2.value, self_->executor_);
+    }
+
+  private:
+    basic_channel* self_;
+  };
+
+  class initiate_async_receive
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive(basic_channel* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const BOOST_ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReceiveHandler>
+    void operator()(BOOST_ASIO_MOVE_ARG(ReceiveHandler) handler) const
+    {
+      detail::non_const_lvalue<ReceiveHandler> handler2(handler);
+      self_->service_->async_receive(self_->impl_,
+          handler2.value, self_->executor_);
+    }
+
+  private:
+    basic_channel* self_;
+  };
+
+  service_type* service_;
+  mutable service_type::implementation_type<message_type> impl_;
+  executor_type executor_;
+};
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // (defined(BOOST_ASIO_HAS_MOVE)
+       //     && defined(BOOST_ASIO_HAS_VARIADIC_TEMPLATES))
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // BOOST_ASIO_BASIC_CHANNEL_HPP
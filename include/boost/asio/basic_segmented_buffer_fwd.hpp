@@ -0,0 +1,33 @@
+//
+// basic_segmented_buffer_fwd.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_BASIC_SEGMENTED_BUFFER_FWD_HPP
+#define BOOST_ASIO_BASIC_SEGMENTED_BUFFER_FWD_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <memory>
+
+namespace boost {
+namespace asio {
+
+template <typename Allocator = std::allocator<char> >
+class basic_segmented_buffer;
+
+template <typename Allocator = std::allocator<char> >
+class dynamic_segmented_buffer;
+
+} // namespace asio
+} // namespace boost
+
+#endif // BOOST_ASIO_BASIC_SEGMENTED_BUFFER_FWD_HPP
@@ -22,12 +22,17 @@
 #include <boost/asio/detail/handler_type_requirements.hpp>
 #include <boost/asio/detail/io_object_impl.hpp>
 #include <boost/asio/detail/non_const_lvalue.hpp>
-#include <boost/asio/detail/signal_set_service.hpp>
 #include <boost/asio/detail/throw_error.hpp>
 #include <boost/asio/detail/type_traits.hpp>
 #include <boost/asio/error.hpp>
 #include <boost/asio/execution_context.hpp>
 
+#if defined(BOOST_ASIO_HAS_SIGNALFD)
+# include <boost/asio/detail/signalfd_signal_set_service.hpp>
+#else // defined(BOOST_ASIO_HAS_SIGNALFD)
+# include <boost/asio/detail/signal_set_service.hpp>
+#endif // defined(BOOST_ASIO_HAS_SIGNALFD)
+
 namespace boost {
 namespace asio {
 
@@ -90,6 +95,17 @@ namespace asio {
  * and @c pthread_sigmask(). For signals to be delivered, programs must ensure
  * that any signals registered using signal_set objects are unblocked in at
  * least one thread.
+ *
+ * @par Receiving signals using signalfd on Linux
+ *
+ * If @c BOOST_ASIO_ENABLE_SIGNALFD is defined, each execution context receives
+ * its signals by reading from its own @c signalfd descriptor, rather than
+ * through a process-wide signal handler. Multiple pending signals are then
+ * read, and their handlers are scheduled, together. In this mode, the rules
+ * above on signal masking are reversed: programs must ensure that any signals
+ * registered using signal_set objects are blocked in every thread. Also, a
+ * signal that is sent to the process is received by only one execution
+ * context.
  */
 template <typename Executor = any_io_executor>
 class basic_signal_set
@@ -561,7 +577,11 @@ private:
     basic_signal_set* self_;
   };
 
+#if defined(BOOST_ASIO_HAS_SIGNALFD)
+  detail::io_object_impl<detail::signalfd_signal_set_service, Executor> impl_;
+#else // defined(BOOST_ASIO_HAS_SIGNALFD)
   detail::io_object_impl<detail::signal_set_service, Executor> impl_;
+#endif // defined(BOOST_ASIO_HAS_SIGNALFD)
 };
 
 } // namespace asio
@@ -35,8 +35,13 @@
 # include <boost/asio/detail/reactive_socket_service.hpp>
 #endif
 
+#if defined(BOOST_ASIO_HAS_IO_SENDERS)
+# include <boost/asio/detail/reactive_socket_sender.hpp>
+#endif // defined(BOOST_ASIO_HAS_IO_SENDERS)
+
 #if defined(BOOST_ASIO_HAS_MOVE)
 # include <utility>
+# include <vector>
 #endif // defined(BOOST_ASIO_HAS_MOVE)
 
 #include <boost/asio/detail/push_options.hpp>
@@ -1464,6 +1469,88 @@ public:
   }
 #endif // !defined(BOOST_ASIO_NO_EXTENSIONS)
 
+#if defined(BOOST_ASIO_HAS_IO_SENDERS) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Obtain a sender for an asynchronous accept.
+  /**
+   * This function returns a sender that, when connected to a receiver and
+   * started, accepts a new connection into the given socket. The operation is
+   * performed by the acceptor's reactor, and its state lives in the object
+   * returned by execution::connect(), so no memory is allocated for the
+   * operation.
+   *
+   * On success, the receiver's @c set_value is called with no arguments. A
+   * failed operation calls @c set_error with the error_code, and a cancelled
+   * operation calls @c set_done. The receiver is called from a thread running
+   * the acceptor's execution context.
+   *
+   * @param peer The socket into which the new connection will be accepted.
+   * Ownership of the peer object is retained by the caller, which must
+   * guarantee that it is valid until the receiver is called.
+   *
+   * @par Example
+   * @code boost::asio::ip::tcp::socket socket(my_context);
+   * auto op = boost::asio::execution::connect(
+   *     acceptor.accept_sender(socket), my_receiver);
+   * boost::asio::execution::start(op); @endcode
+   */
+  template <typename Protocol1, typename Executor1>
+#if defined(GENERATING_DOCUMENTATION)
+  unspecified
+#else // defined(GENERATING_DOCUMENTATION)
+  detail::reactive_socket_accept_sender<
+    detail::reactive_socket_service<Protocol>,
+    basic_socket<Protocol1, Executor1> >
+#endif // defined(GENERATING_DOCUMENTATION)
+  accept_sender(basic_socket<Protocol1, Executor1>& peer,
+      typename enable_if<
+        is_convertible<Protocol, Protocol1>::value
+      >::type* = 0)
+  {
+    return detail::reactive_socket_accept_sender<
+      detail::reactive_socket_service<Protocol>,
+      basic_socket<Protocol1, Executor1> >(
+        impl_.get_service(), impl_.get_implementation(),
+        peer, static_cast<endpoint_type*>(0));
+  }
+
+  /// Obtain a sender for an asynchronous accept that also obtains the endpoint
+  /// of the peer.
+  /**
+   * This function returns a sender that, when connected to a receiver and
+   * started, accepts a new connection into the given socket and stores the
+   * remote peer's endpoint. It behaves as the single-argument overload
+   * otherwise.
+   *
+   * @param peer The socket into which the new connection will be accepted.
+   * Ownership of the peer object is retained by the caller, which must
+   * guarantee that it is valid until the receiver is called.
+   *
+   * @param peer_endpoint An endpoint object into which the endpoint of the
+   * remote peer will be written. Ownership of the peer_endpoint object is
+   * retained by the caller, which must guarantee that it is valid until the
+   * receiver is called.
+   */
+  template <typename Executor1>
+#if defined(GENERATING_DOCUMENTATION)
+  unspecified
+#else // defined(GENERATING_DOCUMENTATION)
+  detail::reactive_socket_accept_sender<
+    detail::reactive_socket_service<Protocol>,
+    basic_socket<protocol_type, Executor1> >
+#endif // defined(GENERATING_DOCUMENTATION)
+  accept_sender(basic_socket<protocol_type, Executor1>& peer,
+      endpoint_type& peer_endpoint)
+  {
+    return detail::reactive_socket_accept_sender<
+      detail::reactive_socket_service<Protocol>,
+      basic_socket<protocol_type, Executor1> >(
+        impl_.get_service(), impl_.get_implementation(),
+        peer, &peer_endpoint);
+  }
+#endif // defined(BOOST_ASIO_HAS_IO_SENDERS)
+       //   || defined(GENERATING_DOCUMENTATION)
+
 #if defined(BOOST_ASIO_HAS_MOVE) || defined(GENERATING_DOCUMENTATION)
   /// Accept a new connection.
   /**
@@ -2375,6 +2462,153 @@ public:
         context.get_executor(), &peer_endpoint,
         static_cast<other_socket_type*>(0));
   }
+
+#if !defined(BOOST_ASIO_HAS_IOCP) && !defined(BOOST_ASIO_WINDOWS_RUNTIME) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous accept of a batch of connections.
+  /**
+   * This function is used to asynchronously accept the connections that are
+   * waiting on the acceptor. When the acceptor becomes ready, connections are
+   * accepted until none remain or until @c max_connections have been
+   * accepted, and are all passed to a single invocation of the handler. The
+   * function call always returns immediately.
+   *
+   * The new sockets are created in non-blocking mode and with the
+   * close-on-exec flag set. Where the platform provides @c accept4, this is
+   * done as part of accepting each connection.
+   *
+   * This overload requires that the Protocol template parameter satisfy the
+   * AcceptableProtocol type requirements.
+   *
+   * @param max_connections The maximum number of connections to accept. A
+   * value of zero is treated as one.
+   *
+   * @param handler The handler to be called when the accept operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   // Result of operation.
+   *   const boost::system::error_code& error,
+   *   // On success, the newly accepted sockets.
+   *   std::vector<typename Protocol::socket::template
+   *     rebind_executor<executor_type>::other> peers
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using boost::asio::post().
+   *
+   * @note An error is reported only if no connections were accepted. If the
+   * error persists, it is reported by the next operation.
+   *
+   * @note This operation is not available on Windows.
+   *
+   * @par Example
+   * @code
+   * void accept_handler(const boost::system::error_code& error,
+   *     std::vector<boost::asio::ip::tcp::socket> peers)
+   * {
+   *   if (!error)
+   *   {
+   *     // Accept succeeded.
+   *   }
+   * }
+   *
+   * ...
+   *
+   * boost::asio::ip::tcp::acceptor acceptor(my_context);
+   * ...
+   * acceptor.async_accept_many(64, accept_handler);
+   * @endcode
+   */
+  template <
+      BOOST_ASIO_COMPLETION_TOKEN_FOR(void (boost::system::error_code,
+        std::vector<typename Protocol::socket::template rebind_executor<
+          executor_type>::other>)) MoveAcceptHandler
+            BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(MoveAcceptHandler,
+      void (boost::system::error_code,
+        std::vector<typename Protocol::socket::template
+          rebind_executor<executor_type>::other>))
+  async_accept_many(std::size_t max_connections,
+      BOOST_ASIO_MOVE_ARG(MoveAcceptHandler) handler
+        BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<MoveAcceptHandler,
+      void (boost::system::error_code,
+        std::vector<typename Protocol::socket::template
+          rebind_executor<executor_type>::other>)>(
+          initiate_async_accept_many(this), handler,
+          impl_.get_executor(), max_connections);
+  }
+
+  /// Start an asynchronous accept of a batch of connections.
+  /**
+   * This function is used to asynchronously accept the connections that are
+   * waiting on the acceptor. When the acceptor becomes ready, connections are
+   * accepted until none remain or until @c max_connections have been
+   * accepted, and are all passed to a single invocation of the handler. The
+   * function call always returns immediately.
+   *
+   * The new sockets are created in non-blocking mode and with the
+   * close-on-exec flag set. Where the platform provides @c accept4, this is
+   * done as part of accepting each connection.
+   *
+   * This overload requires that the Protocol template parameter satisfy the
+   * AcceptableProtocol type requirements.
+   *
+   * @param ex The I/O executor object to be used for the newly accepted
+   * sockets.
+   *
+   * @param max_connections The maximum number of connections to accept. A
+   * value of zero is treated as one.
+   *
+   * @param handler The handler to be called when the accept operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   // Result of operation.
+   *   const boost::system::error_code& error,
+   *   // On success, the newly accepted sockets.
+   *   std::vector<typename Protocol::socket::template
+   *     rebind_executor<Executor1>::other> peers
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using boost::asio::post().
+   *
+   * @note An error is reported only if no connections were accepted. If the
+   * error persists, it is reported by the next operation.
+   *
+   * @note This operation is not available on Windows.
+   */
+  template <typename Executor1,
+      BOOST_ASIO_COMPLETION_TOKEN_FOR(void (boost::system::error_code,
+        std::vector<typename Protocol::socket::template rebind_executor<
+          Executor1>::other>)) MoveAcceptHandler
+            BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(MoveAcceptHandler,
+      void (boost::system::error_code,
+        std::vector<typename Protocol::socket::template
+          rebind_executor<Executor1>::other>))
+  async_accept_many(const Executor1& ex, std::size_t max_connections,
+      BOOST_ASIO_MOVE_ARG(MoveAcceptHandler) handler
+        BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type),
+      typename enable_if<
+        is_executor<Executor1>::value
+          || execution::is_executor<Executor1>::value
+      >::type* = 0)
+  {
+    return async_initiate<MoveAcceptHandler,
+      void (boost::system::error_code,
+        std::vector<typename Protocol::socket::template
+          rebind_executor<Executor1>::other>)>(
+          initiate_async_accept_many(this), handler,
+          ex, max_connections);
+  }
+#endif // !defined(BOOST_ASIO_HAS_IOCP) && !defined(BOOST_ASIO_WINDOWS_RUNTIME)
+       //   || defined(GENERATING_DOCUMENTATION)
 #endif // defined(BOOST_ASIO_HAS_MOVE) || defined(GENERATING_DOCUMENTATION)
 
 private:
@@ -2483,6 +2717,40 @@ private:
     basic_socket_acceptor* self_;
   };
 
+#if defined(BOOST_ASIO_HAS_MOVE) \
+  && !defined(BOOST_ASIO_HAS_IOCP) && !defined(BOOST_ASIO_WINDOWS_RUNTIME)
+  class initiate_async_accept_many
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_accept_many(basic_socket_acceptor* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const BOOST_ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename MoveAcceptHandler, typename Executor1>
+    void operator()(BOOST_ASIO_MOVE_ARG(MoveAcceptHandler) handler,
+        const Executor1& peer_ex, std::size_t max_connections) const
+    {
+      detail::non_const_lvalue<MoveAcceptHandler> handler2(handler);
+      self_->impl_.get_service().async_accept_many(
+          self_->impl_.get_implementation(), peer_ex, max_connections,
+          handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_socket_acceptor* self_;
+  };
+#endif // defined(BOOST_ASIO_HAS_MOVE)
+       //   && !defined(BOOST_ASIO_HAS_IOCP)
+       //   && !defined(BOOST_ASIO_WINDOWS_RUNTIME)
+
 #if defined(BOOST_ASIO_WINDOWS_RUNTIME)
   detail::io_object_impl<
     detail::null_socket_service<Protocol>, Executor> impl_;
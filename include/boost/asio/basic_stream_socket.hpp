@@ -19,11 +19,16 @@
 #include <cstddef>
 #include <boost/asio/async_result.hpp>
 #include <boost/asio/basic_socket.hpp>
+#include <boost/asio/detail/chrono.hpp>
 #include <boost/asio/detail/handler_type_requirements.hpp>
 #include <boost/asio/detail/non_const_lvalue.hpp>
 #include <boost/asio/detail/throw_error.hpp>
 #include <boost/asio/error.hpp>
 
+#if defined(BOOST_ASIO_HAS_IO_SENDERS)
+# include <boost/asio/detail/reactive_socket_sender.hpp>
+#endif // defined(BOOST_ASIO_HAS_IO_SENDERS)
+
 #include <boost/asio/detail/push_options.hpp>
 
 namespace boost {
@@ -858,6 +863,64 @@ public:
         buffers, socket_base::message_flags(0));
   }
 
+#if defined(BOOST_ASIO_HAS_OPERATION_DEADLINES) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous write that must complete by a deadline.
+  /**
+   * This function is used to asynchronously write data to the stream socket.
+   * The function call always returns immediately.
+   *
+   * The deadline is tracked by the socket's reactor, alongside its other
+   * timers. If the write has not completed by the expiry time, it is
+   * cancelled and the handler is passed the boost::asio::error::timed_out
+   * error. No separate timer object is required.
+   *
+   * @param buffers One or more data buffers to be written to the socket.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the handler is called.
+   *
+   * @param expiry The time by which the write must complete.
+   *
+   * @param handler The handler to be called when the write operation completes.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes written.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using boost::asio::post().
+   *
+   * @par Example
+   * @code
+   * socket.async_write_some_until(boost::asio::buffer(data, size),
+   *     boost::asio::chrono::steady_clock::now()
+   *       + boost::asio::chrono::seconds(30),
+   *     handler);
+   * @endcode
+   */
+  template <typename ConstBufferSequence,
+      BOOST_ASIO_COMPLETION_TOKEN_FOR(void (boost::system::error_code,
+        std::size_t)) WriteHandler
+          BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+      void (boost::system::error_code, std::size_t))
+  async_write_some_until(const ConstBufferSequence& buffers,
+      const chrono::steady_clock::time_point& expiry,
+      BOOST_ASIO_MOVE_ARG(WriteHandler) handler
+        BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<WriteHandler,
+      void (boost::system::error_code, std::size_t)>(
+        initiate_async_send_until(this), handler,
+        buffers, socket_base::message_flags(0), expiry);
+  }
+#endif // defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+       //   || defined(GENERATING_DOCUMENTATION)
+
   /// Read some data from the socket.
   /**
    * This function is used to read data from the stream socket. The function
@@ -973,6 +1036,145 @@ public:
         buffers, socket_base::message_flags(0));
   }
 
+#if defined(BOOST_ASIO_HAS_OPERATION_DEADLINES) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous read that must complete by a deadline.
+  /**
+   * This function is used to asynchronously read data from the stream socket.
+   * The function call always returns immediately.
+   *
+   * The deadline is tracked by the socket's reactor, alongside its other
+   * timers. If the read has not completed by the expiry time, it is cancelled
+   * and the handler is passed the boost::asio::error::timed_out error. No
+   * separate timer object is required.
+   *
+   * @param buffers One or more buffers into which the data will be read.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the handler is called.
+   *
+   * @param expiry The time by which the read must complete.
+   *
+   * @param handler The handler to be called when the read operation completes.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes read.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using boost::asio::post().
+   *
+   * @par Example
+   * @code
+   * socket.async_read_some_until(boost::asio::buffer(data, size),
+   *     boost::asio::chrono::steady_clock::now()
+   *       + boost::asio::chrono::seconds(30),
+   *     handler);
+   * @endcode
+   */
+  template <typename MutableBufferSequence,
+      BOOST_ASIO_COMPLETION_TOKEN_FOR(void (boost::system::error_code,
+        std::size_t)) ReadHandler
+          BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
+      void (boost::system::error_code, std::size_t))
+  async_read_some_until(const MutableBufferSequence& buffers,
+      const chrono::steady_clock::time_point& expiry,
+      BOOST_ASIO_MOVE_ARG(ReadHandler) handler
+        BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<ReadHandler,
+      void (boost::system::error_code, std::size_t)>(
+        initiate_async_receive_until(this), handler,
+        buffers, socket_base::message_flags(0), expiry);
+  }
+#endif // defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#if defined(BOOST_ASIO_HAS_IO_SENDERS) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Obtain a sender for an asynchronous write.
+  /**
+   * This function returns a sender that, when connected to a receiver and
+   * started, writes data to the stream socket. The operation is performed by
+   * the socket's reactor, and its state lives in the object returned by
+   * execution::connect(), so no memory is allocated for the operation.
+   *
+   * On success, the receiver's @c set_value is called with the number of
+   * bytes written. A failed operation calls @c set_error with the
+   * error_code, and a cancelled operation calls @c set_done. The receiver is
+   * called from a thread running the socket's execution context.
+   *
+   * @param buffers One or more data buffers to be written to the socket.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the receiver is called.
+   *
+   * @par Example
+   * @code auto op = boost::asio::execution::connect(
+   *     socket.write_some_sender(boost::asio::buffer(data, size)),
+   *     my_receiver);
+   * boost::asio::execution::start(op); @endcode
+   */
+  template <typename ConstBufferSequence>
+#if defined(GENERATING_DOCUMENTATION)
+  unspecified
+#else // defined(GENERATING_DOCUMENTATION)
+  detail::reactive_socket_send_sender<
+    detail::reactive_socket_service<Protocol>, ConstBufferSequence>
+#endif // defined(GENERATING_DOCUMENTATION)
+  write_some_sender(const ConstBufferSequence& buffers)
+  {
+    return detail::reactive_socket_send_sender<
+      detail::reactive_socket_service<Protocol>, ConstBufferSequence>(
+        this->impl_.get_service(), this->impl_.get_implementation(),
+        buffers, socket_base::message_flags(0));
+  }
+
+  /// Obtain a sender for an asynchronous read.
+  /**
+   * This function returns a sender that, when connected to a receiver and
+   * started, reads data from the stream socket. The operation is performed by
+   * the socket's reactor, and its state lives in the object returned by
+   * execution::connect(), so no memory is allocated for the operation.
+   *
+   * On success, the receiver's @c set_value is called with the number of
+   * bytes read. A failed operation, including one that reaches the end of the
+   * stream, calls @c set_error with the error_code, and a cancelled operation
+   * calls @c set_done. The receiver is called from a thread running the
+   * socket's execution context.
+   *
+   * @param buffers One or more buffers into which the data will be read.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the receiver is called.
+   *
+   * @par Example
+   * @code auto op = boost::asio::execution::connect(
+   *     socket.read_some_sender(boost::asio::buffer(data, size)),
+   *     my_receiver);
+   * boost::asio::execution::start(op); @endcode
+   */
+  template <typename MutableBufferSequence>
+#if defined(GENERATING_DOCUMENTATION)
+  unspecified
+#else // defined(GENERATING_DOCUMENTATION)
+  detail::reactive_socket_recv_sender<
+    detail::reactive_socket_service<Protocol>, MutableBufferSequence>
+#endif // defined(GENERATING_DOCUMENTATION)
+  read_some_sender(const MutableBufferSequence& buffers)
+  {
+    return detail::reactive_socket_recv_sender<
+      detail::reactive_socket_service<Protocol>, MutableBufferSequence>(
+        this->impl_.get_service(), this->impl_.get_implementation(),
+        buffers, socket_base::message_flags(0));
+  }
+#endif // defined(BOOST_ASIO_HAS_IO_SENDERS)
+       //   || defined(GENERATING_DOCUMENTATION)
+
 private:
   // Disallow copying and assignment.
   basic_stream_socket(const basic_stream_socket&) BOOST_ASIO_DELETED;
@@ -1045,6 +1247,76 @@ private:
   private:
     basic_stream_socket* self_;
   };
+
+#if defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+  class initiate_async_send_until
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_send_until(basic_stream_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const BOOST_ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WriteHandler, typename ConstBufferSequence>
+    void operator()(BOOST_ASIO_MOVE_ARG(WriteHandler) handler,
+        const ConstBufferSequence& buffers, socket_base::message_flags flags,
+        const chrono::steady_clock::time_point& expiry) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      BOOST_ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+      detail::non_const_lvalue<WriteHandler> handler2(handler);
+      self_->impl_.get_service().async_send_until(
+          self_->impl_.get_implementation(), buffers, flags, expiry,
+          handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_stream_socket* self_;
+  };
+
+  class initiate_async_receive_until
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive_until(basic_stream_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const BOOST_ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReadHandler, typename MutableBufferSequence>
+    void operator()(BOOST_ASIO_MOVE_ARG(ReadHandler) handler,
+        const MutableBufferSequence& buffers, socket_base::message_flags flags,
+        const chrono::steady_clock::time_point& expiry) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ReadHandler.
+      BOOST_ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+      detail::non_const_lvalue<ReadHandler> handler2(handler);
+      self_->impl_.get_service().async_receive_until(
+          self_->impl_.get_implementation(), buffers, flags, expiry,
+          handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_stream_socket* self_;
+  };
+#endif // defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
 };
 
 } // namespace asio
@@ -27,6 +27,10 @@
 #include <boost/asio/error.hpp>
 #include <boost/asio/wait_traits.hpp>
 
+#if defined(BOOST_ASIO_HAS_IO_SENDERS)
+# include <boost/asio/detail/timer_wait_sender.hpp>
+#endif // defined(BOOST_ASIO_HAS_IO_SENDERS)
+
 #if defined(BOOST_ASIO_HAS_MOVE)
 # include <utility>
 #endif // defined(BOOST_ASIO_HAS_MOVE)
@@ -624,6 +628,35 @@ public:
     return s;
   }
 
+  /// Get the timer's slack.
+  /**
+   * This function may be used to obtain the amount of time by which the timer
+   * is permitted to expire later than its expiry time.
+   */
+  duration slack() const
+  {
+    return impl_.get_service().slack(impl_.get_implementation());
+  }
+
+  /// Set the timer's slack.
+  /**
+   * This function sets the amount of time by which the timer is permitted to
+   * expire later than its expiry time, so that it can expire together with
+   * other timers. A larger slack lets the implementation avoid reprogramming
+   * its underlying timer when asynchronous wait operations are started. By
+   * default the slack is zero.
+   *
+   * The slack applies to asynchronous wait operations that are started after
+   * this function is called.
+   *
+   * @param slack_time The slack to be used for the timer. Must not be
+   * negative.
+   */
+  void slack(const duration& slack_time)
+  {
+    impl_.get_service().set_slack(impl_.get_implementation(), slack_time);
+  }
+
 #if !defined(BOOST_ASIO_NO_DEPRECATED)
   /// (Deprecated: Use expiry().) Get the timer's expiry time relative to now.
   /**
@@ -761,6 +794,42 @@ public:
         initiate_async_wait(this), handler);
   }
 
+#if defined(BOOST_ASIO_HAS_IO_SENDERS) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Obtain a sender for an asynchronous wait on the timer.
+  /**
+   * This function returns a sender that, when connected to a receiver and
+   * started, waits for the timer to expire. The wait is queued with the
+   * timer's scheduler, and its state lives in the object returned by
+   * execution::connect(), so no memory is allocated for the operation.
+   *
+   * The receiver's @c set_value is called with no arguments when the timer
+   * expires, and @c set_done is called if the timer is cancelled. The
+   * receiver is called from a thread running the timer's execution context.
+   *
+   * @par Example
+   * @code timer.expires_after(std::chrono::seconds(1));
+   * auto op = boost::asio::execution::connect(
+   *     timer.wait_sender(), my_receiver);
+   * boost::asio::execution::start(op); @endcode
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  unspecified
+#else // defined(GENERATING_DOCUMENTATION)
+  detail::timer_wait_sender<
+    detail::deadline_timer_service<
+      detail::chrono_time_traits<Clock, WaitTraits> > >
+#endif // defined(GENERATING_DOCUMENTATION)
+  wait_sender()
+  {
+    return detail::timer_wait_sender<
+      detail::deadline_timer_service<
+        detail::chrono_time_traits<Clock, WaitTraits> > >(
+          impl_.get_service(), impl_.get_implementation());
+  }
+#endif // defined(BOOST_ASIO_HAS_IO_SENDERS)
+       //   || defined(GENERATING_DOCUMENTATION)
+
 private:
   // Disallow copying and assignment.
   basic_waitable_timer(const basic_waitable_timer&) BOOST_ASIO_DELETED;
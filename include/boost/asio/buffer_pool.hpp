@@ -0,0 +1,228 @@
+//
+// buffer_pool.hpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_BUFFER_POOL_HPP
+#define BOOST_ASIO_BUFFER_POOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_MOVE) || defined(GENERATING_DOCUMENTATION)
+
+#include <cstddef>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/detail/limits.hpp>
+#include <boost/asio/detail/mutex.hpp>
+#include <boost/asio/detail/noncopyable.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+class buffer_pool;
+
+/// A buffer that has been taken from a buffer_pool.
+/**
+ * A pooled_buffer object owns a single fixed-size buffer obtained from a
+ * buffer_pool. The buffer is returned to the pool when the object is
+ * destroyed or reset. Objects of this type are movable but not copyable.
+ *
+ * The buffer has a capacity equal to the pool's buffer size, and a size that
+ * indicates how much of it is in use. A newly acquired buffer's size is equal
+ * to its capacity.
+ */
+class pooled_buffer
+{
+public:
+  /// Construct an empty pooled_buffer that does not own a buffer.
+  pooled_buffer() BOOST_ASIO_NOEXCEPT
+    : pool_(0),
+      data_(0),
+      size_(0)
+  {
+  }
+
+  /// Move construct a pooled_buffer, transferring ownership of the buffer.
+  pooled_buffer(pooled_buffer&& other) BOOST_ASIO_NOEXCEPT
+    : pool_(other.pool_),
+      data_(other.data_),
+      size_(other.size_)
+  {
+    other.pool_ = 0;
+    other.data_ = 0;
+    other.size_ = 0;
+  }
+
+  /// Move assign a pooled_buffer, transferring ownership of the buffer.
+  pooled_buffer& operator=(pooled_buffer&& other) BOOST_ASIO_NOEXCEPT
+  {
+    if (this != &other)
+    {
+      reset();
+      pool_ = other.pool_;
+      data_ = other.data_;
+      size_ = other.size_;
+      other.pool_ = 0;
+      other.data_ = 0;
+      other.size_ = 0;
+    }
+    return *this;
+  }
+
+  /// Destructor returns the buffer to its pool.
+  ~pooled_buffer()
+  {
+    reset();
+  }
+
+  /// Get the part of the buffer that is in use.
+  mutable_buffer data() const BOOST_ASIO_NOEXCEPT
+  {
+    return mutable_buffer(data_, size_);
+  }
+
+  /// Get the number of bytes of the buffer that are in use.
+  std::size_t size() const BOOST_ASIO_NOEXCEPT
+  {
+    return size_;
+  }
+
+  /// Get the total size of the buffer.
+  BOOST_ASIO_DECL std::size_t capacity() const BOOST_ASIO_NOEXCEPT;
+
+  /// Determine whether the object owns a buffer.
+  bool empty() const BOOST_ASIO_NOEXCEPT
+  {
+    return data_ == 0;
+  }
+
+  /// Set the number of bytes of the buffer that are in use.
+  /**
+   * @param n The new size. Values greater than capacity() are clamped.
+   */
+  void resize(std::size_t n) BOOST_ASIO_NOEXCEPT
+  {
+    std::size_t c = capacity();
+    size_ = n < c ? n : c;
+  }
+
+  /// Return the buffer to its pool.
+  BOOST_ASIO_DECL void reset() BOOST_ASIO_NOEXCEPT;
+
+private:
+  friend class buffer_pool;
+
+  pooled_buffer(buffer_pool* pool, void* data, std::size_t size)
+    : pool_(pool),
+      data_(data),
+      size_(size)
+  {
+  }
+
+  buffer_pool* pool_;
+  void* data_;
+  std::size_t size_;
+};
+
+/// A thread-safe pool of fixed-size buffers.
+/**
+ * The buffer_pool class allows memory for reads to be shared between many
+ * connections. Rather than each connection owning a buffer for the whole time
+ * that it waits for data, a buffer is taken from the pool only when data is
+ * ready to be read, and is returned to the pool when the pooled_buffer that
+ * owns it is destroyed. See boost::asio::async_read_pooled.
+ *
+ * Buffers are allocated on demand when the pool is empty, so the pool never
+ * fails to provide a buffer. Returned buffers are kept for reuse, up to the
+ * maximum number specified at construction; any excess is freed.
+ *
+ * The pool must outlive all pooled_buffer objects that it has provided.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe.
+ */
+class buffer_pool
+  : private noncopyable
+{
+public:
+  /// Construct a buffer pool.
+  /**
+   * @param buffer_size The size of each buffer, in bytes.
+   *
+   * @param max_idle The maximum number of unused buffers to retain.
+   */
+  BOOST_ASIO_DECL explicit buffer_pool(std::size_t buffer_size,
+      std::size_t max_idle = (std::numeric_limits<std::size_t>::max)());
+
+  /// Destructor frees all unused buffers.
+  BOOST_ASIO_DECL ~buffer_pool();
+
+  /// Get the size of each buffer.
+  std::size_t buffer_size() const BOOST_ASIO_NOEXCEPT
+  {
+    return buffer_size_;
+  }
+
+  /// Get the number of unused buffers held by the pool.
+  BOOST_ASIO_DECL std::size_t idle() const;
+
+  /// Take a buffer from the pool, allocating one if the pool is empty.
+  /**
+   * @returns A pooled_buffer whose size is equal to buffer_size().
+   *
+   * @throws std::bad_alloc Thrown if a buffer could not be allocated.
+   */
+  BOOST_ASIO_DECL pooled_buffer acquire();
+
+private:
+  friend class pooled_buffer;
+
+  // The header stored in the memory of an unused buffer.
+  struct block
+  {
+    block* next_;
+  };
+
+  // Return a buffer to the pool.
+  BOOST_ASIO_DECL void release(void* data) BOOST_ASIO_NOEXCEPT;
+
+  // Mutex to protect access to the list of unused buffers.
+  mutable detail::mutex mutex_;
+
+  // The size of each buffer.
+  std::size_t buffer_size_;
+
+  // The maximum number of unused buffers to retain.
+  std::size_t max_idle_;
+
+  // The list of unused buffers.
+  block* idle_;
+
+  // The number of unused buffers.
+  std::size_t idle_count_;
+};
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#if defined(BOOST_ASIO_HEADER_ONLY)
+# include <boost/asio/impl/buffer_pool.ipp>
+#endif // defined(BOOST_ASIO_HEADER_ONLY)
+
+#endif // defined(BOOST_ASIO_HAS_MOVE) || defined(GENERATING_DOCUMENTATION)
+
+#endif // BOOST_ASIO_BUFFER_POOL_HPP
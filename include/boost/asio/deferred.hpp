@@ -0,0 +1,463 @@
+//
+// deferred.hpp
+// ~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DEFERRED_HPP
+#define BOOST_ASIO_DEFERRED_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_DEFERRED) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <cstddef>
+#include <tuple>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/detail/type_traits.hpp>
+#include <boost/asio/detail/utility.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// Tag used to select the constructors of the deferred operation types.
+struct deferred_init_tag {};
+
+// Trait used to obtain the completion signature of a deferred operation.
+template <typename T>
+struct deferred_signature;
+
+// Completion handler used to launch the tail of a deferred sequence.
+template <typename Handler, typename Tail>
+class deferred_sequence_handler;
+
+} // namespace detail
+
+template <typename Function>
+class deferred_function;
+
+template <typename... Values>
+class deferred_values;
+
+template <typename Signature, typename Initiation, typename... InitArgs>
+class deferred_async_operation;
+
+template <typename Head, typename Tail>
+class deferred_sequence;
+
+/// Class used to specify that an asynchronous operation should return a
+/// function object to lazily launch the operation.
+/**
+ * The deferred_t class is used to indicate that an asynchronous operation
+ * should return a function object which is itself an initiation function. A
+ * deferred_t object may be passed as a completion token to an asynchronous
+ * operation, typically using the special value @c boost::asio::deferred. For
+ * example:
+ *
+ * @code auto my_deferred_op
+ *   = my_socket.async_read_some(my_buffer,
+ *       boost::asio::deferred); @endcode
+ *
+ * The initiating function captures its arguments and returns without starting
+ * the operation. The operation is started when the returned object is invoked
+ * with a completion token, which may be any token including another deferred
+ * adapter:
+ *
+ * @code std::move(my_deferred_op)(
+ *   [](boost::system::error_code ec, std::size_t n)
+ *   {
+ *     ...
+ *   }); @endcode
+ *
+ * Deferred operations may be composed into a sequence using @c then(), or
+ * equivalently by passing a function wrapped by @c deferred as the completion
+ * token. The function receives the result of the previous operation and
+ * returns the next deferred operation. The whole sequence is itself a deferred
+ * operation, and all of its state, including the final completion handler, is
+ * moved from one step to the next. No additional memory is allocated to join
+ * the steps together.
+ */
+class deferred_t
+{
+public:
+  /// Default constructor.
+  BOOST_ASIO_CONSTEXPR deferred_t()
+  {
+  }
+
+  /// Adapts an executor to add the @c deferred_t completion token as the
+  /// default.
+  template <typename InnerExecutor>
+  struct executor_with_default : InnerExecutor
+  {
+    /// Specify @c deferred_t as the default completion token type.
+    typedef deferred_t default_completion_token_type;
+
+    /// Construct the adapted executor from the inner executor type.
+    executor_with_default(const InnerExecutor& ex) BOOST_ASIO_NOEXCEPT
+      : InnerExecutor(ex)
+    {
+    }
+
+    /// Convert the specified executor to the inner executor type, then use
+    /// that to construct the adapted executor.
+    template <typename OtherExecutor>
+    executor_with_default(const OtherExecutor& ex,
+        typename enable_if<
+          is_convertible<OtherExecutor, InnerExecutor>::value
+        >::type* = 0) BOOST_ASIO_NOEXCEPT
+      : InnerExecutor(ex)
+    {
+    }
+  };
+
+  /// Type alias to adapt an I/O object to use @c deferred_t as its
+  /// default completion token type.
+  template <typename T>
+  using as_default_on_t = typename T::template rebind_executor<
+      executor_with_default<typename T::executor_type> >::other;
+
+  /// Function helper to adapt an I/O object to use @c deferred_t as its
+  /// default completion token type.
+  template <typename T>
+  static typename decay<T>::type::template rebind_executor<
+      executor_with_default<typename decay<T>::type::executor_type>
+    >::other
+  as_default_on(BOOST_ASIO_MOVE_ARG(T) object)
+  {
+    return typename decay<T>::type::template rebind_executor<
+        executor_with_default<typename decay<T>::type::executor_type>
+      >::other(BOOST_ASIO_MOVE_CAST(T)(object));
+  }
+
+  /// Creates a completion token that continues a deferred sequence.
+  /**
+   * The function object is called with the result of the operation to which
+   * the token is passed, and must return the next deferred operation in the
+   * sequence.
+   */
+  template <typename Function>
+  deferred_function<typename decay<Function>::type>
+  operator()(BOOST_ASIO_MOVE_ARG(Function) function) const
+  {
+    return deferred_function<typename decay<Function>::type>(
+        detail::deferred_init_tag(),
+        BOOST_ASIO_MOVE_CAST(Function)(function));
+  }
+
+  /// Creates a deferred operation that completes immediately with the
+  /// specified values.
+  /**
+   * This is typically used as the final step of a deferred sequence, to
+   * transform the result of the preceding operation.
+   */
+  template <typename... Values>
+  static deferred_values<typename decay<Values>::type...>
+  values(BOOST_ASIO_MOVE_ARG(Values)... values)
+  {
+    return deferred_values<typename decay<Values>::type...>(
+        detail::deferred_init_tag(),
+        BOOST_ASIO_MOVE_CAST(Values)(values)...);
+  }
+};
+
+/// Wraps a function object so that it may be used as a completion token that
+/// continues a deferred sequence.
+template <typename Function>
+class deferred_function
+{
+public:
+  /// Constructor.
+  template <typename F>
+  BOOST_ASIO_CONSTEXPR explicit deferred_function(
+      detail::deferred_init_tag, BOOST_ASIO_MOVE_ARG(F) function)
+    : function_(BOOST_ASIO_MOVE_CAST(F)(function))
+  {
+  }
+
+  /// Calls the wrapped function object to obtain the next deferred operation.
+  template <typename... Args>
+  auto operator()(BOOST_ASIO_MOVE_ARG(Args)... args) BOOST_ASIO_RVALUE_REF_QUAL
+  {
+    return BOOST_ASIO_MOVE_CAST(Function)(function_)(
+        BOOST_ASIO_MOVE_CAST(Args)(args)...);
+  }
+
+//private:
+  Function function_;
+};
+
+/// Encapsulates deferred values.
+template <typename... Values>
+class BOOST_ASIO_NODISCARD deferred_values
+{
+private:
+  std::tuple<Values...> values_;
+
+  struct initiate
+  {
+    template <typename Handler, typename... V>
+    void operator()(Handler handler, BOOST_ASIO_MOVE_ARG(V)... values)
+    {
+      BOOST_ASIO_MOVE_OR_LVALUE(Handler)(handler)(
+          BOOST_ASIO_MOVE_CAST(V)(values)...);
+    }
+  };
+
+  template <typename CompletionToken, std::size_t... I>
+  auto invoke_helper(BOOST_ASIO_MOVE_ARG(CompletionToken) token,
+      detail::index_sequence<I...>)
+  {
+    return boost::asio::async_initiate<CompletionToken, void(Values...)>(
+        initiate(), token,
+        std::get<I>(BOOST_ASIO_MOVE_CAST(std::tuple<Values...>)(values_))...);
+  }
+
+public:
+  /// Construct a deferred operation from the values.
+  template <typename... V>
+  BOOST_ASIO_CONSTEXPR explicit deferred_values(
+      detail::deferred_init_tag, BOOST_ASIO_MOVE_ARG(V)... values)
+    : values_(BOOST_ASIO_MOVE_CAST(V)(values)...)
+  {
+  }
+
+  /// Passes the values to the completion handler obtained from the token.
+  template <BOOST_ASIO_COMPLETION_TOKEN_FOR(void(Values...)) CompletionToken>
+  auto operator()(BOOST_ASIO_MOVE_ARG(CompletionToken) token)
+    BOOST_ASIO_RVALUE_REF_QUAL
+  {
+    return this->invoke_helper(
+        BOOST_ASIO_MOVE_CAST(CompletionToken)(token),
+        detail::index_sequence_for<Values...>());
+  }
+
+  /// Passes copies of the values to the completion handler obtained from the
+  /// token.
+  template <BOOST_ASIO_COMPLETION_TOKEN_FOR(void(Values...)) CompletionToken>
+  auto operator()(BOOST_ASIO_MOVE_ARG(CompletionToken) token) const &
+  {
+    return deferred_values(*this)(
+        BOOST_ASIO_MOVE_CAST(CompletionToken)(token));
+  }
+
+  /// Creates a deferred sequence that passes the values to a function, which
+  /// returns the next deferred operation.
+  template <typename Function>
+  deferred_sequence<deferred_values,
+    deferred_function<typename decay<Function>::type> >
+  then(BOOST_ASIO_MOVE_ARG(Function) function) BOOST_ASIO_RVALUE_REF_QUAL
+  {
+    return deferred_sequence<deferred_values,
+      deferred_function<typename decay<Function>::type> >(
+        detail::deferred_init_tag(),
+        BOOST_ASIO_MOVE_CAST(deferred_values)(*this),
+        deferred_t()(BOOST_ASIO_MOVE_CAST(Function)(function)));
+  }
+
+  /// Creates a deferred sequence that passes copies of the values to a
+  /// function, which returns the next deferred operation.
+  template <typename Function>
+  deferred_sequence<deferred_values,
+    deferred_function<typename decay<Function>::type> >
+  then(BOOST_ASIO_MOVE_ARG(Function) function) const &
+  {
+    return deferred_values(*this).then(
+        BOOST_ASIO_MOVE_CAST(Function)(function));
+  }
+};
+
+/// Encapsulates a deferred asynchronous operation.
+/**
+ * Objects of this type are returned by initiating functions that are passed
+ * the @c deferred completion token. The object holds the operation's
+ * initiation function object and arguments, and starts the operation when it
+ * is invoked with a completion token.
+ */
+template <typename Signature, typename Initiation, typename... InitArgs>
+class BOOST_ASIO_NODISCARD deferred_async_operation
+{
+private:
+  Initiation initiation_;
+  std::tuple<InitArgs...> init_args_;
+
+  template <typename CompletionToken, std::size_t... I>
+  auto invoke_helper(BOOST_ASIO_MOVE_ARG(CompletionToken) token,
+      detail::index_sequence<I...>)
+  {
+    return boost::asio::async_initiate<CompletionToken, Signature>(
+        BOOST_ASIO_MOVE_CAST(Initiation)(initiation_), token,
+        std::get<I>(BOOST_ASIO_MOVE_CAST(std::tuple<InitArgs...>)(
+            init_args_))...);
+  }
+
+public:
+  /// Construct a deferred operation from an initiation function object and
+  /// its arguments.
+  template <typename I, typename... A>
+  BOOST_ASIO_CONSTEXPR explicit deferred_async_operation(
+      detail::deferred_init_tag, BOOST_ASIO_MOVE_ARG(I) initiation,
+      BOOST_ASIO_MOVE_ARG(A)... init_args)
+    : initiation_(BOOST_ASIO_MOVE_CAST(I)(initiation)),
+      init_args_(BOOST_ASIO_MOVE_CAST(A)(init_args)...)
+  {
+  }
+
+  /// Starts the operation using the specified completion token.
+  template <BOOST_ASIO_COMPLETION_TOKEN_FOR(Signature) CompletionToken>
+  auto operator()(BOOST_ASIO_MOVE_ARG(CompletionToken) token)
+    BOOST_ASIO_RVALUE_REF_QUAL
+  {
+    return this->invoke_helper(
+        BOOST_ASIO_MOVE_CAST(CompletionToken)(token),
+        detail::index_sequence_for<InitArgs...>());
+  }
+
+  /// Starts a copy of the operation using the specified completion token.
+  template <BOOST_ASIO_COMPLETION_TOKEN_FOR(Signature) CompletionToken>
+  auto operator()(BOOST_ASIO_MOVE_ARG(CompletionToken) token) const &
+  {
+    return deferred_async_operation(*this)(
+        BOOST_ASIO_MOVE_CAST(CompletionToken)(token));
+  }
+
+  /// Creates a deferred sequence that passes the result of the operation to a
+  /// function, which returns the next deferred operation.
+  template <typename Function>
+  deferred_sequence<deferred_async_operation,
+    deferred_function<typename decay<Function>::type> >
+  then(BOOST_ASIO_MOVE_ARG(Function) function) BOOST_ASIO_RVALUE_REF_QUAL
+  {
+    return deferred_sequence<deferred_async_operation,
+      deferred_function<typename decay<Function>::type> >(
+        detail::deferred_init_tag(),
+        BOOST_ASIO_MOVE_CAST(deferred_async_operation)(*this),
+        deferred_t()(BOOST_ASIO_MOVE_CAST(Function)(function)));
+  }
+
+  /// Creates a deferred sequence that passes the result of a copy of the
+  /// operation to a function, which returns the next deferred operation.
+  template <typename Function>
+  deferred_sequence<deferred_async_operation,
+    deferred_function<typename decay<Function>::type> >
+  then(BOOST_ASIO_MOVE_ARG(Function) function) const &
+  {
+    return deferred_async_operation(*this).then(
+        BOOST_ASIO_MOVE_CAST(Function)(function));
+  }
+};
+
+/// Defines a link between two consecutive operations in a sequence.
+/**
+ * The head is started first. When it completes, its result is passed to the
+ * tail to obtain the next deferred operation, which is then started with the
+ * sequence's completion handler. The completion signature of the sequence is
+ * that of the operation returned by the tail.
+ */
+template <typename Head, typename Tail>
+class BOOST_ASIO_NODISCARD deferred_sequence
+{
+private:
+  typedef typename detail::deferred_signature<
+    deferred_sequence>::type signature;
+
+  Head head_;
+  Tail tail_;
+
+  struct initiate
+  {
+    template <typename Handler>
+    void operator()(BOOST_ASIO_MOVE_ARG(Handler) handler,
+        BOOST_ASIO_MOVE_ARG(Head) head, BOOST_ASIO_MOVE_ARG(Tail) tail)
+    {
+      BOOST_ASIO_MOVE_CAST(Head)(head)(
+          detail::deferred_sequence_handler<
+            typename decay<Handler>::type, Tail>(
+              BOOST_ASIO_MOVE_CAST(Handler)(handler),
+              BOOST_ASIO_MOVE_CAST(Tail)(tail)));
+    }
+  };
+
+public:
+  /// Construct a sequence from its head and tail.
+  template <typename H, typename T>
+  BOOST_ASIO_CONSTEXPR explicit deferred_sequence(detail::deferred_init_tag,
+      BOOST_ASIO_MOVE_ARG(H) head, BOOST_ASIO_MOVE_ARG(T) tail)
+    : head_(BOOST_ASIO_MOVE_CAST(H)(head)),
+      tail_(BOOST_ASIO_MOVE_CAST(T)(tail))
+  {
+  }
+
+  /// Starts the sequence using the specified completion token.
+  template <BOOST_ASIO_COMPLETION_TOKEN_FOR(signature) CompletionToken>
+  auto operator()(BOOST_ASIO_MOVE_ARG(CompletionToken) token)
+    BOOST_ASIO_RVALUE_REF_QUAL
+  {
+    return boost::asio::async_initiate<CompletionToken, signature>(
+        initiate(), token, BOOST_ASIO_MOVE_CAST(Head)(head_),
+        BOOST_ASIO_MOVE_CAST(Tail)(tail_));
+  }
+
+  /// Starts a copy of the sequence using the specified completion token.
+  template <BOOST_ASIO_COMPLETION_TOKEN_FOR(signature) CompletionToken>
+  auto operator()(BOOST_ASIO_MOVE_ARG(CompletionToken) token) const &
+  {
+    return deferred_sequence(*this)(
+        BOOST_ASIO_MOVE_CAST(CompletionToken)(token));
+  }
+
+  /// Extends the sequence with a function that receives its result and
+  /// returns the next deferred operation.
+  template <typename Function>
+  deferred_sequence<deferred_sequence,
+    deferred_function<typename decay<Function>::type> >
+  then(BOOST_ASIO_MOVE_ARG(Function) function) BOOST_ASIO_RVALUE_REF_QUAL
+  {
+    return deferred_sequence<deferred_sequence,
+      deferred_function<typename decay<Function>::type> >(
+        detail::deferred_init_tag(),
+        BOOST_ASIO_MOVE_CAST(deferred_sequence)(*this),
+        deferred_t()(BOOST_ASIO_MOVE_CAST(Function)(function)));
+  }
+
+  /// Extends a copy of the sequence with a function that receives its result
+  /// and returns the next deferred operation.
+  template <typename Function>
+  deferred_sequence<deferred_sequence,
+    deferred_function<typename decay<Function>::type> >
+  then(BOOST_ASIO_MOVE_ARG(Function) function) const &
+  {
+    return deferred_sequence(*this).then(
+        BOOST_ASIO_MOVE_CAST(Function)(function));
+  }
+};
+
+/// A special value, similar to std::nothrow.
+/**
+ * See the documentation for boost::asio::deferred_t for a usage example.
+ */
+constexpr deferred_t deferred;
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#include <boost/asio/impl/deferred.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_DEFERRED)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // BOOST_ASIO_DEFERRED_HPP
@@ -0,0 +1,357 @@
+//
+// detail/async_sync_service.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_ASYNC_SYNC_SERVICE_HPP
+#define BOOST_ASIO_DETAIL_ASYNC_SYNC_SERVICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_MOVE) && defined(BOOST_ASIO_HAS_STD_ATOMIC)
+
+#include <atomic>
+#include <cstddef>
+#include <boost/asio/error.hpp>
+#include <boost/asio/execution_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/detail/async_waiter.hpp>
+#include <boost/asio/detail/async_waiter_op.hpp>
+#include <boost/asio/detail/bind_handler.hpp>
+#include <boost/asio/detail/handler_alloc_helpers.hpp>
+#include <boost/asio/detail/memory.hpp>
+#include <boost/asio/detail/mutex.hpp>
+#include <boost/asio/detail/op_queue.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// Implements the asynchronous mutex, semaphore, latch and event objects.
+//
+// Each object's state is held in a single atomic word. The lowest bit is set
+// while operations are waiting, and the remaining bits hold a value whose
+// meaning depends on the kind of object. Operations that do not need to wait,
+// and releases that do not need to wake a waiter, only touch the atomic word.
+// The waiter bit and the queue of waiting operations are only modified while
+// the object's mutex is held.
+class async_sync_service
+  : public execution_context_service_base<async_sync_service>
+{
+public:
+  // The bit in the state word that indicates that there are waiters.
+  static const std::size_t waiters_bit = 1;
+
+  // The amount by which the state word changes for each unit of value.
+  static const std::size_t value_unit = 2;
+
+  // Determine whether an operation may complete without waiting, given the
+  // current state. If so, the state the operation leaves behind is returned in
+  // next.
+  typedef bool (*try_func_type)(std::size_t state, std::size_t& next);
+
+  // The state of a single synchronisation object.
+  class implementation_type
+  {
+  public:
+    implementation_type()
+      : state_(0),
+        next_(0),
+        prev_(0)
+    {
+    }
+
+  private:
+    friend class async_sync_service;
+
+    // The object's value and waiter bit.
+    std::atomic<std::size_t> state_;
+
+    // Mutex to protect access to the waiter bit and the queue of waiters.
+    boost::asio::detail::mutex mutex_;
+
+    // Operations waiting on the object.
+    op_queue<async_waiter> waiters_;
+
+    // Pointers to adjacent implementations in linked list.
+    implementation_type* next_;
+    implementation_type* prev_;
+  };
+
+  // Constructor.
+  explicit async_sync_service(execution_context& context)
+    : execution_context_service_base<async_sync_service>(context),
+      mutex_(),
+      impl_list_(0)
+  {
+  }
+
+  // Destroy all user-defined handler objects owned by the service.
+  void shutdown()
+  {
+    op_queue<async_waiter> ops;
+
+    boost::asio::detail::mutex::scoped_lock lock(mutex_);
+
+    implementation_type* impl = impl_list_;
+    while (impl)
+    {
+      boost::asio::detail::mutex::scoped_lock impl_lock(impl->mutex_);
+      ops.push(impl->waiters_);
+      impl = impl->next_;
+    }
+  }
+
+  // Construct a new implementation with the given initial value.
+  void construct(implementation_type& impl, std::size_t value)
+  {
+    impl.state_.store(value * value_unit);
+
+    // Insert implementation into linked list of all implementations.
+    boost::asio::detail::mutex::scoped_lock lock(mutex_);
+    impl.next_ = impl_list_;
+    impl.prev_ = 0;
+    if (impl_list_)
+      impl_list_->prev_ = &impl;
+    impl_list_ = &impl;
+  }
+
+  // Destroy an implementation. Any waiting operations are completed with the
+  // operation_aborted error.
+  void destroy(implementation_type& impl)
+  {
+    cancel(impl);
+
+    // Remove implementation from linked list of all implementations.
+    boost::asio::detail::mutex::scoped_lock lock(mutex_);
+    if (impl_list_ == &impl)
+      impl_list_ = impl.next_;
+    if (impl.prev_)
+      impl.prev_->next_ = impl.next_;
+    if (impl.next_)
+      impl.next_->prev_= impl.prev_;
+    impl.next_ = 0;
+    impl.prev_ = 0;
+  }
+
+  // Get the object's current value.
+  std::size_t value(const implementation_type& impl) const
+  {
+    return impl.state_.load() / value_unit;
+  }
+
+  // Complete all waiting operations with the operation_aborted error.
+  void cancel(implementation_type& impl)
+  {
+    op_queue<async_waiter> ops;
+
+    boost::asio::detail::mutex::scoped_lock lock(impl.mutex_);
+    ops.push(impl.waiters_);
+    impl.state_.fetch_and(~waiters_bit);
+    lock.unlock();
+
+    complete_all(ops, boost::asio::error::operation_aborted);
+  }
+
+  // Attempt to complete an operation without waiting.
+  bool try_complete(implementation_type& impl, try_func_type try_func)
+  {
+    std::size_t state = impl.state_.load();
+    std::size_t next = 0;
+    while (try_func(state, next))
+      if (impl.state_.compare_exchange_weak(state, next))
+        return true;
+    return false;
+  }
+
+  // Start an asynchronous operation. The operation completes immediately if
+  // try_func allows it, otherwise it waits until it is woken.
+  template <typename Handler, typename IoExecutor>
+  void async_wait(implementation_type& impl, try_func_type try_func,
+      Handler& handler, const IoExecutor& io_ex,
+      const char* object_type, const char* op_name)
+  {
+    (void)object_type;
+    (void)op_name;
+
+    if (!try_complete(impl, try_func))
+    {
+      // Allocate and construct an operation to wrap the handler.
+      typedef async_waiter_op<Handler, IoExecutor> op;
+      typename op::ptr p = { boost::asio::detail::addressof(handler),
+        op::ptr::allocate(handler), 0 };
+      p.p = new (p.v) op(handler, io_ex);
+
+      BOOST_ASIO_HANDLER_CREATION((this->context(),
+            *p.p, object_type, &impl, 0, op_name));
+
+      boost::asio::detail::mutex::scoped_lock lock(impl.mutex_);
+      std::size_t state = impl.state_.load();
+      for (;;)
+      {
+        std::size_t next = 0;
+        if (try_func(state, next))
+        {
+          // The object was released while the operation was being set up.
+          if (impl.state_.compare_exchange_weak(state, next))
+          {
+            lock.unlock();
+            p.p->complete(boost::system::error_code());
+            p.v = p.p = 0;
+            return;
+          }
+        }
+        else if (impl.state_.compare_exchange_weak(
+              state, state | waiters_bit))
+        {
+          impl.waiters_.push(p.p);
+          p.v = p.p = 0;
+          return;
+        }
+      }
+    }
+
+    boost::asio::post(io_ex, binder1<Handler, boost::system::error_code>(
+          0, BOOST_ASIO_MOVE_CAST(Handler)(handler),
+          boost::system::error_code()));
+  }
+
+  // Increase the object's value by n. Waiting operations are woken, and each
+  // takes one unit of the increase, until either the increase or the waiters
+  // are exhausted. Any remainder is added to the value.
+  void release(implementation_type& impl, std::size_t n)
+  {
+    std::size_t state = impl.state_.load();
+    while ((state & waiters_bit) == 0)
+      if (impl.state_.compare_exchange_weak(state, state + n * value_unit))
+        return;
+
+    op_queue<async_waiter> ops;
+
+    boost::asio::detail::mutex::scoped_lock lock(impl.mutex_);
+    while (n > 0 && !impl.waiters_.empty())
+    {
+      async_waiter* op = impl.waiters_.front();
+      impl.waiters_.pop();
+      ops.push(op);
+      --n;
+    }
+
+    // The waiter bit may already have been cleared by a cancellation, after
+    // which other threads may modify the state without the lock.
+    if (impl.waiters_.empty())
+    {
+      std::size_t state = impl.state_.load();
+      while (!impl.state_.compare_exchange_weak(
+            state, (state & ~waiters_bit) + n * value_unit)) {}
+    }
+    lock.unlock();
+
+    complete_all(ops, boost::system::error_code());
+  }
+
+  // Release a mutex that is held. If there are waiters, ownership passes to
+  // the first of them.
+  void unlock(implementation_type& impl)
+  {
+    std::size_t state = value_unit;
+    if (impl.state_.compare_exchange_strong(state, 0))
+      return;
+
+    op_queue<async_waiter> ops;
+
+    boost::asio::detail::mutex::scoped_lock lock(impl.mutex_);
+    if (async_waiter* op = impl.waiters_.front())
+    {
+      // The mutex remains locked on behalf of the woken operation.
+      impl.waiters_.pop();
+      ops.push(op);
+      if (impl.waiters_.empty())
+        impl.state_.store(value_unit);
+    }
+    else
+    {
+      // The waiters were cancelled before the lock was acquired.
+      impl.state_.store(0);
+    }
+    lock.unlock();
+
+    complete_all(ops, boost::system::error_code());
+  }
+
+  // Decrease the object's value by n. If the value reaches zero, all waiting
+  // operations are woken.
+  void count_down(implementation_type& impl, std::size_t n)
+  {
+    std::size_t state = impl.state_.fetch_sub(n * value_unit);
+    if (state / value_unit == n && (state & waiters_bit) != 0)
+      wake_all(impl, 0);
+  }
+
+  // Set the given bits of the object's value. If they were not already set,
+  // all waiting operations are woken.
+  void set_bits(implementation_type& impl, std::size_t bits)
+  {
+    std::size_t state = impl.state_.fetch_or(bits * value_unit);
+    if ((state & waiters_bit) != 0)
+      wake_all(impl, ~waiters_bit);
+  }
+
+  // Clear the given bits of the object's value.
+  void clear_bits(implementation_type& impl, std::size_t bits)
+  {
+    impl.state_.fetch_and(~(bits * value_unit));
+  }
+
+private:
+  // Wake all waiting operations, then apply the mask to the state.
+  void wake_all(implementation_type& impl, std::size_t mask)
+  {
+    op_queue<async_waiter> ops;
+
+    boost::asio::detail::mutex::scoped_lock lock(impl.mutex_);
+    ops.push(impl.waiters_);
+    impl.state_.fetch_and(mask);
+    lock.unlock();
+
+    complete_all(ops, boost::system::error_code());
+  }
+
+  // Complete a set of dequeued operations with the given error.
+  static void complete_all(op_queue<async_waiter>& ops,
+      const boost::system::error_code& ec)
+  {
+    while (async_waiter* op = ops.front())
+    {
+      ops.pop();
+      op->complete(ec);
+    }
+  }
+
+  // Mutex to protect access to the linked list of implementations.
+  boost::asio::detail::mutex mutex_;
+
+  // The head of a linked list of all implementations.
+  implementation_type* impl_list_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_MOVE) && defined(BOOST_ASIO_HAS_STD_ATOMIC)
+
+#endif // BOOST_ASIO_DETAIL_ASYNC_SYNC_SERVICE_HPP
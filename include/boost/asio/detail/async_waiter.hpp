@@ -0,0 +1,74 @@
+//
+// detail/async_waiter.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_ASYNC_WAITER_HPP
+#define BOOST_ASIO_DETAIL_ASYNC_WAITER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <boost/asio/detail/handler_tracking.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+class op_queue_access;
+
+// Base class for operations waiting on an asynchronous synchronisation
+// primitive. Like channel operations, waiters are not run by the scheduler.
+// Completing a waiter posts its bound handler to the primitive's I/O executor.
+class async_waiter BOOST_ASIO_INHERIT_TRACKED_HANDLER
+{
+public:
+  // Complete the operation with the given error.
+  void complete(const boost::system::error_code& ec)
+  {
+    func_(this, &ec);
+  }
+
+  // Destroy the operation without invoking its handler.
+  void destroy()
+  {
+    func_(this, 0);
+  }
+
+protected:
+  typedef void (*func_type)(async_waiter*, const boost::system::error_code*);
+
+  async_waiter(func_type func)
+    : next_(0),
+      func_(func)
+  {
+  }
+
+  // Prevents deletion through this type.
+  ~async_waiter()
+  {
+  }
+
+private:
+  friend class op_queue_access;
+  async_waiter* next_;
+  func_type func_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_ASYNC_WAITER_HPP
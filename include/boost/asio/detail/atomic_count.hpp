@@ -32,12 +32,27 @@ namespace detail {
 #if !defined(BOOST_ASIO_HAS_THREADS)
 typedef long atomic_count;
 inline void increment(atomic_count& a, long b) { a += b; }
+
+inline long unsynchronised_increment(atomic_count& a, long b)
+{
+  return a += b;
+}
+
 inline void ref_count_up(atomic_count& a) { ++a; }
 inline bool ref_count_down(atomic_count& a) { return --a == 0; }
 #elif defined(BOOST_ASIO_HAS_STD_ATOMIC)
 typedef std::atomic<long> atomic_count;
 inline void increment(atomic_count& a, long b) { a += b; }
 
+// Adjust a count that is accessed by only one thread at a time, without the
+// cost of an atomic read-modify-write operation.
+inline long unsynchronised_increment(atomic_count& a, long b)
+{
+  long value = a.load(std::memory_order_relaxed) + b;
+  a.store(value, std::memory_order_relaxed);
+  return value;
+}
+
 inline void ref_count_up(atomic_count& a)
 {
   a.fetch_add(1, std::memory_order_relaxed);
@@ -55,6 +70,14 @@ inline bool ref_count_down(atomic_count& a)
 #else // defined(BOOST_ASIO_HAS_STD_ATOMIC)
 typedef boost::detail::atomic_count atomic_count;
 inline void increment(atomic_count& a, long b) { while (b > 0) ++a, --b; }
+
+inline long unsynchronised_increment(atomic_count& a, long b)
+{
+  for (; b > 0; --b) ++a;
+  for (; b < 0; ++b) --a;
+  return a;
+}
+
 inline void ref_count_up(atomic_count& a) { ++a; }
 inline bool ref_count_down(atomic_count& a) { return --a == 0; }
 #endif // defined(BOOST_ASIO_HAS_STD_ATOMIC)
@@ -0,0 +1,261 @@
+//
+// detail/awaitable_frame_pool.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_AWAITABLE_FRAME_POOL_HPP
+#define BOOST_ASIO_DETAIL_AWAITABLE_FRAME_POOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_CO_AWAIT)
+
+#include <cstddef>
+#include <new>
+#include <boost/asio/detail/noncopyable.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+// The maximum number of idle frames of each size class kept by each thread.
+#if !defined(BOOST_ASIO_AWAITABLE_FRAME_POOL_SIZE)
+# define BOOST_ASIO_AWAITABLE_FRAME_POOL_SIZE 64
+#endif // !defined(BOOST_ASIO_AWAITABLE_FRAME_POOL_SIZE)
+
+#if defined(__SANITIZE_ADDRESS__)
+# define BOOST_ASIO_AWAITABLE_FRAME_POOL_ASAN 1
+#elif defined(__has_feature)
+# if __has_feature(address_sanitizer)
+#  define BOOST_ASIO_AWAITABLE_FRAME_POOL_ASAN 1
+# endif // __has_feature(address_sanitizer)
+#endif // defined(__SANITIZE_ADDRESS__)
+
+#if defined(BOOST_ASIO_AWAITABLE_FRAME_POOL_ASAN)
+# include <sanitizer/asan_interface.h>
+#endif // defined(BOOST_ASIO_AWAITABLE_FRAME_POOL_ASAN)
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// A per-thread cache of coroutine frame memory, segregated by size class.
+// A coroutine call chain allocates frames of several different sizes, and
+// each size class keeps its own list of idle blocks, so that a chain that is
+// repeatedly entered and left is served entirely from the cache. Blocks are
+// returned to the cache of the thread that frees them. Idle blocks are linked
+// through their own memory.
+class awaitable_frame_pool
+  : private noncopyable
+{
+public:
+  // Frames are rounded up to a multiple of the granularity. Larger frames are
+  // not cached.
+  enum
+  {
+    granularity = 64,
+    max_cached_size = 4096,
+    size_classes = max_cached_size / granularity
+  };
+
+  // Counters describing the pool's activity on the calling thread.
+  struct counters
+  {
+    // The number of frames allocated.
+    std::size_t allocations;
+
+    // The number of allocations that were served from the cache.
+    std::size_t reuses;
+
+    // The number of frames freed.
+    std::size_t deallocations;
+
+    // The number of freed frames that were released to the global allocator,
+    // because they were too large or their size class was full.
+    std::size_t releases;
+
+    // The number of idle frames currently held in the cache.
+    std::size_t idle;
+  };
+
+  awaitable_frame_pool()
+  {
+    for (int i = 0; i < size_classes; ++i)
+    {
+      heads_[i] = 0;
+      counts_[i] = 0;
+    }
+    counters_ = counters();
+  }
+
+  ~awaitable_frame_pool()
+  {
+    for (int i = 0; i < size_classes; ++i)
+    {
+      while (idle_block* block = heads_[i])
+      {
+        unpoison(block, (i + 1) * granularity);
+        heads_[i] = block->next_;
+        ::operator delete(block);
+      }
+    }
+  }
+
+  // Allocate memory for a frame of the given size.
+  void* allocate(std::size_t size)
+  {
+    ++counters_.allocations;
+    if (size > 0 && size <= max_cached_size)
+    {
+      std::size_t index = (size - 1) / granularity;
+      if (idle_block* block = heads_[index])
+      {
+        unpoison(block, (index + 1) * granularity);
+        heads_[index] = block->next_;
+        --counts_[index];
+        --counters_.idle;
+        ++counters_.reuses;
+        return block;
+      }
+      return ::operator new(block_size(size));
+    }
+    return ::operator new(size);
+  }
+
+  // Get the size of the memory block used for a frame of the given size. Any
+  // cacheable frame may end up in some thread's cache, so it must always be
+  // allocated with the full size of its size class.
+  static std::size_t block_size(std::size_t size)
+  {
+    if (size > 0 && size <= max_cached_size)
+      return ((size - 1) / granularity + 1) * granularity;
+    return size;
+  }
+
+  // Free memory for a frame of the given size, which must be the size that was
+  // passed to allocate().
+  void deallocate(void* pointer, std::size_t size)
+  {
+    ++counters_.deallocations;
+    if (size > 0 && size <= max_cached_size)
+    {
+      std::size_t index = (size - 1) / granularity;
+      if (counts_[index] < BOOST_ASIO_AWAITABLE_FRAME_POOL_SIZE)
+      {
+        idle_block* block = static_cast<idle_block*>(pointer);
+        block->next_ = heads_[index];
+        heads_[index] = block;
+        ++counts_[index];
+        ++counters_.idle;
+        poison(block, (index + 1) * granularity);
+        return;
+      }
+    }
+    ++counters_.releases;
+    ::operator delete(pointer);
+  }
+
+  // Get the counters for the calling thread's pool.
+  const counters& get_counters() const
+  {
+    return counters_;
+  }
+
+  // Get the pool for the calling thread, or null if the thread's pool has
+  // already been destroyed.
+  static awaitable_frame_pool* instance();
+
+  // Allocate memory for a frame using the calling thread's pool.
+  static void* thread_allocate(std::size_t size)
+  {
+    if (awaitable_frame_pool* pool = instance())
+      return pool->allocate(size);
+    return ::operator new(block_size(size));
+  }
+
+  // Free memory for a frame using the calling thread's pool.
+  static void thread_deallocate(void* pointer, std::size_t size)
+  {
+    if (awaitable_frame_pool* pool = instance())
+      pool->deallocate(pointer, size);
+    else
+      ::operator delete(pointer);
+  }
+
+private:
+  struct idle_block
+  {
+    idle_block* next_;
+  };
+
+  // Set when the thread's pool has been destroyed, after which frames that
+  // are still outstanding use the global allocator directly. Being trivially
+  // destructible, the flag remains usable during thread exit.
+  static bool& destroyed()
+  {
+    static thread_local bool flag = false;
+    return flag;
+  }
+
+  // The type of the calling thread's pool, which marks the pool as destroyed.
+  struct thread_pool;
+
+  // Idle blocks, other than their links, are inaccessible when running under
+  // AddressSanitizer so that uses of freed frames are still detected.
+  static void poison(idle_block* block, std::size_t size)
+  {
+#if defined(BOOST_ASIO_AWAITABLE_FRAME_POOL_ASAN)
+    __asan_poison_memory_region(block + 1, size - sizeof(idle_block));
+#else // defined(BOOST_ASIO_AWAITABLE_FRAME_POOL_ASAN)
+    (void)block;
+    (void)size;
+#endif // defined(BOOST_ASIO_AWAITABLE_FRAME_POOL_ASAN)
+  }
+
+  static void unpoison(idle_block* block, std::size_t size)
+  {
+#if defined(BOOST_ASIO_AWAITABLE_FRAME_POOL_ASAN)
+    __asan_unpoison_memory_region(block + 1, size - sizeof(idle_block));
+#else // defined(BOOST_ASIO_AWAITABLE_FRAME_POOL_ASAN)
+    (void)block;
+    (void)size;
+#endif // defined(BOOST_ASIO_AWAITABLE_FRAME_POOL_ASAN)
+  }
+
+  idle_block* heads_[size_classes];
+  std::size_t counts_[size_classes];
+  counters counters_;
+};
+
+struct awaitable_frame_pool::thread_pool : awaitable_frame_pool
+{
+  ~thread_pool()
+  {
+    destroyed() = true;
+  }
+};
+
+inline awaitable_frame_pool* awaitable_frame_pool::instance()
+{
+  if (destroyed())
+    return 0;
+  static thread_local thread_pool pool;
+  return &pool;
+}
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_CO_AWAIT)
+
+#endif // BOOST_ASIO_DETAIL_AWAITABLE_FRAME_POOL_HPP
@@ -0,0 +1,293 @@
+//
+// detail/buffer_search.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_BUFFER_SEARCH_HPP
+#define BOOST_ASIO_DETAIL_BUFFER_SEARCH_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include <boost/asio/buffer.hpp>
+
+#if defined(BOOST_ASIO_HAS_AVX2)
+# include <immintrin.h>
+#elif defined(BOOST_ASIO_HAS_SSE2)
+# include <emmintrin.h>
+#endif // defined(BOOST_ASIO_HAS_SSE2)
+
+#if defined(BOOST_ASIO_HAS_SSE2) && defined(BOOST_ASIO_MSVC)
+# include <intrin.h>
+#endif // defined(BOOST_ASIO_HAS_SSE2) && defined(BOOST_ASIO_MSVC)
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+#if defined(BOOST_ASIO_HAS_SSE2)
+
+// Returns the index of the lowest set bit in a non-zero mask.
+inline unsigned int buffer_search_lowest_bit(unsigned int mask)
+{
+#if defined(BOOST_ASIO_MSVC)
+  unsigned long index = 0;
+  _BitScanForward(&index, mask);
+  return static_cast<unsigned int>(index);
+#else // defined(BOOST_ASIO_MSVC)
+  return static_cast<unsigned int>(__builtin_ctz(mask));
+#endif // defined(BOOST_ASIO_MSVC)
+}
+
+#endif // defined(BOOST_ASIO_HAS_SSE2)
+
+// Find the first occurrence of a character in a contiguous range. Returns
+// last if the character is not found.
+inline const char* buffer_search_char(
+    const char* first, const char* last, char c)
+{
+#if defined(BOOST_ASIO_HAS_AVX2)
+  const __m256i wide_needle = _mm256_set1_epi8(c);
+  while (last - first >= 32)
+  {
+    __m256i block = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(first));
+    unsigned int mask = static_cast<unsigned int>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, wide_needle)));
+    if (mask != 0)
+      return first + buffer_search_lowest_bit(mask);
+    first += 32;
+  }
+#endif // defined(BOOST_ASIO_HAS_AVX2)
+
+#if defined(BOOST_ASIO_HAS_SSE2)
+  const __m128i needle = _mm_set1_epi8(c);
+  while (last - first >= 16)
+  {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+    unsigned int mask = static_cast<unsigned int>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+    if (mask != 0)
+      return first + buffer_search_lowest_bit(mask);
+    first += 16;
+  }
+#endif // defined(BOOST_ASIO_HAS_SSE2)
+
+  for (; first != last; ++first)
+    if (*first == c)
+      return first;
+  return last;
+}
+
+// Find the first complete occurrence of a delimiter of two or more characters
+// in a contiguous range. Returns last if there is no occurrence that lies
+// entirely within the range.
+inline const char* buffer_search_string(const char* first,
+    const char* last, const char* delim, std::size_t delim_length)
+{
+  using namespace std; // For memcmp.
+
+  if (static_cast<std::size_t>(last - first) < delim_length)
+    return last;
+
+  // Candidate matches must start before this point.
+  const char* limit = last - delim_length + 1;
+
+  // The vectorised loops look for positions where both the first and last
+  // characters of the delimiter match, then verify the characters in between.
+#if defined(BOOST_ASIO_HAS_AVX2)
+  const __m256i wide_head = _mm256_set1_epi8(delim[0]);
+  const __m256i wide_tail = _mm256_set1_epi8(delim[delim_length - 1]);
+  while (limit - first >= 32)
+  {
+    __m256i head_block = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(first));
+    __m256i tail_block = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(first + delim_length - 1));
+    unsigned int mask = static_cast<unsigned int>(
+        _mm256_movemask_epi8(_mm256_and_si256(
+            _mm256_cmpeq_epi8(head_block, wide_head),
+            _mm256_cmpeq_epi8(tail_block, wide_tail))));
+    while (mask != 0)
+    {
+      const char* candidate = first + buffer_search_lowest_bit(mask);
+      if (memcmp(candidate + 1, delim + 1, delim_length - 2) == 0)
+        return candidate;
+      mask &= mask - 1;
+    }
+    first += 32;
+  }
+#endif // defined(BOOST_ASIO_HAS_AVX2)
+
+#if defined(BOOST_ASIO_HAS_SSE2)
+  const __m128i head = _mm_set1_epi8(delim[0]);
+  const __m128i tail = _mm_set1_epi8(delim[delim_length - 1]);
+  while (limit - first >= 16)
+  {
+    __m128i head_block = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(first));
+    __m128i tail_block = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(first + delim_length - 1));
+    unsigned int mask = static_cast<unsigned int>(
+        _mm_movemask_epi8(_mm_and_si128(
+            _mm_cmpeq_epi8(head_block, head),
+            _mm_cmpeq_epi8(tail_block, tail))));
+    while (mask != 0)
+    {
+      const char* candidate = first + buffer_search_lowest_bit(mask);
+      if (memcmp(candidate + 1, delim + 1, delim_length - 2) == 0)
+        return candidate;
+      mask &= mask - 1;
+    }
+    first += 16;
+  }
+#endif // defined(BOOST_ASIO_HAS_SSE2)
+
+  for (; first != limit; ++first)
+  {
+    first = buffer_search_char(first, limit, delim[0]);
+    if (first == limit)
+      break;
+    if (memcmp(first + 1, delim + 1, delim_length - 1) == 0)
+      return first;
+  }
+  return last;
+}
+
+// Find the first occurrence of a character in a range of buffers, starting the
+// search at the specified offset. Returns (offset,true) if a match was found.
+// Returns (total_size,false) if there was no match.
+template <typename Iterator>
+std::pair<std::size_t, bool> buffer_search_range(Iterator iter,
+    Iterator end, std::size_t start, char delim)
+{
+  std::size_t offset = 0;
+  for (; iter != end; ++iter)
+  {
+    const_buffer segment(*iter);
+    const char* data = static_cast<const char*>(segment.data());
+    std::size_t size = segment.size();
+    if (offset + size > start)
+    {
+      const char* first = data + (start > offset ? start - offset : 0);
+      const char* last = data + size;
+      const char* pos = buffer_search_char(first, last, delim);
+      if (pos != last)
+        return std::make_pair(offset + (pos - data), true);
+    }
+    offset += size;
+  }
+
+  return std::make_pair(offset, false);
+}
+
+// Find the first occurrence of a delimiter in a range of buffers, starting the
+// search at the specified offset. Matches may span any number of buffers.
+// Returns (offset,true) if a full match was found. Returns (offset,false) if a
+// partial match was found at the end of the sequence, in which case the offset
+// is the beginning of the partial match. Returns (total_size,false) if no full
+// or partial match was found.
+template <typename Iterator>
+std::pair<std::size_t, bool> buffer_search_range(Iterator iter,
+    Iterator end, std::size_t start, const char* delim,
+    std::size_t delim_length)
+{
+  using namespace std; // For memcmp.
+
+  if (delim_length == 1)
+    return (buffer_search_range)(iter, end, start, delim[0]);
+
+  std::size_t offset = 0;
+  for (; iter != end; ++iter)
+  {
+    const_buffer segment(*iter);
+    const char* data = static_cast<const char*>(segment.data());
+    std::size_t size = segment.size();
+    if (offset + size <= start)
+    {
+      offset += size;
+      continue;
+    }
+
+    std::size_t first_index = start > offset ? start - offset : 0;
+    if (delim_length == 0)
+      return std::make_pair(offset + first_index, true);
+
+    // Look for a match that lies entirely within this buffer.
+    const char* first = data + first_index;
+    const char* last = data + size;
+    const char* pos = buffer_search_string(first, last, delim, delim_length);
+    if (pos != last)
+      return std::make_pair(offset + (pos - data), true);
+
+    // Look for a match that starts in the tail of this buffer and continues
+    // into subsequent buffers.
+    std::size_t tail_index = size >= delim_length ? size - delim_length + 1 : 0;
+    for (pos = data + (std::max)(first_index, tail_index); pos != last; ++pos)
+    {
+      std::size_t matched = last - pos;
+      if (*pos != delim[0] || memcmp(pos, delim, matched) != 0)
+        continue;
+
+      Iterator next = iter;
+      while (matched < delim_length)
+      {
+        if (++next == end)
+          return std::make_pair(offset + (pos - data), false);
+        const_buffer next_segment(*next);
+        std::size_t length = (std::min)(
+            next_segment.size(), delim_length - matched);
+        if (memcmp(next_segment.data(), delim + matched, length) != 0)
+          break;
+        matched += length;
+      }
+
+      if (matched == delim_length)
+        return std::make_pair(offset + (pos - data), true);
+    }
+
+    offset += size;
+  }
+
+  return std::make_pair(offset, false);
+}
+
+// Find the first occurrence of a character in a buffer sequence.
+template <typename ConstBufferSequence>
+inline std::pair<std::size_t, bool> buffer_search(
+    const ConstBufferSequence& buffers, std::size_t start, char delim)
+{
+  return (buffer_search_range)(boost::asio::buffer_sequence_begin(buffers),
+      boost::asio::buffer_sequence_end(buffers), start, delim);
+}
+
+// Find the first occurrence of a delimiter in a buffer sequence.
+template <typename ConstBufferSequence>
+inline std::pair<std::size_t, bool> buffer_search(
+    const ConstBufferSequence& buffers, std::size_t start,
+    const char* delim, std::size_t delim_length)
+{
+  return (buffer_search_range)(boost::asio::buffer_sequence_begin(buffers),
+      boost::asio::buffer_sequence_end(buffers), start, delim, delim_length);
+}
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_BUFFER_SEARCH_HPP
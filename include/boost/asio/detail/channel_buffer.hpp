@@ -0,0 +1,133 @@
+//
+// detail/channel_buffer.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_CHANNEL_BUFFER_HPP
+#define BOOST_ASIO_DETAIL_CHANNEL_BUFFER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_MOVE)
+
+#include <cstddef>
+#include <new>
+#include <boost/asio/detail/noncopyable.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// A fixed-capacity ring of messages. The storage is allocated once, when the
+// channel is constructed, so that buffering a message never allocates.
+template <typename Message>
+class channel_buffer
+  : private noncopyable
+{
+public:
+  channel_buffer()
+    : storage_(0),
+      capacity_(0),
+      head_(0),
+      size_(0)
+  {
+  }
+
+  ~channel_buffer()
+  {
+    clear();
+    ::operator delete(storage_);
+  }
+
+  // Allocate storage for the given number of messages. Must be called at most
+  // once, before any messages are added.
+  void allocate(std::size_t capacity)
+  {
+    if (capacity > 0)
+    {
+      storage_ = static_cast<Message*>(
+          ::operator new(capacity * sizeof(Message)));
+      capacity_ = capacity;
+    }
+  }
+
+  std::size_t capacity() const
+  {
+    return capacity_;
+  }
+
+  std::size_t size() const
+  {
+    return size_;
+  }
+
+  bool empty() const
+  {
+    return size_ == 0;
+  }
+
+  bool full() const
+  {
+    return size_ == capacity_;
+  }
+
+  // Append a message. The buffer must not be full.
+  void push(Message& m)
+  {
+    std::size_t tail = head_ + size_;
+    if (tail >= capacity_)
+      tail -= capacity_;
+    new (storage_ + tail) Message(BOOST_ASIO_MOVE_CAST(Message)(m));
+    ++size_;
+  }
+
+  // Get the message at the front of the buffer. The buffer must not be empty.
+  Message& front()
+  {
+    return storage_[head_];
+  }
+
+  // Remove the message at the front of the buffer. The buffer must not be
+  // empty.
+  void pop()
+  {
+    storage_[head_].~Message();
+    if (++head_ == capacity_)
+      head_ = 0;
+    --size_;
+  }
+
+  void clear()
+  {
+    while (size_ > 0)
+      pop();
+    head_ = 0;
+  }
+
+private:
+  Message* storage_;
+  std::size_t capacity_;
+  std::size_t head_;
+  std::size_t size_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_MOVE)
+
+#endif // BOOST_ASIO_DETAIL_CHANNEL_BUFFER_HPP
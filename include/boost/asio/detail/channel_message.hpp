@@ -0,0 +1,108 @@
+//
+// detail/channel_message.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_CHANNEL_MESSAGE_HPP
+#define BOOST_ASIO_DETAIL_CHANNEL_MESSAGE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_MOVE)
+
+#include <boost/asio/detail/bind_handler.hpp>
+#include <boost/asio/detail/type_traits.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// The value carried through a channel for a given completion signature.
+// Channels support the signatures void(error_code) and void(error_code, T).
+template <typename Signature>
+class channel_message;
+
+template <>
+class channel_message<void(boost::system::error_code)>
+{
+public:
+  template <typename Handler>
+  struct handler_binder
+  {
+    typedef binder1<Handler, boost::system::error_code> type;
+  };
+
+  channel_message()
+  {
+  }
+
+  // Bind a receive handler to its arguments. The message is null when the
+  // operation failed.
+  template <typename Handler>
+  static typename handler_binder<Handler>::type bind(Handler& handler,
+      const boost::system::error_code& ec, channel_message*)
+  {
+    return typename handler_binder<Handler>::type(
+        0, BOOST_ASIO_MOVE_CAST(Handler)(handler), ec);
+  }
+};
+
+template <typename T>
+class channel_message<void(boost::system::error_code, T)>
+{
+public:
+  template <typename Handler>
+  struct handler_binder
+  {
+    typedef move_binder2<Handler, boost::system::error_code,
+      typename decay<T>::type> type;
+  };
+
+  template <typename U>
+  explicit channel_message(BOOST_ASIO_MOVE_ARG(U) u)
+    : value_(BOOST_ASIO_MOVE_CAST(U)(u))
+  {
+  }
+
+  channel_message(channel_message&& other)
+    : value_(BOOST_ASIO_MOVE_CAST(typename decay<T>::type)(other.value_))
+  {
+  }
+
+  // Bind a receive handler to its arguments. The message is null when the
+  // operation failed, in which case a value-initialised T is passed.
+  template <typename Handler>
+  static typename handler_binder<Handler>::type bind(Handler& handler,
+      const boost::system::error_code& ec, channel_message* m)
+  {
+    return typename handler_binder<Handler>::type(
+        0, BOOST_ASIO_MOVE_CAST(Handler)(handler), ec,
+        m ? BOOST_ASIO_MOVE_CAST(typename decay<T>::type)(m->value_)
+          : typename decay<T>::type());
+  }
+
+private:
+  typename decay<T>::type value_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_MOVE)
+
+#endif // BOOST_ASIO_DETAIL_CHANNEL_MESSAGE_HPP
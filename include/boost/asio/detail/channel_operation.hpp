@@ -0,0 +1,76 @@
+//
+// detail/channel_operation.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_CHANNEL_OPERATION_HPP
+#define BOOST_ASIO_DETAIL_CHANNEL_OPERATION_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <boost/asio/detail/handler_tracking.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+class op_queue_access;
+
+// Base class for pending channel send and receive operations. Channel
+// operations are not run by the scheduler. Instead, completing an operation
+// posts its bound handler to the channel's I/O executor.
+class channel_operation BOOST_ASIO_INHERIT_TRACKED_HANDLER
+{
+public:
+  // Complete the operation with the given error. A receive operation takes
+  // the message, if any, from the object pointed to by message.
+  void complete(const boost::system::error_code& ec, void* message)
+  {
+    func_(this, &ec, message);
+  }
+
+  // Destroy the operation without invoking its handler.
+  void destroy()
+  {
+    func_(this, 0, 0);
+  }
+
+protected:
+  typedef void (*func_type)(channel_operation*,
+      const boost::system::error_code*, void*);
+
+  channel_operation(func_type func)
+    : next_(0),
+      func_(func)
+  {
+  }
+
+  // Prevents deletion through this type.
+  ~channel_operation()
+  {
+  }
+
+private:
+  friend class op_queue_access;
+  channel_operation* next_;
+  func_type func_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_CHANNEL_OPERATION_HPP
@@ -0,0 +1,97 @@
+//
+// detail/channel_receive_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_CHANNEL_RECEIVE_OP_HPP
+#define BOOST_ASIO_DETAIL_CHANNEL_RECEIVE_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_MOVE)
+
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/detail/channel_operation.hpp>
+#include <boost/asio/detail/handler_alloc_helpers.hpp>
+#include <boost/asio/detail/memory.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// A receive operation waiting for a message. A sender hands its message
+// directly to the operation when it completes it.
+template <typename Message, typename Handler, typename IoExecutor>
+class channel_receive_op : public channel_operation
+{
+public:
+  BOOST_ASIO_DEFINE_HANDLER_PTR(channel_receive_op);
+
+  channel_receive_op(Handler& handler, const IoExecutor& io_ex)
+    : channel_operation(&channel_receive_op::do_complete),
+      handler_(BOOST_ASIO_MOVE_CAST(Handler)(handler)),
+      work_(io_ex)
+  {
+  }
+
+  static void do_complete(channel_operation* base,
+      const boost::system::error_code* ec, void* message)
+  {
+    // Take ownership of the handler object.
+    channel_receive_op* o(static_cast<channel_receive_op*>(base));
+    ptr p = { boost::asio::detail::addressof(o->handler_), o, o };
+
+    // Take ownership of the operation's outstanding work. It is released only
+    // after the completion has been posted, so that the I/O executor does not
+    // run out of work in between.
+    executor_work_guard<IoExecutor> w(
+        BOOST_ASIO_MOVE_CAST(executor_work_guard<IoExecutor>)(o->work_));
+
+    // Make the upcall if required.
+    if (ec)
+    {
+      BOOST_ASIO_HANDLER_COMPLETION((*o));
+
+      // Make a copy of the handler so that the memory can be deallocated
+      // before the completion is posted.
+      typedef typename Message::template handler_binder<Handler>::type
+        binder_type;
+      binder_type handler(Message::bind(o->handler_,
+            *ec, static_cast<Message*>(message)));
+      p.h = boost::asio::detail::addressof(handler.handler_);
+      p.reset();
+
+      boost::asio::post(w.get_executor(),
+          BOOST_ASIO_MOVE_CAST(binder_type)(handler));
+    }
+  }
+
+private:
+  Handler handler_;
+
+  // Channel operations are not known to the scheduler, so the operation keeps
+  // the I/O executor's context busy while it is pending.
+  executor_work_guard<IoExecutor> work_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_MOVE)
+
+#endif // BOOST_ASIO_DETAIL_CHANNEL_RECEIVE_OP_HPP
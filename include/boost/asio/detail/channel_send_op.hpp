@@ -0,0 +1,116 @@
+//
+// detail/channel_send_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_CHANNEL_SEND_OP_HPP
+#define BOOST_ASIO_DETAIL_CHANNEL_SEND_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_MOVE)
+
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/detail/bind_handler.hpp>
+#include <boost/asio/detail/channel_operation.hpp>
+#include <boost/asio/detail/handler_alloc_helpers.hpp>
+#include <boost/asio/detail/memory.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// A send operation waiting for space in the channel. The operation owns the
+// message until a receiver, or the channel's buffer, takes it.
+template <typename Message>
+class channel_send_op_base : public channel_operation
+{
+public:
+  Message& message()
+  {
+    return message_;
+  }
+
+protected:
+  channel_send_op_base(Message& m, func_type complete_func)
+    : channel_operation(complete_func),
+      message_(BOOST_ASIO_MOVE_CAST(Message)(m))
+  {
+  }
+
+private:
+  Message message_;
+};
+
+template <typename Message, typename Handler, typename IoExecutor>
+class channel_send_op : public channel_send_op_base<Message>
+{
+public:
+  BOOST_ASIO_DEFINE_HANDLER_PTR(channel_send_op);
+
+  channel_send_op(Message& m, Handler& handler, const IoExecutor& io_ex)
+    : channel_send_op_base<Message>(m, &channel_send_op::do_complete),
+      handler_(BOOST_ASIO_MOVE_CAST(Handler)(handler)),
+      work_(io_ex)
+  {
+  }
+
+  static void do_complete(channel_operation* base,
+      const boost::system::error_code* ec, void* /*message*/)
+  {
+    // Take ownership of the handler object.
+    channel_send_op* o(static_cast<channel_send_op*>(base));
+    ptr p = { boost::asio::detail::addressof(o->handler_), o, o };
+
+    // Take ownership of the operation's outstanding work. It is released only
+    // after the completion has been posted, so that the I/O executor does not
+    // run out of work in between.
+    executor_work_guard<IoExecutor> w(
+        BOOST_ASIO_MOVE_CAST(executor_work_guard<IoExecutor>)(o->work_));
+
+    // Make the upcall if required.
+    if (ec)
+    {
+      BOOST_ASIO_HANDLER_COMPLETION((*o));
+
+      // Make a copy of the handler so that the memory can be deallocated
+      // before the completion is posted.
+      typedef detail::binder1<Handler, boost::system::error_code> binder_type;
+      binder_type handler(0, BOOST_ASIO_MOVE_CAST(Handler)(o->handler_), *ec);
+      p.h = boost::asio::detail::addressof(handler.handler_);
+      p.reset();
+
+      boost::asio::post(w.get_executor(),
+          BOOST_ASIO_MOVE_CAST(binder_type)(handler));
+    }
+  }
+
+private:
+  Handler handler_;
+
+  // Channel operations are not known to the scheduler, so the operation keeps
+  // the I/O executor's context busy while it is pending.
+  executor_work_guard<IoExecutor> work_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_MOVE)
+
+#endif // BOOST_ASIO_DETAIL_CHANNEL_SEND_OP_HPP
@@ -0,0 +1,419 @@
+//
+// detail/channel_service.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_CHANNEL_SERVICE_HPP
+#define BOOST_ASIO_DETAIL_CHANNEL_SERVICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_MOVE)
+
+#include <cstddef>
+#include <boost/asio/error.hpp>
+#include <boost/asio/execution_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/detail/channel_buffer.hpp>
+#include <boost/asio/detail/channel_operation.hpp>
+#include <boost/asio/detail/channel_receive_op.hpp>
+#include <boost/asio/detail/channel_send_op.hpp>
+#include <boost/asio/detail/handler_alloc_helpers.hpp>
+#include <boost/asio/detail/memory.hpp>
+#include <boost/asio/detail/mutex.hpp>
+#include <boost/asio/detail/op_queue.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// Implements the channel I/O objects. The Mutex protects each channel's
+// state, and is a null_mutex when the channel is used from a single thread.
+template <typename Mutex>
+class channel_service
+  : public execution_context_service_base<channel_service<Mutex> >
+{
+public:
+  // The state common to all channels, regardless of the message type.
+  class base_implementation_type
+  {
+  protected:
+    base_implementation_type()
+      : open_(true),
+        next_(0),
+        prev_(0)
+    {
+    }
+
+  private:
+    friend class channel_service;
+
+    // Mutex to protect access to the channel's state.
+    Mutex mutex_;
+
+    // Whether the channel accepts new messages.
+    bool open_;
+
+    // Send operations waiting for space in the buffer. There are pending
+    // senders only when the buffer is full.
+    op_queue<channel_operation> senders_;
+
+    // Receive operations waiting for a message. There are pending receivers
+    // only when the buffer is empty.
+    op_queue<channel_operation> receivers_;
+
+    // Pointers to adjacent channel implementations in linked list.
+    base_implementation_type* next_;
+    base_implementation_type* prev_;
+  };
+
+  // The state of a channel carrying a particular type of message.
+  template <typename Message>
+  class implementation_type : public base_implementation_type
+  {
+  private:
+    friend class channel_service;
+
+    // Messages that have been sent but not yet received.
+    channel_buffer<Message> buffer_;
+  };
+
+  // Constructor.
+  explicit channel_service(execution_context& context)
+    : execution_context_service_base<channel_service>(context),
+      mutex_(),
+      impl_list_(0)
+  {
+  }
+
+  // Destroy all user-defined handler objects owned by the service.
+  void shutdown()
+  {
+    op_queue<channel_operation> ops;
+
+    boost::asio::detail::mutex::scoped_lock lock(mutex_);
+
+    base_implementation_type* impl = impl_list_;
+    while (impl)
+    {
+      typename Mutex::scoped_lock impl_lock(impl->mutex_);
+      ops.push(impl->senders_);
+      ops.push(impl->receivers_);
+      impl = impl->next_;
+    }
+  }
+
+  // Construct a new channel implementation.
+  template <typename Message>
+  void construct(implementation_type<Message>& impl,
+      std::size_t max_buffer_size)
+  {
+    impl.buffer_.allocate(max_buffer_size);
+
+    // Insert implementation into linked list of all implementations.
+    boost::asio::detail::mutex::scoped_lock lock(mutex_);
+    impl.next_ = impl_list_;
+    impl.prev_ = 0;
+    if (impl_list_)
+      impl_list_->prev_ = &impl;
+    impl_list_ = &impl;
+  }
+
+  // Destroy a channel implementation. Any pending operations are completed
+  // with the operation_aborted error.
+  template <typename Message>
+  void destroy(implementation_type<Message>& impl)
+  {
+    cancel(impl);
+
+    // Remove implementation from linked list of all implementations.
+    boost::asio::detail::mutex::scoped_lock lock(mutex_);
+    if (impl_list_ == &impl)
+      impl_list_ = impl.next_;
+    if (impl.prev_)
+      impl.prev_->next_ = impl.next_;
+    if (impl.next_)
+      impl.next_->prev_= impl.prev_;
+    impl.next_ = 0;
+    impl.prev_ = 0;
+  }
+
+  // Get the maximum number of messages that may be buffered.
+  template <typename Message>
+  std::size_t capacity(const implementation_type<Message>& impl) const
+  {
+    return impl.buffer_.capacity();
+  }
+
+  // Determine whether the channel is open.
+  template <typename Message>
+  bool is_open(implementation_type<Message>& impl) const
+  {
+    typename Mutex::scoped_lock lock(impl.mutex_);
+    return impl.open_;
+  }
+
+  // Determine whether a message can be received without waiting.
+  template <typename Message>
+  bool ready(implementation_type<Message>& impl) const
+  {
+    typename Mutex::scoped_lock lock(impl.mutex_);
+    return !impl.buffer_.empty() || !impl.senders_.empty();
+  }
+
+  // Close the channel. Buffered messages may still be received, but pending
+  // and subsequent sends fail, as do receives once the buffer is empty.
+  template <typename Message>
+  void close(implementation_type<Message>& impl)
+  {
+    op_queue<channel_operation> ops;
+
+    typename Mutex::scoped_lock lock(impl.mutex_);
+    impl.open_ = false;
+    ops.push(impl.senders_);
+    ops.push(impl.receivers_);
+    lock.unlock();
+
+    complete_all(ops, boost::asio::error::channel_closed);
+  }
+
+  // Cancel all pending operations. Buffered messages are unaffected.
+  template <typename Message>
+  void cancel(implementation_type<Message>& impl)
+  {
+    op_queue<channel_operation> ops;
+
+    typename Mutex::scoped_lock lock(impl.mutex_);
+    ops.push(impl.senders_);
+    ops.push(impl.receivers_);
+    lock.unlock();
+
+    complete_all(ops, boost::asio::error::operation_aborted);
+  }
+
+  // Discard any buffered messages, cancel all pending operations and reopen
+  // the channel.
+  template <typename Message>
+  void reset(implementation_type<Message>& impl)
+  {
+    op_queue<channel_operation> ops;
+
+    typename Mutex::scoped_lock lock(impl.mutex_);
+    impl.open_ = true;
+    impl.buffer_.clear();
+    ops.push(impl.senders_);
+    ops.push(impl.receivers_);
+    lock.unlock();
+
+    complete_all(ops, boost::asio::error::operation_aborted);
+  }
+
+  // Attempt to send a message without waiting.
+  template <typename Message>
+  bool try_send(implementation_type<Message>& impl, Message& m)
+  {
+    typename Mutex::scoped_lock lock(impl.mutex_);
+    if (!impl.open_)
+      return false;
+
+    if (channel_operation* receiver = impl.receivers_.front())
+    {
+      // Hand the message directly to a waiting receiver.
+      impl.receivers_.pop();
+      lock.unlock();
+      receiver->complete(boost::system::error_code(), &m);
+      return true;
+    }
+
+    if (impl.buffer_.full())
+      return false;
+
+    impl.buffer_.push(m);
+    return true;
+  }
+
+  // Attempt to receive a message without waiting. The handler is invoked
+  // inline with the message if one is available.
+  template <typename Message, typename Handler>
+  bool try_receive(implementation_type<Message>& impl, Handler& handler)
+  {
+    typename Mutex::scoped_lock lock(impl.mutex_);
+    if (impl.buffer_.empty() && impl.senders_.empty())
+      return false;
+
+    channel_operation* sender = 0;
+    Message m(take_message(impl, sender));
+    lock.unlock();
+
+    if (sender)
+      sender->complete(boost::system::error_code(), 0);
+    Message::bind(handler, boost::system::error_code(), &m)();
+    return true;
+  }
+
+  // Start an asynchronous send. The operation completes immediately unless
+  // the buffer is full and there is no receiver waiting.
+  template <typename Message, typename Handler, typename IoExecutor>
+  void async_send(implementation_type<Message>& impl,
+      Message& m, Handler& handler, const IoExecutor& io_ex)
+  {
+    typename Mutex::scoped_lock lock(impl.mutex_);
+    if (!impl.open_)
+    {
+      lock.unlock();
+      post_completion(io_ex, binder1<Handler, boost::system::error_code>(
+            0, BOOST_ASIO_MOVE_CAST(Handler)(handler),
+            boost::asio::error::channel_closed));
+      return;
+    }
+
+    if (channel_operation* receiver = impl.receivers_.front())
+    {
+      // Hand the message directly to a waiting receiver.
+      impl.receivers_.pop();
+      lock.unlock();
+      receiver->complete(boost::system::error_code(), &m);
+      post_completion(io_ex, binder1<Handler, boost::system::error_code>(
+            0, BOOST_ASIO_MOVE_CAST(Handler)(handler),
+            boost::system::error_code()));
+      return;
+    }
+
+    if (!impl.buffer_.full())
+    {
+      impl.buffer_.push(m);
+      lock.unlock();
+      post_completion(io_ex, binder1<Handler, boost::system::error_code>(
+            0, BOOST_ASIO_MOVE_CAST(Handler)(handler),
+            boost::system::error_code()));
+      return;
+    }
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef channel_send_op<Message, Handler, IoExecutor> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(m, handler, io_ex);
+
+    BOOST_ASIO_HANDLER_CREATION((this->context(),
+          *p.p, "channel", &impl, 0, "async_send"));
+
+    impl.senders_.push(p.p);
+    p.v = p.p = 0;
+  }
+
+  // Start an asynchronous receive. The operation completes immediately if a
+  // message is buffered or a sender is waiting.
+  template <typename Message, typename Handler, typename IoExecutor>
+  void async_receive(implementation_type<Message>& impl,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    typename Mutex::scoped_lock lock(impl.mutex_);
+    if (!impl.buffer_.empty() || !impl.senders_.empty())
+    {
+      channel_operation* sender = 0;
+      Message m(take_message(impl, sender));
+      lock.unlock();
+
+      if (sender)
+        sender->complete(boost::system::error_code(), 0);
+      post_completion(io_ex,
+          Message::bind(handler, boost::system::error_code(), &m));
+      return;
+    }
+
+    if (!impl.open_)
+    {
+      lock.unlock();
+      post_completion(io_ex,
+          Message::bind(handler, boost::asio::error::channel_closed, 0));
+      return;
+    }
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef channel_receive_op<Message, Handler, IoExecutor> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(handler, io_ex);
+
+    BOOST_ASIO_HANDLER_CREATION((this->context(),
+          *p.p, "channel", &impl, 0, "async_receive"));
+
+    impl.receivers_.push(p.p);
+    p.v = p.p = 0;
+  }
+
+private:
+  // Remove the next message from the channel. If a sender was waiting for
+  // space, its message moves into the buffer and the sender is returned so
+  // that it may be completed once the lock is released. Must be called with
+  // the channel's lock held.
+  template <typename Message>
+  static Message take_message(implementation_type<Message>& impl,
+      channel_operation*& sender)
+  {
+    sender = impl.senders_.front();
+    if (sender)
+      impl.senders_.pop();
+
+    if (impl.buffer_.empty())
+    {
+      // Unbuffered channel, so take the message straight from the sender.
+      return Message(BOOST_ASIO_MOVE_CAST(Message)(
+            static_cast<channel_send_op_base<Message>*>(sender)->message()));
+    }
+
+    Message m(BOOST_ASIO_MOVE_CAST(Message)(impl.buffer_.front()));
+    impl.buffer_.pop();
+    if (sender)
+      impl.buffer_.push(
+          static_cast<channel_send_op_base<Message>*>(sender)->message());
+    return m;
+  }
+
+  // Complete a set of dequeued operations with the given error.
+  static void complete_all(op_queue<channel_operation>& ops,
+      const boost::system::error_code& ec)
+  {
+    while (channel_operation* op = ops.front())
+    {
+      ops.pop();
+      op->complete(ec, 0);
+    }
+  }
+
+  // Post the completion of an operation that did not need to wait.
+  template <typename IoExecutor, typename Function>
+  static void post_completion(const IoExecutor& io_ex,
+      BOOST_ASIO_MOVE_ARG(Function) f)
+  {
+    boost::asio::post(io_ex, BOOST_ASIO_MOVE_CAST(Function)(f));
+  }
+
+  // Mutex to protect access to the linked list of implementations.
+  boost::asio::detail::mutex mutex_;
+
+  // The head of a linked list of all implementations.
+  base_implementation_type* impl_list_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_MOVE)
+
+#endif // BOOST_ASIO_DETAIL_CHANNEL_SERVICE_HPP
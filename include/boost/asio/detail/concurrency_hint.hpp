@@ -33,6 +33,14 @@
 // If set, this bit indicates that the reactor should perform locking for I/O.
 #define BOOST_ASIO_CONCURRENCY_HINT_LOCKING_REACTOR_IO 0x4u
 
+// If set, this bit indicates that the scheduler should poll the reactor
+// continuously rather than block in it.
+#define BOOST_ASIO_CONCURRENCY_HINT_BUSY_POLLING_REACTOR 0x8u
+
+// If set, this bit indicates that a reactor operation that completes
+// immediately may invoke its handler on the initiating thread.
+#define BOOST_ASIO_CONCURRENCY_HINT_INLINE_COMPLETION 0x10u
+
 // Helper macro to determine if we have a special concurrency hint.
 #define BOOST_ASIO_CONCURRENCY_HINT_IS_SPECIAL(hint) \
   ((static_cast<unsigned>(hint) \
@@ -46,12 +54,30 @@
       | BOOST_ASIO_CONCURRENCY_HINT_LOCKING_ ## facility)) \
         ^ BOOST_ASIO_CONCURRENCY_HINT_ID) != 0)
 
+// Helper macro to determine if the reactor should be busy polled.
+#define BOOST_ASIO_CONCURRENCY_HINT_IS_BUSY_POLLING(hint) \
+  ((static_cast<unsigned>(hint) \
+    & (BOOST_ASIO_CONCURRENCY_HINT_ID_MASK \
+      | BOOST_ASIO_CONCURRENCY_HINT_BUSY_POLLING_REACTOR)) \
+        == (BOOST_ASIO_CONCURRENCY_HINT_ID \
+          | BOOST_ASIO_CONCURRENCY_HINT_BUSY_POLLING_REACTOR))
+
+// Helper macro to determine if immediate completions may be invoked inline.
+#define BOOST_ASIO_CONCURRENCY_HINT_IS_INLINE_COMPLETION(hint) \
+  ((static_cast<unsigned>(hint) \
+    & (BOOST_ASIO_CONCURRENCY_HINT_ID_MASK \
+      | BOOST_ASIO_CONCURRENCY_HINT_INLINE_COMPLETION)) \
+        == (BOOST_ASIO_CONCURRENCY_HINT_ID \
+          | BOOST_ASIO_CONCURRENCY_HINT_INLINE_COMPLETION))
+
 // This special concurrency hint disables locking in both the scheduler and
-// reactor I/O. This hint has the following restrictions:
+// reactor I/O, and the scheduler counts outstanding work without atomic
+// operations. This hint has the following restrictions:
 //
 // - Care must be taken to ensure that all operations on the io_context and any
 //   of its associated I/O objects (such as sockets and timers) occur in only
-//   one thread at a time.
+//   one thread at a time. This includes copying and destroying executors and
+//   work guards that track outstanding work.
 //
 // - Asynchronous resolve operations fail with operation_not_supported.
 //
@@ -78,6 +104,44 @@
       | BOOST_ASIO_CONCURRENCY_HINT_LOCKING_REACTOR_REGISTRATION \
       | BOOST_ASIO_CONCURRENCY_HINT_LOCKING_REACTOR_IO)
 
+// This special concurrency hint disables locking in the same way as
+// BOOST_ASIO_CONCURRENCY_HINT_UNSAFE, and has the same restrictions. In
+// addition, a thread that runs the io_context polls the reactor continuously,
+// without blocking, while there are no handlers ready to run.
+#define BOOST_ASIO_CONCURRENCY_HINT_UNSAFE_BUSY_POLL \
+  static_cast<int>(BOOST_ASIO_CONCURRENCY_HINT_ID \
+      | BOOST_ASIO_CONCURRENCY_HINT_BUSY_POLLING_REACTOR)
+
+// This special concurrency hint provides full thread safety. In addition, a
+// thread that runs the io_context polls the reactor continuously, without
+// blocking, while there are no handlers ready to run.
+#define BOOST_ASIO_CONCURRENCY_HINT_SAFE_BUSY_POLL \
+  static_cast<int>(BOOST_ASIO_CONCURRENCY_HINT_ID \
+      | BOOST_ASIO_CONCURRENCY_HINT_LOCKING_SCHEDULER \
+      | BOOST_ASIO_CONCURRENCY_HINT_LOCKING_REACTOR_REGISTRATION \
+      | BOOST_ASIO_CONCURRENCY_HINT_LOCKING_REACTOR_IO \
+      | BOOST_ASIO_CONCURRENCY_HINT_BUSY_POLLING_REACTOR)
+
+// This special concurrency hint disables locking in the same way as
+// BOOST_ASIO_CONCURRENCY_HINT_UNSAFE, and has the same restrictions. In
+// addition, when a reactor operation started from a thread that is running the
+// io_context completes immediately, its handler may be invoked before the
+// initiating function returns.
+#define BOOST_ASIO_CONCURRENCY_HINT_UNSAFE_INLINE \
+  static_cast<int>(BOOST_ASIO_CONCURRENCY_HINT_ID \
+      | BOOST_ASIO_CONCURRENCY_HINT_INLINE_COMPLETION)
+
+// This special concurrency hint provides full thread safety. In addition, when
+// a reactor operation started from a thread that is running the io_context
+// completes immediately, its handler may be invoked before the initiating
+// function returns.
+#define BOOST_ASIO_CONCURRENCY_HINT_SAFE_INLINE \
+  static_cast<int>(BOOST_ASIO_CONCURRENCY_HINT_ID \
+      | BOOST_ASIO_CONCURRENCY_HINT_LOCKING_SCHEDULER \
+      | BOOST_ASIO_CONCURRENCY_HINT_LOCKING_REACTOR_REGISTRATION \
+      | BOOST_ASIO_CONCURRENCY_HINT_LOCKING_REACTOR_IO \
+      | BOOST_ASIO_CONCURRENCY_HINT_INLINE_COMPLETION)
+
 // This #define may be overridden at compile time to specify a program-wide
 // default concurrency hint, used by the zero-argument io_context constructor.
 #if !defined(BOOST_ASIO_CONCURRENCY_HINT_DEFAULT)
@@ -18,6 +18,7 @@
 #include <boost/asio/detail/config.hpp>
 #include <boost/asio/detail/conditionally_enabled_mutex.hpp>
 #include <boost/asio/detail/event.hpp>
+#include <boost/asio/detail/futex_event.hpp>
 #include <boost/asio/detail/noncopyable.hpp>
 #include <boost/asio/detail/null_event.hpp>
 #include <boost/asio/detail/scoped_lock.hpp>
@@ -110,7 +111,11 @@ public:
   }
 
 private:
+#if defined(BOOST_ASIO_HAS_FUTEX)
+  futex_event event_;
+#else // defined(BOOST_ASIO_HAS_FUTEX)
   boost::asio::detail::event event_;
+#endif // defined(BOOST_ASIO_HAS_FUTEX)
 };
 
 } // namespace detail
@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include <boost/asio/detail/config.hpp>
+#include <boost/asio/detail/futex_mutex.hpp>
 #include <boost/asio/detail/mutex.hpp>
 #include <boost/asio/detail/noncopyable.hpp>
 #include <boost/asio/detail/scoped_lock.hpp>
@@ -31,6 +32,13 @@ class conditionally_enabled_mutex
   : private noncopyable
 {
 public:
+  // The type of the underlying mutex.
+#if defined(BOOST_ASIO_HAS_FUTEX)
+  typedef futex_mutex mutex_type;
+#else // defined(BOOST_ASIO_HAS_FUTEX)
+  typedef boost::asio::detail::mutex mutex_type;
+#endif // defined(BOOST_ASIO_HAS_FUTEX)
+
   // Helper class to lock and unlock a mutex automatically.
   class scoped_lock
     : private noncopyable
@@ -93,7 +101,7 @@ public:
     }
 
     // Get the underlying mutex.
-    boost::asio::detail::mutex& mutex()
+    mutex_type& mutex()
     {
       return mutex_.mutex_;
     }
@@ -138,7 +146,7 @@ public:
 private:
   friend class scoped_lock;
   friend class conditionally_enabled_event;
-  boost::asio::detail::mutex mutex_;
+  mutex_type mutex_;
   const bool enabled_;
 };
 
@@ -541,6 +541,29 @@
 # endif // !defined(BOOST_ASIO_RVALUE_REF_QUAL)
 #endif // defined(BOOST_ASIO_HAS_REF_QUALIFIED_FUNCTIONS)
 
+// Support enum classes on compilers known to allow them.
+#if !defined(BOOST_ASIO_HAS_ENUM_CLASS)
+# if !defined(BOOST_ASIO_DISABLE_ENUM_CLASS)
+#  if defined(__clang__)
+#   if __has_feature(__cxx_strong_enums__)
+#    define BOOST_ASIO_HAS_ENUM_CLASS 1
+#   endif // __has_feature(__cxx_strong_enums__)
+#  endif // defined(__clang__)
+#  if defined(__GNUC__)
+#   if ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 4)) || (__GNUC__ > 4)
+#    if (__cplusplus >= 201103) || defined(__GXX_EXPERIMENTAL_CXX0X__)
+#     define BOOST_ASIO_HAS_ENUM_CLASS 1
+#    endif // (__cplusplus >= 201103) || defined(__GXX_EXPERIMENTAL_CXX0X__)
+#   endif // ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 4)) || (__GNUC__ > 4)
+#  endif // defined(__GNUC__)
+#  if defined(BOOST_ASIO_MSVC)
+#   if (_MSC_VER >= 1700)
+#    define BOOST_ASIO_HAS_ENUM_CLASS 1
+#   endif // (_MSC_VER >= 1700)
+#  endif // defined(BOOST_ASIO_MSVC)
+# endif // !defined(BOOST_ASIO_DISABLE_ENUM_CLASS)
+#endif // !defined(BOOST_ASIO_HAS_ENUM_CLASS)
+
 // Standard library support for system errors.
 # if !defined(BOOST_ASIO_DISABLE_STD_SYSTEM_ERROR)
 #  if defined(__clang__)
@@ -1186,6 +1209,54 @@
 # endif // !defined(BOOST_ASIO_DISABLE_STD_ANY)
 #endif // !defined(BOOST_ASIO_HAS_STD_ANY)
 
+// Standard library support for std::variant.
+#if !defined(BOOST_ASIO_HAS_STD_VARIANT)
+# if !defined(BOOST_ASIO_DISABLE_STD_VARIANT)
+#  if defined(__clang__)
+#   if (__cplusplus >= 201703)
+#    if __has_include(<variant>)
+#     define BOOST_ASIO_HAS_STD_VARIANT 1
+#    endif // __has_include(<variant>)
+#   endif // (__cplusplus >= 201703)
+#  elif defined(__GNUC__)
+#   if (__GNUC__ >= 7)
+#    if (__cplusplus >= 201703)
+#     define BOOST_ASIO_HAS_STD_VARIANT 1
+#    endif // (__cplusplus >= 201703)
+#   endif // (__GNUC__ >= 7)
+#  endif // defined(__GNUC__)
+#  if defined(BOOST_ASIO_MSVC)
+#   if (_MSC_VER >= 1910) && (_MSVC_LANG >= 201703)
+#    define BOOST_ASIO_HAS_STD_VARIANT 1
+#   endif // (_MSC_VER >= 1910) && (_MSVC_LANG >= 201703)
+#  endif // defined(BOOST_ASIO_MSVC)
+# endif // !defined(BOOST_ASIO_DISABLE_STD_VARIANT)
+#endif // !defined(BOOST_ASIO_HAS_STD_VARIANT)
+
+// Standard library support for std::optional.
+#if !defined(BOOST_ASIO_HAS_STD_OPTIONAL)
+# if !defined(BOOST_ASIO_DISABLE_STD_OPTIONAL)
+#  if defined(__clang__)
+#   if (__cplusplus >= 201703)
+#    if __has_include(<optional>)
+#     define BOOST_ASIO_HAS_STD_OPTIONAL 1
+#    endif // __has_include(<optional>)
+#   endif // (__cplusplus >= 201703)
+#  elif defined(__GNUC__)
+#   if (__GNUC__ >= 7)
+#    if (__cplusplus >= 201703)
+#     define BOOST_ASIO_HAS_STD_OPTIONAL 1
+#    endif // (__cplusplus >= 201703)
+#   endif // (__GNUC__ >= 7)
+#  endif // defined(__GNUC__)
+#  if defined(BOOST_ASIO_MSVC)
+#   if (_MSC_VER >= 1910) && (_MSVC_LANG >= 201703)
+#    define BOOST_ASIO_HAS_STD_OPTIONAL 1
+#   endif // (_MSC_VER >= 1910) && (_MSVC_LANG >= 201703)
+#  endif // defined(BOOST_ASIO_MSVC)
+# endif // !defined(BOOST_ASIO_DISABLE_STD_OPTIONAL)
+#endif // !defined(BOOST_ASIO_HAS_STD_OPTIONAL)
+
 // Standard library support for std::source_location.
 #if !defined(BOOST_ASIO_HAS_STD_SOURCE_LOCATION)
 # if !defined(BOOST_ASIO_DISABLE_STD_SOURCE_LOCATION)
@@ -1376,6 +1447,29 @@
 #   endif // (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 8)
 #  endif // defined(BOOST_ASIO_HAS_EPOLL)
 # endif // !defined(BOOST_ASIO_HAS_TIMERFD)
+# if !defined(BOOST_ASIO_HAS_ACCEPT4)
+#  if !defined(BOOST_ASIO_DISABLE_ACCEPT4)
+#   if (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 10)
+#    define BOOST_ASIO_HAS_ACCEPT4 1
+#   endif // (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 10)
+#  endif // !defined(BOOST_ASIO_DISABLE_ACCEPT4)
+# endif // !defined(BOOST_ASIO_HAS_ACCEPT4)
+// Signals are delivered through signalfd only on request, since the signals
+// must then be blocked in every thread of the program.
+# if !defined(BOOST_ASIO_HAS_SIGNALFD)
+#  if defined(BOOST_ASIO_ENABLE_SIGNALFD)
+#   if (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 8)
+#    define BOOST_ASIO_HAS_SIGNALFD 1
+#   endif // (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 8)
+#  endif // defined(BOOST_ASIO_ENABLE_SIGNALFD)
+# endif // !defined(BOOST_ASIO_HAS_SIGNALFD)
+# if !defined(BOOST_ASIO_HAS_DESCRIPTOR_TABLE)
+#  if !defined(BOOST_ASIO_DISABLE_DESCRIPTOR_TABLE)
+#   if defined(BOOST_ASIO_HAS_EPOLL) && defined(BOOST_ASIO_HAS_STD_ATOMIC)
+#    define BOOST_ASIO_HAS_DESCRIPTOR_TABLE 1
+#   endif // defined(BOOST_ASIO_HAS_EPOLL) && defined(BOOST_ASIO_HAS_STD_ATOMIC)
+#  endif // !defined(BOOST_ASIO_DISABLE_DESCRIPTOR_TABLE)
+# endif // !defined(BOOST_ASIO_HAS_DESCRIPTOR_TABLE)
 #endif // defined(__linux__)
 
 // Mac OS X, FreeBSD, NetBSD, OpenBSD: kqueue.
@@ -1586,6 +1680,17 @@
 # endif // defined(BOOST_ASIO_HAS_THREADS)
 #endif // !defined(BOOST_ASIO_HAS_PTHREADS)
 
+// Linux futexes, used for the scheduler's internal mutex and event.
+#if !defined(BOOST_ASIO_HAS_FUTEX)
+# if !defined(BOOST_ASIO_DISABLE_FUTEX)
+#  if defined(__linux__) && defined(BOOST_ASIO_HAS_PTHREADS) \
+     && defined(BOOST_ASIO_HAS_STD_ATOMIC)
+#   define BOOST_ASIO_HAS_FUTEX 1
+#  endif // defined(__linux__) && defined(BOOST_ASIO_HAS_PTHREADS)
+         //   && defined(BOOST_ASIO_HAS_STD_ATOMIC)
+# endif // !defined(BOOST_ASIO_DISABLE_FUTEX)
+#endif // !defined(BOOST_ASIO_HAS_FUTEX)
+
 // Helper to prevent macro expansion.
 #define BOOST_ASIO_PREVENT_MACRO_SUBSTITUTION
 
@@ -1702,6 +1807,85 @@
 # define BOOST_ASIO_THREAD_KEYWORD __thread
 #endif // !defined(BOOST_ASIO_THREAD_KEYWORD)
 
+// Support for reusing the stacks of coroutines created by spawn(). Requires
+// mmap/mprotect, and thread_local objects for the per-thread free lists.
+#if !defined(BOOST_ASIO_HAS_SPAWN_STACK_POOL)
+# if !defined(BOOST_ASIO_DISABLE_SPAWN_STACK_POOL)
+#  if !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__) \
+    && !defined(BOOST_USE_SEGMENTED_STACKS)
+#   if defined(__clang__)
+#    if __has_feature(__cxx_thread_local__)
+#     define BOOST_ASIO_HAS_SPAWN_STACK_POOL 1
+#    endif // __has_feature(__cxx_thread_local__)
+#   elif defined(__GNUC__)
+#    if ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4)
+#     if (__cplusplus >= 201103) || defined(__GXX_EXPERIMENTAL_CXX0X__)
+#      define BOOST_ASIO_HAS_SPAWN_STACK_POOL 1
+#     endif // (__cplusplus >= 201103) || defined(__GXX_EXPERIMENTAL_CXX0X__)
+#    endif // ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4)
+#   endif // defined(__GNUC__)
+#  endif // !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+         //   && !defined(BOOST_USE_SEGMENTED_STACKS)
+# endif // !defined(BOOST_ASIO_DISABLE_SPAWN_STACK_POOL)
+#endif // !defined(BOOST_ASIO_HAS_SPAWN_STACK_POOL)
+
+// Support for sender-based I/O operations. The operation states embed the
+// reactor and timer operations, so only reactor-based backends are supported.
+#if !defined(BOOST_ASIO_HAS_IO_SENDERS)
+# if !defined(BOOST_ASIO_DISABLE_IO_SENDERS)
+#  if defined(BOOST_ASIO_HAS_MOVE) \
+    && defined(BOOST_ASIO_HAS_VARIADIC_TEMPLATES) \
+    && defined(BOOST_ASIO_HAS_ALIAS_TEMPLATES) \
+    && defined(BOOST_ASIO_HAS_DECLTYPE) \
+    && defined(BOOST_ASIO_HAS_NOEXCEPT) \
+    && defined(BOOST_ASIO_HAS_WORKING_EXPRESSION_SFINAE) \
+    && defined(BOOST_ASIO_HAS_STD_EXCEPTION_PTR)
+#   if !defined(BOOST_ASIO_HAS_IOCP) \
+      && !defined(BOOST_ASIO_WINDOWS_RUNTIME)
+#    define BOOST_ASIO_HAS_IO_SENDERS 1
+#   endif // !defined(BOOST_ASIO_HAS_IOCP)
+          //   && !defined(BOOST_ASIO_WINDOWS_RUNTIME)
+#  endif // defined(BOOST_ASIO_HAS_MOVE)
+         //   && defined(BOOST_ASIO_HAS_VARIADIC_TEMPLATES)
+         //   && defined(BOOST_ASIO_HAS_ALIAS_TEMPLATES)
+         //   && defined(BOOST_ASIO_HAS_DECLTYPE)
+         //   && defined(BOOST_ASIO_HAS_NOEXCEPT)
+         //   && defined(BOOST_ASIO_HAS_WORKING_EXPRESSION_SFINAE)
+         //   && defined(BOOST_ASIO_HAS_STD_EXCEPTION_PTR)
+# endif // !defined(BOOST_ASIO_DISABLE_IO_SENDERS)
+#endif // !defined(BOOST_ASIO_HAS_IO_SENDERS)
+
+// Support for operation deadlines that are tracked by the reactor. The
+// deadlines are kept in a timer queue owned by the reactor, so only
+// reactor-based backends are supported.
+#if !defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+# if !defined(BOOST_ASIO_DISABLE_OPERATION_DEADLINES)
+#  if defined(BOOST_ASIO_HAS_STD_CHRONO)
+#   if !defined(BOOST_ASIO_HAS_IOCP) \
+      && !defined(BOOST_ASIO_WINDOWS_RUNTIME)
+#    define BOOST_ASIO_HAS_OPERATION_DEADLINES 1
+#   endif // !defined(BOOST_ASIO_HAS_IOCP)
+          //   && !defined(BOOST_ASIO_WINDOWS_RUNTIME)
+#  endif // defined(BOOST_ASIO_HAS_STD_CHRONO)
+# endif // !defined(BOOST_ASIO_DISABLE_OPERATION_DEADLINES)
+#endif // !defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+
+// Support for the deferred completion token. Initiating functions only return
+// the deferred operation object when their return type can be deduced.
+#if !defined(BOOST_ASIO_HAS_DEFERRED)
+# if !defined(BOOST_ASIO_DISABLE_DEFERRED)
+#  if defined(BOOST_ASIO_HAS_MOVE) \
+    && defined(BOOST_ASIO_HAS_VARIADIC_TEMPLATES) \
+    && defined(BOOST_ASIO_HAS_DECLTYPE) \
+    && defined(BOOST_ASIO_HAS_RETURN_TYPE_DEDUCTION)
+#   define BOOST_ASIO_HAS_DEFERRED 1
+#  endif // defined(BOOST_ASIO_HAS_MOVE)
+         //   && defined(BOOST_ASIO_HAS_VARIADIC_TEMPLATES)
+         //   && defined(BOOST_ASIO_HAS_DECLTYPE)
+         //   && defined(BOOST_ASIO_HAS_RETURN_TYPE_DEDUCTION)
+# endif // !defined(BOOST_ASIO_DISABLE_DEFERRED)
+#endif // !defined(BOOST_ASIO_HAS_DEFERRED)
+
 // Support for POSIX ssize_t typedef.
 #if !defined(BOOST_ASIO_DISABLE_SSIZE_T)
 # if defined(__linux__) \
@@ -1789,6 +1973,28 @@
 # endif // !defined(BOOST_ASIO_DISABLE_STD_COROUTINE)
 #endif // !defined(BOOST_ASIO_HAS_STD_COROUTINE)
 
+// Support for SSE2 intrinsics.
+#if !defined(BOOST_ASIO_HAS_SSE2)
+# if !defined(BOOST_ASIO_DISABLE_SSE2)
+#  if defined(__SSE2__)
+#   define BOOST_ASIO_HAS_SSE2 1
+#  elif defined(BOOST_ASIO_MSVC)
+#   if defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#    define BOOST_ASIO_HAS_SSE2 1
+#   endif // defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#  endif // defined(BOOST_ASIO_MSVC)
+# endif // !defined(BOOST_ASIO_DISABLE_SSE2)
+#endif // !defined(BOOST_ASIO_HAS_SSE2)
+
+// Support for AVX2 intrinsics.
+#if !defined(BOOST_ASIO_HAS_AVX2)
+# if !defined(BOOST_ASIO_DISABLE_AVX2)
+#  if defined(BOOST_ASIO_HAS_SSE2) && defined(__AVX2__)
+#   define BOOST_ASIO_HAS_AVX2 1
+#  endif // defined(BOOST_ASIO_HAS_SSE2) && defined(__AVX2__)
+# endif // !defined(BOOST_ASIO_DISABLE_AVX2)
+#endif // !defined(BOOST_ASIO_HAS_AVX2)
+
 // Compiler support for the the [[nodiscard]] attribute.
 #if !defined(BOOST_ASIO_NODISCARD)
 # if defined(__has_cpp_attribute)
@@ -17,6 +17,8 @@
 
 #include <boost/asio/detail/config.hpp>
 #include <cstddef>
+#include <boost/asio/associated_cancellation_slot.hpp>
+#include <boost/asio/cancellation_type.hpp>
 #include <boost/asio/error.hpp>
 #include <boost/asio/execution_context.hpp>
 #include <boost/asio/detail/bind_handler.hpp>
@@ -220,6 +222,18 @@ public:
         Time_Traits::add(Time_Traits::now(), expiry_time), ec);
   }
 
+  // Get the amount by which the timer's expiry may be delayed.
+  duration_type slack(const implementation_type& impl) const
+  {
+    return impl.timer_data.slack();
+  }
+
+  // Set the amount by which the timer's expiry may be delayed.
+  void set_slack(implementation_type& impl, const duration_type& slack_time)
+  {
+    impl.timer_data.set_slack(slack_time);
+  }
+
   // Set the expiry time for the timer relative to now.
   std::size_t expires_from_now(implementation_type& impl,
       const duration_type& expiry_time, boost::system::error_code& ec)
@@ -246,12 +260,22 @@ public:
   void async_wait(implementation_type& impl,
       Handler& handler, const IoExecutor& io_ex)
   {
+    typename associated_cancellation_slot<Handler>::type slot
+      = boost::asio::get_associated_cancellation_slot(handler);
+
     // Allocate and construct an operation to wrap the handler.
     typedef wait_handler<Handler, IoExecutor> op;
     typename op::ptr p = { boost::asio::detail::addressof(handler),
       op::ptr::allocate(handler), 0 };
     p.p = new (p.v) op(handler, io_ex);
 
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<op_cancellation>(this, &impl.timer_data);
+    }
+
     impl.might_have_pending_waits = true;
 
     BOOST_ASIO_HANDLER_CREATION((scheduler_.context(),
@@ -261,7 +285,54 @@ public:
     p.v = p.p = 0;
   }
 
+#if defined(BOOST_ASIO_HAS_IO_SENDERS)
+  // Start an asynchronous wait, constructing the operation in storage owned
+  // by the caller. The storage must remain valid until the operation's
+  // completion function is called.
+  template <typename Op, typename Owner>
+  void async_wait_in_place(implementation_type& impl,
+      void* storage, Owner& owner)
+  {
+    Op* op = new (storage) Op(owner);
+
+    impl.might_have_pending_waits = true;
+
+    BOOST_ASIO_HANDLER_CREATION((scheduler_.context(),
+          *op, "deadline_timer", &impl, 0, "async_wait"));
+
+    scheduler_.schedule_timer(timer_queue_, impl.expiry, impl.timer_data, op);
+  }
+#endif // defined(BOOST_ASIO_HAS_IO_SENDERS)
+
 private:
+  // Helper class used to implement per-operation cancellation.
+  class op_cancellation
+  {
+  public:
+    op_cancellation(deadline_timer_service* s,
+        typename timer_queue<Time_Traits>::per_timer_data* p)
+      : service_(s),
+        timer_data_(p)
+    {
+    }
+
+    void operator()(cancellation_type_t type)
+    {
+      if (!!(type &
+            (cancellation_type::terminal
+              | cancellation_type::partial
+              | cancellation_type::total)))
+      {
+        service_->scheduler_.cancel_timer_by_key(
+            service_->timer_queue_, timer_data_, this);
+      }
+    }
+
+  private:
+    deadline_timer_service* service_;
+    typename timer_queue<Time_Traits>::per_timer_data* timer_data_;
+  };
+
   // Helper function to wait given a duration type. The duration type should
   // either be of type boost::posix_time::time_duration, or implement the
   // required subset of its interface.
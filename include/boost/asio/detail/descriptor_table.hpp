@@ -0,0 +1,253 @@
+//
+// detail/descriptor_table.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_DESCRIPTOR_TABLE_HPP
+#define BOOST_ASIO_DETAIL_DESCRIPTOR_TABLE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_DESCRIPTOR_TABLE)
+
+#include <atomic>
+#include <cstddef>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <boost/asio/detail/cstdint.hpp>
+#include <boost/asio/detail/noncopyable.hpp>
+#include <boost/asio/detail/object_pool.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+// The largest number of descriptors that a table will hold. The table is
+// further limited by the process's hard limit on open files.
+#if !defined(BOOST_ASIO_DESCRIPTOR_TABLE_SIZE)
+# define BOOST_ASIO_DESCRIPTOR_TABLE_SIZE 1048576
+#endif // !defined(BOOST_ASIO_DESCRIPTOR_TABLE_SIZE)
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// A table of objects indexed directly by descriptor number.
+//
+// Objects are stored in fixed-size slabs, which are allocated on first use
+// and installed without locking. Each object occupies whole cache lines. Once
+// constructed, objects are not destroyed until the table itself is destroyed,
+// so a pointer obtained from the table always refers to a valid object.
+//
+// Each slot has an atomic state word. The lowest bit is set while the slot is
+// claimed, and the word advances on every claim and release, so that the value
+// returned by claim() identifies a single use of the descriptor. This allows
+// stale references to be recognised after the descriptor has been closed and
+// its number reused.
+template <typename Object, typename Arg>
+class descriptor_table
+  : private noncopyable
+{
+public:
+  // Constructor. Objects are constructed using the given argument.
+  explicit descriptor_table(Arg arg)
+    : arg_(arg),
+      slab_count_(max_size() / slab_size),
+      slabs_(new std::atomic<void*>[slab_count_])
+  {
+    for (std::size_t i = 0; i < slab_count_; ++i)
+      slabs_[i].store(0, std::memory_order_relaxed);
+  }
+
+  // Destructor destroys all objects.
+  ~descriptor_table()
+  {
+    for (std::size_t i = 0; i < slab_count_; ++i)
+      if (void* slab = slabs_[i].load(std::memory_order_relaxed))
+        destroy_slab(slab);
+    delete[] slabs_;
+  }
+
+  // Get the number of descriptors that may be held in the table.
+  std::size_t capacity() const
+  {
+    return slab_count_ * slab_size;
+  }
+
+  // Claim the slot for a descriptor. Returns null if the descriptor is outside
+  // the table, or if its slot is still claimed by an earlier use of the same
+  // descriptor number. On success, key is set to identify the claim.
+  Object* claim(int descriptor, uint32_t& key)
+  {
+    if (descriptor < 0 || static_cast<std::size_t>(descriptor) >= capacity())
+      return 0;
+
+    void* slab = get_slab(descriptor / slab_size, true);
+    if (!slab)
+      return 0;
+
+    std::atomic<uint32_t>* state = state_at(slab, descriptor % slab_size);
+    uint32_t value = state->load(std::memory_order_relaxed);
+    if ((value & 1) != 0 || !state->compare_exchange_strong(value,
+          value + 1, std::memory_order_acquire, std::memory_order_relaxed))
+      return 0;
+
+    key = value + 1;
+    return object_at(slab, descriptor % slab_size);
+  }
+
+  // Release the slot for a descriptor that was claimed.
+  void release(int descriptor)
+  {
+    void* slab = get_slab(descriptor / slab_size, false);
+    state_at(slab, descriptor % slab_size)->fetch_add(
+        1, std::memory_order_release);
+  }
+
+  // Find the object for a descriptor, provided that the slot is still claimed
+  // under the given key. Returns null otherwise.
+  Object* find(int descriptor, uint32_t key) const
+  {
+    if (descriptor < 0 || static_cast<std::size_t>(descriptor) >= capacity())
+      return 0;
+
+    void* slab = get_slab(descriptor / slab_size, false);
+    if (!slab || state_at(slab, descriptor % slab_size)->load(
+          std::memory_order_acquire) != key)
+      return 0;
+
+    return object_at(slab, descriptor % slab_size);
+  }
+
+  // Find the claimed slot with the lowest descriptor not less than the given
+  // descriptor. Returns null if there is none, otherwise the object, with the
+  // descriptor updated to match.
+  Object* next_claimed(int& descriptor) const
+  {
+    for (std::size_t i = descriptor; i < capacity(); )
+    {
+      void* slab = get_slab(i / slab_size, false);
+      if (!slab)
+      {
+        i = (i / slab_size + 1) * slab_size;
+        continue;
+      }
+
+      if ((state_at(slab, i % slab_size)->load(
+              std::memory_order_acquire) & 1) != 0)
+      {
+        descriptor = static_cast<int>(i);
+        return object_at(slab, i % slab_size);
+      }
+
+      ++i;
+    }
+
+    return 0;
+  }
+
+private:
+  // The layout of a slab. Each slot holds an object followed by its state.
+  enum
+  {
+    slab_size = 256,
+    cache_line_size = 64,
+    state_offset = (sizeof(Object) + sizeof(std::atomic<uint32_t>) - 1)
+      / sizeof(std::atomic<uint32_t>) * sizeof(std::atomic<uint32_t>),
+    slot_size = (state_offset + sizeof(std::atomic<uint32_t>)
+        + cache_line_size - 1) / cache_line_size * cache_line_size
+  };
+
+  // Determine the table size from the limit on open files.
+  static std::size_t max_size()
+  {
+    std::size_t size = BOOST_ASIO_DESCRIPTOR_TABLE_SIZE;
+    rlimit limit;
+    if (::getrlimit(RLIMIT_NOFILE, &limit) == 0
+        && limit.rlim_max != RLIM_INFINITY && limit.rlim_max < size)
+      size = static_cast<std::size_t>(limit.rlim_max);
+    return (size + slab_size - 1) / slab_size * slab_size;
+  }
+
+  static Object* object_at(void* slab, std::size_t index)
+  {
+    return static_cast<Object*>(static_cast<void*>(
+          static_cast<char*>(slab) + index * slot_size));
+  }
+
+  static std::atomic<uint32_t>* state_at(void* slab, std::size_t index)
+  {
+    return static_cast<std::atomic<uint32_t>*>(static_cast<void*>(
+          static_cast<char*>(slab) + index * slot_size + state_offset));
+  }
+
+  // Get the slab with the given index, optionally creating it if it does not
+  // exist. A slab that loses a race to be installed is destroyed.
+  void* get_slab(std::size_t index, bool create) const
+  {
+    void* slab = slabs_[index].load(std::memory_order_acquire);
+    if (slab || !create)
+      return slab;
+
+    void* new_slab = create_slab();
+    if (!new_slab)
+      return 0;
+
+    if (slabs_[index].compare_exchange_strong(slab, new_slab,
+          std::memory_order_acq_rel, std::memory_order_acquire))
+      return new_slab;
+
+    destroy_slab(new_slab);
+    return slab;
+  }
+
+  // Allocate a slab and construct its objects. Returns null if the memory
+  // could not be allocated.
+  void* create_slab() const
+  {
+    void* slab = 0;
+    if (::posix_memalign(&slab, cache_line_size, slab_size * slot_size) != 0)
+      return 0;
+
+    for (std::size_t i = 0; i < slab_size; ++i)
+    {
+      object_pool_access::construct<Object>(object_at(slab, i), arg_);
+      new (state_at(slab, i)) std::atomic<uint32_t>(0);
+    }
+
+    return slab;
+  }
+
+  static void destroy_slab(void* slab)
+  {
+    for (std::size_t i = 0; i < slab_size; ++i)
+      object_pool_access::destruct(object_at(slab, i));
+    ::free(slab);
+  }
+
+  // The argument used to construct objects.
+  Arg arg_;
+
+  // The number of slabs that the table may hold.
+  std::size_t slab_count_;
+
+  // The slabs, which are null until first used.
+  std::atomic<void*>* slabs_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_DESCRIPTOR_TABLE)
+
+#endif // BOOST_ASIO_DETAIL_DESCRIPTOR_TABLE_HPP
@@ -0,0 +1,106 @@
+//
+// detail/dfa_table.hpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_DFA_TABLE_HPP
+#define BOOST_ASIO_DETAIL_DFA_TABLE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <vector>
+#include <boost/asio/detail/noncopyable.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// Transition table for a deterministic finite automaton that searches for the
+// end of the first match of a regular expression. The table is immutable once
+// compiled and may be shared between any number of matchers.
+class dfa_table
+  : private noncopyable
+{
+public:
+  // The type used to store state numbers.
+  typedef unsigned short state_type;
+
+  // The maximum number of states the compiled automaton may have.
+  enum { max_states = 8192 };
+
+  // Compile the pattern.
+  BOOST_ASIO_DECL dfa_table(const char* pattern,
+      std::size_t length, boost::system::error_code& ec);
+
+  // The state in which every search begins.
+  static state_type start_state()
+  {
+    return 0;
+  }
+
+  // The pseudo-state entered when a match is complete.
+  state_type match_state() const
+  {
+    return match_state_;
+  }
+
+  // Whether the pattern matches the empty string.
+  bool matches_empty() const
+  {
+    return matches_empty_;
+  }
+
+  // Get the number of states in the automaton.
+  std::size_t state_count() const
+  {
+    return match_state_;
+  }
+
+  // Get the state that follows the given state on a byte.
+  state_type next(state_type state, unsigned char c) const
+  {
+    return transitions_[state * class_count_ + byte_classes_[c]];
+  }
+
+private:
+  friend class dfa_compiler;
+
+  // The equivalence class of each byte value.
+  unsigned char byte_classes_[256];
+
+  // The number of byte equivalence classes.
+  std::size_t class_count_;
+
+  // The transitions, indexed by state and then byte class.
+  std::vector<state_type> transitions_;
+
+  // The pseudo-state representing a completed match.
+  state_type match_state_;
+
+  // Whether the empty string is a match.
+  bool matches_empty_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#if defined(BOOST_ASIO_HEADER_ONLY)
+# include <boost/asio/detail/impl/dfa_table.ipp>
+#endif // defined(BOOST_ASIO_HEADER_ONLY)
+
+#endif // BOOST_ASIO_DETAIL_DFA_TABLE_HPP
@@ -21,16 +21,20 @@
 
 #include <boost/asio/detail/atomic_count.hpp>
 #include <boost/asio/detail/conditionally_enabled_mutex.hpp>
+#include <boost/asio/detail/cstdint.hpp>
+#include <boost/asio/detail/descriptor_table.hpp>
 #include <boost/asio/detail/limits.hpp>
 #include <boost/asio/detail/object_pool.hpp>
 #include <boost/asio/detail/op_queue.hpp>
 #include <boost/asio/detail/reactor_op.hpp>
+#include <boost/asio/detail/reactor_op_deadline.hpp>
 #include <boost/asio/detail/select_interrupter.hpp>
 #include <boost/asio/detail/socket_types.hpp>
 #include <boost/asio/detail/timer_queue_base.hpp>
 #include <boost/asio/detail/timer_queue_set.hpp>
 #include <boost/asio/detail/wait_op.hpp>
 #include <boost/asio/execution_context.hpp>
+#include <sys/epoll.h>
 
 #if defined(BOOST_ASIO_HAS_TIMERFD)
 # include <sys/timerfd.h>
@@ -70,6 +74,11 @@ public:
     bool try_speculative_[max_ops];
     bool shutdown_;
 
+    // The data registered with epoll to identify the descriptor. States held
+    // in the descriptor table are identified by their descriptor and key, with
+    // the lowest bit set. Other states are identified by their address.
+    epoll_data_t event_data_;
+
     BOOST_ASIO_DECL descriptor_state(bool locking);
     void set_ready_events(uint32_t events) { task_result_ = events; }
     void add_ready_events(uint32_t events) { task_result_ |= events; }
@@ -109,6 +118,12 @@ public:
       int op_type, socket_type descriptor,
       per_descriptor_data& descriptor_data, reactor_op* op);
 
+  // Change whether readiness of a registered descriptor wakes only one of the
+  // reactors waiting on it. Returns 0 on success, system error code on
+  // failure.
+  BOOST_ASIO_DECL int set_exclusive_wake(socket_type descriptor,
+      per_descriptor_data& descriptor_data, bool exclusive);
+
   // Move descriptor registration from one descriptor_data object to another.
   BOOST_ASIO_DECL void move_descriptor(socket_type descriptor,
       per_descriptor_data& target_descriptor_data,
@@ -132,6 +147,22 @@ public:
   BOOST_ASIO_DECL void cancel_ops(socket_type descriptor,
       per_descriptor_data& descriptor_data);
 
+  // Cancel all operations associated with the given descriptor and
+  // cancellation key. The handlers associated with the descriptor will be
+  // invoked with the operation_aborted error.
+  BOOST_ASIO_DECL void cancel_ops_by_key(socket_type descriptor,
+      per_descriptor_data& descriptor_data,
+      int op_type, void* cancellation_key);
+
+#if defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+  // Cancel the deadline of an operation that has completed.
+  BOOST_ASIO_DECL void cancel_deadline(reactor_op_deadline* deadline);
+
+  // Complete the operation associated with an expired deadline, if it is still
+  // pending. The handler will be invoked with the timed_out error.
+  BOOST_ASIO_DECL void expire_deadline(reactor_op_deadline* deadline);
+#endif // defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+
   // Cancel any operations that are running against the descriptor and remove
   // its registration from the reactor. The reactor resources associated with
   // the descriptor must be released by calling cleanup_descriptor_data.
@@ -171,6 +202,12 @@ public:
       typename timer_queue<Time_Traits>::per_timer_data& timer,
       std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)());
 
+  // Cancel the timer operations associated with the given key.
+  template <typename Time_Traits>
+  void cancel_timer_by_key(timer_queue<Time_Traits>& queue,
+      typename timer_queue<Time_Traits>::per_timer_data* timer,
+      void* cancellation_key);
+
   // Move the timer operations associated with the given timer.
   template <typename Time_Traits>
   void move_timer(timer_queue<Time_Traits>& queue,
@@ -180,6 +217,20 @@ public:
   // Run epoll once until interrupted or events are ready to be dispatched.
   BOOST_ASIO_DECL void run(long usec, op_queue<operation>& ops);
 
+  // Counters describing how the reactor's timeout has been updated.
+  struct counters
+  {
+    // The number of times the timer descriptor was reprogrammed.
+    std::size_t timeout_updates;
+
+    // The number of times a new earliest timer did not require the timer
+    // descriptor to be reprogrammed.
+    std::size_t timeout_updates_avoided;
+  };
+
+  // Get the counters.
+  BOOST_ASIO_DECL counters get_counters();
+
   // Interrupt the select loop.
   BOOST_ASIO_DECL void interrupt();
 
@@ -194,12 +245,27 @@ private:
   // Create the timerfd file descriptor. Does not throw.
   BOOST_ASIO_DECL static int do_timerfd_create();
 
-  // Allocate a new descriptor state object.
-  BOOST_ASIO_DECL descriptor_state* allocate_descriptor_state();
+  // Allocate a new descriptor state object for the given descriptor.
+  BOOST_ASIO_DECL descriptor_state* allocate_descriptor_state(
+      socket_type descriptor);
 
   // Free an existing descriptor state object.
   BOOST_ASIO_DECL void free_descriptor_state(descriptor_state* s);
 
+  // Change the events registered for a descriptor. The descriptor's mutex
+  // must be held. Returns 0 on success, system error code on failure.
+  BOOST_ASIO_DECL int update_registration(socket_type descriptor,
+      descriptor_state* descriptor_data, uint32_t events);
+
+  // Add a registered descriptor to a newly created epoll descriptor.
+  BOOST_ASIO_DECL void reregister_descriptor(descriptor_state* state);
+
+  // Find the descriptor state identified by the data of an epoll event.
+  // Returns null if the event refers to a descriptor that has since been
+  // deregistered.
+  BOOST_ASIO_DECL descriptor_state* find_descriptor_state(
+      const epoll_data_t& data);
+
   // Helper function to add a new timer queue.
   BOOST_ASIO_DECL void do_add_timer_queue(timer_queue_base& queue);
 
@@ -209,6 +275,18 @@ private:
   // Called to recalculate and update the timeout.
   BOOST_ASIO_DECL void update_timeout();
 
+  // Called when a timer has been enqueued that must fire within the given
+  // number of microseconds. Updates the timeout only if the timer descriptor
+  // would otherwise fire too late.
+  BOOST_ASIO_DECL void update_timeout(long latest_usec, bool earliest);
+
+#if defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+  // Schedule the deadline of an operation that is being queued. The
+  // descriptor's mutex must be held.
+  BOOST_ASIO_DECL void schedule_deadline(reactor_op_deadline* deadline,
+      int op_type, socket_type descriptor, descriptor_state* descriptor_data);
+#endif // defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+
   // Get the timeout value for the epoll_wait call. The timeout value is
   // returned as a number of milliseconds. A return value of -1 indicates
   // that epoll_wait should block indefinitely.
@@ -218,8 +296,18 @@ private:
   // Get the timeout value for the timer descriptor. The return value is the
   // flag argument to be used when calling timerfd_settime.
   BOOST_ASIO_DECL int get_timeout(itimerspec& ts);
+
+  // Program the timer descriptor to fire when the earliest timer expires.
+  BOOST_ASIO_DECL void set_timer_fd();
+
+  // Get the current time of the clock used by the timer descriptor.
+  BOOST_ASIO_DECL static int64_t monotonic_usec();
 #endif // defined(BOOST_ASIO_HAS_TIMERFD)
 
+  // The longest time for which the reactor waits, to ensure that changes to
+  // the system clock are detected.
+  enum { max_timeout_usec = 5 * 60 * 1000 * 1000 };
+
   // The scheduler implementation used to post completions.
   scheduler& scheduler_;
 
@@ -235,18 +323,42 @@ private:
   // The timer file descriptor.
   int timer_fd_;
 
+  // The monotonic time, in microseconds, at which the timer descriptor is
+  // programmed to fire.
+  int64_t timer_fd_expiry_;
+
+  // Whether the timer descriptor may fire later than the earliest timer,
+  // within that timer's slack.
+  bool timer_fd_delayed_;
+
+  // The counters.
+  counters counters_;
+
   // The timer queues.
   timer_queue_set timer_queues_;
 
+#if defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+  // The queue of deadlines for pending operations.
+  reactor_op_deadline::queue_type deadline_queue_;
+#endif // defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+
   // Whether the service has been shut down.
   bool shutdown_;
 
   // Mutex to protect access to the registered descriptors.
   mutex registered_descriptors_mutex_;
 
-  // Keep track of all registered descriptors.
+  // Keep track of registered descriptors that are not in the table.
   object_pool<descriptor_state> registered_descriptors_;
 
+#if defined(BOOST_ASIO_HAS_DESCRIPTOR_TABLE)
+  // The states of registered descriptors, indexed by descriptor. A descriptor
+  // is held in the pool instead if its number is outside the table, or if its
+  // slot is still in use because the number was reused before the previous
+  // state was freed.
+  descriptor_table<descriptor_state, bool> descriptor_table_;
+#endif // defined(BOOST_ASIO_HAS_DESCRIPTOR_TABLE)
+
   // Helper class to do post-perform_io cleanup.
   struct perform_io_cleanup_on_block_exit;
   friend struct perform_io_cleanup_on_block_exit;
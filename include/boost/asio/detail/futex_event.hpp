@@ -0,0 +1,261 @@
+//
+// detail/futex_event.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_FUTEX_EVENT_HPP
+#define BOOST_ASIO_DETAIL_FUTEX_EVENT_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_FUTEX)
+
+#include <cstddef>
+#include <boost/asio/detail/assert.hpp>
+#include <boost/asio/detail/futex_ops.hpp>
+#include <boost/asio/detail/noncopyable.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// An event on which each waiting thread blocks on its own futex word. The
+// waiting threads are kept in a stack, so that signalling one waiter wakes
+// the thread that most recently became idle, rather than an arbitrary one. A
+// waiter spins briefly before blocking, and a waiter that is woken while
+// still spinning does not need a system call to wake it.
+//
+// The waiter stack is protected by the mutex associated with the lock that is
+// passed to each function, which must be unlockable and relockable.
+class futex_event
+  : private noncopyable
+{
+public:
+  // Constructor.
+  futex_event()
+    : state_(0),
+      waiters_(0)
+  {
+  }
+
+  // Destructor.
+  ~futex_event()
+  {
+  }
+
+  // Signal the event. (Retained for backward compatibility.)
+  template <typename Lock>
+  void signal(Lock& lock)
+  {
+    this->signal_all(lock);
+  }
+
+  // Signal all waiters.
+  template <typename Lock>
+  void signal_all(Lock& lock)
+  {
+    BOOST_ASIO_ASSERT(lock.locked());
+    (void)lock;
+    state_ |= 1;
+    while (waiter* w = pop_waiter())
+      if (release_waiter(w))
+        futex_ops::wake(w->state_, 1);
+  }
+
+  // Unlock the mutex and signal one waiter.
+  template <typename Lock>
+  void unlock_and_signal_one(Lock& lock)
+  {
+    BOOST_ASIO_ASSERT(lock.locked());
+    state_ |= 1;
+    waiter* w = pop_waiter();
+    bool blocked = w && release_waiter(w);
+    lock.unlock();
+    if (blocked)
+      futex_ops::wake(w->state_, 1);
+  }
+
+  // Unlock the mutex and signal one waiter who may destroy us.
+  template <typename Lock>
+  void unlock_and_signal_one_for_destruction(Lock& lock)
+  {
+    BOOST_ASIO_ASSERT(lock.locked());
+    state_ |= 1;
+    waiter* w = pop_waiter();
+    if (w && release_waiter(w))
+      futex_ops::wake(w->state_, 1);
+    lock.unlock();
+  }
+
+  // If there's a waiter, unlock the mutex and signal it.
+  template <typename Lock>
+  bool maybe_unlock_and_signal_one(Lock& lock)
+  {
+    BOOST_ASIO_ASSERT(lock.locked());
+    state_ |= 1;
+    if (state_ > 1)
+    {
+      // A waiter that has already been released, but has not yet reacquired
+      // the lock, will observe the new state without being woken again.
+      waiter* w = pop_waiter();
+      bool blocked = w && release_waiter(w);
+      lock.unlock();
+      if (blocked)
+        futex_ops::wake(w->state_, 1);
+      return true;
+    }
+    return false;
+  }
+
+  // Reset the event.
+  template <typename Lock>
+  void clear(Lock& lock)
+  {
+    BOOST_ASIO_ASSERT(lock.locked());
+    (void)lock;
+    state_ &= ~std::size_t(1);
+  }
+
+  // Wait for the event to become signalled.
+  template <typename Lock>
+  void wait(Lock& lock)
+  {
+    BOOST_ASIO_ASSERT(lock.locked());
+    while ((state_ & 1) == 0)
+    {
+      waiter w;
+      push_waiter(&w);
+      state_ += 2;
+      lock.unlock();
+      block(w, 0);
+      lock.lock();
+      state_ -= 2;
+    }
+  }
+
+  // Timed wait for the event to become signalled.
+  template <typename Lock>
+  bool wait_for_usec(Lock& lock, long usec)
+  {
+    BOOST_ASIO_ASSERT(lock.locked());
+    if ((state_ & 1) == 0)
+    {
+      waiter w;
+      push_waiter(&w);
+      state_ += 2;
+      lock.unlock();
+      timespec ts;
+      ts.tv_sec = usec / 1000000;
+      ts.tv_nsec = (usec % 1000000) * 1000;
+      block(w, &ts);
+      lock.lock();
+      state_ -= 2;
+
+      // The waiter is still on the stack if it timed out.
+      if (w.state_.load(std::memory_order_relaxed) != released)
+        remove_waiter(&w);
+    }
+    return (state_ & 1) != 0;
+  }
+
+private:
+  // The values of a waiter's futex word.
+  enum { spinning = 0, released = 1, blocked = 2 };
+
+  // A waiting thread, which lives on that thread's stack.
+  struct waiter
+  {
+    waiter()
+      : state_(spinning),
+        next_(0)
+    {
+    }
+
+    futex_ops::word_type state_;
+    waiter* next_;
+  };
+
+  void push_waiter(waiter* w)
+  {
+    w->next_ = waiters_;
+    waiters_ = w;
+  }
+
+  waiter* pop_waiter()
+  {
+    waiter* w = waiters_;
+    if (w)
+      waiters_ = w->next_;
+    return w;
+  }
+
+  void remove_waiter(waiter* w)
+  {
+    for (waiter** p = &waiters_; *p; p = &(*p)->next_)
+    {
+      if (*p == w)
+      {
+        *p = w->next_;
+        return;
+      }
+    }
+  }
+
+  // Release a waiter that has been removed from the stack. Returns true if
+  // the waiter is blocked in the kernel and must be woken. The waiter may
+  // return as soon as it observes the new state, in which case the wake is
+  // harmless as futex waits are permitted to return spuriously.
+  static bool release_waiter(waiter* w)
+  {
+    return w->state_.exchange(released, std::memory_order_release) == blocked;
+  }
+
+  // Spin and then block until released, or until the timeout elapses.
+  static void block(waiter& w, const timespec* timeout)
+  {
+    for (int i = futex_ops::spin_count(); i > 0; --i)
+    {
+      if (w.state_.load(std::memory_order_acquire) == released)
+        return;
+      futex_ops::relax();
+    }
+
+    uint32_t value = spinning;
+    if (!w.state_.compare_exchange_strong(value, blocked,
+          std::memory_order_acquire, std::memory_order_acquire))
+      return;
+
+    if (timeout)
+    {
+      futex_ops::wait(w.state_, blocked, timeout);
+      return;
+    }
+
+    while (w.state_.load(std::memory_order_acquire) == blocked)
+      futex_ops::wait(w.state_, blocked);
+  }
+
+  std::size_t state_;
+  waiter* waiters_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_FUTEX)
+
+#endif // BOOST_ASIO_DETAIL_FUTEX_EVENT_HPP
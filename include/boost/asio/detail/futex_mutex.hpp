@@ -0,0 +1,92 @@
+//
+// detail/futex_mutex.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_FUTEX_MUTEX_HPP
+#define BOOST_ASIO_DETAIL_FUTEX_MUTEX_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_FUTEX)
+
+#include <boost/asio/detail/futex_ops.hpp>
+#include <boost/asio/detail/noncopyable.hpp>
+#include <boost/asio/detail/scoped_lock.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// An adaptive mutex that spins briefly while the lock is held by another
+// thread, and then blocks on a futex. The state word is 0 when unlocked, 1
+// when locked, and 2 when locked and there may be blocked threads.
+class futex_mutex
+  : private noncopyable
+{
+public:
+  typedef boost::asio::detail::scoped_lock<futex_mutex> scoped_lock;
+
+  // Constructor.
+  futex_mutex()
+    : state_(0)
+  {
+  }
+
+  // Destructor.
+  ~futex_mutex()
+  {
+  }
+
+  // Lock the mutex.
+  void lock()
+  {
+    uint32_t value = 0;
+    if (state_.compare_exchange_strong(value, 1,
+          std::memory_order_acquire, std::memory_order_relaxed))
+      return;
+
+    for (int i = futex_ops::spin_count(); i > 0 && value != 2; --i)
+    {
+      futex_ops::relax();
+      value = state_.load(std::memory_order_relaxed);
+      if (value == 0 && state_.compare_exchange_weak(value, 1,
+            std::memory_order_acquire, std::memory_order_relaxed))
+        return;
+    }
+
+    while (state_.exchange(2, std::memory_order_acquire) != 0)
+      futex_ops::wait(state_, 2);
+  }
+
+  // Unlock the mutex.
+  void unlock()
+  {
+    if (state_.exchange(0, std::memory_order_release) == 2)
+      futex_ops::wake(state_, 1);
+  }
+
+private:
+  futex_ops::word_type state_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_FUTEX)
+
+#endif // BOOST_ASIO_DETAIL_FUTEX_MUTEX_HPP
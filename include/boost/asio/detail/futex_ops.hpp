@@ -0,0 +1,89 @@
+//
+// detail/futex_ops.hpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_FUTEX_OPS_HPP
+#define BOOST_ASIO_DETAIL_FUTEX_OPS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_FUTEX)
+
+#include <atomic>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <boost/asio/detail/cstdint.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+// The number of times that a thread polls a futex word before it blocks in
+// the kernel. Spinning is disabled on machines with a single processor.
+#if !defined(BOOST_ASIO_FUTEX_SPIN_COUNT)
+# define BOOST_ASIO_FUTEX_SPIN_COUNT 100
+#endif // !defined(BOOST_ASIO_FUTEX_SPIN_COUNT)
+
+namespace boost {
+namespace asio {
+namespace detail {
+namespace futex_ops {
+
+typedef std::atomic<uint32_t> word_type;
+
+// Block while the word holds the expected value, or until the relative
+// timeout, if any, elapses. May return spuriously.
+inline void wait(word_type& word, uint32_t expected,
+    const timespec* timeout = 0)
+{
+  ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word),
+      FUTEX_WAIT_PRIVATE, expected, timeout, 0, 0);
+}
+
+// Wake up to the specified number of threads blocked on the word.
+inline void wake(word_type& word, int count)
+{
+  ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word),
+      FUTEX_WAKE_PRIVATE, count, 0, 0, 0);
+}
+
+// Hint to the processor that the calling thread is spinning.
+inline void relax()
+{
+#if defined(__i386__) || defined(__x86_64__)
+  __asm__ __volatile__ ("pause" ::: "memory");
+#elif defined(__aarch64__)
+  __asm__ __volatile__ ("yield" ::: "memory");
+#else
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+// The number of times to poll before blocking.
+inline int spin_count()
+{
+  static const int count =
+    ::sysconf(_SC_NPROCESSORS_ONLN) > 1 ? BOOST_ASIO_FUTEX_SPIN_COUNT : 0;
+  return count;
+}
+
+} // namespace futex_ops
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_FUTEX)
+
+#endif // BOOST_ASIO_DETAIL_FUTEX_OPS_HPP
@@ -44,6 +44,10 @@ dev_poll_reactor::dev_poll_reactor(boost::asio::execution_context& ctx)
   ev.events = POLLIN | POLLERR;
   ev.revents = 0;
   ::write(dev_poll_fd_, &ev, sizeof(ev));
+
+#if defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+  timer_queues_.insert(&deadline_queue_);
+#endif // defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
 }
 
 dev_poll_reactor::~dev_poll_reactor()
@@ -169,13 +173,25 @@ void dev_poll_reactor::start_op(int op_type, socket_type descriptor,
         if (op->perform())
         {
           lock.unlock();
-          scheduler_.post_immediate_completion(op, is_continuation);
+          scheduler_.dispatch_immediate_completion(op, is_continuation);
           return;
         }
       }
     }
   }
 
+#if defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+  if (reactor_op_deadline* deadline = op->deadline_)
+  {
+    bool earliest = deadline_queue_.enqueue_timer(
+        deadline->expiry_, deadline->timer_, deadline);
+    deadline->scheduled(this, descriptor, 0, op_type);
+    scheduler_.work_started();
+    if (earliest)
+      interrupter_.interrupt();
+  }
+#endif // defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+
   bool first = op_queue_[op_type].enqueue_operation(descriptor, op);
   scheduler_.work_started();
   if (first)
@@ -202,6 +218,41 @@ void dev_poll_reactor::cancel_ops(socket_type descriptor,
   cancel_ops_unlocked(descriptor, boost::asio::error::operation_aborted);
 }
 
+void dev_poll_reactor::cancel_ops_by_key(socket_type descriptor,
+    dev_poll_reactor::per_descriptor_data&,
+    int op_type, void* cancellation_key)
+{
+  boost::asio::detail::mutex::scoped_lock lock(mutex_);
+  op_queue<operation> ops;
+  bool need_interrupt = op_queue_[op_type].cancel_operations_by_key(
+      descriptor, ops, cancellation_key, boost::asio::error::operation_aborted);
+  scheduler_.post_deferred_completions(ops);
+  if (need_interrupt)
+    interrupter_.interrupt();
+}
+
+#if defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+void dev_poll_reactor::cancel_deadline(reactor_op_deadline* deadline)
+{
+  boost::asio::detail::mutex::scoped_lock lock(mutex_);
+  op_queue<operation> ops;
+  deadline_queue_.cancel_timer(deadline->timer_, ops);
+  lock.unlock();
+  scheduler_.post_deferred_completions(ops);
+}
+
+void dev_poll_reactor::expire_deadline(reactor_op_deadline* deadline)
+{
+  boost::asio::detail::mutex::scoped_lock lock(mutex_);
+  op_queue<operation> ops;
+  bool need_interrupt = op_queue_[deadline->op_type_].expire_operation(
+      deadline->descriptor_, ops, deadline);
+  scheduler_.post_deferred_completions(ops);
+  if (need_interrupt)
+    interrupter_.interrupt();
+}
+#endif // defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+
 void dev_poll_reactor::deregister_descriptor(socket_type descriptor,
     dev_poll_reactor::per_descriptor_data&, bool)
 {
@@ -0,0 +1,671 @@
+//
+// detail/impl/dfa_table.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IMPL_DFA_TABLE_IPP
+#define BOOST_ASIO_DETAIL_IMPL_DFA_TABLE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <algorithm>
+#include <bitset>
+#include <map>
+#include <vector>
+#include <boost/asio/detail/dfa_table.hpp>
+#include <boost/asio/error.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// Compiles a pattern into a dfa_table. The pattern is first parsed into a
+// syntax tree, which is converted into a Thompson NFA. The NFA is then turned
+// into a DFA using the subset construction, with the NFA's start state added
+// to every subset so that a match may begin at any position.
+class dfa_compiler
+{
+public:
+  dfa_compiler(const char* pattern, std::size_t length)
+    : pattern_(pattern),
+      length_(length),
+      position_(0),
+      error_(false)
+  {
+  }
+
+  void compile(dfa_table& table, boost::system::error_code& ec)
+  {
+    std::size_t root = parse_alternation(0);
+    if (!error_ && position_ != length_)
+      error_ = true;
+
+    std::size_t match = add_state(nfa_state::match, std::bitset<256>(), 0);
+    std::size_t start = build(root, match);
+
+    if (!error_)
+      build_byte_classes(table);
+
+    if (!error_)
+      build_transitions(table, start);
+
+    ec = error_
+      ? boost::system::error_code(boost::asio::error::invalid_argument)
+      : boost::system::error_code();
+  }
+
+private:
+  // Limits that bound the work done for pathological patterns.
+  enum
+  {
+    max_nesting = 64,
+    max_repeat = 1000,
+    max_nfa_states = 65536
+  };
+
+  // A node in the syntax tree.
+  struct node
+  {
+    enum kind_type { empty, bytes, concat, alternate, repeat } kind;
+    std::bitset<256> set;
+    std::vector<std::size_t> children;
+    std::size_t min;
+    std::size_t max;
+  };
+
+  // A state in the NFA.
+  struct nfa_state
+  {
+    enum kind_type { bytes, split, match } kind;
+    std::bitset<256> set;
+    std::size_t out;
+    std::size_t out1;
+  };
+
+  static std::size_t unbounded()
+  {
+    return static_cast<std::size_t>(-1);
+  }
+
+  std::size_t add_node(node::kind_type kind)
+  {
+    node n;
+    n.kind = kind;
+    n.min = 0;
+    n.max = 0;
+    nodes_.push_back(n);
+    return nodes_.size() - 1;
+  }
+
+  std::size_t add_bytes(const std::bitset<256>& set)
+  {
+    std::size_t n = add_node(node::bytes);
+    nodes_[n].set = set;
+    return n;
+  }
+
+  bool at_end() const
+  {
+    return position_ == length_;
+  }
+
+  char peek() const
+  {
+    return pattern_[position_];
+  }
+
+  std::size_t fail()
+  {
+    error_ = true;
+    position_ = length_;
+    return add_node(node::empty);
+  }
+
+  // alternation := concatenation ('|' concatenation)*
+  std::size_t parse_alternation(std::size_t depth)
+  {
+    if (depth > max_nesting)
+      return fail();
+
+    std::size_t first = parse_concatenation(depth);
+    if (at_end() || peek() != '|')
+      return first;
+
+    std::size_t n = add_node(node::alternate);
+    nodes_[n].children.push_back(first);
+    while (!at_end() && peek() == '|')
+    {
+      ++position_;
+      std::size_t child = parse_concatenation(depth);
+      nodes_[n].children.push_back(child);
+    }
+    return n;
+  }
+
+  // concatenation := repetition*
+  std::size_t parse_concatenation(std::size_t depth)
+  {
+    std::vector<std::size_t> children;
+    while (!at_end() && peek() != '|' && peek() != ')')
+      children.push_back(parse_repetition(depth));
+
+    if (children.empty())
+      return add_node(node::empty);
+    if (children.size() == 1)
+      return children[0];
+
+    std::size_t n = add_node(node::concat);
+    nodes_[n].children.swap(children);
+    return n;
+  }
+
+  // repetition := atom ('*' | '+' | '?' | '{' m [',' [n]] '}')*
+  std::size_t parse_repetition(std::size_t depth)
+  {
+    std::size_t atom = parse_atom(depth);
+    while (!at_end())
+    {
+      std::size_t min = 0, max = unbounded();
+      switch (peek())
+      {
+      case '*':
+        ++position_;
+        break;
+      case '+':
+        ++position_;
+        min = 1;
+        break;
+      case '?':
+        ++position_;
+        max = 1;
+        break;
+      case '{':
+        ++position_;
+        if (!parse_number(min))
+          return fail();
+        max = min;
+        if (!at_end() && peek() == ',')
+        {
+          ++position_;
+          max = unbounded();
+          if (!at_end() && peek() != '}' && !parse_number(max))
+            return fail();
+        }
+        if (at_end() || peek() != '}' || max < min)
+          return fail();
+        ++position_;
+        break;
+      default:
+        return atom;
+      }
+
+      std::size_t n = add_node(node::repeat);
+      nodes_[n].children.push_back(atom);
+      nodes_[n].min = min;
+      nodes_[n].max = max;
+      atom = n;
+    }
+    return atom;
+  }
+
+  bool parse_number(std::size_t& value)
+  {
+    if (at_end() || peek() < '0' || peek() > '9')
+      return false;
+    value = 0;
+    while (!at_end() && peek() >= '0' && peek() <= '9')
+    {
+      value = value * 10 + (peek() - '0');
+      if (value > max_repeat)
+        return false;
+      ++position_;
+    }
+    return true;
+  }
+
+  // atom := '(' ['?:'] alternation ')' | '[' class ']' | '.' | escape | char
+  std::size_t parse_atom(std::size_t depth)
+  {
+    char c = peek();
+    ++position_;
+    switch (c)
+    {
+    case '(':
+      {
+        if (length_ - position_ >= 2
+            && pattern_[position_] == '?' && pattern_[position_ + 1] == ':')
+          position_ += 2;
+        std::size_t n = parse_alternation(depth + 1);
+        if (at_end() || peek() != ')')
+          return fail();
+        ++position_;
+        return n;
+      }
+    case '[':
+      return parse_class();
+    case '.':
+      {
+        std::bitset<256> set;
+        set.set();
+        set.reset('\n');
+        return add_bytes(set);
+      }
+    case '\\':
+      {
+        std::bitset<256> set;
+        if (!parse_escape(set))
+          return fail();
+        return add_bytes(set);
+      }
+    case ')': case '*': case '+': case '?': case '{': case '^': case '$':
+      return fail();
+    default:
+      {
+        std::bitset<256> set;
+        set.set(static_cast<unsigned char>(c));
+        return add_bytes(set);
+      }
+    }
+  }
+
+  static void set_range(std::bitset<256>& set, int first, int last)
+  {
+    for (int i = first; i <= last; ++i)
+      set.set(i);
+  }
+
+  static int hex_value(char c)
+  {
+    if (c >= '0' && c <= '9')
+      return c - '0';
+    if (c >= 'a' && c <= 'f')
+      return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+      return c - 'A' + 10;
+    return -1;
+  }
+
+  // Parse the escape sequence following a backslash. Returns false if the
+  // sequence is not supported.
+  bool parse_escape(std::bitset<256>& set)
+  {
+    if (at_end())
+      return false;
+
+    char c = peek();
+    ++position_;
+    bool negate = false;
+    switch (c)
+    {
+    case 'D':
+      negate = true;
+      // Fall through.
+    case 'd':
+      set_range(set, '0', '9');
+      break;
+    case 'W':
+      negate = true;
+      // Fall through.
+    case 'w':
+      set_range(set, 'a', 'z');
+      set_range(set, 'A', 'Z');
+      set_range(set, '0', '9');
+      set.set('_');
+      break;
+    case 'S':
+      negate = true;
+      // Fall through.
+    case 's':
+      set.set(' ');
+      set_range(set, '\t', '\r');
+      break;
+    case 'n': set.set('\n'); break;
+    case 'r': set.set('\r'); break;
+    case 't': set.set('\t'); break;
+    case 'f': set.set('\f'); break;
+    case 'v': set.set('\v'); break;
+    case '0': set.set(0); break;
+    case 'x':
+      {
+        if (length_ - position_ < 2)
+          return false;
+        int high = hex_value(pattern_[position_]);
+        int low = hex_value(pattern_[position_ + 1]);
+        if (high < 0 || low < 0)
+          return false;
+        position_ += 2;
+        set.set(high * 16 + low);
+        break;
+      }
+    default:
+      if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')
+          || (c >= '0' && c <= '9'))
+        return false;
+      set.set(static_cast<unsigned char>(c));
+      break;
+    }
+
+    if (negate)
+      set.flip();
+    return true;
+  }
+
+  // class := ['^'] (item | item '-' item)+ ']'
+  std::size_t parse_class()
+  {
+    std::bitset<256> set;
+    bool negate = false;
+    if (!at_end() && peek() == '^')
+    {
+      negate = true;
+      ++position_;
+    }
+
+    bool first = true;
+    for (;;)
+    {
+      if (at_end())
+        return fail();
+
+      char c = peek();
+      ++position_;
+      if (c == ']' && !first)
+        break;
+      first = false;
+
+      std::bitset<256> item;
+      if (c == '\\')
+      {
+        if (!parse_escape(item))
+          return fail();
+      }
+      else
+        item.set(static_cast<unsigned char>(c));
+
+      if (length_ - position_ >= 2 && peek() == '-'
+          && pattern_[position_ + 1] != ']')
+      {
+        // Ranges are only permitted between single characters.
+        ++position_;
+        std::bitset<256> last_item;
+        char last = peek();
+        ++position_;
+        if (last == '\\')
+        {
+          if (!parse_escape(last_item))
+            return fail();
+        }
+        else
+          last_item.set(static_cast<unsigned char>(last));
+        if (item.count() != 1 || last_item.count() != 1)
+          return fail();
+
+        int low = 0, high = 0;
+        for (int i = 0; i < 256; ++i)
+        {
+          if (item.test(i))
+            low = i;
+          if (last_item.test(i))
+            high = i;
+        }
+        if (low > high)
+          return fail();
+        set_range(item, low, high);
+      }
+
+      set |= item;
+    }
+
+    if (negate)
+      set.flip();
+    return add_bytes(set);
+  }
+
+  std::size_t add_state(nfa_state::kind_type kind,
+      const std::bitset<256>& set, std::size_t out, std::size_t out1 = 0)
+  {
+    if (states_.size() >= max_nfa_states)
+    {
+      error_ = true;
+      return out;
+    }
+
+    nfa_state s;
+    s.kind = kind;
+    s.set = set;
+    s.out = out;
+    s.out1 = out1;
+    states_.push_back(s);
+    return states_.size() - 1;
+  }
+
+  // Build the NFA fragment for a node, where the fragment continues with the
+  // state next. Returns the fragment's entry state.
+  std::size_t build(std::size_t n, std::size_t next)
+  {
+    if (error_)
+      return next;
+
+    switch (nodes_[n].kind)
+    {
+    case node::bytes:
+      return add_state(nfa_state::bytes, nodes_[n].set, next);
+    case node::concat:
+      for (std::size_t i = nodes_[n].children.size(); i > 0; --i)
+        next = build(nodes_[n].children[i - 1], next);
+      return next;
+    case node::alternate:
+      {
+        std::size_t entry = build(nodes_[n].children.back(), next);
+        for (std::size_t i = nodes_[n].children.size() - 1; i > 0; --i)
+        {
+          std::size_t branch = build(nodes_[n].children[i - 1], next);
+          entry = add_state(nfa_state::split, std::bitset<256>(), branch, entry);
+        }
+        return entry;
+      }
+    case node::repeat:
+      {
+        std::size_t child = nodes_[n].children[0];
+        std::size_t entry = next;
+        if (nodes_[n].max == unbounded())
+        {
+          std::size_t loop = add_state(nfa_state::split,
+              std::bitset<256>(), next, next);
+          std::size_t body = build(child, loop);
+          if (!error_)
+            states_[loop].out = body;
+          entry = loop;
+        }
+        else
+        {
+          for (std::size_t i = nodes_[n].min; i < nodes_[n].max; ++i)
+          {
+            std::size_t body = build(child, entry);
+            entry = add_state(nfa_state::split,
+                std::bitset<256>(), body, next);
+          }
+        }
+        for (std::size_t i = 0; i < nodes_[n].min; ++i)
+          entry = build(child, entry);
+        return entry;
+      }
+    case node::empty:
+    default:
+      return next;
+    }
+  }
+
+  // Partition the byte values into classes that no NFA state distinguishes.
+  void build_byte_classes(dfa_table& table)
+  {
+    std::map<std::vector<bool>, std::size_t> classes;
+    for (std::size_t c = 0; c < 256; ++c)
+    {
+      std::vector<bool> signature;
+      for (std::size_t s = 0; s < states_.size(); ++s)
+        if (states_[s].kind == nfa_state::bytes)
+          signature.push_back(states_[s].set.test(c));
+
+      std::map<std::vector<bool>, std::size_t>::iterator iter
+        = classes.find(signature);
+      if (iter == classes.end())
+      {
+        iter = classes.insert(std::make_pair(
+              signature, classes.size())).first;
+        representatives_.push_back(c);
+      }
+      table.byte_classes_[c] = static_cast<unsigned char>(iter->second);
+    }
+    table.class_count_ = classes.size();
+  }
+
+  // Add the epsilon closure of an NFA state to a subset.
+  void add_closure(std::size_t state, std::vector<std::size_t>& subset,
+      bool& accepting)
+  {
+    std::vector<std::size_t> stack(1, state);
+    while (!stack.empty())
+    {
+      std::size_t s = stack.back();
+      stack.pop_back();
+      if (marks_[s] == mark_)
+        continue;
+      marks_[s] = mark_;
+
+      switch (states_[s].kind)
+      {
+      case nfa_state::bytes:
+        subset.push_back(s);
+        break;
+      case nfa_state::split:
+        stack.push_back(states_[s].out1);
+        stack.push_back(states_[s].out);
+        break;
+      case nfa_state::match:
+      default:
+        accepting = true;
+        break;
+      }
+    }
+  }
+
+  // Run the subset construction.
+  void build_transitions(dfa_table& table, std::size_t start)
+  {
+    const std::size_t match_marker = static_cast<std::size_t>(-1);
+    const std::size_t class_count = table.class_count_;
+
+    marks_.assign(states_.size(), 0);
+    mark_ = 1;
+
+    std::vector<std::vector<std::size_t> > subsets(1);
+    bool accepting = false;
+    add_closure(start, subsets[0], accepting);
+    std::sort(subsets[0].begin(), subsets[0].end());
+
+    if (accepting)
+    {
+      table.matches_empty_ = true;
+      table.match_state_ = 1;
+      table.transitions_.assign(class_count, 1);
+      return;
+    }
+
+    std::map<std::vector<std::size_t>, std::size_t> index;
+    index.insert(std::make_pair(subsets[0], 0));
+
+    std::vector<std::size_t> transitions;
+    for (std::size_t i = 0; i < subsets.size(); ++i)
+    {
+      for (std::size_t c = 0; c < class_count; ++c)
+      {
+        std::vector<std::size_t> subset;
+        accepting = false;
+        ++mark_;
+
+        std::size_t byte = representatives_[c];
+        for (std::size_t j = 0; j < subsets[i].size(); ++j)
+        {
+          const nfa_state& s = states_[subsets[i][j]];
+          if (s.set.test(byte))
+            add_closure(s.out, subset, accepting);
+        }
+
+        if (accepting)
+        {
+          transitions.push_back(match_marker);
+          continue;
+        }
+
+        add_closure(start, subset, accepting);
+        std::sort(subset.begin(), subset.end());
+
+        std::map<std::vector<std::size_t>, std::size_t>::iterator iter
+          = index.find(subset);
+        if (iter == index.end())
+        {
+          if (subsets.size() >= dfa_table::max_states - 1)
+          {
+            error_ = true;
+            return;
+          }
+          iter = index.insert(std::make_pair(subset, subsets.size())).first;
+          subsets.push_back(subset);
+        }
+        transitions.push_back(iter->second);
+      }
+    }
+
+    table.match_state_ = static_cast<dfa_table::state_type>(subsets.size());
+    table.transitions_.resize(transitions.size());
+    for (std::size_t i = 0; i < transitions.size(); ++i)
+    {
+      table.transitions_[i] = static_cast<dfa_table::state_type>(
+          transitions[i] == match_marker
+            ? table.match_state_ : transitions[i]);
+    }
+  }
+
+  const char* pattern_;
+  std::size_t length_;
+  std::size_t position_;
+  bool error_;
+  std::vector<node> nodes_;
+  std::vector<nfa_state> states_;
+  std::vector<std::size_t> representatives_;
+  std::vector<std::size_t> marks_;
+  std::size_t mark_;
+};
+
+dfa_table::dfa_table(const char* pattern,
+    std::size_t length, boost::system::error_code& ec)
+  : class_count_(1),
+    match_state_(1),
+    matches_empty_(false)
+{
+  for (std::size_t i = 0; i < 256; ++i)
+    byte_classes_[i] = 0;
+  transitions_.assign(1, 0);
+
+  dfa_compiler compiler(pattern, length);
+  compiler.compile(*this, ec);
+}
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_IMPL_DFA_TABLE_IPP
@@ -50,8 +50,9 @@ void epoll_reactor::schedule_timer(timer_queue<Time_Traits>& queue,
 
   bool earliest = queue.enqueue_timer(time, timer, op);
   scheduler_.work_started();
-  if (earliest)
-    update_timeout();
+  if (earliest || timer_fd_delayed_)
+    update_timeout(queue.latest_wait_duration_usec(
+          timer, max_timeout_usec), earliest);
 }
 
 template <typename Time_Traits>
@@ -67,6 +68,18 @@ std::size_t epoll_reactor::cancel_timer(timer_queue<Time_Traits>& queue,
   return n;
 }
 
+template <typename Time_Traits>
+void epoll_reactor::cancel_timer_by_key(timer_queue<Time_Traits>& queue,
+    typename timer_queue<Time_Traits>::per_timer_data* timer,
+    void* cancellation_key)
+{
+  mutex::scoped_lock lock(mutex_);
+  op_queue<operation> ops;
+  queue.cancel_timer_by_key(timer, ops, cancellation_key);
+  lock.unlock();
+  scheduler_.post_deferred_completions(ops);
+}
+
 template <typename Time_Traits>
 void epoll_reactor::move_timer(timer_queue<Time_Traits>& queue,
     typename timer_queue<Time_Traits>::per_timer_data& target,
@@ -26,6 +26,7 @@
 #include <boost/asio/error.hpp>
 
 #if defined(BOOST_ASIO_HAS_TIMERFD)
+# include <ctime>
 # include <sys/timerfd.h>
 #endif // defined(BOOST_ASIO_HAS_TIMERFD)
 
@@ -43,8 +44,15 @@ epoll_reactor::epoll_reactor(boost::asio::execution_context& ctx)
     interrupter_(),
     epoll_fd_(do_epoll_create()),
     timer_fd_(do_timerfd_create()),
+    timer_fd_expiry_((std::numeric_limits<int64_t>::max)()),
+    timer_fd_delayed_(false),
+    counters_(),
     shutdown_(false),
     registered_descriptors_mutex_(mutex_.enabled())
+#if defined(BOOST_ASIO_HAS_DESCRIPTOR_TABLE)
+    , descriptor_table_(BOOST_ASIO_CONCURRENCY_HINT_IS_LOCKING(
+          REACTOR_IO, scheduler_.concurrency_hint()))
+#endif // defined(BOOST_ASIO_HAS_DESCRIPTOR_TABLE)
 {
   // Add the interrupter's descriptor to epoll.
   epoll_event ev = { 0, { 0 } };
@@ -60,6 +68,10 @@ epoll_reactor::epoll_reactor(boost::asio::execution_context& ctx)
     ev.data.ptr = &timer_fd_;
     epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, timer_fd_, &ev);
   }
+
+#if defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+  timer_queues_.insert(&deadline_queue_);
+#endif // defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
 }
 
 epoll_reactor::~epoll_reactor()
@@ -86,6 +98,17 @@ void epoll_reactor::shutdown()
     registered_descriptors_.free(state);
   }
 
+#if defined(BOOST_ASIO_HAS_DESCRIPTOR_TABLE)
+  for (int descriptor = 0; descriptor_state* state =
+      descriptor_table_.next_claimed(descriptor); ++descriptor)
+  {
+    for (int i = 0; i < max_ops; ++i)
+      ops.push(state->op_queue_[i]);
+    state->shutdown_ = true;
+    descriptor_table_.release(descriptor);
+  }
+#endif // defined(BOOST_ASIO_HAS_DESCRIPTOR_TABLE)
+
   timer_queues_.get_all_timers(ops);
 
   scheduler_.abandon_operations(ops);
@@ -105,6 +128,7 @@ void epoll_reactor::notify_fork(
       ::close(timer_fd_);
     timer_fd_ = -1;
     timer_fd_ = do_timerfd_create();
+    timer_fd_expiry_ = (std::numeric_limits<int64_t>::max)();
 
     interrupter_.recreate();
 
@@ -130,16 +154,61 @@ void epoll_reactor::notify_fork(
     for (descriptor_state* state = registered_descriptors_.first();
         state != 0; state = state->next_)
     {
-      ev.events = state->registered_events_;
-      ev.data.ptr = state;
-      int result = epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, state->descriptor_, &ev);
-      if (result != 0)
-      {
-        boost::system::error_code ec(errno,
-            boost::asio::error::get_system_category());
-        boost::asio::detail::throw_error(ec, "epoll re-registration");
-      }
+      reregister_descriptor(state);
     }
+
+#if defined(BOOST_ASIO_HAS_DESCRIPTOR_TABLE)
+    for (int descriptor = 0; descriptor_state* state =
+        descriptor_table_.next_claimed(descriptor); ++descriptor)
+    {
+      reregister_descriptor(state);
+    }
+#endif // defined(BOOST_ASIO_HAS_DESCRIPTOR_TABLE)
+  }
+}
+
+int epoll_reactor::update_registration(socket_type descriptor,
+    descriptor_state* descriptor_data, uint32_t events)
+{
+  epoll_event ev = { 0, { 0 } };
+  ev.events = events;
+  ev.data = descriptor_data->event_data_;
+
+#if defined(EPOLLEXCLUSIVE)
+  // An exclusive registration cannot be modified, only replaced. As with a
+  // modification, adding the descriptor again reports any existing readiness.
+  if (((descriptor_data->registered_events_ | events) & EPOLLEXCLUSIVE) != 0)
+  {
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, descriptor, &ev);
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, descriptor, &ev) != 0)
+    {
+      int error = errno;
+      ev.events = descriptor_data->registered_events_;
+      epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, descriptor, &ev);
+      return error;
+    }
+    descriptor_data->registered_events_ = events;
+    return 0;
+  }
+#endif // defined(EPOLLEXCLUSIVE)
+
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, descriptor, &ev) != 0)
+    return errno;
+  descriptor_data->registered_events_ = events;
+  return 0;
+}
+
+void epoll_reactor::reregister_descriptor(descriptor_state* state)
+{
+  epoll_event ev = { 0, { 0 } };
+  ev.events = state->registered_events_;
+  ev.data = state->event_data_;
+  int result = epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, state->descriptor_, &ev);
+  if (result != 0)
+  {
+    boost::system::error_code ec(errno,
+        boost::asio::error::get_system_category());
+    boost::asio::detail::throw_error(ec, "epoll re-registration");
   }
 }
 
@@ -151,7 +220,7 @@ void epoll_reactor::init_task()
 int epoll_reactor::register_descriptor(socket_type descriptor,
     epoll_reactor::per_descriptor_data& descriptor_data)
 {
-  descriptor_data = allocate_descriptor_state();
+  descriptor_data = allocate_descriptor_state(descriptor);
 
   BOOST_ASIO_HANDLER_REACTOR_REGISTRATION((
         context(), static_cast<uintmax_t>(descriptor),
@@ -170,7 +239,7 @@ int epoll_reactor::register_descriptor(socket_type descriptor,
   epoll_event ev = { 0, { 0 } };
   ev.events = EPOLLIN | EPOLLERR | EPOLLHUP | EPOLLPRI | EPOLLET;
   descriptor_data->registered_events_ = ev.events;
-  ev.data.ptr = descriptor_data;
+  ev.data = descriptor_data->event_data_;
   int result = epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, descriptor, &ev);
   if (result != 0)
   {
@@ -193,7 +262,7 @@ int epoll_reactor::register_internal_descriptor(
     int op_type, socket_type descriptor,
     epoll_reactor::per_descriptor_data& descriptor_data, reactor_op* op)
 {
-  descriptor_data = allocate_descriptor_state();
+  descriptor_data = allocate_descriptor_state(descriptor);
 
   BOOST_ASIO_HANDLER_REACTOR_REGISTRATION((
         context(), static_cast<uintmax_t>(descriptor),
@@ -213,7 +282,7 @@ int epoll_reactor::register_internal_descriptor(
   epoll_event ev = { 0, { 0 } };
   ev.events = EPOLLIN | EPOLLERR | EPOLLHUP | EPOLLPRI | EPOLLET;
   descriptor_data->registered_events_ = ev.events;
-  ev.data.ptr = descriptor_data;
+  ev.data = descriptor_data->event_data_;
   int result = epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, descriptor, &ev);
   if (result != 0)
     return errno;
@@ -221,6 +290,39 @@ int epoll_reactor::register_internal_descriptor(
   return 0;
 }
 
+int epoll_reactor::set_exclusive_wake(socket_type descriptor,
+    epoll_reactor::per_descriptor_data& descriptor_data, bool exclusive)
+{
+  if (!descriptor_data)
+    return EBADF;
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  if (descriptor_data->shutdown_)
+    return EBADF;
+
+  if (descriptor_data->registered_events_ == 0)
+    return EOPNOTSUPP;
+
+#if defined(EPOLLEXCLUSIVE)
+  // An exclusive registration may only use the events that epoll permits for
+  // it. Errors and hang-ups are always reported.
+  uint32_t events = descriptor_data->registered_events_ & EPOLLOUT;
+  if (exclusive)
+    events |= EPOLLIN | EPOLLET | EPOLLEXCLUSIVE;
+  else
+    events |= EPOLLIN | EPOLLERR | EPOLLHUP | EPOLLPRI | EPOLLET;
+
+  if (events == descriptor_data->registered_events_)
+    return 0;
+
+  return update_registration(descriptor, descriptor_data, events);
+#else // defined(EPOLLEXCLUSIVE)
+  (void)descriptor;
+  return exclusive ? EOPNOTSUPP : 0;
+#endif // defined(EPOLLEXCLUSIVE)
+}
+
 void epoll_reactor::move_descriptor(socket_type,
     epoll_reactor::per_descriptor_data& target_descriptor_data,
     epoll_reactor::per_descriptor_data& source_descriptor_data)
@@ -262,7 +364,7 @@ void epoll_reactor::start_op(int op_type, socket_type descriptor,
             if (descriptor_data->registered_events_ != 0)
               descriptor_data->try_speculative_[op_type] = false;
           descriptor_lock.unlock();
-          scheduler_.post_immediate_completion(op, is_continuation);
+          scheduler_.dispatch_immediate_completion(op, is_continuation);
           return;
         }
       }
@@ -278,16 +380,10 @@ void epoll_reactor::start_op(int op_type, socket_type descriptor,
       {
         if ((descriptor_data->registered_events_ & EPOLLOUT) == 0)
         {
-          epoll_event ev = { 0, { 0 } };
-          ev.events = descriptor_data->registered_events_ | EPOLLOUT;
-          ev.data.ptr = descriptor_data;
-          if (epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, descriptor, &ev) == 0)
-          {
-            descriptor_data->registered_events_ |= ev.events;
-          }
-          else
+          if (int error = update_registration(descriptor, descriptor_data,
+                descriptor_data->registered_events_ | EPOLLOUT))
           {
-            op->ec_ = boost::system::error_code(errno,
+            op->ec_ = boost::system::error_code(error,
                 boost::asio::error::get_system_category());
             scheduler_.post_immediate_completion(op, is_continuation);
             return;
@@ -303,18 +399,21 @@ void epoll_reactor::start_op(int op_type, socket_type descriptor,
     }
     else
     {
+      uint32_t events = descriptor_data->registered_events_;
       if (op_type == write_op)
       {
-        descriptor_data->registered_events_ |= EPOLLOUT;
+        events |= EPOLLOUT;
       }
 
-      epoll_event ev = { 0, { 0 } };
-      ev.events = descriptor_data->registered_events_;
-      ev.data.ptr = descriptor_data;
-      epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, descriptor, &ev);
+      update_registration(descriptor, descriptor_data, events);
     }
   }
 
+#if defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+  if (op->deadline_)
+    schedule_deadline(op->deadline_, op_type, descriptor, descriptor_data);
+#endif // defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+
   descriptor_data->op_queue_[op_type].push(op);
   scheduler_.work_started();
 }
@@ -343,6 +442,74 @@ void epoll_reactor::cancel_ops(socket_type,
   scheduler_.post_deferred_completions(ops);
 }
 
+void epoll_reactor::cancel_ops_by_key(socket_type,
+    epoll_reactor::per_descriptor_data& descriptor_data,
+    int op_type, void* cancellation_key)
+{
+  if (!descriptor_data)
+    return;
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  op_queue<operation> ops;
+  op_queue<reactor_op> other_ops;
+  while (reactor_op* op = descriptor_data->op_queue_[op_type].front())
+  {
+    descriptor_data->op_queue_[op_type].pop();
+    if (op->cancellation_key_ == cancellation_key)
+    {
+      op->ec_ = boost::asio::error::operation_aborted;
+      ops.push(op);
+    }
+    else
+      other_ops.push(op);
+  }
+  descriptor_data->op_queue_[op_type].push(other_ops);
+
+  descriptor_lock.unlock();
+
+  scheduler_.post_deferred_completions(ops);
+}
+
+#if defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+void epoll_reactor::cancel_deadline(reactor_op_deadline* deadline)
+{
+  mutex::scoped_lock lock(mutex_);
+  op_queue<operation> ops;
+  deadline_queue_.cancel_timer(deadline->timer_, ops);
+  lock.unlock();
+  scheduler_.post_deferred_completions(ops);
+}
+
+void epoll_reactor::expire_deadline(reactor_op_deadline* deadline)
+{
+  descriptor_state* descriptor_data =
+    static_cast<descriptor_state*>(deadline->descriptor_data_);
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  op_queue<operation> ops;
+  op_queue<reactor_op> other_ops;
+  int op_type = deadline->op_type_;
+  while (reactor_op* op = descriptor_data->op_queue_[op_type].front())
+  {
+    descriptor_data->op_queue_[op_type].pop();
+    if (op->deadline_ == deadline)
+    {
+      op->ec_ = boost::asio::error::timed_out;
+      ops.push(op);
+    }
+    else
+      other_ops.push(op);
+  }
+  descriptor_data->op_queue_[op_type].push(other_ops);
+
+  descriptor_lock.unlock();
+
+  scheduler_.post_deferred_completions(ops);
+}
+#endif // defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+
 void epoll_reactor::deregister_descriptor(socket_type descriptor,
     epoll_reactor::per_descriptor_data& descriptor_data, bool closing)
 {
@@ -485,7 +652,8 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
       // Ignore.
     }
 # endif // defined(BOOST_ASIO_HAS_TIMERFD)
-    else
+    else if (descriptor_state* descriptor_data =
+        find_descriptor_state(events[i].data))
     {
       unsigned event_mask = 0;
       if ((events[i].events & EPOLLIN) != 0)
@@ -495,7 +663,7 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
       if ((events[i].events & (EPOLLERR | EPOLLHUP)) != 0)
         event_mask |= BOOST_ASIO_HANDLER_REACTOR_ERROR_EVENT;
       BOOST_ASIO_HANDLER_REACTOR_EVENTS((context(),
-            reinterpret_cast<uintmax_t>(ptr), event_mask));
+            reinterpret_cast<uintmax_t>(descriptor_data), event_mask));
     }
   }
 #endif // defined(BOOST_ASIO_ENABLE_HANDLER_TRACKING)
@@ -530,12 +698,12 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
       check_timers = true;
     }
 #endif // defined(BOOST_ASIO_HAS_TIMERFD)
-    else
+    else if (descriptor_state* descriptor_data =
+        find_descriptor_state(events[i].data))
     {
       // The descriptor operation doesn't count as work in and of itself, so we
       // don't call work_started() here. This still allows the scheduler to
       // stop if the only remaining operations are descriptor operations.
-      descriptor_state* descriptor_data = static_cast<descriptor_state*>(ptr);
       if (!ops.is_enqueued(descriptor_data))
       {
         descriptor_data->set_ready_events(events[i].events);
@@ -555,16 +723,17 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
 
 #if defined(BOOST_ASIO_HAS_TIMERFD)
     if (timer_fd_ != -1)
-    {
-      itimerspec new_timeout;
-      itimerspec old_timeout;
-      int flags = get_timeout(new_timeout);
-      timerfd_settime(timer_fd_, flags, &new_timeout, &old_timeout);
-    }
+      set_timer_fd();
 #endif // defined(BOOST_ASIO_HAS_TIMERFD)
   }
 }
 
+epoll_reactor::counters epoll_reactor::get_counters()
+{
+  mutex::scoped_lock lock(mutex_);
+  return counters_;
+}
+
 void epoll_reactor::interrupt()
 {
   epoll_event ev = { 0, { 0 } };
@@ -622,8 +791,21 @@ int epoll_reactor::do_timerfd_create()
 #endif // defined(BOOST_ASIO_HAS_TIMERFD)
 }
 
-epoll_reactor::descriptor_state* epoll_reactor::allocate_descriptor_state()
+epoll_reactor::descriptor_state* epoll_reactor::allocate_descriptor_state(
+    socket_type descriptor)
 {
+#if defined(BOOST_ASIO_HAS_DESCRIPTOR_TABLE)
+  uint32_t key = 0;
+  if (descriptor_state* s = descriptor_table_.claim(descriptor, key))
+  {
+    s->event_data_.u64 = (static_cast<uint64_t>(key) << 32)
+      | (static_cast<uint64_t>(descriptor) << 1) | 1;
+    return s;
+  }
+#else // defined(BOOST_ASIO_HAS_DESCRIPTOR_TABLE)
+  (void)descriptor;
+#endif // defined(BOOST_ASIO_HAS_DESCRIPTOR_TABLE)
+
   mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
   return registered_descriptors_.alloc(BOOST_ASIO_CONCURRENCY_HINT_IS_LOCKING(
         REACTOR_IO, scheduler_.concurrency_hint()));
@@ -631,10 +813,34 @@ epoll_reactor::descriptor_state* epoll_reactor::allocate_descriptor_state()
 
 void epoll_reactor::free_descriptor_state(epoll_reactor::descriptor_state* s)
 {
+#if defined(BOOST_ASIO_HAS_DESCRIPTOR_TABLE)
+  if ((s->event_data_.u64 & 1) != 0)
+  {
+    descriptor_table_.release(
+        static_cast<int>((s->event_data_.u64 >> 1) & 0x7FFFFFFF));
+    return;
+  }
+#endif // defined(BOOST_ASIO_HAS_DESCRIPTOR_TABLE)
+
   mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
   registered_descriptors_.free(s);
 }
 
+epoll_reactor::descriptor_state* epoll_reactor::find_descriptor_state(
+    const epoll_data_t& data)
+{
+#if defined(BOOST_ASIO_HAS_DESCRIPTOR_TABLE)
+  if ((data.u64 & 1) != 0)
+  {
+    return descriptor_table_.find(
+        static_cast<int>((data.u64 >> 1) & 0x7FFFFFFF),
+        static_cast<uint32_t>(data.u64 >> 32));
+  }
+#endif // defined(BOOST_ASIO_HAS_DESCRIPTOR_TABLE)
+
+  return static_cast<descriptor_state*>(data.ptr);
+}
+
 void epoll_reactor::do_add_timer_queue(timer_queue_base& queue)
 {
   mutex::scoped_lock lock(mutex_);
@@ -652,16 +858,57 @@ void epoll_reactor::update_timeout()
 #if defined(BOOST_ASIO_HAS_TIMERFD)
   if (timer_fd_ != -1)
   {
-    itimerspec new_timeout;
-    itimerspec old_timeout;
-    int flags = get_timeout(new_timeout);
-    timerfd_settime(timer_fd_, flags, &new_timeout, &old_timeout);
+    set_timer_fd();
     return;
   }
 #endif // defined(BOOST_ASIO_HAS_TIMERFD)
   interrupt();
 }
 
+void epoll_reactor::update_timeout(long latest_usec, bool earliest)
+{
+#if defined(BOOST_ASIO_HAS_TIMERFD)
+  if (timer_fd_ != -1)
+  {
+    // The timer descriptor can be left alone if it fires no later than the
+    // new timer's expiry plus its slack. If it fires before the new timer
+    // expires, it is reprogrammed at that point.
+    if (timer_fd_expiry_ - latest_usec <= monotonic_usec())
+    {
+      timer_fd_delayed_ = true;
+      if (earliest)
+        ++counters_.timeout_updates_avoided;
+      return;
+    }
+
+    set_timer_fd();
+    return;
+  }
+#else // defined(BOOST_ASIO_HAS_TIMERFD)
+  (void)latest_usec;
+#endif // defined(BOOST_ASIO_HAS_TIMERFD)
+  if (earliest)
+    interrupt();
+}
+
+#if defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+void epoll_reactor::schedule_deadline(reactor_op_deadline* deadline,
+    int op_type, socket_type descriptor, descriptor_state* descriptor_data)
+{
+  mutex::scoped_lock lock(mutex_);
+
+  if (shutdown_)
+    return;
+
+  bool earliest = deadline_queue_.enqueue_timer(
+      deadline->expiry_, deadline->timer_, deadline);
+  deadline->scheduled(this, descriptor, descriptor_data, op_type);
+  scheduler_.work_started();
+  if (earliest)
+    update_timeout();
+}
+#endif // defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+
 int epoll_reactor::get_timeout(int msec)
 {
   // By default we will wait no longer than 5 minutes. This will ensure that
@@ -677,12 +924,34 @@ int epoll_reactor::get_timeout(itimerspec& ts)
   ts.it_interval.tv_sec = 0;
   ts.it_interval.tv_nsec = 0;
 
-  long usec = timer_queues_.wait_duration_usec(5 * 60 * 1000 * 1000);
+  long usec = timer_queues_.wait_duration_usec(max_timeout_usec);
   ts.it_value.tv_sec = usec / 1000000;
   ts.it_value.tv_nsec = usec ? (usec % 1000000) * 1000 : 1;
 
   return usec ? 0 : TFD_TIMER_ABSTIME;
 }
+
+void epoll_reactor::set_timer_fd()
+{
+  itimerspec new_timeout;
+  itimerspec old_timeout;
+  int flags = get_timeout(new_timeout);
+  timerfd_settime(timer_fd_, flags, &new_timeout, &old_timeout);
+
+  // An absolute time is used only when the timer has already expired.
+  timer_fd_expiry_ = flags ? 0 : monotonic_usec()
+    + static_cast<int64_t>(new_timeout.it_value.tv_sec) * 1000000
+    + new_timeout.it_value.tv_nsec / 1000;
+  timer_fd_delayed_ = false;
+  ++counters_.timeout_updates;
+}
+
+int64_t epoll_reactor::monotonic_usec()
+{
+  timespec ts;
+  ::clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<int64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
 #endif // defined(BOOST_ASIO_HAS_TIMERFD)
 
 struct epoll_reactor::perform_io_cleanup_on_block_exit
@@ -722,6 +991,8 @@ epoll_reactor::descriptor_state::descriptor_state(bool locking)
   : operation(&epoll_reactor::descriptor_state::do_complete),
     mutex_(locking)
 {
+  event_data_.u64 = 0;
+  event_data_.ptr = this;
 }
 
 operation* epoll_reactor::descriptor_state::perform_io(uint32_t events)
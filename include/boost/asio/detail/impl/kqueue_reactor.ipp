@@ -63,6 +63,10 @@ kqueue_reactor::kqueue_reactor(boost::asio::execution_context& ctx)
         boost::asio::error::get_system_category());
     boost::asio::detail::throw_error(error);
   }
+
+#if defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+  timer_queues_.insert(&deadline_queue_);
+#endif // defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
 }
 
 kqueue_reactor::~kqueue_reactor()
@@ -221,7 +225,7 @@ void kqueue_reactor::start_op(int op_type, socket_type descriptor,
       if (op->perform())
       {
         descriptor_lock.unlock();
-        scheduler_.post_immediate_completion(op, is_continuation);
+        scheduler_.dispatch_immediate_completion(op, is_continuation);
         return;
       }
 
@@ -259,6 +263,11 @@ void kqueue_reactor::start_op(int op_type, socket_type descriptor,
     }
   }
 
+#if defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+  if (op->deadline_)
+    schedule_deadline(op->deadline_, op_type, descriptor, descriptor_data);
+#endif // defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+
   descriptor_data->op_queue_[op_type].push(op);
   scheduler_.work_started();
 }
@@ -287,6 +296,74 @@ void kqueue_reactor::cancel_ops(socket_type,
   scheduler_.post_deferred_completions(ops);
 }
 
+void kqueue_reactor::cancel_ops_by_key(socket_type,
+    kqueue_reactor::per_descriptor_data& descriptor_data,
+    int op_type, void* cancellation_key)
+{
+  if (!descriptor_data)
+    return;
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  op_queue<operation> ops;
+  op_queue<reactor_op> other_ops;
+  while (reactor_op* op = descriptor_data->op_queue_[op_type].front())
+  {
+    descriptor_data->op_queue_[op_type].pop();
+    if (op->cancellation_key_ == cancellation_key)
+    {
+      op->ec_ = boost::asio::error::operation_aborted;
+      ops.push(op);
+    }
+    else
+      other_ops.push(op);
+  }
+  descriptor_data->op_queue_[op_type].push(other_ops);
+
+  descriptor_lock.unlock();
+
+  scheduler_.post_deferred_completions(ops);
+}
+
+#if defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+void kqueue_reactor::cancel_deadline(reactor_op_deadline* deadline)
+{
+  mutex::scoped_lock lock(mutex_);
+  op_queue<operation> ops;
+  deadline_queue_.cancel_timer(deadline->timer_, ops);
+  lock.unlock();
+  scheduler_.post_deferred_completions(ops);
+}
+
+void kqueue_reactor::expire_deadline(reactor_op_deadline* deadline)
+{
+  descriptor_state* descriptor_data =
+    static_cast<descriptor_state*>(deadline->descriptor_data_);
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  op_queue<operation> ops;
+  op_queue<reactor_op> other_ops;
+  int op_type = deadline->op_type_;
+  while (reactor_op* op = descriptor_data->op_queue_[op_type].front())
+  {
+    descriptor_data->op_queue_[op_type].pop();
+    if (op->deadline_ == deadline)
+    {
+      op->ec_ = boost::asio::error::timed_out;
+      ops.push(op);
+    }
+    else
+      other_ops.push(op);
+  }
+  descriptor_data->op_queue_[op_type].push(other_ops);
+
+  descriptor_lock.unlock();
+
+  scheduler_.post_deferred_completions(ops);
+}
+#endif // defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+
 void kqueue_reactor::deregister_descriptor(socket_type descriptor,
     kqueue_reactor::per_descriptor_data& descriptor_data, bool closing)
 {
@@ -547,6 +624,24 @@ void kqueue_reactor::do_remove_timer_queue(timer_queue_base& queue)
   timer_queues_.erase(&queue);
 }
 
+#if defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+void kqueue_reactor::schedule_deadline(reactor_op_deadline* deadline,
+    int op_type, socket_type descriptor, descriptor_state* descriptor_data)
+{
+  mutex::scoped_lock lock(mutex_);
+
+  if (shutdown_)
+    return;
+
+  bool earliest = deadline_queue_.enqueue_timer(
+      deadline->expiry_, deadline->timer_, deadline);
+  deadline->scheduled(this, descriptor, descriptor_data, op_type);
+  scheduler_.work_started();
+  if (earliest)
+    interrupt();
+}
+#endif // defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+
 timespec* kqueue_reactor::get_timeout(long usec, timespec& ts)
 {
   // By default we will wait no longer than 5 minutes. This will ensure that
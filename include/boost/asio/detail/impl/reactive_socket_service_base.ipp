@@ -169,6 +169,28 @@ boost::system::error_code reactive_socket_service_base::cancel(
   return ec;
 }
 
+boost::system::error_code reactive_socket_service_base::update_exclusive_wake(
+    reactive_socket_service_base::base_implementation_type& impl,
+    boost::system::error_code& ec)
+{
+#if defined(BOOST_ASIO_HAS_EPOLL)
+  bool exclusive = (impl.state_ & socket_ops::exclusive_wake) != 0;
+  if (int err = reactor_.set_exclusive_wake(
+        impl.socket_, impl.reactor_data_, exclusive))
+  {
+    impl.state_ ^= socket_ops::exclusive_wake;
+    ec = boost::system::error_code(err,
+        boost::asio::error::get_system_category());
+    return ec;
+  }
+#else // defined(BOOST_ASIO_HAS_EPOLL)
+  (void)impl;
+#endif // defined(BOOST_ASIO_HAS_EPOLL)
+
+  ec = boost::system::error_code();
+  return ec;
+}
+
 boost::system::error_code reactive_socket_service_base::do_open(
     reactive_socket_service_base::base_implementation_type& impl,
     int af, int type, int protocol, boost::system::error_code& ec)
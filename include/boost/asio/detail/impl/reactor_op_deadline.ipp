@@ -0,0 +1,90 @@
+//
+// detail/impl/reactor_op_deadline.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IMPL_REACTOR_OP_DEADLINE_IPP
+#define BOOST_ASIO_DETAIL_IMPL_REACTOR_OP_DEADLINE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+
+#include <new>
+#include <boost/asio/detail/reactor.hpp>
+#include <boost/asio/detail/reactor_op_deadline.hpp>
+#include <boost/asio/detail/recycling_allocator.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+void reactor_op_deadline::attach(reactor_op* op, const time_type& expiry)
+{
+  recycling_allocator<reactor_op_deadline> alloc;
+  op->deadline_ = new (alloc.allocate(1))
+    reactor_op_deadline(expiry, op->func_);
+  op->func_ = &reactor_op_deadline::do_op_complete;
+}
+
+void reactor_op_deadline::do_complete(void* owner, operation* base,
+    const boost::system::error_code& /*ec*/,
+    std::size_t /*bytes_transferred*/)
+{
+  reactor_op_deadline* d(static_cast<reactor_op_deadline*>(base));
+
+  // The deadline queue delivers a success code on expiry, and the
+  // operation_aborted error if the operation completed first.
+  if (owner && !d->ec_)
+    d->reactor_->expire_deadline(d);
+
+  d->release();
+}
+
+void reactor_op_deadline::do_op_complete(void* owner, operation* base,
+    const boost::system::error_code& ec, std::size_t bytes_transferred)
+{
+  reactor_op* o(static_cast<reactor_op*>(base));
+  reactor_op_deadline* d = o->deadline_;
+
+  // Restore the operation's own completion function before making the upcall.
+  o->func_ = d->op_complete_func_;
+  o->deadline_ = 0;
+
+  if (owner && d->reactor_)
+    d->reactor_->cancel_deadline(d);
+  d->release();
+
+  o->complete(owner, ec, bytes_transferred);
+}
+
+void reactor_op_deadline::release()
+{
+  if (ref_count_down(ref_count_))
+  {
+    this->~reactor_op_deadline();
+    recycling_allocator<reactor_op_deadline> alloc;
+    alloc.deallocate(this, 1);
+  }
+}
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+
+#endif // BOOST_ASIO_DETAIL_IMPL_REACTOR_OP_DEADLINE_IPP
@@ -17,6 +17,7 @@
 
 #include <boost/asio/detail/config.hpp>
 
+#include <algorithm>
 #include <boost/asio/detail/concurrency_hint.hpp>
 #include <boost/asio/detail/event.hpp>
 #include <boost/asio/detail/limits.hpp>
@@ -55,8 +56,7 @@ struct scheduler::task_cleanup
   {
     if (this_thread_->private_outstanding_work > 0)
     {
-      boost::asio::detail::increment(
-          scheduler_->outstanding_work_,
+      scheduler_->increment_outstanding_work(
           this_thread_->private_outstanding_work);
     }
     this_thread_->private_outstanding_work = 0;
@@ -80,8 +80,7 @@ struct scheduler::work_cleanup
   {
     if (this_thread_->private_outstanding_work > 1)
     {
-      boost::asio::detail::increment(
-          scheduler_->outstanding_work_,
+      scheduler_->increment_outstanding_work(
           this_thread_->private_outstanding_work - 1);
     }
     else if (this_thread_->private_outstanding_work < 1)
@@ -104,6 +103,24 @@ struct scheduler::work_cleanup
   thread_info* this_thread_;
 };
 
+struct scheduler::batch_cleanup
+{
+  ~batch_cleanup()
+  {
+    // Operations that were taken from the queue but not run are returned to
+    // the front of the queue, ahead of any operations added since.
+    if (!this_thread_->private_batch_queue.empty())
+    {
+      lock_->lock();
+      scheduler_->op_queue_.push_front(this_thread_->private_batch_queue);
+    }
+  }
+
+  scheduler* scheduler_;
+  mutex::scoped_lock* lock_;
+  thread_info* this_thread_;
+};
+
 scheduler::scheduler(boost::asio::execution_context& ctx,
     int concurrency_hint, bool own_thread)
   : boost::asio::detail::execution_context_service_base<scheduler>(ctx),
@@ -112,12 +129,16 @@ scheduler::scheduler(boost::asio::execution_context& ctx,
           SCHEDULER, concurrency_hint)
         || !BOOST_ASIO_CONCURRENCY_HINT_IS_LOCKING(
           REACTOR_IO, concurrency_hint)),
+    busy_poll_(BOOST_ASIO_CONCURRENCY_HINT_IS_BUSY_POLLING(concurrency_hint)),
+    inline_completion_(BOOST_ASIO_CONCURRENCY_HINT_IS_INLINE_COMPLETION(
+          concurrency_hint)),
     mutex_(BOOST_ASIO_CONCURRENCY_HINT_IS_LOCKING(
           SCHEDULER, concurrency_hint)),
     task_(0),
     task_interrupted_(true),
     outstanding_work_(0),
     stopped_(false),
+    stop_count_(0),
     shutdown_(false),
     concurrency_hint_(concurrency_hint),
     thread_(0)
@@ -196,14 +217,27 @@ std::size_t scheduler::run(boost::system::error_code& ec)
 
   thread_info this_thread;
   this_thread.private_outstanding_work = 0;
+  this_thread.inline_depth = 0;
   thread_call_stack::context ctx(this, this_thread);
 
   mutex::scoped_lock lock(mutex_);
 
+#if defined(BOOST_ASIO_HAS_THREADS)
+  // We want to support nested calls to the run functions, so any handlers
+  // that the outer call has taken as a batch but not yet run need to be put
+  // back at the front of the main queue now.
+  if (one_thread_)
+    if (thread_info* outer_info = static_cast<thread_info*>(ctx.next_by_key()))
+      op_queue_.push_front(outer_info->private_batch_queue);
+#endif // defined(BOOST_ASIO_HAS_THREADS)
+
   std::size_t n = 0;
-  for (; do_run_one(lock, this_thread, ec); lock.lock())
-    if (n != (std::numeric_limits<std::size_t>::max)())
-      ++n;
+  while (std::size_t r = do_run_one(lock, this_thread,
+        BOOST_ASIO_SCHEDULER_BATCH_SIZE, ec))
+  {
+    n += (std::min)(r, (std::numeric_limits<std::size_t>::max)() - n);
+    lock.lock();
+  }
   return n;
 }
 
@@ -218,11 +252,21 @@ std::size_t scheduler::run_one(boost::system::error_code& ec)
 
   thread_info this_thread;
   this_thread.private_outstanding_work = 0;
+  this_thread.inline_depth = 0;
   thread_call_stack::context ctx(this, this_thread);
 
   mutex::scoped_lock lock(mutex_);
 
-  return do_run_one(lock, this_thread, ec);
+#if defined(BOOST_ASIO_HAS_THREADS)
+  // We want to support nested calls to the run functions, so any handlers
+  // that the outer call has taken as a batch but not yet run need to be put
+  // back at the front of the main queue now.
+  if (one_thread_)
+    if (thread_info* outer_info = static_cast<thread_info*>(ctx.next_by_key()))
+      op_queue_.push_front(outer_info->private_batch_queue);
+#endif // defined(BOOST_ASIO_HAS_THREADS)
+
+  return do_run_one(lock, this_thread, 1, ec);
 }
 
 std::size_t scheduler::wait_one(long usec, boost::system::error_code& ec)
@@ -236,10 +280,20 @@ std::size_t scheduler::wait_one(long usec, boost::system::error_code& ec)
 
   thread_info this_thread;
   this_thread.private_outstanding_work = 0;
+  this_thread.inline_depth = 0;
   thread_call_stack::context ctx(this, this_thread);
 
   mutex::scoped_lock lock(mutex_);
 
+#if defined(BOOST_ASIO_HAS_THREADS)
+  // We want to support nested calls to the run functions, so any handlers
+  // that the outer call has taken as a batch but not yet run need to be put
+  // back at the front of the main queue now.
+  if (one_thread_)
+    if (thread_info* outer_info = static_cast<thread_info*>(ctx.next_by_key()))
+      op_queue_.push_front(outer_info->private_batch_queue);
+#endif // defined(BOOST_ASIO_HAS_THREADS)
+
   return do_wait_one(lock, this_thread, usec, ec);
 }
 
@@ -254,6 +308,7 @@ std::size_t scheduler::poll(boost::system::error_code& ec)
 
   thread_info this_thread;
   this_thread.private_outstanding_work = 0;
+  this_thread.inline_depth = 0;
   thread_call_stack::context ctx(this, this_thread);
 
   mutex::scoped_lock lock(mutex_);
@@ -263,8 +318,13 @@ std::size_t scheduler::poll(boost::system::error_code& ec)
   // that are already on a thread-private queue need to be put on to the main
   // queue now.
   if (one_thread_)
+  {
     if (thread_info* outer_info = static_cast<thread_info*>(ctx.next_by_key()))
+    {
+      op_queue_.push_front(outer_info->private_batch_queue);
       op_queue_.push(outer_info->private_op_queue);
+    }
+  }
 #endif // defined(BOOST_ASIO_HAS_THREADS)
 
   std::size_t n = 0;
@@ -285,6 +345,7 @@ std::size_t scheduler::poll_one(boost::system::error_code& ec)
 
   thread_info this_thread;
   this_thread.private_outstanding_work = 0;
+  this_thread.inline_depth = 0;
   thread_call_stack::context ctx(this, this_thread);
 
   mutex::scoped_lock lock(mutex_);
@@ -294,8 +355,13 @@ std::size_t scheduler::poll_one(boost::system::error_code& ec)
   // that are already on a thread-private queue need to be put on to the main
   // queue now.
   if (one_thread_)
+  {
     if (thread_info* outer_info = static_cast<thread_info*>(ctx.next_by_key()))
+    {
+      op_queue_.push_front(outer_info->private_batch_queue);
       op_queue_.push(outer_info->private_op_queue);
+    }
+  }
 #endif // defined(BOOST_ASIO_HAS_THREADS)
 
   return do_poll_one(lock, this_thread, ec);
@@ -354,6 +420,45 @@ void scheduler::post_immediate_completion(
   wake_one_thread_and_unlock(lock);
 }
 
+void scheduler::dispatch_immediate_completion(
+    scheduler::operation* op, bool is_continuation)
+{
+#if defined(BOOST_ASIO_HAS_STD_EXCEPTION_PTR) \
+  || defined(BOOST_ASIO_NO_EXCEPTIONS)
+  if (inline_completion_)
+  {
+    thread_info* this_thread = static_cast<thread_info*>(
+        thread_call_stack::contains(this));
+    if (this_thread && this_thread->inline_depth
+        < BOOST_ASIO_SCHEDULER_INLINE_DEPTH)
+    {
+      // The initiating function releases its ownership of the operation only
+      // after this call returns, so an exception must not escape. It is
+      // instead rethrown from the run function once the current handler has
+      // completed.
+      ++this_thread->inline_depth;
+# if !defined(BOOST_ASIO_NO_EXCEPTIONS)
+      try
+      {
+# endif // !defined(BOOST_ASIO_NO_EXCEPTIONS)
+        op->complete(this, boost::system::error_code(), op->task_result_);
+# if !defined(BOOST_ASIO_NO_EXCEPTIONS)
+      }
+      catch (...)
+      {
+        this_thread->capture_current_exception();
+      }
+# endif // !defined(BOOST_ASIO_NO_EXCEPTIONS)
+      --this_thread->inline_depth;
+      return;
+    }
+  }
+#endif // defined(BOOST_ASIO_HAS_STD_EXCEPTION_PTR)
+       //   || defined(BOOST_ASIO_NO_EXCEPTIONS)
+
+  post_immediate_completion(op, is_continuation);
+}
+
 void scheduler::post_immediate_completions(std::size_t n,
     op_queue<scheduler::operation>& ops, bool is_continuation)
 {
@@ -372,7 +477,7 @@ void scheduler::post_immediate_completions(std::size_t n,
   (void)is_continuation;
 #endif // defined(BOOST_ASIO_HAS_THREADS)
 
-  increment(outstanding_work_, static_cast<long>(n));
+  increment_outstanding_work(static_cast<long>(n));
   mutex::scoped_lock lock(mutex_);
   op_queue_.push(ops);
   wake_one_thread_and_unlock(lock);
@@ -435,7 +540,7 @@ void scheduler::abandon_operations(
 }
 
 std::size_t scheduler::do_run_one(mutex::scoped_lock& lock,
-    scheduler::thread_info& this_thread,
+    scheduler::thread_info& this_thread, std::size_t max_ops,
     const boost::system::error_code& ec)
 {
   while (!stopped_)
@@ -449,7 +554,8 @@ std::size_t scheduler::do_run_one(mutex::scoped_lock& lock,
 
       if (o == &task_operation_)
       {
-        task_interrupted_ = more_handlers;
+        // A busy-polled task never blocks, so never needs to be interrupted.
+        task_interrupted_ = more_handlers || busy_poll_;
 
         if (more_handlers && !one_thread_)
           wakeup_event_.unlock_and_signal_one(lock);
@@ -462,26 +568,63 @@ std::size_t scheduler::do_run_one(mutex::scoped_lock& lock,
         // Run the task. May throw an exception. Only block if the operation
         // queue is empty and we're not polling, otherwise we want to return
         // as soon as possible.
-        task_->run(more_handlers ? 0 : -1, this_thread.private_op_queue);
+        task_->run(more_handlers || busy_poll_ ? 0 : -1,
+            this_thread.private_op_queue);
       }
       else
       {
         std::size_t task_result = o->task_result_;
 
+        // No other thread is expected to run handlers, so take further ready
+        // operations to be run without reacquiring the lock. The batch ends at
+        // the task so that the task's position in the queue is preserved.
+        if (one_thread_)
+        {
+          for (std::size_t i = 1; i < max_ops; ++i)
+          {
+            operation* next = op_queue_.front();
+            if (next == 0 || next == &task_operation_)
+              break;
+            op_queue_.pop();
+            this_thread.private_batch_queue.push(next);
+          }
+        }
+
+        long stop_count = stop_count_;
+
         if (more_handlers && !one_thread_)
           wake_one_thread_and_unlock(lock);
         else
           lock.unlock();
 
-        // Ensure the count of outstanding work is decremented on block exit.
-        work_cleanup on_exit = { this, &lock, &this_thread };
-        (void)on_exit;
-
-        // Complete the operation. May throw an exception. Deletes the object.
-        o->complete(this, ec, task_result);
-        this_thread.rethrow_pending_exception();
-
-        return 1;
+        // Ensure that operations not run are requeued on block exit.
+        batch_cleanup on_batch_exit = { this, &lock, &this_thread };
+        (void)on_batch_exit;
+
+        for (std::size_t n = 1;; ++n)
+        {
+          {
+            // Ensure the count of outstanding work is decremented on block
+            // exit.
+            work_cleanup on_exit = { this, &lock, &this_thread };
+            (void)on_exit;
+
+            // Complete the operation. May throw an exception. Deletes the
+            // object.
+            o->complete(this, ec, task_result);
+            this_thread.rethrow_pending_exception();
+          }
+
+          // Run the next operation in the batch, unless the scheduler has
+          // been stopped in the meantime.
+          o = this_thread.private_batch_queue.front();
+          if (o == 0 || stop_count_ != stop_count)
+            return n;
+
+          this_thread.private_batch_queue.pop();
+          task_result = o->task_result_;
+          lock.unlock();
+        }
       }
     }
     else
@@ -515,7 +658,7 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock& lock,
     op_queue_.pop();
     bool more_handlers = (!op_queue_.empty());
 
-    task_interrupted_ = more_handlers;
+    task_interrupted_ = more_handlers || busy_poll_;
 
     if (more_handlers && !one_thread_)
       wakeup_event_.unlock_and_signal_one(lock);
@@ -529,7 +672,8 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock& lock,
       // Run the task. May throw an exception. Only block if the operation
       // queue is empty and we're not polling, otherwise we want to return
       // as soon as possible.
-      task_->run(more_handlers ? 0 : usec, this_thread.private_op_queue);
+      task_->run(more_handlers || busy_poll_ ? 0 : usec,
+          this_thread.private_op_queue);
     }
 
     o = op_queue_.front();
@@ -624,6 +768,7 @@ void scheduler::stop_all_threads(
     mutex::scoped_lock& lock)
 {
   stopped_ = true;
+  ++stop_count_;
   wakeup_event_.signal_all(lock);
 
   if (!task_interrupted_ && task_)
@@ -26,8 +26,21 @@ Service& service_registry::use_service()
 {
   execution_context::service::key key;
   init_key<Service>(key, 0);
+
+#if defined(BOOST_ASIO_HAS_STD_ATOMIC)
+  std::size_t index = service_index<Service>::value();
+  if (execution_context::service* service = find_indexed_service(index, key))
+    return *static_cast<Service*>(service);
+#endif // defined(BOOST_ASIO_HAS_STD_ATOMIC)
+
   factory_type factory = &service_registry::create<Service, execution_context>;
-  return *static_cast<Service*>(do_use_service(key, factory, &owner_));
+  execution_context::service* service = do_use_service(key, factory, &owner_);
+
+#if defined(BOOST_ASIO_HAS_STD_ATOMIC)
+  index_service(index, service);
+#endif // defined(BOOST_ASIO_HAS_STD_ATOMIC)
+
+  return *static_cast<Service*>(service);
 }
 
 template <typename Service>
@@ -35,8 +48,21 @@ Service& service_registry::use_service(io_context& owner)
 {
   execution_context::service::key key;
   init_key<Service>(key, 0);
+
+#if defined(BOOST_ASIO_HAS_STD_ATOMIC)
+  std::size_t index = service_index<Service>::value();
+  if (execution_context::service* service = find_indexed_service(index, key))
+    return *static_cast<Service*>(service);
+#endif // defined(BOOST_ASIO_HAS_STD_ATOMIC)
+
   factory_type factory = &service_registry::create<Service, io_context>;
-  return *static_cast<Service*>(do_use_service(key, factory, &owner));
+  execution_context::service* service = do_use_service(key, factory, &owner);
+
+#if defined(BOOST_ASIO_HAS_STD_ATOMIC)
+  index_service(index, service);
+#endif // defined(BOOST_ASIO_HAS_STD_ATOMIC)
+
+  return *static_cast<Service*>(service);
 }
 
 template <typename Service>
@@ -52,6 +78,12 @@ bool service_registry::has_service() const
 {
   execution_context::service::key key;
   init_key<Service>(key, 0);
+
+#if defined(BOOST_ASIO_HAS_STD_ATOMIC)
+  if (find_indexed_service(service_index<Service>::value(), key))
+    return true;
+#endif // defined(BOOST_ASIO_HAS_STD_ATOMIC)
+
   return do_has_service(key);
 }
 
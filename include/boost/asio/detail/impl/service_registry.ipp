@@ -26,10 +26,21 @@ namespace boost {
 namespace asio {
 namespace detail {
 
+#if defined(BOOST_ASIO_HAS_STD_ATOMIC)
+std::size_t service_index_base::next_index()
+{
+  static std::atomic<std::size_t> next(0);
+  return next.fetch_add(1, std::memory_order_relaxed);
+}
+#endif // defined(BOOST_ASIO_HAS_STD_ATOMIC)
+
 service_registry::service_registry(execution_context& owner)
   : owner_(owner),
     first_service_(0)
 {
+#if defined(BOOST_ASIO_HAS_STD_ATOMIC)
+  clear_indexed_services();
+#endif // defined(BOOST_ASIO_HAS_STD_ATOMIC)
 }
 
 service_registry::~service_registry()
@@ -48,12 +59,21 @@ void service_registry::shutdown_services()
 
 void service_registry::destroy_services()
 {
+#if defined(BOOST_ASIO_HAS_STD_ATOMIC)
+  // Services are found only by searching the list while they are destroyed.
+  clear_indexed_services();
+#endif // defined(BOOST_ASIO_HAS_STD_ATOMIC)
+
   while (first_service_)
   {
     execution_context::service* next_service = first_service_->next_;
     destroy(first_service_);
     first_service_ = next_service;
   }
+
+#if defined(BOOST_ASIO_HAS_STD_ATOMIC)
+  clear_indexed_services();
+#endif // defined(BOOST_ASIO_HAS_STD_ATOMIC)
 }
 
 void service_registry::notify_fork(execution_context::fork_event fork_ev)
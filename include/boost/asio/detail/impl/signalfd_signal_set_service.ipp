@@ -0,0 +1,390 @@
+//
+// detail/impl/signalfd_signal_set_service.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IMPL_SIGNALFD_SIGNAL_SET_SERVICE_IPP
+#define BOOST_ASIO_DETAIL_IMPL_SIGNALFD_SIGNAL_SET_SERVICE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_SIGNALFD)
+
+#include <boost/asio/detail/signalfd_signal_set_service.hpp>
+#include <boost/asio/detail/socket_types.hpp>
+#include <boost/asio/detail/throw_error.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+reactor_op::status
+signalfd_signal_set_service::signalfd_read_op::do_perform(reactor_op* base)
+{
+  signalfd_read_op* o(static_cast<signalfd_read_op*>(base));
+
+  // Read as many pending signals as will fit in one call, and deliver them
+  // together. A short read means that no more signals were pending.
+  signalfd_siginfo info[max_signals_per_read];
+  for (;;)
+  {
+    signed_size_type bytes = ::read(
+        o->service_->descriptor_, info, sizeof(info));
+    if (bytes < 0 && errno == EINTR)
+      continue;
+    if (bytes < static_cast<signed_size_type>(sizeof(signalfd_siginfo)))
+      break;
+
+    std::size_t count = bytes / sizeof(signalfd_siginfo);
+    o->service_->deliver_signals(info, count);
+    if (count < max_signals_per_read)
+      break;
+  }
+
+  return not_done;
+}
+
+signalfd_signal_set_service::signalfd_signal_set_service(
+    execution_context& context)
+  : execution_context_service_base<signalfd_signal_set_service>(context),
+    scheduler_(boost::asio::use_service<scheduler>(context)),
+    reactor_(boost::asio::use_service<reactor>(context)),
+    read_op_(this),
+    mutex_(),
+    descriptor_(-1)
+{
+  reactor_.init_task();
+
+  for (int i = 0; i < max_signal_number; ++i)
+  {
+    registration_count_[i] = 0;
+    registrations_[i] = 0;
+  }
+
+  sigemptyset(&mask_);
+  descriptor_ = ::signalfd(-1, &mask_, SFD_NONBLOCK | SFD_CLOEXEC);
+  if (descriptor_ == -1)
+  {
+    boost::system::error_code ec(errno,
+        boost::asio::error::get_system_category());
+    boost::asio::detail::throw_error(ec, "signalfd");
+  }
+
+  reactor_.register_internal_descriptor(reactor::read_op,
+      descriptor_, reactor_data_, &read_op_);
+}
+
+signalfd_signal_set_service::~signalfd_signal_set_service()
+{
+  close_descriptor();
+}
+
+void signalfd_signal_set_service::shutdown()
+{
+  close_descriptor();
+
+  op_queue<operation> ops;
+
+  for (int i = 0; i < max_signal_number; ++i)
+  {
+    registration* reg = registrations_[i];
+    while (reg)
+    {
+      ops.push(*reg->queue_);
+      reg = reg->next_in_table_;
+    }
+  }
+
+  scheduler_.abandon_operations(ops);
+}
+
+void signalfd_signal_set_service::notify_fork(
+    boost::asio::execution_context::fork_event)
+{
+  // A child process inherits the descriptor, which then receives the child's
+  // own signals, and the reactor registers it again along with all other
+  // descriptors. No further action is required.
+}
+
+void signalfd_signal_set_service::construct(
+    signalfd_signal_set_service::implementation_type& impl)
+{
+  impl.signals_ = 0;
+}
+
+void signalfd_signal_set_service::destroy(
+    signalfd_signal_set_service::implementation_type& impl)
+{
+  boost::system::error_code ignored_ec;
+  clear(impl, ignored_ec);
+  cancel(impl, ignored_ec);
+}
+
+boost::system::error_code signalfd_signal_set_service::add(
+    signalfd_signal_set_service::implementation_type& impl,
+    int signal_number, boost::system::error_code& ec)
+{
+  // Check that the signal number is valid.
+  if (signal_number < 0 || signal_number >= max_signal_number)
+  {
+    ec = boost::asio::error::invalid_argument;
+    return ec;
+  }
+
+  mutex::scoped_lock lock(mutex_);
+
+  // Find the appropriate place to insert the registration.
+  registration** insertion_point = &impl.signals_;
+  registration* next = impl.signals_;
+  while (next && next->signal_number_ < signal_number)
+  {
+    insertion_point = &next->next_in_set_;
+    next = next->next_in_set_;
+  }
+
+  // Only do something if the signal is not already registered.
+  if (next == 0 || next->signal_number_ != signal_number)
+  {
+    // Start receiving the signal if we're the first.
+    if (registration_count_[signal_number] == 0)
+      if (update_mask(signal_number, true, ec))
+        return ec;
+
+    registration* new_registration = new registration;
+
+    // Record the new registration in the set.
+    new_registration->signal_number_ = signal_number;
+    new_registration->queue_ = &impl.queue_;
+    new_registration->next_in_set_ = next;
+    *insertion_point = new_registration;
+
+    // Insert registration into the registration table.
+    new_registration->next_in_table_ = registrations_[signal_number];
+    if (registrations_[signal_number])
+      registrations_[signal_number]->prev_in_table_ = new_registration;
+    registrations_[signal_number] = new_registration;
+
+    ++registration_count_[signal_number];
+  }
+
+  ec = boost::system::error_code();
+  return ec;
+}
+
+boost::system::error_code signalfd_signal_set_service::remove(
+    signalfd_signal_set_service::implementation_type& impl,
+    int signal_number, boost::system::error_code& ec)
+{
+  // Check that the signal number is valid.
+  if (signal_number < 0 || signal_number >= max_signal_number)
+  {
+    ec = boost::asio::error::invalid_argument;
+    return ec;
+  }
+
+  mutex::scoped_lock lock(mutex_);
+
+  // Find the signal number in the list of registrations.
+  registration** deletion_point = &impl.signals_;
+  registration* reg = impl.signals_;
+  while (reg && reg->signal_number_ < signal_number)
+  {
+    deletion_point = &reg->next_in_set_;
+    reg = reg->next_in_set_;
+  }
+
+  if (reg != 0 && reg->signal_number_ == signal_number)
+  {
+    // Stop receiving the signal if we're the last.
+    if (registration_count_[signal_number] == 1)
+      if (update_mask(signal_number, false, ec))
+        return ec;
+
+    // Remove the registration from the set.
+    *deletion_point = reg->next_in_set_;
+
+    unlink_registration(reg);
+    delete reg;
+  }
+
+  ec = boost::system::error_code();
+  return ec;
+}
+
+boost::system::error_code signalfd_signal_set_service::clear(
+    signalfd_signal_set_service::implementation_type& impl,
+    boost::system::error_code& ec)
+{
+  mutex::scoped_lock lock(mutex_);
+
+  while (registration* reg = impl.signals_)
+  {
+    // Stop receiving the signal if we're the last.
+    if (registration_count_[reg->signal_number_] == 1)
+      if (update_mask(reg->signal_number_, false, ec))
+        return ec;
+
+    impl.signals_ = reg->next_in_set_;
+
+    unlink_registration(reg);
+    delete reg;
+  }
+
+  ec = boost::system::error_code();
+  return ec;
+}
+
+boost::system::error_code signalfd_signal_set_service::cancel(
+    signalfd_signal_set_service::implementation_type& impl,
+    boost::system::error_code& ec)
+{
+  BOOST_ASIO_HANDLER_OPERATION((scheduler_.context(),
+        "signal_set", &impl, 0, "cancel"));
+
+  op_queue<operation> ops;
+  {
+    mutex::scoped_lock lock(mutex_);
+
+    while (signal_op* op = impl.queue_.front())
+    {
+      op->ec_ = boost::asio::error::operation_aborted;
+      impl.queue_.pop();
+      ops.push(op);
+    }
+  }
+
+  scheduler_.post_deferred_completions(ops);
+
+  ec = boost::system::error_code();
+  return ec;
+}
+
+boost::system::error_code signalfd_signal_set_service::update_mask(
+    int signal_number, bool add, boost::system::error_code& ec)
+{
+  sigset_t mask = mask_;
+  int result = add
+    ? ::sigaddset(&mask, signal_number)
+    : ::sigdelset(&mask, signal_number);
+
+  // The descriptor is closed once the service has been shut down.
+  if (result == 0 && descriptor_ != -1)
+    result = ::signalfd(descriptor_, &mask, 0);
+
+  if (result == -1)
+  {
+    ec = boost::system::error_code(errno,
+        boost::asio::error::get_system_category());
+    return ec;
+  }
+
+  mask_ = mask;
+  ec = boost::system::error_code();
+  return ec;
+}
+
+void signalfd_signal_set_service::unlink_registration(registration* reg)
+{
+  if (registrations_[reg->signal_number_] == reg)
+    registrations_[reg->signal_number_] = reg->next_in_table_;
+  if (reg->prev_in_table_)
+    reg->prev_in_table_->next_in_table_ = reg->next_in_table_;
+  if (reg->next_in_table_)
+    reg->next_in_table_->prev_in_table_ = reg->prev_in_table_;
+
+  --registration_count_[reg->signal_number_];
+}
+
+void signalfd_signal_set_service::deliver_signals(
+    const signalfd_siginfo* info, std::size_t count)
+{
+  op_queue<operation> ops;
+  {
+    mutex::scoped_lock lock(mutex_);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      int signal_number = static_cast<int>(info[i].ssi_signo);
+      if (signal_number <= 0 || signal_number >= max_signal_number)
+        continue;
+
+      registration* reg = registrations_[signal_number];
+      while (reg)
+      {
+        if (reg->queue_->empty())
+        {
+          ++reg->undelivered_;
+        }
+        else
+        {
+          while (signal_op* op = reg->queue_->front())
+          {
+            op->signal_number_ = signal_number;
+            reg->queue_->pop();
+            ops.push(op);
+          }
+        }
+
+        reg = reg->next_in_table_;
+      }
+    }
+  }
+
+  scheduler_.post_deferred_completions(ops);
+}
+
+void signalfd_signal_set_service::close_descriptor()
+{
+  if (descriptor_ != -1)
+  {
+    reactor_.deregister_internal_descriptor(descriptor_, reactor_data_);
+    reactor_.cleanup_descriptor_data(reactor_data_);
+    ::close(descriptor_);
+    descriptor_ = -1;
+  }
+}
+
+void signalfd_signal_set_service::start_wait_op(
+    signalfd_signal_set_service::implementation_type& impl, signal_op* op)
+{
+  scheduler_.work_started();
+
+  mutex::scoped_lock lock(mutex_);
+
+  registration* reg = impl.signals_;
+  while (reg)
+  {
+    if (reg->undelivered_ > 0)
+    {
+      --reg->undelivered_;
+      op->signal_number_ = reg->signal_number_;
+      scheduler_.post_deferred_completion(op);
+      return;
+    }
+
+    reg = reg->next_in_set_;
+  }
+
+  impl.queue_.push(op);
+}
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_SIGNALFD)
+
+#endif // BOOST_ASIO_DETAIL_IMPL_SIGNALFD_SIGNAL_SET_SERVICE_IPP
@@ -134,6 +134,56 @@ socket_type accept(socket_type s, socket_addr_type* addr,
   return new_s;
 }
 
+#if defined(BOOST_ASIO_HAS_ACCEPT4) && defined(SOCK_NONBLOCK)
+template <typename SockLenType>
+inline socket_type call_accept4(SockLenType msghdr::*, socket_type s,
+    socket_addr_type* addr, std::size_t* addrlen, int flags)
+{
+  SockLenType tmp_addrlen = addrlen ? (SockLenType)*addrlen : 0;
+  socket_type result = ::accept4(s, addr, addrlen ? &tmp_addrlen : 0, flags);
+  if (addrlen)
+    *addrlen = (std::size_t)tmp_addrlen;
+  return result;
+}
+#endif // defined(BOOST_ASIO_HAS_ACCEPT4) && defined(SOCK_NONBLOCK)
+
+socket_type accept_non_blocking(socket_type s, socket_addr_type* addr,
+    std::size_t* addrlen, boost::system::error_code& ec)
+{
+#if defined(BOOST_ASIO_HAS_ACCEPT4) && defined(SOCK_NONBLOCK)
+  if (s == invalid_socket)
+  {
+    ec = boost::asio::error::bad_descriptor;
+    return invalid_socket;
+  }
+
+  // Create the new socket in non-blocking mode and with close-on-exec set,
+  // saving the system calls otherwise needed to change its flags.
+  socket_type new_s = call_accept4(&msghdr::msg_namelen,
+      s, addr, addrlen, SOCK_NONBLOCK | SOCK_CLOEXEC);
+  get_last_error(ec, new_s == invalid_socket);
+  return new_s;
+#else // defined(BOOST_ASIO_HAS_ACCEPT4) && defined(SOCK_NONBLOCK)
+  socket_type new_s = socket_ops::accept(s, addr, addrlen, ec);
+  if (new_s == invalid_socket)
+    return new_s;
+
+  state_type state = 0;
+  if (!socket_ops::set_internal_non_blocking(new_s, state, true, ec))
+  {
+    boost::system::error_code ignored_ec;
+    socket_ops::close(new_s, state, true, ignored_ec);
+    return invalid_socket;
+  }
+
+# if !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+  ::fcntl(new_s, F_SETFD, FD_CLOEXEC);
+# endif // !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+  return new_s;
+#endif // defined(BOOST_ASIO_HAS_ACCEPT4) && defined(SOCK_NONBLOCK)
+}
+
 socket_type sync_accept(socket_type s, state_type state,
     socket_addr_type* addr, std::size_t* addrlen, boost::system::error_code& ec)
 {
@@ -269,6 +319,55 @@ bool non_blocking_accept(socket_type s,
   }
 }
 
+bool non_blocking_accept_many(socket_type s,
+    state_type state, socket_type* new_sockets, std::size_t max_sockets,
+    std::size_t& count, boost::system::error_code& ec)
+{
+  while (count < max_sockets)
+  {
+    // Accept the next waiting connection.
+    socket_type new_socket = socket_ops::accept_non_blocking(s, 0, 0, ec);
+
+    // Check if operation succeeded.
+    if (new_socket != invalid_socket)
+    {
+      new_sockets[count++] = new_socket;
+      continue;
+    }
+
+    // Retry operation if interrupted by signal.
+    if (ec == boost::asio::error::interrupted)
+      continue;
+
+    // Operation failed.
+    bool aborted = (ec == boost::asio::error::connection_aborted);
+#if defined(EPROTO)
+    aborted = aborted || (ec.value() == EPROTO);
+#endif // defined(EPROTO)
+    if (ec == boost::asio::error::would_block
+        || ec == boost::asio::error::try_again)
+    {
+      // Retry operation if no connections have been accepted.
+      if (count == 0)
+        return false;
+    }
+    else if (aborted && !(state & enable_connection_aborted))
+    {
+      // Move on to the next waiting connection.
+      continue;
+    }
+
+    // An error is reported only if no connections have been accepted. If it
+    // persists, it will be seen when the operation is next performed.
+    if (count > 0)
+      ec = boost::system::error_code();
+    return true;
+  }
+
+  ec = boost::system::error_code();
+  return true;
+}
+
 #endif // defined(BOOST_ASIO_HAS_IOCP)
 
 template <typename SockLenType>
@@ -1886,6 +1985,23 @@ int setsockopt(socket_type s, state_type& state, int level, int optname,
     return 0;
   }
 
+  if (level == custom_socket_option_level
+      && optname == exclusive_wake_option)
+  {
+    if (optlen != sizeof(int))
+    {
+      ec = boost::asio::error::invalid_argument;
+      return socket_error_retval;
+    }
+
+    if (*static_cast<const int*>(optval))
+      state |= exclusive_wake;
+    else
+      state &= ~exclusive_wake;
+    ec.assign(0, ec.category());
+    return 0;
+  }
+
   if (level == SOL_SOCKET && optname == SO_LINGER)
     state |= user_set_linger;
 
@@ -1971,6 +2087,20 @@ int getsockopt(socket_type s, state_type state, int level, int optname,
     return 0;
   }
 
+  if (level == custom_socket_option_level
+      && optname == exclusive_wake_option)
+  {
+    if (*optlen != sizeof(int))
+    {
+      ec = boost::asio::error::invalid_argument;
+      return socket_error_retval;
+    }
+
+    *static_cast<int*>(optval) = (state & exclusive_wake) ? 1 : 0;
+    ec.assign(0, ec.category());
+    return 0;
+  }
+
 #if defined(__BORLANDC__)
   // Mysteriously, using the getsockopt and setsockopt functions directly with
   // Borland C++ results in incorrect values being set and read. The bug can be
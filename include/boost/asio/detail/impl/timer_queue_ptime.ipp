@@ -58,6 +58,13 @@ long timer_queue<time_traits<boost::posix_time::ptime> >::wait_duration_usec(
   return impl_.wait_duration_usec(max_duration);
 }
 
+long timer_queue<time_traits<boost::posix_time::ptime> >::
+  latest_wait_duration_usec(const per_timer_data& timer,
+    long max_duration) const
+{
+  return impl_.latest_wait_duration_usec(timer, max_duration);
+}
+
 void timer_queue<time_traits<boost::posix_time::ptime> >::get_ready_timers(
     op_queue<operation>& ops)
 {
@@ -76,6 +83,12 @@ std::size_t timer_queue<time_traits<boost::posix_time::ptime> >::cancel_timer(
   return impl_.cancel_timer(timer, ops, max_cancelled);
 }
 
+void timer_queue<time_traits<boost::posix_time::ptime> >::cancel_timer_by_key(
+    per_timer_data* timer, op_queue<operation>& ops, void* cancellation_key)
+{
+  impl_.cancel_timer_by_key(timer, ops, cancellation_key);
+}
+
 void timer_queue<time_traits<boost::posix_time::ptime> >::move_timer(
     per_timer_data& target, per_timer_data& source)
 {
@@ -0,0 +1,93 @@
+//
+// detail/io_sender_base.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IO_SENDER_BASE_HPP
+#define BOOST_ASIO_DETAIL_IO_SENDER_BASE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_IO_SENDERS)
+
+#include <exception>
+#include <boost/asio/error.hpp>
+#include <boost/asio/execution/set_done.hpp>
+#include <boost/asio/execution/set_error.hpp>
+#include <boost/asio/execution/set_value.hpp>
+#include <boost/asio/detail/type_traits.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// Describes the completion signals of a sender for an I/O operation. The
+// operation's results are sent as values, a failure as an error_code, and
+// cancellation as done.
+template <typename... Values>
+struct io_sender_base
+{
+  template <template <typename...> class Tuple,
+      template <typename...> class Variant>
+  using value_types = Variant<Tuple<Values...> >;
+
+  template <template <typename...> class Variant>
+  using error_types = Variant<boost::system::error_code, std::exception_ptr>;
+
+  BOOST_ASIO_STATIC_CONSTEXPR(bool, sends_done = true);
+};
+
+// Deliver the result of an I/O operation to a receiver. An exception thrown by
+// the receiver's set_value is passed to its set_error.
+template <typename Receiver, typename... Values>
+void io_sender_complete(Receiver& receiver,
+    const boost::system::error_code& ec, Values&&... values)
+{
+  if (ec == boost::asio::error::operation_aborted)
+  {
+    execution::set_done(BOOST_ASIO_MOVE_CAST(Receiver)(receiver));
+  }
+  else if (ec)
+  {
+    execution::set_error(BOOST_ASIO_MOVE_CAST(Receiver)(receiver), ec);
+  }
+  else
+  {
+#if !defined(BOOST_ASIO_NO_EXCEPTIONS)
+    try
+    {
+#endif // !defined(BOOST_ASIO_NO_EXCEPTIONS)
+      execution::set_value(BOOST_ASIO_MOVE_CAST(Receiver)(receiver),
+          BOOST_ASIO_MOVE_CAST(Values)(values)...);
+#if !defined(BOOST_ASIO_NO_EXCEPTIONS)
+    }
+    catch (...)
+    {
+      execution::set_error(BOOST_ASIO_MOVE_CAST(Receiver)(receiver),
+          std::current_exception());
+    }
+#endif // !defined(BOOST_ASIO_NO_EXCEPTIONS)
+  }
+}
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_IO_SENDERS)
+
+#endif // BOOST_ASIO_DETAIL_IO_SENDER_BASE_HPP
@@ -29,6 +29,7 @@
 #include <boost/asio/detail/object_pool.hpp>
 #include <boost/asio/detail/op_queue.hpp>
 #include <boost/asio/detail/reactor_op.hpp>
+#include <boost/asio/detail/reactor_op_deadline.hpp>
 #include <boost/asio/detail/select_interrupter.hpp>
 #include <boost/asio/detail/socket_types.hpp>
 #include <boost/asio/detail/timer_queue_base.hpp>
@@ -132,6 +133,22 @@ public:
   BOOST_ASIO_DECL void cancel_ops(socket_type descriptor,
       per_descriptor_data& descriptor_data);
 
+  // Cancel all operations associated with the given descriptor and
+  // cancellation key. The handlers associated with the descriptor will be
+  // invoked with the operation_aborted error.
+  BOOST_ASIO_DECL void cancel_ops_by_key(socket_type descriptor,
+      per_descriptor_data& descriptor_data,
+      int op_type, void* cancellation_key);
+
+#if defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+  // Cancel the deadline of an operation that has completed.
+  BOOST_ASIO_DECL void cancel_deadline(reactor_op_deadline* deadline);
+
+  // Complete the operation associated with an expired deadline, if it is still
+  // pending. The handler will be invoked with the timed_out error.
+  BOOST_ASIO_DECL void expire_deadline(reactor_op_deadline* deadline);
+#endif // defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+
   // Cancel any operations that are running against the descriptor and remove
   // its registration from the reactor. The reactor resources associated with
   // the descriptor must be released by calling cleanup_descriptor_data.
@@ -171,6 +188,12 @@ public:
       typename timer_queue<Time_Traits>::per_timer_data& timer,
       std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)());
 
+  // Cancel the timer operations associated with the given key.
+  template <typename Time_Traits>
+  void cancel_timer_by_key(timer_queue<Time_Traits>& queue,
+      typename timer_queue<Time_Traits>::per_timer_data* timer,
+      void* cancellation_key);
+
   // Move the timer operations associated with the given timer.
   template <typename Time_Traits>
   void move_timer(timer_queue<Time_Traits>& queue,
@@ -203,6 +226,13 @@ private:
   // Get the timeout value for the kevent call.
   BOOST_ASIO_DECL timespec* get_timeout(long usec, timespec& ts);
 
+#if defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+  // Schedule the deadline of an operation that is being queued. The
+  // descriptor's mutex must be held.
+  BOOST_ASIO_DECL void schedule_deadline(reactor_op_deadline* deadline,
+      int op_type, socket_type descriptor, descriptor_state* descriptor_data);
+#endif // defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+
   // The scheduler used to post completions.
   scheduler& scheduler_;
 
@@ -218,6 +248,11 @@ private:
   // The timer queues.
   timer_queue_set timer_queues_;
 
+#if defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+  // The queue of deadlines for pending operations.
+  reactor_op_deadline::queue_type deadline_queue_;
+#endif // defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+
   // Whether the service has been shut down.
   bool shutdown_;
 
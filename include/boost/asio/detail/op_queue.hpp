@@ -133,6 +133,24 @@ public:
     }
   }
 
+  // Push all operations from another queue on to the front of the queue. The
+  // source queue may contain operations of a derived type.
+  template <typename OtherOperation>
+  void push_front(op_queue<OtherOperation>& q)
+  {
+    if (Operation* other_front = op_queue_access::front(q))
+    {
+      Operation* other_back = op_queue_access::back(q);
+      if (front_)
+        op_queue_access::next(other_back, front_);
+      else
+        back_ = other_back;
+      front_ = other_front;
+      op_queue_access::front(q) = 0;
+      op_queue_access::back(q) = 0;
+    }
+  }
+
   // Whether the queue is empty.
   bool empty() const
   {
@@ -26,6 +26,10 @@
 #include <boost/asio/detail/socket_holder.hpp>
 #include <boost/asio/detail/socket_ops.hpp>
 
+#if defined(BOOST_ASIO_HAS_MOVE)
+# include <vector>
+#endif // defined(BOOST_ASIO_HAS_MOVE)
+
 #include <boost/asio/detail/push_options.hpp>
 
 namespace boost {
@@ -233,6 +237,150 @@ private:
   handler_work<Handler, IoExecutor> work_;
 };
 
+template <typename Protocol, typename PeerIoExecutor,
+    typename Handler, typename IoExecutor>
+class reactive_socket_accept_many_op : public reactor_op
+{
+public:
+  BOOST_ASIO_DEFINE_HANDLER_PTR(reactive_socket_accept_many_op);
+
+  reactive_socket_accept_many_op(const boost::system::error_code& success_ec,
+      const PeerIoExecutor& peer_io_ex, socket_type socket,
+      socket_ops::state_type state, const Protocol& protocol,
+      std::size_t max_sockets, Handler& handler, const IoExecutor& io_ex)
+    : reactor_op(success_ec, &reactive_socket_accept_many_op::do_perform,
+        &reactive_socket_accept_many_op::do_complete),
+      socket_(socket),
+      state_(state),
+      protocol_(protocol),
+      peer_io_ex_(peer_io_ex),
+      new_sockets_(max_sockets > 0 ? max_sockets : 1, invalid_socket),
+      count_(0),
+      handler_(BOOST_ASIO_MOVE_CAST(Handler)(handler)),
+      work_(handler_, io_ex)
+  {
+  }
+
+  // Close any accepted sockets that were not passed to the handler.
+  ~reactive_socket_accept_many_op()
+  {
+    for (std::size_t i = 0; i < count_; ++i)
+      socket_holder new_socket(new_sockets_[i]);
+  }
+
+  static status do_perform(reactor_op* base)
+  {
+    reactive_socket_accept_many_op* o(
+        static_cast<reactive_socket_accept_many_op*>(base));
+
+    status result = socket_ops::non_blocking_accept_many(o->socket_,
+        o->state_, &o->new_sockets_[0], o->new_sockets_.size(),
+        o->count_, o->ec_) ? done : not_done;
+
+    BOOST_ASIO_HANDLER_REACTOR_OPERATION((*o, "non_blocking_accept_many",
+          o->ec_));
+
+    return result;
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const boost::system::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    reactive_socket_accept_many_op* o(
+        static_cast<reactive_socket_accept_many_op*>(base));
+    ptr p = { boost::asio::detail::addressof(o->handler_), o, o };
+
+    // On success, assign new connections to peer socket objects.
+    std::vector<peer_socket_type> peers;
+    if (owner)
+      o->do_assign(peers);
+
+    BOOST_ASIO_HANDLER_COMPLETION((*o));
+
+    // Take ownership of the operation's outstanding work.
+    handler_work<Handler, IoExecutor> w(
+        BOOST_ASIO_MOVE_CAST2(handler_work<Handler, IoExecutor>)(
+          o->work_));
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::move_binder2<Handler,
+      boost::system::error_code, std::vector<peer_socket_type> >
+        handler(0, BOOST_ASIO_MOVE_CAST(Handler)(o->handler_), o->ec_,
+          BOOST_ASIO_MOVE_CAST(std::vector<peer_socket_type>)(peers));
+    p.h = boost::asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      BOOST_ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, "..."));
+      w.complete(handler, handler.handler_);
+      BOOST_ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  typedef typename Protocol::socket::template
+    rebind_executor<PeerIoExecutor>::other peer_socket_type;
+
+  // A peer socket that can be given a descriptor that was accepted in
+  // non-blocking mode, so that its mode need not be changed again before the
+  // first asynchronous operation.
+  class accepted_socket : public peer_socket_type
+  {
+  public:
+    explicit accepted_socket(const PeerIoExecutor& ex)
+      : peer_socket_type(ex)
+    {
+    }
+
+    void assign_non_blocking(const Protocol& protocol,
+        socket_type new_socket, boost::system::error_code& ec)
+    {
+      this->impl_.get_service().assign_non_blocking(
+          this->impl_.get_implementation(), protocol, new_socket, ec);
+    }
+  };
+
+  void do_assign(std::vector<peer_socket_type>& peers)
+  {
+    peers.reserve(count_);
+    for (std::size_t i = 0; i < count_; ++i)
+    {
+      accepted_socket peer(peer_io_ex_);
+      boost::system::error_code ec;
+      peer.assign_non_blocking(protocol_, new_sockets_[i], ec);
+      if (ec)
+      {
+        // Report the error only if there are no connections to deliver. The
+        // remaining sockets are closed when the operation is destroyed.
+        if (peers.empty())
+          ec_ = ec;
+        return;
+      }
+      new_sockets_[i] = invalid_socket;
+      peers.push_back(BOOST_ASIO_MOVE_CAST(peer_socket_type)(peer));
+    }
+  }
+
+  socket_type socket_;
+  socket_ops::state_type state_;
+  Protocol protocol_;
+  PeerIoExecutor peer_io_ex_;
+  std::vector<socket_type> new_sockets_;
+  std::size_t count_;
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
 #endif // defined(BOOST_ASIO_HAS_MOVE)
 
 } // namespace detail
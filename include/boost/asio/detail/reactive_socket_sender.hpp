@@ -0,0 +1,464 @@
+//
+// detail/reactive_socket_sender.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_REACTIVE_SOCKET_SENDER_HPP
+#define BOOST_ASIO_DETAIL_REACTIVE_SOCKET_SENDER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_IO_SENDERS)
+
+#include <boost/asio/socket_base.hpp>
+#include <boost/asio/detail/fenced_block.hpp>
+#include <boost/asio/detail/handler_tracking.hpp>
+#include <boost/asio/detail/io_sender_base.hpp>
+#include <boost/asio/detail/reactive_socket_accept_op.hpp>
+#include <boost/asio/detail/reactive_socket_recv_op.hpp>
+#include <boost/asio/detail/reactive_socket_send_op.hpp>
+#include <boost/asio/detail/type_traits.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// A receive operation constructed inside a sender's operation state. On
+// completion the operation destroys itself and passes its result to the
+// operation state that owns its storage.
+template <typename MutableBufferSequence, typename Owner>
+class reactive_socket_recv_sender_op :
+  public reactive_socket_recv_op_base<MutableBufferSequence>
+{
+public:
+  reactive_socket_recv_sender_op(const boost::system::error_code& success_ec,
+      socket_type socket, socket_ops::state_type state,
+      const MutableBufferSequence& buffers, socket_base::message_flags flags,
+      Owner& owner)
+    : reactive_socket_recv_op_base<MutableBufferSequence>(success_ec, socket,
+        state, buffers, flags, &reactive_socket_recv_sender_op::do_complete),
+      owner_(owner)
+  {
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const boost::system::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    reactive_socket_recv_sender_op* o(
+        static_cast<reactive_socket_recv_sender_op*>(base));
+
+    BOOST_ASIO_HANDLER_COMPLETION((*o));
+
+    // Copy the results out so that the operation can be destroyed before the
+    // upcall is made. The upcall may destroy the storage.
+    Owner& op_owner(o->owner_);
+    boost::system::error_code ec(o->ec_);
+    std::size_t bytes_transferred(o->bytes_transferred_);
+    o->~reactive_socket_recv_sender_op();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      BOOST_ASIO_HANDLER_INVOCATION_BEGIN((ec, bytes_transferred));
+      op_owner.complete(ec, bytes_transferred);
+      BOOST_ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  Owner& owner_;
+};
+
+// A send operation constructed inside a sender's operation state.
+template <typename ConstBufferSequence, typename Owner>
+class reactive_socket_send_sender_op :
+  public reactive_socket_send_op_base<ConstBufferSequence>
+{
+public:
+  reactive_socket_send_sender_op(const boost::system::error_code& success_ec,
+      socket_type socket, socket_ops::state_type state,
+      const ConstBufferSequence& buffers, socket_base::message_flags flags,
+      Owner& owner)
+    : reactive_socket_send_op_base<ConstBufferSequence>(success_ec, socket,
+        state, buffers, flags, &reactive_socket_send_sender_op::do_complete),
+      owner_(owner)
+  {
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const boost::system::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    reactive_socket_send_sender_op* o(
+        static_cast<reactive_socket_send_sender_op*>(base));
+
+    BOOST_ASIO_HANDLER_COMPLETION((*o));
+
+    // Copy the results out so that the operation can be destroyed before the
+    // upcall is made. The upcall may destroy the storage.
+    Owner& op_owner(o->owner_);
+    boost::system::error_code ec(o->ec_);
+    std::size_t bytes_transferred(o->bytes_transferred_);
+    o->~reactive_socket_send_sender_op();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      BOOST_ASIO_HANDLER_INVOCATION_BEGIN((ec, bytes_transferred));
+      op_owner.complete(ec, bytes_transferred);
+      BOOST_ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  Owner& owner_;
+};
+
+// An accept operation constructed inside a sender's operation state.
+template <typename Socket, typename Protocol, typename Owner>
+class reactive_socket_accept_sender_op :
+  public reactive_socket_accept_op_base<Socket, Protocol>
+{
+public:
+  reactive_socket_accept_sender_op(const boost::system::error_code& success_ec,
+      socket_type socket, socket_ops::state_type state, Socket& peer,
+      const Protocol& protocol, typename Protocol::endpoint* peer_endpoint,
+      Owner& owner)
+    : reactive_socket_accept_op_base<Socket, Protocol>(
+        success_ec, socket, state, peer, protocol, peer_endpoint,
+        &reactive_socket_accept_sender_op::do_complete),
+      owner_(owner)
+  {
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const boost::system::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    reactive_socket_accept_sender_op* o(
+        static_cast<reactive_socket_accept_sender_op*>(base));
+
+    // On success, assign new connection to peer socket object.
+    if (owner)
+      o->do_assign();
+
+    BOOST_ASIO_HANDLER_COMPLETION((*o));
+
+    // Copy the result out so that the operation can be destroyed before the
+    // upcall is made. The upcall may destroy the storage.
+    Owner& op_owner(o->owner_);
+    boost::system::error_code ec(o->ec_);
+    o->~reactive_socket_accept_sender_op();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      BOOST_ASIO_HANDLER_INVOCATION_BEGIN((ec));
+      op_owner.complete(ec);
+      BOOST_ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  Owner& owner_;
+};
+
+// The operation state produced by connecting a reactive_socket_recv_sender.
+// The reactor operation is constructed in the state's own storage when the
+// state is started.
+template <typename Service, typename MutableBufferSequence, typename Receiver>
+class reactive_socket_recv_sender_operation
+{
+public:
+  typedef typename Service::implementation_type implementation_type;
+
+  template <typename R>
+  reactive_socket_recv_sender_operation(Service& service,
+      implementation_type& impl, const MutableBufferSequence& buffers,
+      socket_base::message_flags flags, BOOST_ASIO_MOVE_ARG(R) r)
+    : service_(&service),
+      impl_(&impl),
+      buffers_(buffers),
+      flags_(flags),
+      receiver_(BOOST_ASIO_MOVE_CAST(R)(r))
+  {
+  }
+
+  // Operation states may only be moved before they are started.
+  reactive_socket_recv_sender_operation(
+      reactive_socket_recv_sender_operation&& other)
+    : service_(other.service_),
+      impl_(other.impl_),
+      buffers_(other.buffers_),
+      flags_(other.flags_),
+      receiver_(BOOST_ASIO_MOVE_CAST(Receiver)(other.receiver_))
+  {
+  }
+
+  void start() BOOST_ASIO_NOEXCEPT
+  {
+    service_->template async_receive_in_place<op>(
+        *impl_, &storage_, buffers_, flags_, *this);
+  }
+
+private:
+  typedef reactive_socket_recv_sender_op<MutableBufferSequence,
+      reactive_socket_recv_sender_operation> op;
+  friend class reactive_socket_recv_sender_op<MutableBufferSequence,
+      reactive_socket_recv_sender_operation>;
+
+  void complete(const boost::system::error_code& ec,
+      std::size_t bytes_transferred)
+  {
+    io_sender_complete(receiver_, ec, bytes_transferred);
+  }
+
+  Service* service_;
+  implementation_type* impl_;
+  MutableBufferSequence buffers_;
+  socket_base::message_flags flags_;
+  Receiver receiver_;
+  typename aligned_storage<sizeof(op), alignment_of<op>::value>::type storage_;
+};
+
+// A sender for an asynchronous receive on a reactor-based socket.
+template <typename Service, typename MutableBufferSequence>
+class reactive_socket_recv_sender : public io_sender_base<std::size_t>
+{
+public:
+  typedef typename Service::implementation_type implementation_type;
+
+  reactive_socket_recv_sender(Service& service, implementation_type& impl,
+      const MutableBufferSequence& buffers, socket_base::message_flags flags)
+    : service_(&service),
+      impl_(&impl),
+      buffers_(buffers),
+      flags_(flags)
+  {
+  }
+
+  template <typename Receiver>
+  reactive_socket_recv_sender_operation<Service,
+      MutableBufferSequence, typename remove_cvref<Receiver>::type>
+  connect(BOOST_ASIO_MOVE_ARG(Receiver) r) const
+  {
+    return reactive_socket_recv_sender_operation<Service,
+        MutableBufferSequence, typename remove_cvref<Receiver>::type>(
+          *service_, *impl_, buffers_, flags_,
+          BOOST_ASIO_MOVE_CAST(Receiver)(r));
+  }
+
+private:
+  Service* service_;
+  implementation_type* impl_;
+  MutableBufferSequence buffers_;
+  socket_base::message_flags flags_;
+};
+
+// The operation state produced by connecting a reactive_socket_send_sender.
+template <typename Service, typename ConstBufferSequence, typename Receiver>
+class reactive_socket_send_sender_operation
+{
+public:
+  typedef typename Service::implementation_type implementation_type;
+
+  template <typename R>
+  reactive_socket_send_sender_operation(Service& service,
+      implementation_type& impl, const ConstBufferSequence& buffers,
+      socket_base::message_flags flags, BOOST_ASIO_MOVE_ARG(R) r)
+    : service_(&service),
+      impl_(&impl),
+      buffers_(buffers),
+      flags_(flags),
+      receiver_(BOOST_ASIO_MOVE_CAST(R)(r))
+  {
+  }
+
+  // Operation states may only be moved before they are started.
+  reactive_socket_send_sender_operation(
+      reactive_socket_send_sender_operation&& other)
+    : service_(other.service_),
+      impl_(other.impl_),
+      buffers_(other.buffers_),
+      flags_(other.flags_),
+      receiver_(BOOST_ASIO_MOVE_CAST(Receiver)(other.receiver_))
+  {
+  }
+
+  void start() BOOST_ASIO_NOEXCEPT
+  {
+    service_->template async_send_in_place<op>(
+        *impl_, &storage_, buffers_, flags_, *this);
+  }
+
+private:
+  typedef reactive_socket_send_sender_op<ConstBufferSequence,
+      reactive_socket_send_sender_operation> op;
+  friend class reactive_socket_send_sender_op<ConstBufferSequence,
+      reactive_socket_send_sender_operation>;
+
+  void complete(const boost::system::error_code& ec,
+      std::size_t bytes_transferred)
+  {
+    io_sender_complete(receiver_, ec, bytes_transferred);
+  }
+
+  Service* service_;
+  implementation_type* impl_;
+  ConstBufferSequence buffers_;
+  socket_base::message_flags flags_;
+  Receiver receiver_;
+  typename aligned_storage<sizeof(op), alignment_of<op>::value>::type storage_;
+};
+
+// A sender for an asynchronous send on a reactor-based socket.
+template <typename Service, typename ConstBufferSequence>
+class reactive_socket_send_sender : public io_sender_base<std::size_t>
+{
+public:
+  typedef typename Service::implementation_type implementation_type;
+
+  reactive_socket_send_sender(Service& service, implementation_type& impl,
+      const ConstBufferSequence& buffers, socket_base::message_flags flags)
+    : service_(&service),
+      impl_(&impl),
+      buffers_(buffers),
+      flags_(flags)
+  {
+  }
+
+  template <typename Receiver>
+  reactive_socket_send_sender_operation<Service,
+      ConstBufferSequence, typename remove_cvref<Receiver>::type>
+  connect(BOOST_ASIO_MOVE_ARG(Receiver) r) const
+  {
+    return reactive_socket_send_sender_operation<Service,
+        ConstBufferSequence, typename remove_cvref<Receiver>::type>(
+          *service_, *impl_, buffers_, flags_,
+          BOOST_ASIO_MOVE_CAST(Receiver)(r));
+  }
+
+private:
+  Service* service_;
+  implementation_type* impl_;
+  ConstBufferSequence buffers_;
+  socket_base::message_flags flags_;
+};
+
+// The operation state produced by connecting a reactive_socket_accept_sender.
+template <typename Service, typename Socket, typename Receiver>
+class reactive_socket_accept_sender_operation
+{
+public:
+  typedef typename Service::implementation_type implementation_type;
+  typedef typename Service::endpoint_type endpoint_type;
+
+  template <typename R>
+  reactive_socket_accept_sender_operation(Service& service,
+      implementation_type& impl, Socket& peer,
+      endpoint_type* peer_endpoint, BOOST_ASIO_MOVE_ARG(R) r)
+    : service_(&service),
+      impl_(&impl),
+      peer_(&peer),
+      peer_endpoint_(peer_endpoint),
+      receiver_(BOOST_ASIO_MOVE_CAST(R)(r))
+  {
+  }
+
+  // Operation states may only be moved before they are started.
+  reactive_socket_accept_sender_operation(
+      reactive_socket_accept_sender_operation&& other)
+    : service_(other.service_),
+      impl_(other.impl_),
+      peer_(other.peer_),
+      peer_endpoint_(other.peer_endpoint_),
+      receiver_(BOOST_ASIO_MOVE_CAST(Receiver)(other.receiver_))
+  {
+  }
+
+  void start() BOOST_ASIO_NOEXCEPT
+  {
+    service_->template async_accept_in_place<op>(
+        *impl_, &storage_, *peer_, peer_endpoint_, *this);
+  }
+
+private:
+  typedef reactive_socket_accept_sender_op<Socket,
+      typename Service::protocol_type,
+      reactive_socket_accept_sender_operation> op;
+  friend class reactive_socket_accept_sender_op<Socket,
+      typename Service::protocol_type,
+      reactive_socket_accept_sender_operation>;
+
+  void complete(const boost::system::error_code& ec)
+  {
+    io_sender_complete(receiver_, ec);
+  }
+
+  Service* service_;
+  implementation_type* impl_;
+  Socket* peer_;
+  endpoint_type* peer_endpoint_;
+  Receiver receiver_;
+  typename aligned_storage<sizeof(op), alignment_of<op>::value>::type storage_;
+};
+
+// A sender for an asynchronous accept on a reactor-based socket.
+template <typename Service, typename Socket>
+class reactive_socket_accept_sender : public io_sender_base<>
+{
+public:
+  typedef typename Service::implementation_type implementation_type;
+  typedef typename Service::endpoint_type endpoint_type;
+
+  reactive_socket_accept_sender(Service& service, implementation_type& impl,
+      Socket& peer, endpoint_type* peer_endpoint)
+    : service_(&service),
+      impl_(&impl),
+      peer_(&peer),
+      peer_endpoint_(peer_endpoint)
+  {
+  }
+
+  template <typename Receiver>
+  reactive_socket_accept_sender_operation<Service,
+      Socket, typename remove_cvref<Receiver>::type>
+  connect(BOOST_ASIO_MOVE_ARG(Receiver) r) const
+  {
+    return reactive_socket_accept_sender_operation<Service,
+        Socket, typename remove_cvref<Receiver>::type>(
+          *service_, *impl_, *peer_, peer_endpoint_,
+          BOOST_ASIO_MOVE_CAST(Receiver)(r));
+  }
+
+private:
+  Service* service_;
+  implementation_type* impl_;
+  Socket* peer_;
+  endpoint_type* peer_endpoint_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_IO_SENDERS)
+
+#endif // BOOST_ASIO_DETAIL_REACTIVE_SOCKET_SENDER_HPP
@@ -29,4 +29,10 @@
 # include <boost/asio/detail/select_reactor.hpp>
 #endif
 
+#if defined(BOOST_ASIO_HAS_OPERATION_DEADLINES) \
+  && defined(BOOST_ASIO_HEADER_ONLY)
+# include <boost/asio/detail/impl/reactor_op_deadline.ipp>
+#endif // defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+       //   && defined(BOOST_ASIO_HEADER_ONLY)
+
 #endif // BOOST_ASIO_DETAIL_REACTOR_HPP
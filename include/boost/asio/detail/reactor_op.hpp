@@ -24,6 +24,10 @@ namespace boost {
 namespace asio {
 namespace detail {
 
+#if defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+class reactor_op_deadline;
+#endif // defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+
 class reactor_op
   : public operation
 {
@@ -34,6 +38,14 @@ public:
   // The number of bytes transferred, to be passed to the completion handler.
   std::size_t bytes_transferred_;
 
+  // The operation key used for targeted cancellation.
+  void* cancellation_key_;
+
+#if defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+  // The deadline by which the operation must complete, if any.
+  reactor_op_deadline* deadline_;
+#endif // defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+
   // Status returned by perform function. May be used to decide whether it is
   // worth performing more operations on the descriptor immediately.
   enum status { not_done, done, done_and_exhausted };
@@ -52,11 +64,19 @@ protected:
     : operation(complete_func),
       ec_(success_ec),
       bytes_transferred_(0),
+      cancellation_key_(0),
+#if defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+      deadline_(0),
+#endif // defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
       perform_func_(perform_func)
   {
   }
 
 private:
+#if defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+  friend class reactor_op_deadline;
+#endif // defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+
   perform_func_type perform_func_;
 };
 
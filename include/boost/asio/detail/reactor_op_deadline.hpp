@@ -0,0 +1,127 @@
+//
+// detail/reactor_op_deadline.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_REACTOR_OP_DEADLINE_HPP
+#define BOOST_ASIO_DETAIL_REACTOR_OP_DEADLINE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+
+#include <boost/asio/detail/atomic_count.hpp>
+#include <boost/asio/detail/chrono.hpp>
+#include <boost/asio/detail/chrono_time_traits.hpp>
+#include <boost/asio/detail/reactor_fwd.hpp>
+#include <boost/asio/detail/reactor_op.hpp>
+#include <boost/asio/detail/socket_types.hpp>
+#include <boost/asio/detail/timer_queue.hpp>
+#include <boost/asio/detail/wait_op.hpp>
+#include <boost/asio/wait_traits.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// A deadline attached to a reactor operation. When the operation is queued
+// against its descriptor, the reactor schedules the deadline in its own timer
+// queue. If the deadline expires first, the operation is removed from the
+// descriptor's queue and completed with the timed_out error. Otherwise the
+// deadline is cancelled when the operation completes.
+class reactor_op_deadline
+  : public wait_op
+{
+public:
+  typedef chrono_time_traits<chrono::steady_clock,
+      boost::asio::wait_traits<chrono::steady_clock> > time_traits;
+  typedef time_traits::time_type time_type;
+  typedef timer_queue<time_traits> queue_type;
+
+  // Attach a deadline to an operation that has not yet been started.
+  BOOST_ASIO_DECL static void attach(reactor_op* op, const time_type& expiry);
+
+  // Called by the reactor, with the descriptor's operations locked, when it
+  // schedules the deadline. The reactor's queue then shares ownership of the
+  // deadline with the operation.
+  void scheduled(reactor* r, socket_type descriptor,
+      void* descriptor_data, int op_type)
+  {
+    reactor_ = r;
+    descriptor_ = descriptor;
+    descriptor_data_ = descriptor_data;
+    op_type_ = op_type;
+    ref_count_up(ref_count_);
+  }
+
+  // The absolute time at which the operation expires.
+  time_type expiry_;
+
+  // The per-timer data used by the reactor's deadline queue.
+  queue_type::per_timer_data timer_;
+
+  // The reactor that has scheduled the deadline, or 0 if it is unscheduled.
+  reactor* reactor_;
+
+  // The descriptor against which the operation was queued.
+  socket_type descriptor_;
+
+  // The reactor's per-descriptor data, if it uses any.
+  void* descriptor_data_;
+
+  // The type of the operation, used to find the operation's queue.
+  int op_type_;
+
+private:
+  reactor_op_deadline(const time_type& expiry, func_type op_complete_func)
+    : wait_op(&reactor_op_deadline::do_complete),
+      expiry_(expiry),
+      reactor_(0),
+      descriptor_(invalid_socket),
+      descriptor_data_(0),
+      op_type_(0),
+      ref_count_(1),
+      op_complete_func_(op_complete_func)
+  {
+  }
+
+  // Called when the deadline expires, or when it has been cancelled.
+  BOOST_ASIO_DECL static void do_complete(void* owner, operation* base,
+      const boost::system::error_code& ec, std::size_t bytes_transferred);
+
+  // Called in place of the completion function of the operation to which the
+  // deadline is attached.
+  BOOST_ASIO_DECL static void do_op_complete(void* owner, operation* base,
+      const boost::system::error_code& ec, std::size_t bytes_transferred);
+
+  // Release a reference, destroying the deadline if it was the last one.
+  BOOST_ASIO_DECL void release();
+
+  // The number of owners, being the operation and, once the deadline has been
+  // scheduled, the reactor's deadline queue.
+  atomic_count ref_count_;
+
+  // The operation's original completion function.
+  func_type op_complete_func_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+
+#endif // BOOST_ASIO_DETAIL_REACTOR_OP_DEADLINE_HPP
@@ -101,6 +101,71 @@ public:
     return this->cancel_operations(operations_.find(descriptor), ops, ec);
   }
 
+  // Cancel operations associated with the descriptor and the given
+  // cancellation key. Returns true if any operations were cancelled, in which
+  // case the reactor's event demultiplexing function may need to be
+  // interrupted and restarted.
+  bool cancel_operations_by_key(Descriptor descriptor, op_queue<operation>& ops,
+      void* cancellation_key, const boost::system::error_code& ec =
+        boost::asio::error::operation_aborted)
+  {
+    bool result = false;
+    iterator i = operations_.find(descriptor);
+    if (i != operations_.end())
+    {
+      op_queue<reactor_op> other_ops;
+      while (reactor_op* op = i->second.front())
+      {
+        i->second.pop();
+        if (op->cancellation_key_ == cancellation_key)
+        {
+          op->ec_ = ec;
+          ops.push(op);
+          result = true;
+        }
+        else
+          other_ops.push(op);
+      }
+      i->second.push(other_ops);
+      if (i->second.empty())
+        operations_.erase(i);
+    }
+    return result;
+  }
+
+#if defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+  // Complete the operation associated with the descriptor and the given
+  // deadline with the timed_out error. Returns true if an operation was
+  // completed, in which case the reactor's event demultiplexing function may
+  // need to be interrupted and restarted.
+  bool expire_operation(Descriptor descriptor, op_queue<operation>& ops,
+      reactor_op_deadline* deadline)
+  {
+    bool result = false;
+    iterator i = operations_.find(descriptor);
+    if (i != operations_.end())
+    {
+      op_queue<reactor_op> other_ops;
+      while (reactor_op* op = i->second.front())
+      {
+        i->second.pop();
+        if (op->deadline_ == deadline)
+        {
+          op->ec_ = boost::asio::error::timed_out;
+          ops.push(op);
+          result = true;
+        }
+        else
+          other_ops.push(op);
+      }
+      i->second.push(other_ops);
+      if (i->second.empty())
+        operations_.erase(i);
+    }
+    return result;
+  }
+#endif // defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+
   // Whether there are no operations in the queue.
   bool empty() const
   {
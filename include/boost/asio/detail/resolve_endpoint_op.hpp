@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include <boost/asio/detail/config.hpp>
+#include <boost/asio/associated_cancellation_slot.hpp>
 #include <boost/asio/detail/bind_handler.hpp>
 #include <boost/asio/detail/fenced_block.hpp>
 #include <boost/asio/detail/handler_alloc_helpers.hpp>
@@ -79,13 +80,20 @@ public:
       // The operation is being run on the worker io_context. Time to perform
       // the resolver operation.
     
-      // Perform the blocking endpoint resolution operation.
-      char host_name[NI_MAXHOST];
-      char service_name[NI_MAXSERV];
-      socket_ops::background_getnameinfo(o->cancel_token_, o->endpoint_.data(),
-          o->endpoint_.size(), host_name, NI_MAXHOST, service_name, NI_MAXSERV,
-          o->endpoint_.protocol().type(), o->ec_);
-      o->results_ = results_type::create(o->endpoint_, host_name, service_name);
+      // Perform the blocking endpoint resolution operation, unless the
+      // operation was cancelled while it was waiting for the worker thread.
+      if (o->cancellation_requested())
+        o->ec_ = boost::asio::error::operation_aborted;
+      else
+      {
+        char host_name[NI_MAXHOST];
+        char service_name[NI_MAXSERV];
+        socket_ops::background_getnameinfo(o->cancel_token_,
+            o->endpoint_.data(), o->endpoint_.size(), host_name, NI_MAXHOST,
+            service_name, NI_MAXSERV, o->endpoint_.protocol().type(), o->ec_);
+        o->results_ = results_type::create(
+            o->endpoint_, host_name, service_name);
+      }
 
       // Pass operation back to main io_context for completion.
       o->scheduler_.post_deferred_completion(o);
@@ -98,6 +106,17 @@ public:
 
       BOOST_ASIO_HANDLER_COMPLETION((*o));
 
+      // Any result is discarded if cancellation was requested. The installed
+      // cancellation handler refers to this operation, so it is removed from
+      // the handler's slot before the operation is destroyed.
+      if (o->cancellation_requested())
+      {
+        o->ec_ = boost::asio::error::operation_aborted;
+        o->results_ = results_type();
+      }
+      if (owner)
+        boost::asio::get_associated_cancellation_slot(o->handler_).clear();
+
       // Take ownership of the operation's outstanding work.
       handler_work<Handler, IoExecutor> w(
           BOOST_ASIO_MOVE_CAST2(handler_work<Handler, IoExecutor>)(
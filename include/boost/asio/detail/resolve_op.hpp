@@ -17,6 +17,7 @@
 
 #include <boost/asio/detail/config.hpp>
 #include <boost/asio/error.hpp>
+#include <boost/asio/detail/atomic_count.hpp>
 #include <boost/asio/detail/operation.hpp>
 
 #include <boost/asio/detail/push_options.hpp>
@@ -31,11 +32,28 @@ public:
   // The error code to be passed to the completion handler.
   boost::system::error_code ec_;
 
+  // Request per-operation cancellation. May be called while the blocking
+  // resolution is in progress on the worker thread.
+  void request_cancellation()
+  {
+    ref_count_up(cancelled_);
+  }
+
+  // Whether per-operation cancellation has been requested.
+  bool cancellation_requested() const
+  {
+    return static_cast<long>(cancelled_) != 0;
+  }
+
 protected:
   resolve_op(func_type complete_func)
-    : operation(complete_func)
+    : operation(complete_func),
+      cancelled_(0)
   {
   }
+
+private:
+  atomic_count cancelled_;
 };
 
 } // namespace detail
@@ -17,6 +17,7 @@
 
 #include <boost/asio/detail/config.hpp>
 #include <boost/asio/detail/bind_handler.hpp>
+#include <boost/asio/associated_cancellation_slot.hpp>
 #include <boost/asio/detail/fenced_block.hpp>
 #include <boost/asio/detail/handler_alloc_helpers.hpp>
 #include <boost/asio/detail/handler_invoke_helpers.hpp>
@@ -87,10 +88,14 @@ public:
       // The operation is being run on the worker io_context. Time to perform
       // the resolver operation.
     
-      // Perform the blocking host resolution operation.
-      socket_ops::background_getaddrinfo(o->cancel_token_,
-          o->query_.host_name().c_str(), o->query_.service_name().c_str(),
-          o->query_.hints(), &o->addrinfo_, o->ec_);
+      // Perform the blocking host resolution operation, unless the operation
+      // was cancelled while it was waiting for the worker thread.
+      if (o->cancellation_requested())
+        o->ec_ = boost::asio::error::operation_aborted;
+      else
+        socket_ops::background_getaddrinfo(o->cancel_token_,
+            o->query_.host_name().c_str(), o->query_.service_name().c_str(),
+            o->query_.hints(), &o->addrinfo_, o->ec_);
 
       // Pass operation back to main io_context for completion.
       o->scheduler_.post_deferred_completion(o);
@@ -103,6 +108,14 @@ public:
 
       BOOST_ASIO_HANDLER_COMPLETION((*o));
 
+      // Any result is discarded if cancellation was requested. The installed
+      // cancellation handler refers to this operation, so it is removed from
+      // the handler's slot before the operation is destroyed.
+      if (o->cancellation_requested())
+        o->ec_ = boost::asio::error::operation_aborted;
+      if (owner)
+        boost::asio::get_associated_cancellation_slot(o->handler_).clear();
+
       // Take ownership of the operation's outstanding work.
       handler_work<Handler, IoExecutor> w(
           BOOST_ASIO_MOVE_CAST2(handler_work<Handler, IoExecutor>)(
@@ -117,7 +130,7 @@ public:
       detail::binder2<Handler, boost::system::error_code, results_type>
         handler(o->handler_, o->ec_, results_type());
       p.h = boost::asio::detail::addressof(handler.handler_);
-      if (o->addrinfo_)
+      if (o->addrinfo_ && !o->ec_)
       {
         handler.arg2_ = results_type::create(o->addrinfo_,
             o->query_.host_name(), o->query_.service_name());
@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include <boost/asio/detail/config.hpp>
+#include <boost/asio/cancellation_type.hpp>
 #include <boost/asio/error.hpp>
 #include <boost/asio/execution_context.hpp>
 #include <boost/asio/detail/mutex.hpp>
@@ -107,6 +108,30 @@ protected:
   };
 #endif // !defined(BOOST_ASIO_WINDOWS_RUNTIME)
 
+  // Helper class used to implement per-operation cancellation.
+  class resolve_op_cancellation
+  {
+  public:
+    explicit resolve_op_cancellation(resolve_op* op)
+      : op_(op)
+    {
+    }
+
+    void operator()(cancellation_type_t type)
+    {
+      if (!!(type &
+            (cancellation_type::terminal
+              | cancellation_type::partial
+              | cancellation_type::total)))
+      {
+        op_->request_cancellation();
+      }
+    }
+
+  private:
+    resolve_op* op_;
+  };
+
   // Helper class to run the work scheduler in a thread.
   class work_scheduler_runner;
 
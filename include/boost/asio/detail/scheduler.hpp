@@ -30,6 +30,19 @@
 
 #include <boost/asio/detail/push_options.hpp>
 
+// The largest number of ready operations that a thread takes from the queue
+// on each acquisition of the lock, when the scheduler is optimised for a
+// single thread.
+#if !defined(BOOST_ASIO_SCHEDULER_BATCH_SIZE)
+# define BOOST_ASIO_SCHEDULER_BATCH_SIZE 16
+#endif // !defined(BOOST_ASIO_SCHEDULER_BATCH_SIZE)
+
+// The largest number of operations that a thread completes inline, one nested
+// within another, when the scheduler permits inline completion.
+#if !defined(BOOST_ASIO_SCHEDULER_INLINE_DEPTH)
+# define BOOST_ASIO_SCHEDULER_INLINE_DEPTH 8
+#endif // !defined(BOOST_ASIO_SCHEDULER_INLINE_DEPTH)
+
 namespace boost {
 namespace asio {
 namespace detail {
@@ -85,7 +98,10 @@ public:
   // Notify that some work has started.
   void work_started()
   {
-    ++outstanding_work_;
+    if (mutex_.enabled())
+      ++outstanding_work_;
+    else
+      unsynchronised_increment(outstanding_work_, 1);
   }
 
   // Used to compensate for a forthcoming work_finished call. Must be called
@@ -95,7 +111,8 @@ public:
   // Notify that some work has finished.
   void work_finished()
   {
-    if (--outstanding_work_ == 0)
+    if ((mutex_.enabled() ? --outstanding_work_
+          : unsynchronised_increment(outstanding_work_, -1)) == 0)
       stop();
   }
 
@@ -113,6 +130,13 @@ public:
   BOOST_ASIO_DECL void post_immediate_completion(
       operation* op, bool is_continuation);
 
+  // Invoke the given operation on the calling thread, if inline completion is
+  // enabled and the thread is running the scheduler, or otherwise request its
+  // invocation and return immediately. Assumes that work_started() has not yet
+  // been called for the operation.
+  BOOST_ASIO_DECL void dispatch_immediate_completion(
+      operation* op, bool is_continuation);
+
   // Request invocation of the given operations and return immediately. Assumes
   // that work_started() has not yet been called for the operations.
   BOOST_ASIO_DECL void post_immediate_completions(std::size_t n,
@@ -150,9 +174,11 @@ private:
   // Structure containing thread-specific data.
   typedef scheduler_thread_info thread_info;
 
-  // Run at most one operation. May block.
+  // Run at most max_ops operations. May block. Returns the number of
+  // operations run.
   BOOST_ASIO_DECL std::size_t do_run_one(mutex::scoped_lock& lock,
-      thread_info& this_thread, const boost::system::error_code& ec);
+      thread_info& this_thread, std::size_t max_ops,
+      const boost::system::error_code& ec);
 
   // Run at most one operation with a timeout. May block.
   BOOST_ASIO_DECL std::size_t do_wait_one(mutex::scoped_lock& lock,
@@ -162,6 +188,17 @@ private:
   BOOST_ASIO_DECL std::size_t do_poll_one(mutex::scoped_lock& lock,
       thread_info& this_thread, const boost::system::error_code& ec);
 
+  // Add to the count of unfinished work. When the scheduler does not lock,
+  // the count is accessed by only one thread at a time and an atomic
+  // read-modify-write operation is not required.
+  void increment_outstanding_work(long n)
+  {
+    if (mutex_.enabled())
+      increment(outstanding_work_, n);
+    else
+      unsynchronised_increment(outstanding_work_, n);
+  }
+
   // Stop the task and all idle threads.
   BOOST_ASIO_DECL void stop_all_threads(mutex::scoped_lock& lock);
 
@@ -181,9 +218,19 @@ private:
   struct work_cleanup;
   friend struct work_cleanup;
 
+  // Helper class to requeue the remainder of a batch on block exit.
+  struct batch_cleanup;
+  friend struct batch_cleanup;
+
   // Whether to optimise for single-threaded use cases.
   const bool one_thread_;
 
+  // Whether to poll the task continuously rather than block in it.
+  const bool busy_poll_;
+
+  // Whether operations that complete immediately may be invoked inline.
+  const bool inline_completion_;
+
   // Mutex to protect access to internal data.
   mutable mutex mutex_;
 
@@ -211,6 +258,10 @@ private:
   // Flag to indicate that the dispatcher has been stopped.
   bool stopped_;
 
+  // The number of times the dispatcher has been stopped. Used to detect a stop
+  // while running a batch of operations without the lock.
+  atomic_count stop_count_;
+
   // Flag to indicate that the dispatcher has been shut down.
   bool shutdown_;
 
@@ -65,9 +65,9 @@ protected:
 private:
   friend class op_queue_access;
   scheduler_operation* next_;
-  func_type func_;
 protected:
   friend class scheduler;
+  func_type func_;
   unsigned int task_result_; // Passed into bytes transferred.
 };
 
@@ -0,0 +1,141 @@
+//
+// detail/scheduler_sender.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_SCHEDULER_SENDER_HPP
+#define BOOST_ASIO_DETAIL_SCHEDULER_SENDER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_IO_SENDERS)
+
+#include <exception>
+#include <boost/asio/execution/set_error.hpp>
+#include <boost/asio/execution/set_value.hpp>
+#include <boost/asio/detail/fenced_block.hpp>
+#include <boost/asio/detail/handler_tracking.hpp>
+#include <boost/asio/detail/scheduler.hpp>
+#include <boost/asio/detail/scheduler_operation.hpp>
+#include <boost/asio/detail/type_traits.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// The operation state produced by connecting a scheduler_sender. The state is
+// itself the queued operation, so starting it does not allocate.
+template <typename Receiver>
+class scheduler_sender_operation : private scheduler_operation
+{
+public:
+  template <typename R>
+  scheduler_sender_operation(scheduler& s, BOOST_ASIO_MOVE_ARG(R) r)
+    : scheduler_operation(&scheduler_sender_operation::do_complete),
+      scheduler_(&s),
+      receiver_(BOOST_ASIO_MOVE_CAST(R)(r))
+  {
+  }
+
+  // Operation states may only be moved before they are started.
+  scheduler_sender_operation(scheduler_sender_operation&& other)
+    : scheduler_operation(&scheduler_sender_operation::do_complete),
+      scheduler_(other.scheduler_),
+      receiver_(BOOST_ASIO_MOVE_CAST(Receiver)(other.receiver_))
+  {
+  }
+
+  void start() BOOST_ASIO_NOEXCEPT
+  {
+    BOOST_ASIO_HANDLER_CREATION((scheduler_->context(),
+          *this, "io_context", scheduler_, 0, "schedule"));
+
+    scheduler_->post_immediate_completion(this, false);
+  }
+
+private:
+  static void do_complete(void* owner, scheduler_operation* base,
+      const boost::system::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    scheduler_sender_operation* o(
+        static_cast<scheduler_sender_operation*>(base));
+
+    // The receiver is not invoked if the operation is destroyed because its
+    // scheduler is shutting down.
+    if (owner)
+    {
+      BOOST_ASIO_HANDLER_COMPLETION((*o));
+      fenced_block b(fenced_block::half);
+      BOOST_ASIO_HANDLER_INVOCATION_BEGIN(());
+#if !defined(BOOST_ASIO_NO_EXCEPTIONS)
+      try
+      {
+#endif // !defined(BOOST_ASIO_NO_EXCEPTIONS)
+        execution::set_value(BOOST_ASIO_MOVE_CAST(Receiver)(o->receiver_));
+#if !defined(BOOST_ASIO_NO_EXCEPTIONS)
+      }
+      catch (...)
+      {
+        execution::set_error(BOOST_ASIO_MOVE_CAST(Receiver)(o->receiver_),
+            std::current_exception());
+      }
+#endif // !defined(BOOST_ASIO_NO_EXCEPTIONS)
+      BOOST_ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+  scheduler* scheduler_;
+  Receiver receiver_;
+};
+
+// A sender that completes on one of the threads running a scheduler.
+class scheduler_sender
+{
+public:
+  template <template <typename...> class Tuple,
+      template <typename...> class Variant>
+  using value_types = Variant<Tuple<> >;
+
+  template <template <typename...> class Variant>
+  using error_types = Variant<std::exception_ptr>;
+
+  BOOST_ASIO_STATIC_CONSTEXPR(bool, sends_done = false);
+
+  explicit scheduler_sender(scheduler& s) BOOST_ASIO_NOEXCEPT
+    : scheduler_(&s)
+  {
+  }
+
+  template <typename Receiver>
+  scheduler_sender_operation<typename remove_cvref<Receiver>::type>
+  connect(BOOST_ASIO_MOVE_ARG(Receiver) r) const
+  {
+    return scheduler_sender_operation<typename remove_cvref<Receiver>::type>(
+        *scheduler_, BOOST_ASIO_MOVE_CAST(Receiver)(r));
+  }
+
+private:
+  scheduler* scheduler_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_IO_SENDERS)
+
+#endif // BOOST_ASIO_DETAIL_SCHEDULER_SENDER_HPP
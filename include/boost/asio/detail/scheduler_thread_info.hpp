@@ -30,7 +30,9 @@ class scheduler_operation;
 struct scheduler_thread_info : public thread_info_base
 {
   op_queue<scheduler_operation> private_op_queue;
+  op_queue<scheduler_operation> private_batch_queue;
   long private_outstanding_work;
+  int inline_depth;
 };
 
 } // namespace detail
@@ -0,0 +1,195 @@
+//
+// detail/segmented_buffer_sequence.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_SEGMENTED_BUFFER_SEQUENCE_HPP
+#define BOOST_ASIO_DETAIL_SEGMENTED_BUFFER_SEQUENCE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <iterator>
+#include <boost/asio/buffer.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// The header of a fixed-size segment. The segment's data immediately follows
+// the header in the same allocation.
+struct segmented_buffer_segment
+{
+  segmented_buffer_segment* next_;
+  segmented_buffer_segment* prev_;
+
+  char* data()
+  {
+    return reinterpret_cast<char*>(this + 1);
+  }
+};
+
+// A buffer sequence that refers to a contiguous range of bytes held in a
+// chain of fixed-size segments. The sequence does not own the segments, and
+// neither the sequence nor its iterators allocate memory.
+template <typename Buffer>
+class segmented_buffer_sequence
+{
+public:
+  typedef Buffer value_type;
+
+  class const_iterator
+  {
+  public:
+    typedef std::ptrdiff_t difference_type;
+    typedef Buffer value_type;
+    typedef const Buffer* pointer;
+    typedef Buffer reference;
+    typedef std::bidirectional_iterator_tag iterator_category;
+
+    const_iterator()
+      : segment_(0),
+        position_(0),
+        first_offset_(0),
+        size_(0),
+        segment_size_(0)
+    {
+    }
+
+    Buffer operator*() const
+    {
+      std::size_t offset = position_ == 0 ? first_offset_ : 0;
+      std::size_t length = segment_size_ - offset;
+      if (length > size_ - position_)
+        length = size_ - position_;
+      return Buffer(segment_->data() + offset, length);
+    }
+
+    const_iterator& operator++()
+    {
+      position_ += (**this).size();
+      if (position_ < size_)
+        segment_ = segment_->next_;
+      return *this;
+    }
+
+    const_iterator operator++(int)
+    {
+      const_iterator tmp(*this);
+      ++*this;
+      return tmp;
+    }
+
+    const_iterator& operator--()
+    {
+      // Every element but the first starts on a segment boundary. The end
+      // iterator refers to the last segment, so only the position changes.
+      std::size_t first_length = segment_size_ - first_offset_;
+      if (position_ == size_)
+      {
+        position_ = size_ <= first_length ? 0 : first_length
+          + (size_ - first_length - 1) / segment_size_ * segment_size_;
+      }
+      else
+      {
+        segment_ = segment_->prev_;
+        position_ = position_ <= first_length ? 0 : position_ - segment_size_;
+      }
+      return *this;
+    }
+
+    const_iterator operator--(int)
+    {
+      const_iterator tmp(*this);
+      --*this;
+      return tmp;
+    }
+
+    friend bool operator==(const const_iterator& a, const const_iterator& b)
+    {
+      return a.position_ == b.position_;
+    }
+
+    friend bool operator!=(const const_iterator& a, const const_iterator& b)
+    {
+      return a.position_ != b.position_;
+    }
+
+  private:
+    friend class segmented_buffer_sequence;
+
+    const_iterator(segmented_buffer_segment* segment, std::size_t position,
+        const segmented_buffer_sequence& sequence)
+      : segment_(segment),
+        position_(position),
+        first_offset_(sequence.first_offset_),
+        size_(sequence.size_),
+        segment_size_(sequence.segment_size_)
+    {
+    }
+
+    segmented_buffer_segment* segment_;
+    std::size_t position_;
+    std::size_t first_offset_;
+    std::size_t size_;
+    std::size_t segment_size_;
+  };
+
+  // Construct an empty sequence.
+  segmented_buffer_sequence()
+    : first_(0),
+      last_(0),
+      first_offset_(0),
+      size_(0),
+      segment_size_(0)
+  {
+  }
+
+  // Construct a sequence of the given size that starts at an offset into the
+  // first segment and ends in the last segment.
+  segmented_buffer_sequence(segmented_buffer_segment* first,
+      std::size_t first_offset, segmented_buffer_segment* last,
+      std::size_t size, std::size_t segment_size)
+    : first_(first),
+      last_(last),
+      first_offset_(first_offset),
+      size_(size),
+      segment_size_(segment_size)
+  {
+  }
+
+  const_iterator begin() const
+  {
+    return const_iterator(first_, 0, *this);
+  }
+
+  const_iterator end() const
+  {
+    return const_iterator(last_, size_, *this);
+  }
+
+private:
+  segmented_buffer_segment* first_;
+  segmented_buffer_segment* last_;
+  std::size_t first_offset_;
+  std::size_t size_;
+  std::size_t segment_size_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_SEGMENTED_BUFFER_SEQUENCE_HPP
@@ -29,6 +29,7 @@
 #include <boost/asio/detail/mutex.hpp>
 #include <boost/asio/detail/op_queue.hpp>
 #include <boost/asio/detail/reactor_op.hpp>
+#include <boost/asio/detail/reactor_op_deadline.hpp>
 #include <boost/asio/detail/reactor_op_queue.hpp>
 #include <boost/asio/detail/select_interrupter.hpp>
 #include <boost/asio/detail/socket_types.hpp>
@@ -106,6 +107,22 @@ public:
   // operation_aborted error.
   BOOST_ASIO_DECL void cancel_ops(socket_type descriptor, per_descriptor_data&);
 
+  // Cancel all operations associated with the given descriptor and
+  // cancellation key. The handlers associated with the descriptor will be
+  // invoked with the operation_aborted error.
+  BOOST_ASIO_DECL void cancel_ops_by_key(socket_type descriptor,
+      per_descriptor_data& descriptor_data,
+      int op_type, void* cancellation_key);
+
+#if defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+  // Cancel the deadline of an operation that has completed.
+  BOOST_ASIO_DECL void cancel_deadline(reactor_op_deadline* deadline);
+
+  // Complete the operation associated with an expired deadline, if it is still
+  // pending. The handler will be invoked with the timed_out error.
+  BOOST_ASIO_DECL void expire_deadline(reactor_op_deadline* deadline);
+#endif // defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+
   // Cancel any operations that are running against the descriptor and remove
   // its registration from the reactor. The reactor resources associated with
   // the descriptor must be released by calling cleanup_descriptor_data.
@@ -149,6 +166,12 @@ public:
       typename timer_queue<Time_Traits>::per_timer_data& timer,
       std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)());
 
+  // Cancel the timer operations associated with the given key.
+  template <typename Time_Traits>
+  void cancel_timer_by_key(timer_queue<Time_Traits>& queue,
+      typename timer_queue<Time_Traits>::per_timer_data* timer,
+      void* cancellation_key);
+
   // Move the timer operations associated with the given timer.
   template <typename Time_Traits>
   void move_timer(timer_queue<Time_Traits>& queue,
@@ -204,6 +227,11 @@ private:
   // The timer queues.
   timer_queue_set timer_queues_;
 
+#if defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+  // The queue of deadlines for pending operations.
+  reactor_op_deadline::queue_type deadline_queue_;
+#endif // defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+
 #if defined(BOOST_ASIO_HAS_IOCP)
   // Helper class to run the reactor loop in a thread.
   class thread_function;
@@ -16,14 +16,25 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include <boost/asio/detail/config.hpp>
+#include <cstddef>
 #include <typeinfo>
 #include <boost/asio/detail/mutex.hpp>
 #include <boost/asio/detail/noncopyable.hpp>
 #include <boost/asio/detail/type_traits.hpp>
 #include <boost/asio/execution_context.hpp>
 
+#if defined(BOOST_ASIO_HAS_STD_ATOMIC)
+# include <atomic>
+#endif // defined(BOOST_ASIO_HAS_STD_ATOMIC)
+
 #include <boost/asio/detail/push_options.hpp>
 
+// The number of service types that may be found without searching the list of
+// services. Service types beyond this number are still found by searching.
+#if !defined(BOOST_ASIO_SERVICE_INDEX_SIZE)
+# define BOOST_ASIO_SERVICE_INDEX_SIZE 64
+#endif // !defined(BOOST_ASIO_SERVICE_INDEX_SIZE)
+
 namespace boost {
 namespace asio {
 
@@ -34,6 +45,27 @@ namespace detail {
 template <typename T>
 class typeid_wrapper {};
 
+#if defined(BOOST_ASIO_HAS_STD_ATOMIC)
+// Allocates a small integer to each service type on first use. The number is
+// the same in every execution context.
+class service_index_base
+{
+protected:
+  BOOST_ASIO_DECL static std::size_t next_index();
+};
+
+template <typename Service>
+class service_index : private service_index_base
+{
+public:
+  static std::size_t value()
+  {
+    static const std::size_t index = next_index();
+    return index;
+  }
+};
+#endif // defined(BOOST_ASIO_HAS_STD_ATOMIC)
+
 class service_registry
   : private noncopyable
 {
@@ -142,6 +174,36 @@ private:
   BOOST_ASIO_DECL bool do_has_service(
       const execution_context::service::key& key) const;
 
+#if defined(BOOST_ASIO_HAS_STD_ATOMIC)
+  // Find the service with the given type index, if it has been recorded. The
+  // service's key is checked because indexes allocated by different modules,
+  // each with its own counter, may collide.
+  execution_context::service* find_indexed_service(std::size_t index,
+      const execution_context::service::key& key) const
+  {
+    if (index < BOOST_ASIO_SERVICE_INDEX_SIZE)
+      if (execution_context::service* service
+          = indexed_services_[index].load(std::memory_order_acquire))
+        if (keys_match(service->key_, key))
+          return service;
+    return 0;
+  }
+
+  // Record the service for the given type index.
+  void index_service(std::size_t index, execution_context::service* service)
+  {
+    if (index < BOOST_ASIO_SERVICE_INDEX_SIZE)
+      indexed_services_[index].store(service, std::memory_order_release);
+  }
+
+  // Forget all recorded services.
+  void clear_indexed_services()
+  {
+    for (std::size_t i = 0; i < BOOST_ASIO_SERVICE_INDEX_SIZE; ++i)
+      indexed_services_[i].store(0, std::memory_order_relaxed);
+  }
+#endif // defined(BOOST_ASIO_HAS_STD_ATOMIC)
+
   // Mutex to protect access to internal data.
   mutable boost::asio::detail::mutex mutex_;
 
@@ -150,6 +212,14 @@ private:
 
   // The first service in the list of contained services.
   execution_context::service* first_service_;
+
+#if defined(BOOST_ASIO_HAS_STD_ATOMIC)
+  // The services found so far, indexed by service type. This allows a service
+  // to be found without locking the mutex or searching the list, and so each
+  // entry is written only once the service is in the list.
+  std::atomic<execution_context::service*>
+    indexed_services_[BOOST_ASIO_SERVICE_INDEX_SIZE];
+#endif // defined(BOOST_ASIO_HAS_STD_ATOMIC)
 };
 
 } // namespace detail
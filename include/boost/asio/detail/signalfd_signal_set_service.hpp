@@ -0,0 +1,253 @@
+//
+// detail/signalfd_signal_set_service.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_SIGNALFD_SIGNAL_SET_SERVICE_HPP
+#define BOOST_ASIO_DETAIL_SIGNALFD_SIGNAL_SET_SERVICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_SIGNALFD)
+
+#include <cstddef>
+#include <signal.h>
+#include <sys/signalfd.h>
+#include <boost/asio/error.hpp>
+#include <boost/asio/execution_context.hpp>
+#include <boost/asio/detail/handler_alloc_helpers.hpp>
+#include <boost/asio/detail/memory.hpp>
+#include <boost/asio/detail/mutex.hpp>
+#include <boost/asio/detail/op_queue.hpp>
+#include <boost/asio/detail/reactor.hpp>
+#include <boost/asio/detail/reactor_op.hpp>
+#include <boost/asio/detail/scheduler.hpp>
+#include <boost/asio/detail/signal_handler.hpp>
+#include <boost/asio/detail/signal_op.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// A signal set service that receives signals through a signalfd descriptor
+// owned by the service, rather than through a process-wide signal handler.
+//
+// The kernel delivers a signal to a signalfd descriptor only while the signal
+// is blocked, so the application must block the signals it adds, in every
+// thread, before they can arrive. A signal sent to the process is consumed by
+// whichever descriptor reads it first, so only one execution context should
+// wait for each signal.
+class signalfd_signal_set_service :
+  public execution_context_service_base<signalfd_signal_set_service>
+{
+public:
+  enum { max_signal_number = NSIG };
+
+  // Type used for tracking an individual signal registration.
+  class registration
+  {
+  public:
+    // Default constructor.
+    registration()
+      : signal_number_(0),
+        queue_(0),
+        undelivered_(0),
+        next_in_table_(0),
+        prev_in_table_(0),
+        next_in_set_(0)
+    {
+    }
+
+  private:
+    // Only this service will have access to the internal values.
+    friend class signalfd_signal_set_service;
+
+    // The signal number that is registered.
+    int signal_number_;
+
+    // The waiting signal handlers.
+    op_queue<signal_op>* queue_;
+
+    // The number of undelivered signals.
+    std::size_t undelivered_;
+
+    // Pointers to adjacent registrations in the registrations_ table.
+    registration* next_in_table_;
+    registration* prev_in_table_;
+
+    // Link to next registration in the signal set.
+    registration* next_in_set_;
+  };
+
+  // The implementation type of the signal_set.
+  class implementation_type
+  {
+  public:
+    // Default constructor.
+    implementation_type()
+      : signals_(0)
+    {
+    }
+
+  private:
+    // Only this service will have access to the internal values.
+    friend class signalfd_signal_set_service;
+
+    // The pending signal handlers.
+    op_queue<signal_op> queue_;
+
+    // Linked list of registered signals.
+    registration* signals_;
+  };
+
+  // Constructor.
+  BOOST_ASIO_DECL signalfd_signal_set_service(execution_context& context);
+
+  // Destructor.
+  BOOST_ASIO_DECL ~signalfd_signal_set_service();
+
+  // Destroy all user-defined handler objects owned by the service.
+  BOOST_ASIO_DECL void shutdown();
+
+  // Perform fork-related housekeeping.
+  BOOST_ASIO_DECL void notify_fork(
+      boost::asio::execution_context::fork_event fork_ev);
+
+  // Construct a new signal_set implementation.
+  BOOST_ASIO_DECL void construct(implementation_type& impl);
+
+  // Destroy a signal_set implementation.
+  BOOST_ASIO_DECL void destroy(implementation_type& impl);
+
+  // Add a signal to a signal_set.
+  BOOST_ASIO_DECL boost::system::error_code add(implementation_type& impl,
+      int signal_number, boost::system::error_code& ec);
+
+  // Remove a signal to a signal_set.
+  BOOST_ASIO_DECL boost::system::error_code remove(implementation_type& impl,
+      int signal_number, boost::system::error_code& ec);
+
+  // Remove all signals from a signal_set.
+  BOOST_ASIO_DECL boost::system::error_code clear(implementation_type& impl,
+      boost::system::error_code& ec);
+
+  // Cancel all operations associated with the signal set.
+  BOOST_ASIO_DECL boost::system::error_code cancel(implementation_type& impl,
+      boost::system::error_code& ec);
+
+  // Start an asynchronous operation to wait for a signal to be delivered.
+  template <typename Handler, typename IoExecutor>
+  void async_wait(implementation_type& impl,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    // Allocate and construct an operation to wrap the handler.
+    typedef signal_handler<Handler, IoExecutor> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(handler, io_ex);
+
+    BOOST_ASIO_HANDLER_CREATION((scheduler_.context(),
+          *p.p, "signal_set", &impl, 0, "async_wait"));
+
+    start_wait_op(impl, p.p);
+    p.v = p.p = 0;
+  }
+
+private:
+  // The operation used to read from the signalfd descriptor. It is owned by
+  // the service and remains registered with the reactor until the descriptor
+  // is deregistered.
+  class signalfd_read_op : public reactor_op
+  {
+  public:
+    explicit signalfd_read_op(signalfd_signal_set_service* service)
+      : reactor_op(boost::system::error_code(),
+          &signalfd_read_op::do_perform, &signalfd_read_op::do_complete),
+        service_(service)
+    {
+    }
+
+    BOOST_ASIO_DECL static status do_perform(reactor_op* base);
+
+    static void do_complete(void* /*owner*/, operation* /*base*/,
+        const boost::system::error_code& /*ec*/,
+        std::size_t /*bytes_transferred*/)
+    {
+    }
+
+  private:
+    signalfd_signal_set_service* service_;
+  };
+
+  // The number of signals read from the descriptor in a single call.
+  enum { max_signals_per_read = 16 };
+
+  // Change the set of signals received by the descriptor.
+  BOOST_ASIO_DECL boost::system::error_code update_mask(
+      int signal_number, bool add, boost::system::error_code& ec);
+
+  // Remove a registration from the registration table.
+  BOOST_ASIO_DECL void unlink_registration(registration* reg);
+
+  // Deliver signals read from the descriptor to waiting handlers.
+  BOOST_ASIO_DECL void deliver_signals(
+      const signalfd_siginfo* info, std::size_t count);
+
+  // Helper function to deregister and close the descriptor.
+  BOOST_ASIO_DECL void close_descriptor();
+
+  // Helper function to start a wait operation.
+  BOOST_ASIO_DECL void start_wait_op(implementation_type& impl, signal_op* op);
+
+  // The scheduler used for dispatching handlers.
+  scheduler& scheduler_;
+
+  // The reactor used for waiting for descriptor readiness.
+  reactor& reactor_;
+
+  // The per-descriptor reactor data used for the descriptor.
+  reactor::per_descriptor_data reactor_data_;
+
+  // The operation that reads signals from the descriptor.
+  signalfd_read_op read_op_;
+
+  // Mutex to protect access to internal data.
+  mutex mutex_;
+
+  // The signalfd descriptor.
+  int descriptor_;
+
+  // The signals received by the descriptor.
+  sigset_t mask_;
+
+  // A count of the number of objects that are registered for each signal.
+  std::size_t registration_count_[max_signal_number];
+
+  // A mapping from signal number to the registered signal sets.
+  registration* registrations_[max_signal_number];
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#if defined(BOOST_ASIO_HEADER_ONLY)
+# include <boost/asio/detail/impl/signalfd_signal_set_service.ipp>
+#endif // defined(BOOST_ASIO_HEADER_ONLY)
+
+#endif // defined(BOOST_ASIO_HAS_SIGNALFD)
+
+#endif // BOOST_ASIO_DETAIL_SIGNALFD_SIGNAL_SET_SERVICE_HPP
@@ -53,7 +53,10 @@ enum
   datagram_oriented = 32,
 
   // The socket may have been dup()-ed.
-  possible_dup = 64
+  possible_dup = 64,
+
+  // User wants readiness to wake only one reactor waiting on the socket.
+  exclusive_wake = 128
 };
 
 typedef unsigned char state_type;
@@ -67,6 +70,10 @@ typedef weak_ptr<void> weak_cancel_token_type;
 BOOST_ASIO_DECL socket_type accept(socket_type s, socket_addr_type* addr,
     std::size_t* addrlen, boost::system::error_code& ec);
 
+BOOST_ASIO_DECL socket_type accept_non_blocking(socket_type s,
+    socket_addr_type* addr, std::size_t* addrlen,
+    boost::system::error_code& ec);
+
 BOOST_ASIO_DECL socket_type sync_accept(socket_type s,
     state_type state, socket_addr_type* addr,
     std::size_t* addrlen, boost::system::error_code& ec);
@@ -84,6 +91,10 @@ BOOST_ASIO_DECL bool non_blocking_accept(socket_type s,
     state_type state, socket_addr_type* addr, std::size_t* addrlen,
     boost::system::error_code& ec, socket_type& new_socket);
 
+BOOST_ASIO_DECL bool non_blocking_accept_many(socket_type s,
+    state_type state, socket_type* new_sockets, std::size_t max_sockets,
+    std::size_t& count, boost::system::error_code& ec);
+
 #endif // defined(BOOST_ASIO_HAS_IOCP)
 
 BOOST_ASIO_DECL int bind(socket_type s, const socket_addr_type* addr,
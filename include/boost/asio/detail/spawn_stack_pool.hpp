@@ -0,0 +1,287 @@
+//
+// detail/spawn_stack_pool.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_SPAWN_STACK_POOL_HPP
+#define BOOST_ASIO_DETAIL_SPAWN_STACK_POOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_SPAWN_STACK_POOL)
+
+#include <cstddef>
+#include <new>
+#include <sys/mman.h>
+#include <boost/coroutine/stack_context.hpp>
+#include <boost/coroutine/stack_traits.hpp>
+#include <boost/asio/detail/noncopyable.hpp>
+#include <boost/asio/detail/throw_exception.hpp>
+
+#if defined(BOOST_USE_VALGRIND)
+# include <valgrind/valgrind.h>
+#endif // defined(BOOST_USE_VALGRIND)
+
+#include <boost/asio/detail/push_options.hpp>
+
+// The maximum number of idle stacks kept by each thread.
+#if !defined(BOOST_ASIO_SPAWN_STACK_POOL_SIZE)
+# define BOOST_ASIO_SPAWN_STACK_POOL_SIZE 1024
+#endif // !defined(BOOST_ASIO_SPAWN_STACK_POOL_SIZE)
+
+#if defined(__SANITIZE_ADDRESS__)
+# define BOOST_ASIO_SPAWN_STACK_POOL_ASAN 1
+#elif defined(__has_feature)
+# if __has_feature(address_sanitizer)
+#  define BOOST_ASIO_SPAWN_STACK_POOL_ASAN 1
+# endif // __has_feature(address_sanitizer)
+#endif // defined(__has_feature)
+
+#if defined(BOOST_ASIO_SPAWN_STACK_POOL_ASAN)
+# include <sanitizer/asan_interface.h>
+#endif // defined(BOOST_ASIO_SPAWN_STACK_POOL_ASAN)
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// A per-thread cache of coroutine stacks. Each stack is a single mapping with
+// an inaccessible guard page below the usable region. Stacks returned to the
+// cache keep their pages resident, so a reused stack neither needs new
+// mappings nor incurs page faults for the memory it has already touched.
+class spawn_stack_pool
+  : private noncopyable
+{
+public:
+  // Counters describing the pool's activity on the calling thread.
+  struct counters
+  {
+    // The number of stacks allocated.
+    std::size_t allocations;
+
+    // The number of allocations that were served from the cache.
+    std::size_t reuses;
+
+    // The number of stacks freed.
+    std::size_t deallocations;
+
+    // The number of freed stacks that were unmapped because the cache was
+    // full.
+    std::size_t releases;
+
+    // The number of idle stacks currently held in the cache.
+    std::size_t idle;
+  };
+
+  spawn_stack_pool()
+    : head_(0)
+  {
+    counters_ = counters();
+  }
+
+  ~spawn_stack_pool()
+  {
+    while (head_)
+    {
+      idle_stack* stack = head_;
+      head_ = stack->next_;
+      unmap(stack->sp_, stack->size_);
+    }
+  }
+
+  // Get a stack with exactly the given usable size, preferring an idle one.
+  void allocate(boost::coroutines::stack_context& ctx, std::size_t size)
+  {
+    ++counters_.allocations;
+    for (idle_stack** p = &head_; *p; p = &(*p)->next_)
+    {
+      if ((*p)->size_ == size)
+      {
+        idle_stack* stack = *p;
+        *p = stack->next_;
+        --counters_.idle;
+        ++counters_.reuses;
+        ctx.size = stack->size_;
+        ctx.sp = stack->sp_;
+        return;
+      }
+    }
+
+    map(ctx, size);
+  }
+
+  // Return a stack to the cache, or release it if the cache is full.
+  void deallocate(boost::coroutines::stack_context& ctx)
+  {
+    ++counters_.deallocations;
+    if (counters_.idle < BOOST_ASIO_SPAWN_STACK_POOL_SIZE)
+    {
+#if defined(BOOST_ASIO_SPAWN_STACK_POOL_ASAN)
+      // Frames abandoned by the final context switch remain poisoned.
+      __asan_unpoison_memory_region(
+          static_cast<char*>(ctx.sp) - ctx.size, ctx.size);
+#endif // defined(BOOST_ASIO_SPAWN_STACK_POOL_ASAN)
+
+      // The bookkeeping for an idle stack lives at the top of the stack.
+      idle_stack* stack = static_cast<idle_stack*>(ctx.sp) - 1;
+      stack->next_ = head_;
+      stack->sp_ = ctx.sp;
+      stack->size_ = ctx.size;
+      head_ = stack;
+      ++counters_.idle;
+    }
+    else
+    {
+      ++counters_.releases;
+      unmap(ctx.sp, ctx.size);
+    }
+  }
+
+  // Get the counters for the calling thread's pool.
+  const counters& get_counters() const
+  {
+    return counters_;
+  }
+
+  // Get the pool for the calling thread, or null if the thread's pool has
+  // already been destroyed. Stacks are returned to the pool of the thread that
+  // destroys the coroutine, which need not be the thread that created it.
+  static spawn_stack_pool* instance();
+
+  // Allocate a stack using the calling thread's pool.
+  static void thread_allocate(
+      boost::coroutines::stack_context& ctx, std::size_t size)
+  {
+    if (spawn_stack_pool* pool = instance())
+      pool->allocate(ctx, size);
+    else
+      map(ctx, size);
+  }
+
+  // Free a stack using the calling thread's pool.
+  static void thread_deallocate(boost::coroutines::stack_context& ctx)
+  {
+    if (spawn_stack_pool* pool = instance())
+      pool->deallocate(ctx);
+    else
+      unmap(ctx.sp, ctx.size);
+  }
+
+private:
+  struct idle_stack
+  {
+    idle_stack* next_;
+    void* sp_;
+    std::size_t size_;
+  };
+
+  // Set when the thread's pool has been destroyed, after which coroutines that
+  // are still outstanding map and unmap their stacks directly. Being trivially
+  // destructible, the flag remains usable during thread exit.
+  static bool& destroyed()
+  {
+    static thread_local bool flag = false;
+    return flag;
+  }
+
+  // The type of the calling thread's pool, which marks the pool as destroyed.
+  struct thread_pool;
+
+  static void map(boost::coroutines::stack_context& ctx, std::size_t size)
+  {
+    std::size_t page_size = boost::coroutines::stack_traits::page_size();
+    void* limit = ::mmap(0, size + page_size, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANON, -1, 0);
+    if (limit == MAP_FAILED)
+    {
+      std::bad_alloc ex;
+      boost::asio::detail::throw_exception(ex);
+    }
+
+    // Without the guard page a stack overflow would silently corrupt memory.
+    if (::mprotect(limit, page_size, PROT_NONE) != 0)
+    {
+      ::munmap(limit, size + page_size);
+      std::bad_alloc ex;
+      boost::asio::detail::throw_exception(ex);
+    }
+
+    ctx.size = size;
+    ctx.sp = static_cast<char*>(limit) + page_size + size;
+  }
+
+  static void unmap(void* sp, std::size_t size)
+  {
+    std::size_t page_size = boost::coroutines::stack_traits::page_size();
+    ::munmap(static_cast<char*>(sp) - size - page_size, size + page_size);
+  }
+
+  idle_stack* head_;
+  counters counters_;
+};
+
+struct spawn_stack_pool::thread_pool : spawn_stack_pool
+{
+  ~thread_pool()
+  {
+    destroyed() = true;
+  }
+};
+
+inline spawn_stack_pool* spawn_stack_pool::instance()
+{
+  if (destroyed())
+    return 0;
+  static thread_local thread_pool pool;
+  return &pool;
+}
+
+// The stack allocator used for coroutines created by spawn(). Satisfies the
+// Boost.Coroutine StackAllocator requirements.
+class spawn_stack_allocator
+{
+public:
+  void allocate(boost::coroutines::stack_context& ctx, std::size_t size)
+  {
+    // Round the requested size up to whole pages.
+    std::size_t page_size = boost::coroutines::stack_traits::page_size();
+    if (size < boost::coroutines::stack_traits::minimum_size())
+      size = boost::coroutines::stack_traits::minimum_size();
+    size = (size + page_size - 1) / page_size * page_size;
+
+    spawn_stack_pool::thread_allocate(ctx, size);
+
+#if defined(BOOST_USE_VALGRIND)
+    ctx.valgrind_stack_id = VALGRIND_STACK_REGISTER(
+        ctx.sp, static_cast<char*>(ctx.sp) - ctx.size);
+#endif // defined(BOOST_USE_VALGRIND)
+  }
+
+  void deallocate(boost::coroutines::stack_context& ctx)
+  {
+#if defined(BOOST_USE_VALGRIND)
+    VALGRIND_STACK_DEREGISTER(ctx.valgrind_stack_id);
+#endif // defined(BOOST_USE_VALGRIND)
+
+    spawn_stack_pool::thread_deallocate(ctx);
+  }
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_SPAWN_STACK_POOL)
+
+#endif // BOOST_ASIO_DETAIL_SPAWN_STACK_POOL_HPP
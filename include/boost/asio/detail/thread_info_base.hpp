@@ -52,6 +52,11 @@ public:
     enum { mem_index = 2 };
   };
 
+  struct cancellation_signal_tag
+  {
+    enum { mem_index = 3 };
+  };
+
   thread_info_base()
 #if defined(BOOST_ASIO_HAS_STD_EXCEPTION_PTR) \
   && !defined(BOOST_ASIO_NO_EXCEPTIONS)
@@ -165,7 +170,7 @@ public:
 
 private:
   enum { chunk_size = 4 };
-  enum { max_mem_index = 3 };
+  enum { max_mem_index = 4 };
   void* reusable_memory_[max_mem_index];
 
 #if defined(BOOST_ASIO_HAS_STD_EXCEPTION_PTR) \
@@ -49,10 +49,23 @@ public:
   public:
     per_timer_data() :
       heap_index_((std::numeric_limits<std::size_t>::max)()),
-      next_(0), prev_(0)
+      next_(0), prev_(0), slack_()
     {
     }
 
+    // Get the amount by which the timer's expiry may be delayed.
+    const duration_type& slack() const
+    {
+      return slack_;
+    }
+
+    // Set the amount by which the timer's expiry may be delayed. Applies to
+    // operations that are subsequently enqueued.
+    void set_slack(const duration_type& d)
+    {
+      slack_ = d;
+    }
+
   private:
     friend class timer_queue;
 
@@ -65,6 +78,9 @@ public:
     // Pointers to adjacent timers in a linked list.
     per_timer_data* next_;
     per_timer_data* prev_;
+
+    // The amount by which the timer's expiry may be delayed.
+    duration_type slack_;
   };
 
   // Constructor.
@@ -142,6 +158,21 @@ public:
         max_duration);
   }
 
+  // Get the time by which the given timer must fire, allowing for its slack.
+  long latest_wait_duration_usec(const per_timer_data& timer,
+      long max_duration) const
+  {
+    if (timer.heap_index_ >= heap_.size())
+      return max_duration;
+
+    return this->to_usec(
+        Time_Traits::to_posix_duration(
+          Time_Traits::subtract(
+            Time_Traits::add(heap_[timer.heap_index_].time_, timer.slack_),
+            Time_Traits::now())),
+        max_duration);
+  }
+
   // Dequeue all timers not later than the current time.
   virtual void get_ready_timers(op_queue<operation>& ops)
   {
@@ -193,11 +224,38 @@ public:
     return num_cancelled;
   }
 
+  // Cancel and dequeue a specific operation for the given timer.
+  void cancel_timer_by_key(per_timer_data* timer,
+      op_queue<operation>& ops, void* cancellation_key)
+  {
+    if (timer->prev_ != 0 || timer == timers_)
+    {
+      op_queue<wait_op> other_ops;
+      while (wait_op* op = timer->op_queue_.front())
+      {
+        timer->op_queue_.pop();
+        if (op->cancellation_key_ == cancellation_key)
+        {
+          op->ec_ = boost::asio::error::operation_aborted;
+          ops.push(op);
+        }
+        else
+          other_ops.push(op);
+      }
+      timer->op_queue_.push(other_ops);
+      if (timer->op_queue_.empty())
+        remove_timer(*timer);
+    }
+  }
+
   // Move operations from one timer to another, empty timer.
   void move_timer(per_timer_data& target, per_timer_data& source)
   {
     target.op_queue_.push(source.op_queue_);
 
+    target.slack_ = source.slack_;
+    source.slack_ = duration_type();
+
     target.heap_index_ = source.heap_index_;
     source.heap_index_ = (std::numeric_limits<std::size_t>::max)();
 
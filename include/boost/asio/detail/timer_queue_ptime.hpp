@@ -67,6 +67,10 @@ public:
   // Get the time for the timer that is earliest in the queue.
   BOOST_ASIO_DECL virtual long wait_duration_usec(long max_duration) const;
 
+  // Get the time by which the given timer must fire, allowing for its slack.
+  BOOST_ASIO_DECL long latest_wait_duration_usec(
+      const per_timer_data& timer, long max_duration) const;
+
   // Dequeue all timers not later than the current time.
   BOOST_ASIO_DECL virtual void get_ready_timers(op_queue<operation>& ops);
 
@@ -78,6 +82,10 @@ public:
       per_timer_data& timer, op_queue<operation>& ops,
       std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)());
 
+  // Cancel and dequeue a specific operation for the given timer.
+  BOOST_ASIO_DECL void cancel_timer_by_key(per_timer_data* timer,
+      op_queue<operation>& ops, void* cancellation_key);
+
   // Move operations from one timer to another, empty timer.
   BOOST_ASIO_DECL void move_timer(per_timer_data& target,
       per_timer_data& source);
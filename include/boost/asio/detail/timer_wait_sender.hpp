@@ -0,0 +1,154 @@
+//
+// detail/timer_wait_sender.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_TIMER_WAIT_SENDER_HPP
+#define BOOST_ASIO_DETAIL_TIMER_WAIT_SENDER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_IO_SENDERS)
+
+#include <boost/asio/detail/fenced_block.hpp>
+#include <boost/asio/detail/handler_tracking.hpp>
+#include <boost/asio/detail/io_sender_base.hpp>
+#include <boost/asio/detail/type_traits.hpp>
+#include <boost/asio/detail/wait_op.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// A timer wait operation constructed inside a sender's operation state. On
+// completion the operation destroys itself and passes its result to the
+// operation state that owns its storage.
+template <typename Owner>
+class timer_wait_sender_op : public wait_op
+{
+public:
+  explicit timer_wait_sender_op(Owner& owner)
+    : wait_op(&timer_wait_sender_op::do_complete),
+      owner_(owner)
+  {
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const boost::system::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    timer_wait_sender_op* o(static_cast<timer_wait_sender_op*>(base));
+
+    BOOST_ASIO_HANDLER_COMPLETION((*o));
+
+    // Copy the result out so that the operation can be destroyed before the
+    // upcall is made. The upcall may destroy the storage.
+    Owner& op_owner(o->owner_);
+    boost::system::error_code ec(o->ec_);
+    o->~timer_wait_sender_op();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      BOOST_ASIO_HANDLER_INVOCATION_BEGIN((ec));
+      op_owner.complete(ec);
+      BOOST_ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  Owner& owner_;
+};
+
+// The operation state produced by connecting a timer_wait_sender.
+template <typename Service, typename Receiver>
+class timer_wait_sender_operation
+{
+public:
+  typedef typename Service::implementation_type implementation_type;
+
+  template <typename R>
+  timer_wait_sender_operation(Service& service,
+      implementation_type& impl, BOOST_ASIO_MOVE_ARG(R) r)
+    : service_(&service),
+      impl_(&impl),
+      receiver_(BOOST_ASIO_MOVE_CAST(R)(r))
+  {
+  }
+
+  // Operation states may only be moved before they are started.
+  timer_wait_sender_operation(timer_wait_sender_operation&& other)
+    : service_(other.service_),
+      impl_(other.impl_),
+      receiver_(BOOST_ASIO_MOVE_CAST(Receiver)(other.receiver_))
+  {
+  }
+
+  void start() BOOST_ASIO_NOEXCEPT
+  {
+    service_->template async_wait_in_place<op>(*impl_, &storage_, *this);
+  }
+
+private:
+  typedef timer_wait_sender_op<timer_wait_sender_operation> op;
+  friend class timer_wait_sender_op<timer_wait_sender_operation>;
+
+  void complete(const boost::system::error_code& ec)
+  {
+    io_sender_complete(receiver_, ec);
+  }
+
+  Service* service_;
+  implementation_type* impl_;
+  Receiver receiver_;
+  typename aligned_storage<sizeof(op), alignment_of<op>::value>::type storage_;
+};
+
+// A sender for an asynchronous wait on a timer.
+template <typename Service>
+class timer_wait_sender : public io_sender_base<>
+{
+public:
+  typedef typename Service::implementation_type implementation_type;
+
+  timer_wait_sender(Service& service, implementation_type& impl)
+    : service_(&service),
+      impl_(&impl)
+  {
+  }
+
+  template <typename Receiver>
+  timer_wait_sender_operation<Service, typename remove_cvref<Receiver>::type>
+  connect(BOOST_ASIO_MOVE_ARG(Receiver) r) const
+  {
+    return timer_wait_sender_operation<Service,
+        typename remove_cvref<Receiver>::type>(
+          *service_, *impl_, BOOST_ASIO_MOVE_CAST(Receiver)(r));
+  }
+
+private:
+  Service* service_;
+  implementation_type* impl_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_IO_SENDERS)
+
+#endif // BOOST_ASIO_DETAIL_TIMER_WAIT_SENDER_HPP
@@ -0,0 +1,75 @@
+//
+// detail/utility.hpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_UTILITY_HPP
+#define BOOST_ASIO_DETAIL_UTILITY_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+#if defined(BOOST_ASIO_HAS_VARIADIC_TEMPLATES)
+
+template <std::size_t... I>
+struct index_sequence
+{
+  typedef index_sequence type;
+};
+
+template <typename S1, typename S2>
+struct join_index_sequences;
+
+template <std::size_t... I1, std::size_t... I2>
+struct join_index_sequences<index_sequence<I1...>, index_sequence<I2...> >
+  : index_sequence<I1..., (sizeof...(I1) + I2)...>
+{
+};
+
+template <std::size_t N>
+struct make_index_sequence
+  : join_index_sequences<
+      typename make_index_sequence<N / 2>::type,
+      typename make_index_sequence<N - N / 2>::type>
+{
+};
+
+template <>
+struct make_index_sequence<0> : index_sequence<>
+{
+};
+
+template <>
+struct make_index_sequence<1> : index_sequence<0>
+{
+};
+
+template <typename... T>
+struct index_sequence_for : make_index_sequence<sizeof...(T)>
+{
+};
+
+#endif // defined(BOOST_ASIO_HAS_VARIADIC_TEMPLATES)
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_UTILITY_HPP
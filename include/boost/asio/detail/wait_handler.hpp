@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include <boost/asio/detail/config.hpp>
+#include <boost/asio/associated_cancellation_slot.hpp>
 #include <boost/asio/detail/bind_handler.hpp>
 #include <boost/asio/detail/fenced_block.hpp>
 #include <boost/asio/detail/handler_alloc_helpers.hpp>
@@ -29,6 +30,32 @@ namespace boost {
 namespace asio {
 namespace detail {
 
+// Invokes a wait's completion handler, first removing the per-operation
+// cancellation handler from the handler's slot. The slot may only be used
+// from the handler's executor, so this is not done when the wait completes.
+template <typename Handler>
+class wait_handler_upcall
+{
+public:
+  wait_handler_upcall(Handler& h,
+      const boost::system::error_code& ec, bool clear_slot)
+    : handler_(h, ec),
+      clear_slot_(clear_slot)
+  {
+  }
+
+  void operator()()
+  {
+    if (clear_slot_)
+      boost::asio::get_associated_cancellation_slot(
+          handler_.handler_).clear();
+    handler_();
+  }
+
+  binder1<Handler, boost::system::error_code> handler_;
+  bool clear_slot_;
+};
+
 template <typename Handler, typename IoExecutor>
 class wait_handler : public wait_op
 {
@@ -63,17 +90,17 @@ public:
     // with the handler. Consequently, a local copy of the handler is required
     // to ensure that any owning sub-object remains valid until after we have
     // deallocated the memory here.
-    detail::binder1<Handler, boost::system::error_code>
-      handler(h->handler_, h->ec_);
-    p.h = boost::asio::detail::addressof(handler.handler_);
+    wait_handler_upcall<Handler> upcall(
+        h->handler_, h->ec_, h->cancellation_key_ != 0);
+    p.h = boost::asio::detail::addressof(upcall.handler_.handler_);
     p.reset();
 
     // Make the upcall if required.
     if (owner)
     {
       fenced_block b(fenced_block::half);
-      BOOST_ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_));
-      w.complete(handler, handler.handler_);
+      BOOST_ASIO_HANDLER_INVOCATION_BEGIN((upcall.handler_.arg1_));
+      w.complete(upcall, upcall.handler_.handler_);
       BOOST_ASIO_HANDLER_INVOCATION_END;
     }
   }
@@ -126,6 +126,15 @@ public:
     post_deferred_completion(op);
   }
 
+  // Request invocation of the given operations and return immediately. Assumes
+  // that work_started() has not yet been called for the operations.
+  void post_immediate_completions(std::size_t n,
+      op_queue<win_iocp_operation>& ops, bool)
+  {
+    ::InterlockedExchangeAdd(&outstanding_work_, static_cast<long>(n));
+    post_deferred_completions(ops);
+  }
+
   // Request invocation of the given operation and return immediately. Assumes
   // that work_started() was previously called for the operation.
   BOOST_ASIO_DECL void post_deferred_completion(win_iocp_operation* op);
@@ -201,6 +210,12 @@ public:
       typename timer_queue<Time_Traits>::per_timer_data& timer,
       std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)());
 
+  // Cancel the timer operations associated with the given key.
+  template <typename Time_Traits>
+  void cancel_timer_by_key(timer_queue<Time_Traits>& queue,
+      typename timer_queue<Time_Traits>::per_timer_data* timer,
+      void* cancellation_key);
+
   // Move the timer operations associated with the given timer.
   template <typename Time_Traits>
   void move_timer(timer_queue<Time_Traits>& queue,
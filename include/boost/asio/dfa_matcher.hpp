@@ -0,0 +1,181 @@
+//
+// dfa_matcher.hpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DFA_MATCHER_HPP
+#define BOOST_ASIO_DFA_MATCHER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/detail/dfa_table.hpp>
+#include <boost/asio/detail/memory.hpp>
+#include <boost/asio/detail/string_view.hpp>
+#include <boost/asio/detail/throw_error.hpp>
+#include <boost/asio/detail/type_traits.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+/// A precompiled, resumable match condition for use with read_until and
+/// async_read_until.
+/**
+ * The dfa_matcher class compiles a regular expression into a deterministic
+ * finite automaton. When used as the match condition for @c read_until or
+ * @c async_read_until, the automaton's state is carried from one read to the
+ * next, so that each byte is examined exactly once and no memory is allocated
+ * while searching.
+ *
+ * The match condition is satisfied at the first position at which some match
+ * of the pattern ends. For example, the pattern <tt>"\\r\\n\\r\\n"</tt> is
+ * satisfied immediately after the first blank line, and <tt>"a+"</tt> is
+ * satisfied immediately after the first @c a.
+ *
+ * The supported syntax is a subset of that of ECMAScript regular expressions:
+ *
+ * @li Literal characters, and @c . to match any character except newline.
+ *
+ * @li Bracket expressions such as <tt>[a-z0-9]</tt> and <tt>[^\\r\\n]</tt>.
+ *
+ * @li The escapes <tt>\\d \\D \\w \\W \\s \\S \\r \\n \\t \\f \\v \\0</tt>,
+ * <tt>\\xHH</tt>, and a backslash followed by a punctuation character.
+ *
+ * @li Grouping with <tt>(...)</tt> or <tt>(?:...)</tt>, alternation with
+ * <tt>|</tt>, and the repetitions <tt>* + ? {m} {m,} {m,n}</tt>.
+ *
+ * Anchors, back-references and assertions are not supported.
+ *
+ * The compiled automaton is shared between copies of a dfa_matcher object.
+ * Each copy has its own search state, so the same object may be passed to any
+ * number of concurrent @c read_until or @c async_read_until operations.
+ *
+ * @par Example
+ * To asynchronously read an HTTP header into a streambuf:
+ * @code boost::asio::streambuf b;
+ * boost::asio::dfa_matcher end_of_header("\r?\n\r?\n");
+ * ...
+ * void handler(const boost::system::error_code& e, std::size_t size)
+ * {
+ *   if (!e)
+ *   {
+ *     std::istream is(&b);
+ *     ...
+ *   }
+ * }
+ * ...
+ * boost::asio::async_read_until(s, b, end_of_header, handler); @endcode
+ */
+class dfa_matcher
+{
+public:
+  /// Compile a pattern.
+  /**
+   * @throws boost::system::system_error Thrown on failure, with the error
+   * boost::asio::error::invalid_argument if the pattern is malformed, uses
+   * unsupported syntax, or would result in an automaton that is too large.
+   */
+  explicit dfa_matcher(const char* pattern)
+    : state_(detail::dfa_table::start_state())
+  {
+    compile(pattern, std::char_traits<char>::length(pattern));
+  }
+
+  /// Compile a pattern.
+  /**
+   * @throws boost::system::system_error Thrown on failure, with the error
+   * boost::asio::error::invalid_argument if the pattern is malformed, uses
+   * unsupported syntax, or would result in an automaton that is too large.
+   */
+  explicit dfa_matcher(BOOST_ASIO_STRING_VIEW_PARAM pattern)
+    : state_(detail::dfa_table::start_state())
+  {
+    compile(pattern.data(), pattern.size());
+  }
+
+  /// Search a range for the end of a match.
+  /**
+   * Continues the search from the state left by any previous call.
+   *
+   * @returns <tt>(i, true)</tt> if a match ends at the position before @c i,
+   * in which case the search state is reset. Otherwise returns
+   * <tt>(end, false)</tt>, and a subsequent call will continue the search as
+   * if the two ranges were contiguous.
+   */
+  template <typename Iterator>
+  std::pair<Iterator, bool> operator()(Iterator begin, Iterator end)
+  {
+    const detail::dfa_table& table = *table_;
+    if (table.matches_empty())
+      return std::make_pair(begin, true);
+
+    const detail::dfa_table::state_type match_state = table.match_state();
+    detail::dfa_table::state_type state = state_;
+    for (Iterator iter = begin; iter != end;)
+    {
+      state = table.next(state, static_cast<unsigned char>(*iter));
+      ++iter;
+      if (state == match_state)
+      {
+        state_ = detail::dfa_table::start_state();
+        return std::make_pair(iter, true);
+      }
+    }
+
+    state_ = state;
+    return std::make_pair(end, false);
+  }
+
+  /// Discard any partial search state.
+  void reset() BOOST_ASIO_NOEXCEPT
+  {
+    state_ = detail::dfa_table::start_state();
+  }
+
+  /// Get the number of states in the compiled automaton.
+  std::size_t state_count() const BOOST_ASIO_NOEXCEPT
+  {
+    return table_->state_count();
+  }
+
+private:
+  void compile(const char* pattern, std::size_t length)
+  {
+    boost::system::error_code ec;
+    table_.reset(new detail::dfa_table(pattern, length, ec));
+    boost::asio::detail::throw_error(ec, "dfa_matcher");
+  }
+
+  detail::shared_ptr<const detail::dfa_table> table_;
+  detail::dfa_table::state_type state_;
+};
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <>
+struct is_match_condition<dfa_matcher>
+{
+  enum { value = 1 };
+};
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DFA_MATCHER_HPP
@@ -222,7 +222,10 @@ enum misc_errors
   not_found,
 
   /// The descriptor cannot fit into the select system call's fd_set.
-  fd_set_failure
+  fd_set_failure,
+
+  /// The channel has been closed.
+  channel_closed
 };
 
 inline const boost::system::error_category& get_system_category()
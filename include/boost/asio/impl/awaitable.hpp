@@ -20,6 +20,8 @@
 #include <new>
 #include <tuple>
 #include <utility>
+#include <boost/asio/cancellation_signal.hpp>
+#include <boost/asio/detail/awaitable_frame_pool.hpp>
 #include <boost/asio/detail/thread_context.hpp>
 #include <boost/asio/detail/thread_info_base.hpp>
 #include <boost/asio/detail/type_traits.hpp>
@@ -74,20 +76,16 @@ class awaitable_frame_base
 {
 public:
 #if !defined(BOOST_ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
+  // Frames, including those of the co_spawn entry point, are allocated from
+  // a per-thread pool with a free list for each size class.
   void* operator new(std::size_t size)
   {
-    return boost::asio::detail::thread_info_base::allocate(
-        boost::asio::detail::thread_info_base::awaitable_frame_tag(),
-        boost::asio::detail::thread_context::thread_call_stack::top(),
-        size);
+    return awaitable_frame_pool::thread_allocate(size);
   }
 
   void operator delete(void* pointer, std::size_t size)
   {
-    boost::asio::detail::thread_info_base::deallocate(
-        boost::asio::detail::thread_info_base::awaitable_frame_tag(),
-        boost::asio::detail::thread_context::thread_call_stack::top(),
-        pointer, size);
+    awaitable_frame_pool::thread_deallocate(pointer, size);
   }
 #endif // !defined(BOOST_ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
 
@@ -153,6 +151,14 @@ public:
     return a;
   }
 
+  // This await transformation resumes an awaitable_generator on the same
+  // thread of execution, to produce its next value.
+  template <typename T>
+  auto await_transform(awaitable_generator_next<T, Executor> n) const noexcept
+  {
+    return n;
+  }
+
   // This await transformation obtains the associated executor of the thread of
   // execution.
   auto await_transform(this_coro::executor_t) noexcept
@@ -338,11 +344,14 @@ class awaitable_thread
 public:
   typedef Executor executor_type;
 
-  // Construct from the entry point of a new thread of execution.
-  awaitable_thread(awaitable<void, Executor> p, const Executor& ex)
+  // Construct from the entry point of a new thread of execution. The slot is
+  // associated with each asynchronous operation awaited by the thread.
+  awaitable_thread(awaitable<void, Executor> p, const Executor& ex,
+      cancellation_slot slot = cancellation_slot())
     : bottom_of_stack_(std::move(p)),
       top_of_stack_(bottom_of_stack_.frame_),
-      executor_(ex)
+      executor_(ex),
+      cancellation_slot_(slot)
   {
   }
 
@@ -350,7 +359,8 @@ public:
   awaitable_thread(awaitable_thread&& other) noexcept
     : bottom_of_stack_(std::move(other.bottom_of_stack_)),
       top_of_stack_(std::exchange(other.top_of_stack_, nullptr)),
-      executor_(std::move(other.executor_))
+      executor_(std::move(other.executor_)),
+      cancellation_slot_(other.cancellation_slot_)
   {
   }
 
@@ -399,6 +409,7 @@ protected:
   awaitable<void, Executor> bottom_of_stack_;
   awaitable_frame_base<Executor>* top_of_stack_;
   executor_type executor_;
+  cancellation_slot cancellation_slot_;
 };
 
 } // namespace detail
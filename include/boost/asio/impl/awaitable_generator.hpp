@@ -0,0 +1,161 @@
+//
+// impl/awaitable_generator.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_IMPL_AWAITABLE_GENERATOR_HPP
+#define BOOST_ASIO_IMPL_AWAITABLE_GENERATOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <optional>
+#include <utility>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// An awaitable_generator_frame is a stack frame that is pushed on top of the
+// consumer's frame each time a value is requested. Yielding a value, or
+// returning, pops the frame so that the awaitable_thread resumes the consumer.
+// Between requests the frame is not part of any stack.
+template <typename T, typename Executor>
+class awaitable_generator_frame
+  : public awaitable_frame_base<Executor>
+{
+public:
+  awaitable_generator<T, Executor> get_return_object() noexcept
+  {
+    this->coro_ =
+      coroutine_handle<awaitable_generator_frame>::from_promise(*this);
+    return awaitable_generator<T, Executor>(this);
+  }
+
+  template <typename U>
+  auto yield_value(U&& u)
+  {
+    value_.emplace(std::forward<U>(u));
+
+    struct result
+    {
+      awaitable_generator_frame* this_;
+
+      bool await_ready() const noexcept
+      {
+        return false;
+      }
+
+      void await_suspend(coroutine_handle<void>) noexcept
+      {
+        this_->pop_frame();
+      }
+
+      void await_resume() const noexcept
+      {
+      }
+    };
+
+    return result{this};
+  }
+
+  void return_void()
+  {
+  }
+
+  bool done() const noexcept
+  {
+    return this->coro_.done();
+  }
+
+  std::optional<T> get()
+  {
+    this->rethrow_exception();
+    std::optional<T> value(std::move(value_));
+    value_.reset();
+    return value;
+  }
+
+private:
+  std::optional<T> value_;
+};
+
+// The awaiter returned by awaitable_generator::next(). It is accepted only by
+// the await_transform of an awaitable frame using the same executor type.
+template <typename T, typename Executor>
+class awaitable_generator_next
+{
+public:
+  explicit awaitable_generator_next(
+      awaitable_generator_frame<T, Executor>* frame) noexcept
+    : frame_(frame)
+  {
+  }
+
+  // A finished generator produces an empty result without suspending.
+  bool await_ready() const noexcept
+  {
+    return frame_->done();
+  }
+
+  template <typename Promise>
+  void await_suspend(coroutine_handle<Promise> h) noexcept
+  {
+    frame_->push_frame(&h.promise());
+  }
+
+  std::optional<T> await_resume()
+  {
+    return frame_->get();
+  }
+
+private:
+  awaitable_generator_frame<T, Executor>* frame_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#if !defined(GENERATING_DOCUMENTATION)
+# if defined(BOOST_ASIO_HAS_STD_COROUTINE)
+
+namespace std {
+
+template <typename T, typename Executor, typename... Args>
+struct coroutine_traits<boost::asio::awaitable_generator<T, Executor>, Args...>
+{
+  typedef boost::asio::detail::awaitable_generator_frame<T, Executor>
+    promise_type;
+};
+
+} // namespace std
+
+# else // defined(BOOST_ASIO_HAS_STD_COROUTINE)
+
+namespace std { namespace experimental {
+
+template <typename T, typename Executor, typename... Args>
+struct coroutine_traits<boost::asio::awaitable_generator<T, Executor>, Args...>
+{
+  typedef boost::asio::detail::awaitable_generator_frame<T, Executor>
+    promise_type;
+};
+
+}} // namespace std::experimental
+
+# endif // defined(BOOST_ASIO_HAS_STD_COROUTINE)
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_IMPL_AWAITABLE_GENERATOR_HPP
@@ -0,0 +1,479 @@
+//
+// impl/awaitable_operators.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_IMPL_AWAITABLE_OPERATORS_HPP
+#define BOOST_ASIO_IMPL_AWAITABLE_OPERATORS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/cancellation_signal.hpp>
+#include <boost/asio/cancellation_type.hpp>
+#include <boost/asio/dispatch.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/asio/detail/recycling_allocator.hpp>
+#include <boost/asio/detail/type_traits.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// The value stored for an operand's result, with void mapped to monostate.
+template <typename T>
+struct awaitable_operator_value
+{
+  typedef T type;
+};
+
+template <>
+struct awaitable_operator_value<void>
+{
+  typedef std::monostate type;
+};
+
+// The state shared between a coroutine evaluating an awaitable operator and
+// the two threads of execution that run its operands. Each operand runs with
+// its own cancellation signal. When waiting for either operand, the first to
+// complete successfully causes the other to be cancelled. The coroutine is
+// resumed when both operands have completed.
+//
+// A cancellation signal must not be emitted while the operand is installing
+// or clearing a handler in the corresponding slot. The operands therefore run
+// on a strand, if the executor type can hold one, and every emit is made on
+// that strand. Otherwise the operands' executor must not run them
+// concurrently.
+template <typename Executor, typename T0, typename T1>
+class awaitable_operator_state
+{
+public:
+  typedef typename awaitable_operator_value<T0>::type value0_type;
+  typedef typename awaitable_operator_value<T1>::type value1_type;
+
+  // Indicates that no operand completed successfully.
+  static constexpr std::size_t no_winner = 2;
+
+  explicit awaitable_operator_state(bool wait_for_all)
+    : wait_for_all_(wait_for_all),
+      remaining_(2),
+      gate_(2),
+      decided_(false),
+      winner_(no_winner)
+  {
+  }
+
+  // Start both operands and suspend the calling coroutine until the state's
+  // completion condition is satisfied.
+  static awaitable<void, Executor> wait(
+      const std::shared_ptr<awaitable_operator_state>& self,
+      awaitable<T0, Executor> a0, awaitable<T1, Executor> a1)
+  {
+    use_awaitable_t<Executor> token;
+    return async_initiate<use_awaitable_t<Executor>, void()>(
+        [self, a0 = std::move(a0), a1 = std::move(a1)](auto handler) mutable
+        {
+          Executor ex = operand_executor(handler.get_executor());
+
+          // Cancellation of the calling coroutine's operation is forwarded to
+          // both operands.
+          self->slot_ = handler.get_cancellation_slot();
+          if (self->slot_.is_connected())
+            self->slot_.template emplace<forward_cancellation>(self, ex);
+
+          self->handler_.emplace(std::move(handler));
+          (dispatch)(ex,
+              [self, ex, a0 = std::move(a0), a1 = std::move(a1)]() mutable
+              {
+                awaitable_thread<Executor>(entry_point<0>(self, std::move(a0)),
+                    ex, self->signals_[0].slot()).launch();
+                awaitable_thread<Executor>(entry_point<1>(self, std::move(a1)),
+                    ex, self->signals_[1].slot()).launch();
+
+                // The right hand operand was not yet running if the left hand
+                // one won while it was being launched.
+                if (self->winner_.load(std::memory_order_acquire) == 0)
+                  self->signals_[1].emit(cancellation_type::terminal);
+              });
+
+          // The handler must not be invoked from within the initiation.
+          self->open_gate(true);
+        }, token);
+  }
+
+  // Get the index of the operand that completed first, or no_winner.
+  std::size_t winner() const
+  {
+    return winner_.load(std::memory_order_acquire);
+  }
+
+  // Rethrow the exception from the leftmost operand that failed, if any.
+  void rethrow() const
+  {
+    if (exceptions_[0])
+      std::rethrow_exception(exceptions_[0]);
+    if (exceptions_[1])
+      std::rethrow_exception(exceptions_[1]);
+  }
+
+  value0_type& value0()
+  {
+    return *value0_;
+  }
+
+  value1_type& value1()
+  {
+    return *value1_;
+  }
+
+private:
+  // Get the executor on which the operands run and cancellation is emitted.
+  static Executor operand_executor(const Executor& ex)
+  {
+    if constexpr (is_constructible<Executor, strand<Executor>>::value)
+      return Executor((make_strand)(ex));
+    else
+      return ex;
+  }
+
+  template <std::size_t I, typename T>
+  static awaitable<void, Executor> entry_point(
+      std::shared_ptr<awaitable_operator_state> self,
+      awaitable<T, Executor> a)
+  {
+    bool done = false;
+    try
+    {
+      if constexpr (std::is_void<T>::value)
+      {
+        co_await std::move(a);
+        done = true;
+        self->template set_value<I>(std::monostate());
+      }
+      else
+      {
+        T t = co_await std::move(a);
+        done = true;
+        self->template set_value<I>(std::move(t));
+      }
+    }
+    catch (...)
+    {
+      if (done)
+        throw;
+
+      self->exceptions_[I] = std::current_exception();
+      self->complete(I, false);
+    }
+  }
+
+  // An operand whose result cannot be stored has failed.
+  template <std::size_t I, typename V>
+  void set_value(V&& v)
+  {
+    try
+    {
+      if constexpr (I == 0)
+        value0_.emplace(std::forward<V>(v));
+      else
+        value1_.emplace(std::forward<V>(v));
+    }
+    catch (...)
+    {
+      exceptions_[I] = std::current_exception();
+      complete(I, false);
+      return;
+    }
+    complete(I, true);
+  }
+
+  void complete(std::size_t index, bool success)
+  {
+    if (!wait_for_all_ && success
+        && !decided_.exchange(true, std::memory_order_acq_rel))
+    {
+      // The other operand has lost and its result would be discarded.
+      winner_.store(index, std::memory_order_release);
+      signals_[1 - index].emit(cancellation_type::terminal);
+    }
+
+    if (remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      open_gate(false);
+  }
+
+  // Forwards cancellation of the calling coroutine to both operands.
+  class forward_cancellation
+  {
+  public:
+    forward_cancellation(
+        const std::shared_ptr<awaitable_operator_state>& state,
+        const Executor& ex)
+      : state_(state),
+        executor_(ex)
+    {
+    }
+
+    void operator()(cancellation_type_t type)
+    {
+      (dispatch)(executor_, [state = state_, type]()
+          {
+            state->signals_[0].emit(type);
+            state->signals_[1].emit(type);
+          });
+    }
+
+  private:
+    std::shared_ptr<awaitable_operator_state> state_;
+    Executor executor_;
+  };
+
+  // The coroutine is resumed once the completion condition is satisfied and
+  // the initiation has returned, whichever happens last.
+  void open_gate(bool from_initiation)
+  {
+    if (gate_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+      handler_type handler(std::move(*handler_));
+      handler_.reset();
+      Executor ex = handler.get_executor();
+
+      // The forwarding handler is removed on the calling coroutine's
+      // executor, which is where its slot is used.
+      auto resume = [this, handler = std::move(handler)]() mutable
+      {
+        if (slot_.is_connected())
+          slot_.clear();
+        std::move(handler)();
+      };
+
+      if (from_initiation)
+        (post)(ex, std::move(resume));
+      else
+        (dispatch)(ex, std::move(resume));
+    }
+  }
+
+  typedef typename async_result<use_awaitable_t<Executor>,
+    void()>::handler_type handler_type;
+
+  const bool wait_for_all_;
+  std::atomic<std::size_t> remaining_;
+  std::atomic<int> gate_;
+  std::atomic<bool> decided_;
+  std::atomic<std::size_t> winner_;
+  cancellation_signal signals_[2];
+  cancellation_slot slot_;
+  std::optional<handler_type> handler_;
+  std::optional<value0_type> value0_;
+  std::optional<value1_type> value1_;
+  std::exception_ptr exceptions_[2];
+};
+
+template <typename Executor, typename T0, typename T1>
+inline std::shared_ptr<awaitable_operator_state<Executor, T0, T1>>
+make_awaitable_operator_state(bool wait_for_all)
+{
+  typedef awaitable_operator_state<Executor, T0, T1> state_type;
+  return std::allocate_shared<state_type>(
+      recycling_allocator<state_type>(), wait_for_all);
+}
+
+// Convert a variant to a wider variant whose leading alternatives match.
+template <typename Result, std::size_t I = 0, typename Variant>
+Result widen_awaitable_operator_variant(Variant&& v)
+{
+  if constexpr (I + 1 < std::variant_size<Variant>::value)
+    if (v.index() != I)
+      return (widen_awaitable_operator_variant<Result, I + 1>)(std::move(v));
+  return Result(std::in_place_index<I>, std::get<I>(std::move(v)));
+}
+
+} // namespace detail
+
+namespace awaitable_operators {
+
+template <typename Executor>
+awaitable<void, Executor> operator&&(
+    awaitable<void, Executor> t, awaitable<void, Executor> u)
+{
+  auto state = detail::make_awaitable_operator_state<
+    Executor, void, void>(true);
+  co_await state->wait(state, std::move(t), std::move(u));
+  state->rethrow();
+}
+
+template <typename T, typename Executor>
+awaitable<T, Executor> operator&&(
+    awaitable<T, Executor> t, awaitable<void, Executor> u)
+{
+  auto state = detail::make_awaitable_operator_state<
+    Executor, T, void>(true);
+  co_await state->wait(state, std::move(t), std::move(u));
+  state->rethrow();
+  co_return std::move(state->value0());
+}
+
+template <typename U, typename Executor>
+awaitable<U, Executor> operator&&(
+    awaitable<void, Executor> t, awaitable<U, Executor> u)
+{
+  auto state = detail::make_awaitable_operator_state<
+    Executor, void, U>(true);
+  co_await state->wait(state, std::move(t), std::move(u));
+  state->rethrow();
+  co_return std::move(state->value1());
+}
+
+template <typename T, typename U, typename Executor>
+awaitable<std::tuple<T, U>, Executor> operator&&(
+    awaitable<T, Executor> t, awaitable<U, Executor> u)
+{
+  auto state = detail::make_awaitable_operator_state<
+    Executor, T, U>(true);
+  co_await state->wait(state, std::move(t), std::move(u));
+  state->rethrow();
+  co_return std::tuple<T, U>(
+      std::move(state->value0()), std::move(state->value1()));
+}
+
+template <typename... T, typename Executor>
+awaitable<std::tuple<T...>, Executor> operator&&(
+    awaitable<std::tuple<T...>, Executor> t, awaitable<void, Executor> u)
+{
+  auto state = detail::make_awaitable_operator_state<
+    Executor, std::tuple<T...>, void>(true);
+  co_await state->wait(state, std::move(t), std::move(u));
+  state->rethrow();
+  co_return std::move(state->value0());
+}
+
+template <typename... T, typename U, typename Executor>
+awaitable<std::tuple<T..., U>, Executor> operator&&(
+    awaitable<std::tuple<T...>, Executor> t, awaitable<U, Executor> u)
+{
+  auto state = detail::make_awaitable_operator_state<
+    Executor, std::tuple<T...>, U>(true);
+  co_await state->wait(state, std::move(t), std::move(u));
+  state->rethrow();
+  co_return std::tuple_cat(std::move(state->value0()),
+      std::tuple<U>(std::move(state->value1())));
+}
+
+template <typename Executor>
+awaitable<std::variant<std::monostate, std::monostate>, Executor> operator||(
+    awaitable<void, Executor> t, awaitable<void, Executor> u)
+{
+  typedef std::variant<std::monostate, std::monostate> result_type;
+  auto state = detail::make_awaitable_operator_state<
+    Executor, void, void>(false);
+  co_await state->wait(state, std::move(t), std::move(u));
+  if (state->winner() == state->no_winner)
+    state->rethrow();
+  if (state->winner() == 0)
+    co_return result_type(std::in_place_index<0>);
+  co_return result_type(std::in_place_index<1>);
+}
+
+template <typename T, typename Executor>
+awaitable<std::variant<T, std::monostate>, Executor> operator||(
+    awaitable<T, Executor> t, awaitable<void, Executor> u)
+{
+  typedef std::variant<T, std::monostate> result_type;
+  auto state = detail::make_awaitable_operator_state<
+    Executor, T, void>(false);
+  co_await state->wait(state, std::move(t), std::move(u));
+  if (state->winner() == state->no_winner)
+    state->rethrow();
+  if (state->winner() == 0)
+    co_return result_type(std::in_place_index<0>, std::move(state->value0()));
+  co_return result_type(std::in_place_index<1>);
+}
+
+template <typename U, typename Executor>
+awaitable<std::variant<std::monostate, U>, Executor> operator||(
+    awaitable<void, Executor> t, awaitable<U, Executor> u)
+{
+  typedef std::variant<std::monostate, U> result_type;
+  auto state = detail::make_awaitable_operator_state<
+    Executor, void, U>(false);
+  co_await state->wait(state, std::move(t), std::move(u));
+  if (state->winner() == state->no_winner)
+    state->rethrow();
+  if (state->winner() == 0)
+    co_return result_type(std::in_place_index<0>);
+  co_return result_type(std::in_place_index<1>, std::move(state->value1()));
+}
+
+template <typename T, typename U, typename Executor>
+awaitable<std::variant<T, U>, Executor> operator||(
+    awaitable<T, Executor> t, awaitable<U, Executor> u)
+{
+  typedef std::variant<T, U> result_type;
+  auto state = detail::make_awaitable_operator_state<
+    Executor, T, U>(false);
+  co_await state->wait(state, std::move(t), std::move(u));
+  if (state->winner() == state->no_winner)
+    state->rethrow();
+  if (state->winner() == 0)
+    co_return result_type(std::in_place_index<0>, std::move(state->value0()));
+  co_return result_type(std::in_place_index<1>, std::move(state->value1()));
+}
+
+template <typename... T, typename Executor>
+awaitable<std::variant<T..., std::monostate>, Executor> operator||(
+    awaitable<std::variant<T...>, Executor> t, awaitable<void, Executor> u)
+{
+  typedef std::variant<T..., std::monostate> result_type;
+  auto state = detail::make_awaitable_operator_state<
+    Executor, std::variant<T...>, void>(false);
+  co_await state->wait(state, std::move(t), std::move(u));
+  if (state->winner() == state->no_winner)
+    state->rethrow();
+  if (state->winner() == 0)
+    co_return detail::widen_awaitable_operator_variant<result_type>(
+        std::move(state->value0()));
+  co_return result_type(std::in_place_index<sizeof...(T)>);
+}
+
+template <typename... T, typename U, typename Executor>
+awaitable<std::variant<T..., U>, Executor> operator||(
+    awaitable<std::variant<T...>, Executor> t, awaitable<U, Executor> u)
+{
+  typedef std::variant<T..., U> result_type;
+  auto state = detail::make_awaitable_operator_state<
+    Executor, std::variant<T...>, U>(false);
+  co_await state->wait(state, std::move(t), std::move(u));
+  if (state->winner() == state->no_winner)
+    state->rethrow();
+  if (state->winner() == 0)
+    co_return detail::widen_awaitable_operator_variant<result_type>(
+        std::move(state->value0()));
+  co_return result_type(std::in_place_index<sizeof...(T)>,
+      std::move(state->value1()));
+}
+
+} // namespace awaitable_operators
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_IMPL_AWAITABLE_OPERATORS_HPP
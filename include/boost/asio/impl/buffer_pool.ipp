@@ -0,0 +1,110 @@
+//
+// impl/buffer_pool.ipp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_IMPL_BUFFER_POOL_IPP
+#define BOOST_ASIO_IMPL_BUFFER_POOL_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_MOVE)
+
+#include <new>
+#include <boost/asio/buffer_pool.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+std::size_t pooled_buffer::capacity() const BOOST_ASIO_NOEXCEPT
+{
+  return pool_ ? pool_->buffer_size() : 0;
+}
+
+void pooled_buffer::reset() BOOST_ASIO_NOEXCEPT
+{
+  if (pool_)
+  {
+    pool_->release(data_);
+    pool_ = 0;
+    data_ = 0;
+    size_ = 0;
+  }
+}
+
+buffer_pool::buffer_pool(std::size_t buffer_size, std::size_t max_idle)
+  : buffer_size_(buffer_size),
+    max_idle_(max_idle),
+    idle_(0),
+    idle_count_(0)
+{
+}
+
+buffer_pool::~buffer_pool()
+{
+  while (idle_)
+  {
+    block* b = idle_;
+    idle_ = b->next_;
+    ::operator delete(b);
+  }
+}
+
+std::size_t buffer_pool::idle() const
+{
+  detail::mutex::scoped_lock lock(mutex_);
+  return idle_count_;
+}
+
+pooled_buffer buffer_pool::acquire()
+{
+  detail::mutex::scoped_lock lock(mutex_);
+  if (block* b = idle_)
+  {
+    idle_ = b->next_;
+    --idle_count_;
+    return pooled_buffer(this, b, buffer_size_);
+  }
+  lock.unlock();
+
+  // Unused buffers hold the list link, so every allocation must fit one.
+  std::size_t size = buffer_size_ < sizeof(block)
+    ? sizeof(block) : buffer_size_;
+  return pooled_buffer(this, ::operator new(size), buffer_size_);
+}
+
+void buffer_pool::release(void* data) BOOST_ASIO_NOEXCEPT
+{
+  detail::mutex::scoped_lock lock(mutex_);
+  if (idle_count_ < max_idle_)
+  {
+    block* b = static_cast<block*>(data);
+    b->next_ = idle_;
+    idle_ = b;
+    ++idle_count_;
+    return;
+  }
+  lock.unlock();
+
+  ::operator delete(data);
+}
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_MOVE)
+
+#endif // BOOST_ASIO_IMPL_BUFFER_POOL_IPP
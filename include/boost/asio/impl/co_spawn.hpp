@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include <boost/asio/detail/config.hpp>
+#include <boost/asio/associated_cancellation_slot.hpp>
 #include <boost/asio/awaitable.hpp>
 #include <boost/asio/dispatch.hpp>
 #include <boost/asio/execution/outstanding_work.hpp>
@@ -181,9 +182,13 @@ public:
   {
     typedef typename result_of<F()>::type awaitable_type;
 
+    // Operations performed by the new thread are cancelled through the slot
+    // associated with the completion handler, if any.
+    cancellation_slot slot = (get_associated_cancellation_slot)(handler);
+
     auto a = (co_spawn_entry_point)(static_cast<awaitable_type*>(nullptr),
         ex_, std::forward<F>(f), std::forward<Handler>(handler));
-    awaitable_handler<executor_type, void>(std::move(a), ex_).launch();
+    awaitable_handler<executor_type, void>(std::move(a), ex_, slot).launch();
   }
 
 private:
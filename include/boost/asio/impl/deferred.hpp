@@ -0,0 +1,254 @@
+//
+// impl/deferred.hpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_IMPL_DEFERRED_HPP
+#define BOOST_ASIO_IMPL_DEFERRED_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <boost/asio/associated_allocator.hpp>
+#include <boost/asio/associated_cancellation_slot.hpp>
+#include <boost/asio/associated_executor.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/detail/handler_alloc_helpers.hpp>
+#include <boost/asio/detail/handler_cont_helpers.hpp>
+#include <boost/asio/detail/handler_invoke_helpers.hpp>
+#include <boost/asio/detail/type_traits.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+template <typename... Values>
+struct deferred_signature<deferred_values<Values...> >
+{
+  typedef void type(Values...);
+};
+
+template <typename Signature, typename Initiation, typename... InitArgs>
+struct deferred_signature<
+  deferred_async_operation<Signature, Initiation, InitArgs...> >
+{
+  typedef Signature type;
+};
+
+template <typename Tail, typename Signature>
+struct deferred_sequence_signature;
+
+template <typename Tail, typename R, typename... Args>
+struct deferred_sequence_signature<Tail, R(Args...)>
+{
+  typedef typename decay<
+    decltype(declval<Tail>()(declval<Args>()...))>::type next_type;
+
+  typedef typename deferred_signature<next_type>::type type;
+};
+
+template <typename Head, typename Tail>
+struct deferred_signature<deferred_sequence<Head, Tail> >
+  : deferred_sequence_signature<Tail,
+      typename deferred_signature<Head>::type>
+{
+};
+
+// Completion handler for the head of a deferred sequence. On completion, the
+// tail is called to obtain the next operation, which is then started with the
+// sequence's final handler.
+template <typename Handler, typename Tail>
+class deferred_sequence_handler
+{
+public:
+  template <typename H, typename T>
+  explicit deferred_sequence_handler(
+      BOOST_ASIO_MOVE_ARG(H) handler, BOOST_ASIO_MOVE_ARG(T) tail)
+    : handler_(BOOST_ASIO_MOVE_CAST(H)(handler)),
+      tail_(BOOST_ASIO_MOVE_CAST(T)(tail))
+  {
+  }
+
+  template <typename... Args>
+  void operator()(BOOST_ASIO_MOVE_ARG(Args)... args)
+  {
+    BOOST_ASIO_MOVE_CAST(Tail)(tail_)(
+        BOOST_ASIO_MOVE_CAST(Args)(args)...)(
+          BOOST_ASIO_MOVE_CAST(Handler)(handler_));
+  }
+
+//private:
+  Handler handler_;
+  Tail tail_;
+};
+
+template <typename Handler, typename Tail>
+inline asio_handler_allocate_is_deprecated
+asio_handler_allocate(std::size_t size,
+    deferred_sequence_handler<Handler, Tail>* this_handler)
+{
+#if defined(BOOST_ASIO_NO_DEPRECATED)
+  boost_asio_handler_alloc_helpers::allocate(size, this_handler->handler_);
+  return asio_handler_allocate_is_no_longer_used();
+#else // defined(BOOST_ASIO_NO_DEPRECATED)
+  return boost_asio_handler_alloc_helpers::allocate(
+      size, this_handler->handler_);
+#endif // defined(BOOST_ASIO_NO_DEPRECATED)
+}
+
+template <typename Handler, typename Tail>
+inline asio_handler_deallocate_is_deprecated
+asio_handler_deallocate(void* pointer, std::size_t size,
+    deferred_sequence_handler<Handler, Tail>* this_handler)
+{
+  boost_asio_handler_alloc_helpers::deallocate(
+      pointer, size, this_handler->handler_);
+#if defined(BOOST_ASIO_NO_DEPRECATED)
+  return asio_handler_deallocate_is_no_longer_used();
+#endif // defined(BOOST_ASIO_NO_DEPRECATED)
+}
+
+template <typename Handler, typename Tail>
+inline bool asio_handler_is_continuation(
+    deferred_sequence_handler<Handler, Tail>* this_handler)
+{
+  return boost_asio_handler_cont_helpers::is_continuation(
+        this_handler->handler_);
+}
+
+template <typename Function, typename Handler, typename Tail>
+inline asio_handler_invoke_is_deprecated
+asio_handler_invoke(Function& function,
+    deferred_sequence_handler<Handler, Tail>* this_handler)
+{
+  boost_asio_handler_invoke_helpers::invoke(
+      function, this_handler->handler_);
+#if defined(BOOST_ASIO_NO_DEPRECATED)
+  return asio_handler_invoke_is_no_longer_used();
+#endif // defined(BOOST_ASIO_NO_DEPRECATED)
+}
+
+template <typename Function, typename Handler, typename Tail>
+inline asio_handler_invoke_is_deprecated
+asio_handler_invoke(const Function& function,
+    deferred_sequence_handler<Handler, Tail>* this_handler)
+{
+  boost_asio_handler_invoke_helpers::invoke(
+      function, this_handler->handler_);
+#if defined(BOOST_ASIO_NO_DEPRECATED)
+  return asio_handler_invoke_is_no_longer_used();
+#endif // defined(BOOST_ASIO_NO_DEPRECATED)
+}
+
+} // namespace detail
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <typename Signature>
+class async_result<deferred_t, Signature>
+{
+public:
+  template <typename Initiation, typename... InitArgs>
+  static deferred_async_operation<Signature,
+    typename decay<Initiation>::type, typename decay<InitArgs>::type...>
+  initiate(BOOST_ASIO_MOVE_ARG(Initiation) initiation,
+      deferred_t, BOOST_ASIO_MOVE_ARG(InitArgs)... args)
+  {
+    return deferred_async_operation<Signature,
+      typename decay<Initiation>::type, typename decay<InitArgs>::type...>(
+        detail::deferred_init_tag(),
+        BOOST_ASIO_MOVE_CAST(Initiation)(initiation),
+        BOOST_ASIO_MOVE_CAST(InitArgs)(args)...);
+  }
+};
+
+template <typename Function, typename Signature>
+class async_result<deferred_function<Function>, Signature>
+{
+public:
+  template <typename Initiation, typename RawCompletionToken,
+      typename... InitArgs>
+  static deferred_sequence<
+    deferred_async_operation<Signature,
+      typename decay<Initiation>::type, typename decay<InitArgs>::type...>,
+    deferred_function<Function> >
+  initiate(BOOST_ASIO_MOVE_ARG(Initiation) initiation,
+      BOOST_ASIO_MOVE_ARG(RawCompletionToken) token,
+      BOOST_ASIO_MOVE_ARG(InitArgs)... args)
+  {
+    return deferred_sequence<
+      deferred_async_operation<Signature,
+        typename decay<Initiation>::type, typename decay<InitArgs>::type...>,
+      deferred_function<Function> >(
+        detail::deferred_init_tag(),
+        deferred_async_operation<Signature,
+          typename decay<Initiation>::type,
+          typename decay<InitArgs>::type...>(
+            detail::deferred_init_tag(),
+            BOOST_ASIO_MOVE_CAST(Initiation)(initiation),
+            BOOST_ASIO_MOVE_CAST(InitArgs)(args)...),
+        BOOST_ASIO_MOVE_CAST(RawCompletionToken)(token));
+  }
+};
+
+template <typename Handler, typename Tail, typename Executor>
+struct associated_executor<
+  detail::deferred_sequence_handler<Handler, Tail>, Executor>
+{
+  typedef typename associated_executor<Handler, Executor>::type type;
+
+  static type get(
+      const detail::deferred_sequence_handler<Handler, Tail>& h,
+      const Executor& ex = Executor()) BOOST_ASIO_NOEXCEPT
+  {
+    return associated_executor<Handler, Executor>::get(h.handler_, ex);
+  }
+};
+
+template <typename Handler, typename Tail, typename Allocator>
+struct associated_allocator<
+  detail::deferred_sequence_handler<Handler, Tail>, Allocator>
+{
+  typedef typename associated_allocator<Handler, Allocator>::type type;
+
+  static type get(
+      const detail::deferred_sequence_handler<Handler, Tail>& h,
+      const Allocator& a = Allocator()) BOOST_ASIO_NOEXCEPT
+  {
+    return associated_allocator<Handler, Allocator>::get(h.handler_, a);
+  }
+};
+
+template <typename Handler, typename Tail, typename CancellationSlot>
+struct associated_cancellation_slot<
+  detail::deferred_sequence_handler<Handler, Tail>, CancellationSlot>
+{
+  typedef typename associated_cancellation_slot<
+    Handler, CancellationSlot>::type type;
+
+  static type get(
+      const detail::deferred_sequence_handler<Handler, Tail>& h,
+      const CancellationSlot& s = CancellationSlot()) BOOST_ASIO_NOEXCEPT
+  {
+    return associated_cancellation_slot<
+      Handler, CancellationSlot>::get(h.handler_, s);
+  }
+};
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_IMPL_DEFERRED_HPP
@@ -109,6 +109,8 @@ public:
       return "Element not found";
     if (value == error::fd_set_failure)
       return "The descriptor does not fit into the select call's fd_set";
+    if (value == error::channel_closed)
+      return "Channel closed";
     return "asio.misc error";
   }
 };
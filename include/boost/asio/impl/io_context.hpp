@@ -15,11 +15,13 @@
 # pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
+#include <iterator>
 #include <boost/asio/detail/completion_handler.hpp>
 #include <boost/asio/detail/executor_op.hpp>
 #include <boost/asio/detail/fenced_block.hpp>
 #include <boost/asio/detail/handler_type_requirements.hpp>
 #include <boost/asio/detail/non_const_lvalue.hpp>
+#include <boost/asio/detail/op_queue.hpp>
 #include <boost/asio/detail/recycling_allocator.hpp>
 #include <boost/asio/detail/service_registry.hpp>
 #include <boost/asio/detail/throw_error.hpp>
@@ -311,6 +313,38 @@ void io_context::basic_executor_type<Allocator, Bits>::execute(
   p.v = p.p = 0;
 }
 
+template <typename Allocator, unsigned int Bits>
+template <typename InputIterator>
+void io_context::basic_executor_type<Allocator, Bits>::post_batch(
+    InputIterator first, InputIterator last) const
+{
+  typedef typename std::iterator_traits<InputIterator>::value_type
+    function_type;
+  typedef detail::executor_op<function_type, Allocator, detail::operation> op;
+
+  // Allocate and construct operations to wrap the functions.
+  detail::op_queue<detail::operation> ops;
+  std::size_t n = 0;
+  for (; first != last; ++first, ++n)
+  {
+    typename op::ptr p = { detail::addressof(allocator_),
+        op::ptr::allocate(allocator_), 0 };
+    p.p = new (p.v) op(*first, allocator_);
+    ops.push(p.p);
+
+    BOOST_ASIO_HANDLER_CREATION((*io_context_, *p.p,
+          "io_context", io_context_, 0, "post_batch"));
+
+    p.v = p.p = 0;
+  }
+
+  if (n > 0)
+  {
+    io_context_->impl_.post_immediate_completions(n,
+        ops, (bits_ & relationship_continuation) != 0);
+  }
+}
+
 #if !defined(BOOST_ASIO_NO_TS_EXECUTORS)
 template <typename Allocator, unsigned int Bits>
 inline io_context& io_context::basic_executor_type<
@@ -0,0 +1,284 @@
+//
+// impl/read_pooled.hpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_IMPL_READ_POOLED_HPP
+#define BOOST_ASIO_IMPL_READ_POOLED_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/associated_allocator.hpp>
+#include <boost/asio/associated_executor.hpp>
+#include <boost/asio/detail/handler_alloc_helpers.hpp>
+#include <boost/asio/detail/handler_cont_helpers.hpp>
+#include <boost/asio/detail/handler_invoke_helpers.hpp>
+#include <boost/asio/detail/handler_tracking.hpp>
+#include <boost/asio/detail/non_const_lvalue.hpp>
+#include <boost/asio/detail/type_traits.hpp>
+
+#if defined(BOOST_ASIO_WINDOWS) || defined(__CYGWIN__)
+# include <boost/asio/detail/socket_ops.hpp>
+#else // defined(BOOST_ASIO_WINDOWS) || defined(__CYGWIN__)
+# include <boost/asio/detail/descriptor_ops.hpp>
+#endif // defined(BOOST_ASIO_WINDOWS) || defined(__CYGWIN__)
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+namespace detail
+{
+  // Read from a native handle that is in non-blocking mode. Returns false if
+  // the read would block.
+  template <typename NativeHandle>
+  inline bool read_pooled_non_blocking(NativeHandle handle,
+      const mutable_buffer& buffer, boost::system::error_code& ec,
+      std::size_t& bytes_transferred)
+  {
+#if defined(BOOST_ASIO_WINDOWS) || defined(__CYGWIN__)
+    return socket_ops::non_blocking_recv1(handle, buffer.data(),
+        buffer.size(), 0, true, ec, bytes_transferred);
+#else // defined(BOOST_ASIO_WINDOWS) || defined(__CYGWIN__)
+    return descriptor_ops::non_blocking_read1(handle, buffer.data(),
+        buffer.size(), ec, bytes_transferred);
+#endif // defined(BOOST_ASIO_WINDOWS) || defined(__CYGWIN__)
+  }
+
+  template <typename AsyncReadStream, typename ReadHandler>
+  class read_pooled_op
+  {
+  public:
+    read_pooled_op(AsyncReadStream& stream,
+        buffer_pool& pool, ReadHandler& handler)
+      : stream_(stream),
+        pool_(pool),
+        start_(0),
+        handler_(BOOST_ASIO_MOVE_CAST(ReadHandler)(handler))
+    {
+    }
+
+    read_pooled_op(const read_pooled_op& other)
+      : stream_(other.stream_),
+        pool_(other.pool_),
+        start_(other.start_),
+        handler_(other.handler_)
+    {
+    }
+
+    read_pooled_op(read_pooled_op&& other)
+      : stream_(other.stream_),
+        pool_(other.pool_),
+        start_(other.start_),
+        handler_(BOOST_ASIO_MOVE_CAST(ReadHandler)(other.handler_))
+    {
+    }
+
+    void operator()(boost::system::error_code ec, int start = 0)
+    {
+      pooled_buffer buffer;
+      switch (start_ = start)
+      {
+        case 1:
+        for (;;)
+        {
+          {
+            BOOST_ASIO_HANDLER_LOCATION((
+                  __FILE__, __LINE__, "async_read_pooled"));
+            stream_.async_wait(AsyncReadStream::wait_read,
+                BOOST_ASIO_MOVE_CAST(read_pooled_op)(*this));
+          }
+          return; default:
+          if (ec)
+            break;
+
+          // The stream is ready, so commit a buffer to the read. Another
+          // reader may already have consumed the data, so the read must not
+          // block. It is made on the native handle, which asynchronous
+          // operations leave in non-blocking mode, so that the stream's own
+          // non-blocking mode is neither consulted nor changed.
+          if (!stream_.native_non_blocking())
+          {
+            stream_.native_non_blocking(true, ec);
+            if (ec)
+              break;
+          }
+          buffer = pool_.acquire();
+          {
+            std::size_t bytes_transferred = 0;
+            if (read_pooled_non_blocking(stream_.native_handle(),
+                  buffer.data(), ec, bytes_transferred))
+            {
+              buffer.resize(bytes_transferred);
+              break;
+            }
+          }
+          buffer.reset();
+        }
+
+        if (ec)
+          buffer.reset();
+        handler_(static_cast<const boost::system::error_code&>(ec),
+            BOOST_ASIO_MOVE_CAST(pooled_buffer)(buffer));
+      }
+    }
+
+  //private:
+    AsyncReadStream& stream_;
+    buffer_pool& pool_;
+    int start_;
+    ReadHandler handler_;
+  };
+
+  template <typename AsyncReadStream, typename ReadHandler>
+  inline asio_handler_allocate_is_deprecated
+  asio_handler_allocate(std::size_t size,
+      read_pooled_op<AsyncReadStream, ReadHandler>* this_handler)
+  {
+#if defined(BOOST_ASIO_NO_DEPRECATED)
+    boost_asio_handler_alloc_helpers::allocate(size, this_handler->handler_);
+    return asio_handler_allocate_is_no_longer_used();
+#else // defined(BOOST_ASIO_NO_DEPRECATED)
+    return boost_asio_handler_alloc_helpers::allocate(
+        size, this_handler->handler_);
+#endif // defined(BOOST_ASIO_NO_DEPRECATED)
+  }
+
+  template <typename AsyncReadStream, typename ReadHandler>
+  inline asio_handler_deallocate_is_deprecated
+  asio_handler_deallocate(void* pointer, std::size_t size,
+      read_pooled_op<AsyncReadStream, ReadHandler>* this_handler)
+  {
+    boost_asio_handler_alloc_helpers::deallocate(
+        pointer, size, this_handler->handler_);
+#if defined(BOOST_ASIO_NO_DEPRECATED)
+    return asio_handler_deallocate_is_no_longer_used();
+#endif // defined(BOOST_ASIO_NO_DEPRECATED)
+  }
+
+  template <typename AsyncReadStream, typename ReadHandler>
+  inline bool asio_handler_is_continuation(
+      read_pooled_op<AsyncReadStream, ReadHandler>* this_handler)
+  {
+    return this_handler->start_ == 0 ? true
+      : boost_asio_handler_cont_helpers::is_continuation(
+          this_handler->handler_);
+  }
+
+  template <typename Function, typename AsyncReadStream, typename ReadHandler>
+  inline asio_handler_invoke_is_deprecated
+  asio_handler_invoke(Function& function,
+      read_pooled_op<AsyncReadStream, ReadHandler>* this_handler)
+  {
+    boost_asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+#if defined(BOOST_ASIO_NO_DEPRECATED)
+    return asio_handler_invoke_is_no_longer_used();
+#endif // defined(BOOST_ASIO_NO_DEPRECATED)
+  }
+
+  template <typename Function, typename AsyncReadStream, typename ReadHandler>
+  inline asio_handler_invoke_is_deprecated
+  asio_handler_invoke(const Function& function,
+      read_pooled_op<AsyncReadStream, ReadHandler>* this_handler)
+  {
+    boost_asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+#if defined(BOOST_ASIO_NO_DEPRECATED)
+    return asio_handler_invoke_is_no_longer_used();
+#endif // defined(BOOST_ASIO_NO_DEPRECATED)
+  }
+
+  template <typename AsyncReadStream>
+  class initiate_async_read_pooled
+  {
+  public:
+    typedef typename AsyncReadStream::executor_type executor_type;
+
+    explicit initiate_async_read_pooled(AsyncReadStream& stream)
+      : stream_(stream)
+    {
+    }
+
+    executor_type get_executor() const BOOST_ASIO_NOEXCEPT
+    {
+      return stream_.get_executor();
+    }
+
+    template <typename ReadHandler>
+    void operator()(BOOST_ASIO_MOVE_ARG(ReadHandler) handler,
+        buffer_pool* pool) const
+    {
+      non_const_lvalue<ReadHandler> handler2(handler);
+      read_pooled_op<AsyncReadStream, typename decay<ReadHandler>::type>(
+          stream_, *pool, handler2.value)(boost::system::error_code(), 1);
+    }
+
+  private:
+    AsyncReadStream& stream_;
+  };
+} // namespace detail
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <typename AsyncReadStream, typename ReadHandler, typename Allocator>
+struct associated_allocator<
+    detail::read_pooled_op<AsyncReadStream, ReadHandler>,
+    Allocator>
+{
+  typedef typename associated_allocator<ReadHandler, Allocator>::type type;
+
+  static type get(
+      const detail::read_pooled_op<AsyncReadStream, ReadHandler>& h,
+      const Allocator& a = Allocator()) BOOST_ASIO_NOEXCEPT
+  {
+    return associated_allocator<ReadHandler, Allocator>::get(h.handler_, a);
+  }
+};
+
+template <typename AsyncReadStream, typename ReadHandler, typename Executor>
+struct associated_executor<
+    detail::read_pooled_op<AsyncReadStream, ReadHandler>,
+    Executor>
+  : detail::associated_executor_forwarding_base<ReadHandler, Executor>
+{
+  typedef typename associated_executor<ReadHandler, Executor>::type type;
+
+  static type get(
+      const detail::read_pooled_op<AsyncReadStream, ReadHandler>& h,
+      const Executor& ex = Executor()) BOOST_ASIO_NOEXCEPT
+  {
+    return associated_executor<ReadHandler, Executor>::get(h.handler_, ex);
+  }
+};
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+template <typename AsyncReadStream,
+    BOOST_ASIO_COMPLETION_TOKEN_FOR(void (boost::system::error_code,
+      pooled_buffer)) ReadHandler>
+inline BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
+    void (boost::system::error_code, pooled_buffer))
+async_read_pooled(AsyncReadStream& s, buffer_pool& pool,
+    BOOST_ASIO_MOVE_ARG(ReadHandler) handler)
+{
+  return async_initiate<ReadHandler,
+    void (boost::system::error_code, pooled_buffer)>(
+      detail::initiate_async_read_pooled<AsyncReadStream>(s),
+      handler, &pool);
+}
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_IMPL_READ_POOLED_HPP
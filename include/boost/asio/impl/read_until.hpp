@@ -24,6 +24,7 @@
 #include <boost/asio/buffer.hpp>
 #include <boost/asio/buffers_iterator.hpp>
 #include <boost/asio/detail/bind_handler.hpp>
+#include <boost/asio/detail/buffer_search.hpp>
 #include <boost/asio/detail/handler_alloc_helpers.hpp>
 #include <boost/asio/detail/handler_cont_helpers.hpp>
 #include <boost/asio/detail/handler_invoke_helpers.hpp>
@@ -107,24 +108,21 @@ std::size_t read_until(SyncReadStream& s,
   {
     // Determine the range of the data to be searched.
     typedef typename DynamicBuffer_v1::const_buffers_type buffers_type;
-    typedef buffers_iterator<buffers_type> iterator;
     buffers_type data_buffers = b.data();
-    iterator begin = iterator::begin(data_buffers);
-    iterator start_pos = begin + search_position;
-    iterator end = iterator::end(data_buffers);
 
     // Look for a match.
-    iterator iter = std::find(start_pos, end, delim);
-    if (iter != end)
+    std::pair<std::size_t, bool> result = detail::buffer_search(
+        data_buffers, search_position, delim);
+    if (result.second)
     {
       // Found a match. We're done.
       ec = boost::system::error_code();
-      return iter - begin + 1;
+      return result.first + 1;
     }
     else
     {
       // No match. Next search can start with the new data.
-      search_position = end - begin;
+      search_position = result.first;
     }
 
     // Check if buffer is full.
@@ -177,33 +175,22 @@ std::size_t read_until(SyncReadStream& s,
   {
     // Determine the range of the data to be searched.
     typedef typename DynamicBuffer_v1::const_buffers_type buffers_type;
-    typedef buffers_iterator<buffers_type> iterator;
     buffers_type data_buffers = b.data();
-    iterator begin = iterator::begin(data_buffers);
-    iterator start_pos = begin + search_position;
-    iterator end = iterator::end(data_buffers);
 
     // Look for a match.
-    std::pair<iterator, bool> result = detail::partial_search(
-        start_pos, end, delim.begin(), delim.end());
-    if (result.first != end)
+    std::pair<std::size_t, bool> result = detail::buffer_search(
+        data_buffers, search_position, delim.data(), delim.length());
+    if (result.second)
     {
-      if (result.second)
-      {
-        // Full match. We're done.
-        ec = boost::system::error_code();
-        return result.first - begin + delim.length();
-      }
-      else
-      {
-        // Partial match. Next search needs to start from beginning of match.
-        search_position = result.first - begin;
-      }
+      // Full match. We're done.
+      ec = boost::system::error_code();
+      return result.first + delim.length();
     }
     else
     {
-      // No match. Next search can start with the new data.
-      search_position = end - begin;
+      // Partial match or no match. Next search needs to start from the
+      // beginning of the partial match, or with the new data.
+      search_position = result.first;
     }
 
     // Check if buffer is full.
@@ -490,25 +477,22 @@ std::size_t read_until(SyncReadStream& s, DynamicBuffer_v2 buffers,
   {
     // Determine the range of the data to be searched.
     typedef typename DynamicBuffer_v2::const_buffers_type buffers_type;
-    typedef buffers_iterator<buffers_type> iterator;
     buffers_type data_buffers =
       const_cast<const DynamicBuffer_v2&>(b).data(0, b.size());
-    iterator begin = iterator::begin(data_buffers);
-    iterator start_pos = begin + search_position;
-    iterator end = iterator::end(data_buffers);
 
     // Look for a match.
-    iterator iter = std::find(start_pos, end, delim);
-    if (iter != end)
+    std::pair<std::size_t, bool> result = detail::buffer_search(
+        data_buffers, search_position, delim);
+    if (result.second)
     {
       // Found a match. We're done.
       ec = boost::system::error_code();
-      return iter - begin + 1;
+      return result.first + 1;
     }
     else
     {
       // No match. Next search can start with the new data.
-      search_position = end - begin;
+      search_position = result.first;
     }
 
     // Check if buffer is full.
@@ -559,34 +543,23 @@ std::size_t read_until(SyncReadStream& s, DynamicBuffer_v2 buffers,
   {
     // Determine the range of the data to be searched.
     typedef typename DynamicBuffer_v2::const_buffers_type buffers_type;
-    typedef buffers_iterator<buffers_type> iterator;
     buffers_type data_buffers =
       const_cast<const DynamicBuffer_v2&>(b).data(0, b.size());
-    iterator begin = iterator::begin(data_buffers);
-    iterator start_pos = begin + search_position;
-    iterator end = iterator::end(data_buffers);
 
     // Look for a match.
-    std::pair<iterator, bool> result = detail::partial_search(
-        start_pos, end, delim.begin(), delim.end());
-    if (result.first != end)
+    std::pair<std::size_t, bool> result = detail::buffer_search(
+        data_buffers, search_position, delim.data(), delim.length());
+    if (result.second)
     {
-      if (result.second)
-      {
-        // Full match. We're done.
-        ec = boost::system::error_code();
-        return result.first - begin + delim.length();
-      }
-      else
-      {
-        // Partial match. Next search needs to start from beginning of match.
-        search_position = result.first - begin;
-      }
+      // Full match. We're done.
+      ec = boost::system::error_code();
+      return result.first + delim.length();
     }
     else
     {
-      // No match. Next search can start with the new data.
-      search_position = end - begin;
+      // Partial match or no match. Next search needs to start from the
+      // beginning of the partial match, or with the new data.
+      search_position = result.first;
     }
 
     // Check if buffer is full.
@@ -833,18 +806,15 @@ namespace detail
             // Determine the range of the data to be searched.
             typedef typename DynamicBuffer_v1::const_buffers_type
               buffers_type;
-            typedef buffers_iterator<buffers_type> iterator;
             buffers_type data_buffers = buffers_.data();
-            iterator begin = iterator::begin(data_buffers);
-            iterator start_pos = begin + search_position_;
-            iterator end = iterator::end(data_buffers);
 
             // Look for a match.
-            iterator iter = std::find(start_pos, end, delim_);
-            if (iter != end)
+            std::pair<std::size_t, bool> result = detail::buffer_search(
+                data_buffers, search_position_, delim_);
+            if (result.second)
             {
               // Found a match. We're done.
-              search_position_ = iter - begin + 1;
+              search_position_ = result.first + 1;
               bytes_to_read = 0;
             }
 
@@ -859,7 +829,7 @@ namespace detail
             else
             {
               // Next search can start with the new data.
-              search_position_ = end - begin;
+              search_position_ = result.first;
               bytes_to_read = std::min<std::size_t>(
                     std::max<std::size_t>(512,
                       buffers_.capacity() - buffers_.size()),
@@ -1129,19 +1099,16 @@ namespace detail
             // Determine the range of the data to be searched.
             typedef typename DynamicBuffer_v1::const_buffers_type
               buffers_type;
-            typedef buffers_iterator<buffers_type> iterator;
             buffers_type data_buffers = buffers_.data();
-            iterator begin = iterator::begin(data_buffers);
-            iterator start_pos = begin + search_position_;
-            iterator end = iterator::end(data_buffers);
 
             // Look for a match.
-            std::pair<iterator, bool> result = detail::partial_search(
-                start_pos, end, delim_.begin(), delim_.end());
-            if (result.first != end && result.second)
+            std::pair<std::size_t, bool> result = detail::buffer_search(
+                data_buffers, search_position_,
+                delim_.data(), delim_.length());
+            if (result.second)
             {
               // Full match. We're done.
-              search_position_ = result.first - begin + delim_.length();
+              search_position_ = result.first + delim_.length();
               bytes_to_read = 0;
             }
 
@@ -1155,17 +1122,9 @@ namespace detail
             // Need to read some more data.
             else
             {
-              if (result.first != end)
-              {
-                // Partial match. Next search needs to start from beginning of
-                // match.
-                search_position_ = result.first - begin;
-              }
-              else
-              {
-                // Next search can start with the new data.
-                search_position_ = end - begin;
-              }
+              // Next search needs to start from the beginning of any partial
+              // match, or otherwise with the new data.
+              search_position_ = result.first;
 
               bytes_to_read = std::min<std::size_t>(
                     std::max<std::size_t>(512,
@@ -2131,20 +2090,17 @@ namespace detail
             // Determine the range of the data to be searched.
             typedef typename DynamicBuffer_v2::const_buffers_type
               buffers_type;
-            typedef buffers_iterator<buffers_type> iterator;
             buffers_type data_buffers =
               const_cast<const DynamicBuffer_v2&>(buffers_).data(
                   0, buffers_.size());
-            iterator begin = iterator::begin(data_buffers);
-            iterator start_pos = begin + search_position_;
-            iterator end = iterator::end(data_buffers);
 
             // Look for a match.
-            iterator iter = std::find(start_pos, end, delim_);
-            if (iter != end)
+            std::pair<std::size_t, bool> result = detail::buffer_search(
+                data_buffers, search_position_, delim_);
+            if (result.second)
             {
               // Found a match. We're done.
-              search_position_ = iter - begin + 1;
+              search_position_ = result.first + 1;
               bytes_to_read_ = 0;
             }
 
@@ -2159,7 +2115,7 @@ namespace detail
             else
             {
               // Next search can start with the new data.
-              search_position_ = end - begin;
+              search_position_ = result.first;
               bytes_to_read_ = std::min<std::size_t>(
                     std::max<std::size_t>(512,
                       buffers_.capacity() - buffers_.size()),
@@ -2432,21 +2388,18 @@ namespace detail
             // Determine the range of the data to be searched.
             typedef typename DynamicBuffer_v2::const_buffers_type
               buffers_type;
-            typedef buffers_iterator<buffers_type> iterator;
             buffers_type data_buffers =
               const_cast<const DynamicBuffer_v2&>(buffers_).data(
                   0, buffers_.size());
-            iterator begin = iterator::begin(data_buffers);
-            iterator start_pos = begin + search_position_;
-            iterator end = iterator::end(data_buffers);
 
             // Look for a match.
-            std::pair<iterator, bool> result = detail::partial_search(
-                start_pos, end, delim_.begin(), delim_.end());
-            if (result.first != end && result.second)
+            std::pair<std::size_t, bool> result = detail::buffer_search(
+                data_buffers, search_position_,
+                delim_.data(), delim_.length());
+            if (result.second)
             {
               // Full match. We're done.
-              search_position_ = result.first - begin + delim_.length();
+              search_position_ = result.first + delim_.length();
               bytes_to_read_ = 0;
             }
 
@@ -2460,17 +2413,9 @@ namespace detail
             // Need to read some more data.
             else
             {
-              if (result.first != end)
-              {
-                // Partial match. Next search needs to start from beginning of
-                // match.
-                search_position_ = result.first - begin;
-              }
-              else
-              {
-                // Next search can start with the new data.
-                search_position_ = end - begin;
-              }
+              // Next search needs to start from the beginning of any partial
+              // match, or otherwise with the new data.
+              search_position_ = result.first;
 
               bytes_to_read_ = std::min<std::size_t>(
                     std::max<std::size_t>(512,
@@ -26,6 +26,7 @@
 #include <boost/asio/detail/handler_invoke_helpers.hpp>
 #include <boost/asio/detail/memory.hpp>
 #include <boost/asio/detail/noncopyable.hpp>
+#include <boost/asio/detail/spawn_stack_pool.hpp>
 #include <boost/asio/detail/type_traits.hpp>
 #include <boost/system/system_error.hpp>
 
@@ -381,7 +382,12 @@ namespace detail {
     {
       typedef typename basic_yield_context<Handler>::callee_type callee_type;
       coro_entry_point<Handler, Function> entry_point = { data_ };
+#if defined(BOOST_ASIO_HAS_SPAWN_STACK_POOL)
+      shared_ptr<callee_type> coro(new callee_type(
+            entry_point, attributes_, spawn_stack_allocator()));
+#else // defined(BOOST_ASIO_HAS_SPAWN_STACK_POOL)
       shared_ptr<callee_type> coro(new callee_type(entry_point, attributes_));
+#endif // defined(BOOST_ASIO_HAS_SPAWN_STACK_POOL)
       data_->coro_ = coro;
       (*coro)();
     }
@@ -31,10 +31,12 @@ class awaitable_handler_base
 public:
   typedef void result_type;
   typedef awaitable<T, Executor> awaitable_type;
+  typedef cancellation_slot cancellation_slot_type;
 
   // Construct from the entry point of a new thread of execution.
-  awaitable_handler_base(awaitable<void, Executor> a, const Executor& ex)
-    : awaitable_thread<Executor>(std::move(a), ex)
+  awaitable_handler_base(awaitable<void, Executor> a, const Executor& ex,
+      cancellation_slot slot = cancellation_slot())
+    : awaitable_thread<Executor>(std::move(a), ex, slot)
   {
   }
 
@@ -44,6 +46,12 @@ public:
   {
   }
 
+  // Operations awaited by the thread use the thread's cancellation slot.
+  cancellation_slot_type get_cancellation_slot() const noexcept
+  {
+    return this->cancellation_slot_;
+  }
+
 protected:
   awaitable_frame<T, Executor>* frame() noexcept
   {
@@ -42,6 +42,10 @@
 # include <boost/asio/detail/scheduler.hpp>
 #endif
 
+#if defined(BOOST_ASIO_HAS_IO_SENDERS)
+# include <boost/asio/detail/scheduler_sender.hpp>
+#endif // defined(BOOST_ASIO_HAS_IO_SENDERS)
+
 #include <boost/asio/detail/push_options.hpp>
 
 namespace boost {
@@ -1018,6 +1022,50 @@ public:
   template <typename Function>
   void execute(BOOST_ASIO_MOVE_ARG(Function) f) const;
 
+  /// Request the io_context to invoke each function object in a range.
+  /**
+   * This function is used to ask the io_context to execute copies of the
+   * function objects in the range [@c first, @c last), as if by calling
+   * @c execute on a @c blocking.never executor for each one in turn. None of
+   * the function objects will be executed inside @c post_batch().
+   *
+   * The function objects are added to the io_context's queue of ready
+   * handlers together, so that the queue is locked only once for the entire
+   * batch.
+   *
+   * @param first An iterator to the first function object to be called. The
+   * function signature of the function object must be:
+   * @code void function(); @endcode
+   *
+   * @param last An iterator past the last function object to be called.
+   */
+  template <typename InputIterator>
+  void post_batch(InputIterator first, InputIterator last) const;
+
+#if defined(BOOST_ASIO_HAS_IO_SENDERS) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Obtain a sender that completes on the io_context.
+  /**
+   * Do not call this function directly. It is intended for use with the
+   * execution::schedule customisation point.
+   *
+   * The returned sender's operation state is queued directly on the
+   * io_context when it is started, so no memory is allocated. The receiver's
+   * @c set_value is called from a thread running the io_context. If the
+   * io_context is destroyed first, the receiver is not invoked.
+   *
+   * For example:
+   * @code auto op = execution::connect(
+   *     execution::schedule(my_io_context.get_executor()), my_receiver);
+   * execution::start(op); @endcode
+   */
+  detail::scheduler_sender schedule() const BOOST_ASIO_NOEXCEPT
+  {
+    return detail::scheduler_sender(io_context_->impl_);
+  }
+#endif // defined(BOOST_ASIO_HAS_IO_SENDERS)
+       //   || defined(GENERATING_DOCUMENTATION)
+
 #if !defined(BOOST_ASIO_NO_TS_EXECUTORS)
   /// Obtain the underlying execution context.
   io_context& context() const BOOST_ASIO_NOEXCEPT;
@@ -0,0 +1,123 @@
+//
+// read_pooled.hpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_READ_POOLED_HPP
+#define BOOST_ASIO_READ_POOLED_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_MOVE) || defined(GENERATING_DOCUMENTATION)
+
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/buffer_pool.hpp>
+#include <boost/asio/error.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+/**
+ * @defgroup async_read_pooled boost::asio::async_read_pooled
+ *
+ * @brief The @c async_read_pooled function is a composed asynchronous
+ * operation that reads into a buffer taken from a pool once data is available.
+ */
+/*@{*/
+
+/// Start an asynchronous operation to read data into a pooled buffer.
+/**
+ * This function is used to asynchronously read data from a stream without
+ * committing a buffer to the operation while it waits. The function call
+ * always returns immediately.
+ *
+ * The operation first waits for the stream to become ready to read, using the
+ * stream's @c async_wait function. Only then is a buffer taken from the pool,
+ * filled by reading from the stream's native handle, and passed to the
+ * handler. An operation that is waiting for data therefore holds no buffer
+ * memory, which allows a large number of mostly idle connections to share a
+ * small number of buffers. The read is performed in non-blocking mode, and if
+ * no data is available when it is attempted, for example because another
+ * operation waiting on the same stream has already consumed the data, the
+ * buffer is returned to the pool and the operation waits again.
+ *
+ * Several of these operations may be outstanding on the same stream at once,
+ * in which case each chunk of data that arrives is delivered to one of them.
+ *
+ * @param s The stream from which the data is to be read. The type must
+ * support the AsyncReadStream concept, and must additionally provide
+ * @c wait_read, @c async_wait, @c native_handle and @c native_non_blocking.
+ * Stream sockets and, where supported, POSIX stream descriptors meet these
+ * requirements. The native handle is put into non-blocking mode, as for any
+ * other asynchronous operation, but the stream's own non-blocking mode is not
+ * changed.
+ *
+ * @param pool The pool from which the buffer will be taken. Ownership of the
+ * pool is retained by the caller, which must guarantee that it remains valid
+ * until all buffers taken from it have been released.
+ *
+ * @param handler The handler to be called when the read operation completes.
+ * Copies will be made of the handler as required. The function signature of
+ * the handler must be:
+ * @code void handler(
+ *   // Result of operation.
+ *   const boost::system::error_code& error,
+ *
+ *   // The buffer containing the data that was read. Its size() is the number
+ *   // of bytes read. The buffer is empty if an error occurred. The buffer is
+ *   // returned to the pool when the object is destroyed.
+ *   boost::asio::pooled_buffer buffer
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the handler will not be invoked from within this function. On
+ * immediate completion, invocation of the handler will be performed in a
+ * manner equivalent to using boost::asio::post().
+ *
+ * @par Example
+ * @code void handle_read(const boost::system::error_code& ec,
+ *     boost::asio::pooled_buffer buffer)
+ * {
+ *   if (!ec)
+ *     process(buffer.data());
+ *   // The buffer is returned to the pool here.
+ * }
+ * ...
+ * boost::asio::buffer_pool pool(16384);
+ * ...
+ * boost::asio::async_read_pooled(sock, pool, handle_read); @endcode
+ */
+template <typename AsyncReadStream,
+    BOOST_ASIO_COMPLETION_TOKEN_FOR(void (boost::system::error_code,
+      pooled_buffer)) ReadHandler
+        BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(
+          typename AsyncReadStream::executor_type)>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
+    void (boost::system::error_code, pooled_buffer))
+async_read_pooled(AsyncReadStream& s, buffer_pool& pool,
+    BOOST_ASIO_MOVE_ARG(ReadHandler) handler
+      BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(
+        typename AsyncReadStream::executor_type));
+
+/*@}*/
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#include <boost/asio/impl/read_pooled.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_MOVE) || defined(GENERATING_DOCUMENTATION)
+
+#endif // BOOST_ASIO_READ_POOLED_HPP
@@ -0,0 +1,661 @@
+//
+// segmented_buffer.hpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_SEGMENTED_BUFFER_HPP
+#define BOOST_ASIO_SEGMENTED_BUFFER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <boost/asio/basic_segmented_buffer_fwd.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/detail/limits.hpp>
+#include <boost/asio/detail/memory.hpp>
+#include <boost/asio/detail/noncopyable.hpp>
+#include <boost/asio/detail/segmented_buffer_sequence.hpp>
+#include <boost/asio/detail/throw_exception.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+/// Automatically resizable buffer class made of a chain of fixed-size
+/// segments.
+/**
+ * The @c basic_segmented_buffer class stores its contents in a chain of
+ * fixed-size segments. As with @c basic_streambuf, the buffer has an input
+ * sequence that is ready to be consumed and an output sequence that has been
+ * prepared for writing.
+ *
+ * Unlike @c basic_streambuf, growing the buffer never moves existing data.
+ * When the output sequence needs more space, segments are appended to the end
+ * of the chain, and when data is consumed from the start of the input
+ * sequence, segments that are no longer in use are detached from the front of
+ * the chain. Detached segments are kept in a pool owned by the buffer and are
+ * reused by subsequent operations, so a buffer that is used for streaming
+ * reaches a steady state in which no memory is allocated or copied. The
+ * pooled segments may be released using @c shrink_to_fit().
+ *
+ * The input and output sequences are exposed as buffer sequences that contain
+ * one element per segment. The sequences are accepted directly by
+ * scatter-gather operations such as @c read_some and @c write_some.
+ *
+ * The buffer is a container, and is used with the dynamic buffer algorithms
+ * (such as @c async_read, @c read_until and @c async_write) through the
+ * dynamic_segmented_buffer class, which is created by calling the
+ * boost::asio::dynamic_buffer function.
+ *
+ * @par Example
+ * Reading a line and then writing it back:
+ * @code boost::asio::segmented_buffer b;
+ * std::size_t n = boost::asio::read_until(sock,
+ *     boost::asio::dynamic_buffer(b), '\n');
+ * boost::asio::write(sock, b.data(0, n));
+ * b.consume(n); @endcode
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ */
+#if defined(GENERATING_DOCUMENTATION)
+template <typename Allocator = std::allocator<char> >
+#else
+template <typename Allocator>
+#endif
+class basic_segmented_buffer
+  : private noncopyable
+{
+private:
+  typedef detail::segmented_buffer_segment segment;
+
+public:
+  /// The allocator type.
+  typedef Allocator allocator_type;
+
+#if defined(GENERATING_DOCUMENTATION)
+  /// The type used to represent the input sequence as a list of buffers.
+  typedef implementation_defined const_buffers_type;
+
+  /// The type used to represent the output sequence as a list of buffers.
+  typedef implementation_defined mutable_buffers_type;
+#else
+  typedef detail::segmented_buffer_sequence<
+    const_buffer> const_buffers_type;
+  typedef detail::segmented_buffer_sequence<
+    mutable_buffer> mutable_buffers_type;
+#endif
+
+  /// The default size of each segment, in bytes.
+  static const std::size_t default_segment_size = 4096;
+
+  /// Construct a basic_segmented_buffer object.
+  /**
+   * Constructs a segmented buffer with the specified maximum size. The initial
+   * size of the buffer's input sequence is 0, and no memory is allocated.
+   *
+   * @param maximum_size Specifies a maximum size for the buffer, in bytes.
+   *
+   * @param segment_size Specifies the size of each segment, in bytes. A value
+   * of 0 is treated as 1.
+   *
+   * @param allocator The allocator used to obtain memory for the segments.
+   */
+  explicit basic_segmented_buffer(
+      std::size_t maximum_size = (std::numeric_limits<std::size_t>::max)(),
+      std::size_t segment_size = default_segment_size,
+      const allocator_type& allocator = allocator_type())
+    : allocator_(allocator),
+      max_size_(maximum_size),
+      segment_size_(segment_size ? segment_size : 1),
+      segment_units_(1 + (segment_size_ + sizeof(segment) - 1)
+          / sizeof(segment)),
+      head_(0),
+      tail_(0),
+      free_(0),
+      segment_count_(0),
+      free_count_(0),
+      offset_(0),
+      size_(0),
+      reserved_(0)
+  {
+  }
+
+  /// Destructor releases all segments.
+  ~basic_segmented_buffer()
+  {
+    while (head_)
+      pop_front();
+    shrink_to_fit();
+  }
+
+  /// Get the size of the input sequence.
+  /**
+   * @returns The size of the input sequence. The value is equal to that
+   * calculated for @c s in the following code:
+   * @code
+   * size_t s = 0;
+   * const_buffers_type bufs = data();
+   * const_buffers_type::const_iterator i = bufs.begin();
+   * while (i != bufs.end())
+   * {
+   *   const_buffer buf(*i++);
+   *   s += buf.size();
+   * }
+   * @endcode
+   */
+  std::size_t size() const BOOST_ASIO_NOEXCEPT
+  {
+    return size_;
+  }
+
+  /// Get the maximum size of the buffer.
+  /**
+   * @returns The allowed maximum of the sum of the sizes of the input sequence
+   * and output sequence.
+   */
+  std::size_t max_size() const BOOST_ASIO_NOEXCEPT
+  {
+    return max_size_;
+  }
+
+  /// Get the current capacity of the buffer.
+  /**
+   * @returns The current total capacity of the buffer, i.e. for both the input
+   * sequence and output sequence, including pooled segments.
+   */
+  std::size_t capacity() const BOOST_ASIO_NOEXCEPT
+  {
+    return (segment_count_ + free_count_) * segment_size_ - offset_;
+  }
+
+  /// Get the size of each segment.
+  std::size_t segment_size() const BOOST_ASIO_NOEXCEPT
+  {
+    return segment_size_;
+  }
+
+  /// Get a list of buffers that represents the input sequence.
+  /**
+   * @returns An object of type @c const_buffers_type that satisfies
+   * ConstBufferSequence requirements, representing all character arrays in the
+   * input sequence.
+   *
+   * @note The returned object is invalidated by any @c basic_segmented_buffer
+   * member function that modifies the input sequence or output sequence.
+   */
+  const_buffers_type data() const BOOST_ASIO_NOEXCEPT
+  {
+    return sequence<const_buffers_type>(0, size_);
+  }
+
+  /// Get a list of buffers that represents part of the input sequence.
+  /**
+   * @param pos Position of the first byte to represent in the buffer sequence.
+   *
+   * @param n The number of bytes to return in the buffer sequence. If the
+   * input sequence is shorter, the buffer sequence represents as many bytes as
+   * are available.
+   *
+   * @note The returned object is invalidated by any @c basic_segmented_buffer
+   * member function that modifies the input sequence or output sequence.
+   */
+  mutable_buffers_type data(std::size_t pos,
+      std::size_t n) BOOST_ASIO_NOEXCEPT
+  {
+    pos = (std::min)(pos, size_);
+    return sequence<mutable_buffers_type>(pos, (std::min)(n, size_ - pos));
+  }
+
+  /// Get a list of buffers that represents part of the input sequence.
+  /**
+   * @param pos Position of the first byte to represent in the buffer sequence.
+   *
+   * @param n The number of bytes to return in the buffer sequence. If the
+   * input sequence is shorter, the buffer sequence represents as many bytes as
+   * are available.
+   *
+   * @note The returned object is invalidated by any @c basic_segmented_buffer
+   * member function that modifies the input sequence or output sequence.
+   */
+  const_buffers_type data(std::size_t pos,
+      std::size_t n) const BOOST_ASIO_NOEXCEPT
+  {
+    pos = (std::min)(pos, size_);
+    return sequence<const_buffers_type>(pos, (std::min)(n, size_ - pos));
+  }
+
+  /// Get a list of buffers that represents the output sequence, with the
+  /// given size.
+  /**
+   * Ensures that the output sequence can accommodate @c n bytes, appending
+   * segments to the chain as required. Existing data is never moved.
+   *
+   * @returns An object of type @c mutable_buffers_type that satisfies
+   * MutableBufferSequence requirements, representing character array objects
+   * at the start of the output sequence such that the sum of the buffer sizes
+   * is @c n.
+   *
+   * @throws std::length_error If <tt>size() + n > max_size()</tt>.
+   *
+   * @note The returned object is invalidated by any @c basic_segmented_buffer
+   * member function that modifies the input sequence or output sequence.
+   */
+  mutable_buffers_type prepare(std::size_t n)
+  {
+    check_length(n);
+    reserve(size_ + n);
+    reserved_ = n;
+    trim();
+    return sequence<mutable_buffers_type>(size_, n);
+  }
+
+  /// Move bytes from the output sequence to the input sequence.
+  /**
+   * @param n The number of bytes to append from the start of the output
+   * sequence to the end of the input sequence. The remainder of the output
+   * sequence is discarded.
+   *
+   * Requires a preceding call <tt>prepare(x)</tt> where <tt>x >= n</tt>, and
+   * no intervening operations that modify the input or output sequence.
+   *
+   * @note If @c n is greater than the size of the output sequence, the entire
+   * output sequence is moved to the input sequence and no error is issued.
+   */
+  void commit(std::size_t n)
+  {
+    size_ += (std::min)(n, reserved_);
+    reserved_ = 0;
+    trim();
+  }
+
+  /// Grow the input sequence by the specified number of bytes.
+  /**
+   * Appends @c n bytes of uninitialised memory to the end of the input
+   * sequence. Any output sequence is discarded.
+   *
+   * @throws std::length_error If <tt>size() + n > max_size()</tt>.
+   */
+  void grow(std::size_t n)
+  {
+    check_length(n);
+    reserved_ = 0;
+    reserve(size_ + n);
+    size_ += n;
+    trim();
+  }
+
+  /// Shrink the input sequence by the specified number of bytes.
+  /**
+   * Erases @c n bytes from the end of the input sequence. If @c n is greater
+   * than the size of the input sequence, the input sequence is emptied. Any
+   * output sequence is discarded.
+   */
+  void shrink(std::size_t n)
+  {
+    size_ -= (std::min)(n, size_);
+    reserved_ = 0;
+    trim();
+  }
+
+  /// Remove characters from the input sequence.
+  /**
+   * Removes @c n characters from the beginning of the input sequence. Segments
+   * that no longer hold any data are returned to the pool.
+   *
+   * @note If @c n is greater than the size of the input sequence, the entire
+   * input sequence is consumed and no error is issued.
+   */
+  void consume(std::size_t n)
+  {
+    n = (std::min)(n, size_);
+    size_ -= n;
+    offset_ += n;
+    trim();
+    while (offset_ >= segment_size_)
+    {
+      pop_front();
+      offset_ -= segment_size_;
+    }
+  }
+
+  /// Release pooled segments.
+  /**
+   * Frees the memory used by segments that are not currently part of the
+   * input or output sequence.
+   */
+  void shrink_to_fit()
+  {
+    while (free_)
+    {
+      segment* s = free_;
+      free_ = s->next_;
+      --free_count_;
+      allocator_.deallocate(s, segment_units_);
+    }
+  }
+
+  /// Get the allocator.
+  allocator_type get_allocator() const BOOST_ASIO_NOEXCEPT
+  {
+    return allocator_type(allocator_);
+  }
+
+private:
+  typedef BOOST_ASIO_REBIND_ALLOC(Allocator, segment) segment_allocator_type;
+
+  // Throw if the input sequence cannot grow by n bytes.
+  void check_length(std::size_t n) const
+  {
+    if (size_ > max_size_ || max_size_ - size_ < n)
+    {
+      std::length_error ex("boost::asio::segmented_buffer too long");
+      boost::asio::detail::throw_exception(ex);
+    }
+  }
+
+  // Get the number of segments needed to hold the given number of bytes,
+  // starting from the current offset into the first segment.
+  std::size_t segments_needed(std::size_t n) const
+  {
+    return n ? (offset_ + n + segment_size_ - 1) / segment_size_ : 0;
+  }
+
+  // Append segments until the chain can hold n bytes.
+  void reserve(std::size_t n)
+  {
+    for (std::size_t needed = segments_needed(n);
+        segment_count_ < needed; ++segment_count_)
+    {
+      segment* s = free_;
+      if (s)
+      {
+        free_ = s->next_;
+        --free_count_;
+      }
+      else
+      {
+        s = allocator_.allocate(segment_units_);
+      }
+
+      s->next_ = 0;
+      s->prev_ = tail_;
+      if (tail_)
+        tail_->next_ = s;
+      else
+        head_ = s;
+      tail_ = s;
+    }
+  }
+
+  // Return segments to the pool that are not needed by either sequence.
+  void trim()
+  {
+    std::size_t needed = segments_needed(size_ + reserved_);
+    while (segment_count_ > needed)
+    {
+      segment* s = tail_;
+      tail_ = s->prev_;
+      if (tail_)
+        tail_->next_ = 0;
+      else
+        head_ = 0;
+      --segment_count_;
+      release(s);
+    }
+
+    if (needed == 0)
+      offset_ = 0;
+  }
+
+  // Return the first segment in the chain to the pool.
+  void pop_front()
+  {
+    segment* s = head_;
+    head_ = s->next_;
+    if (head_)
+      head_->prev_ = 0;
+    else
+      tail_ = 0;
+    --segment_count_;
+    release(s);
+  }
+
+  void release(segment* s)
+  {
+    s->next_ = free_;
+    free_ = s;
+    ++free_count_;
+  }
+
+  // Find the segment that holds the byte at the given position.
+  segment* locate(std::size_t pos) const
+  {
+    std::size_t index = (offset_ + pos) / segment_size_;
+    segment* s;
+    if (index < segment_count_ / 2)
+    {
+      s = head_;
+      for (; index > 0; --index)
+        s = s->next_;
+    }
+    else
+    {
+      s = tail_;
+      for (index = segment_count_ - index - 1; index > 0; --index)
+        s = s->prev_;
+    }
+    return s;
+  }
+
+  // Create a buffer sequence for n bytes starting at the given position.
+  template <typename Sequence>
+  Sequence sequence(std::size_t pos, std::size_t n) const
+  {
+    if (n == 0)
+      return Sequence();
+    return Sequence(locate(pos), (offset_ + pos) % segment_size_,
+        locate(pos + n - 1), n, segment_size_);
+  }
+
+  segment_allocator_type allocator_;
+  std::size_t max_size_;
+  std::size_t segment_size_;
+  std::size_t segment_units_;
+  segment* head_;
+  segment* tail_;
+  segment* free_;
+  std::size_t segment_count_;
+  std::size_t free_count_;
+  std::size_t offset_;
+  std::size_t size_;
+  std::size_t reserved_;
+};
+
+template <typename Allocator>
+const std::size_t basic_segmented_buffer<Allocator>::default_segment_size;
+
+/// Typedef for the typical usage of basic_segmented_buffer.
+typedef basic_segmented_buffer<std::allocator<char> > segmented_buffer;
+
+/// Adapts a basic_segmented_buffer to the dynamic buffer sequence type
+/// requirements.
+/**
+ * Requirements:
+ *
+ * @par DynamicBuffer_v1: The input sequence and output sequence are those of
+ * the underlying basic_segmented_buffer.
+ *
+ * @par DynamicBuffer_v2: The underlying memory is the input sequence of the
+ * basic_segmented_buffer.
+ *
+ * The dynamic_segmented_buffer object stores a reference to the underlying
+ * basic_segmented_buffer, and the user is responsible for ensuring that the
+ * basic_segmented_buffer object remains valid while the
+ * dynamic_segmented_buffer object, and copies of the object, are in use.
+ */
+#if defined(GENERATING_DOCUMENTATION)
+template <typename Allocator = std::allocator<char> >
+#else
+template <typename Allocator>
+#endif
+class dynamic_segmented_buffer
+{
+public:
+  /// The type used to represent a sequence of constant buffers that refers to
+  /// the underlying memory.
+  typedef typename basic_segmented_buffer<Allocator>::const_buffers_type
+    const_buffers_type;
+
+  /// The type used to represent a sequence of mutable buffers that refers to
+  /// the underlying memory.
+  typedef typename basic_segmented_buffer<Allocator>::mutable_buffers_type
+    mutable_buffers_type;
+
+  /// Construct a dynamic buffer from a basic_segmented_buffer.
+  explicit dynamic_segmented_buffer(
+      basic_segmented_buffer<Allocator>& b) BOOST_ASIO_NOEXCEPT
+    : buffer_(b)
+  {
+  }
+
+  /// Copy construct a dynamic buffer.
+  dynamic_segmented_buffer(
+      const dynamic_segmented_buffer& other) BOOST_ASIO_NOEXCEPT
+    : buffer_(other.buffer_)
+  {
+  }
+
+#if defined(BOOST_ASIO_HAS_MOVE) || defined(GENERATING_DOCUMENTATION)
+  /// Move construct a dynamic buffer.
+  dynamic_segmented_buffer(
+      dynamic_segmented_buffer&& other) BOOST_ASIO_NOEXCEPT
+    : buffer_(other.buffer_)
+  {
+  }
+#endif // defined(BOOST_ASIO_HAS_MOVE) || defined(GENERATING_DOCUMENTATION)
+
+  /// @b DynamicBuffer_v1: Get the size of the input sequence.
+  /// @b DynamicBuffer_v2: Get the current size of the underlying memory.
+  std::size_t size() const BOOST_ASIO_NOEXCEPT
+  {
+    return buffer_.size();
+  }
+
+  /// Get the maximum size of the dynamic buffer.
+  std::size_t max_size() const BOOST_ASIO_NOEXCEPT
+  {
+    return buffer_.max_size();
+  }
+
+  /// Get the maximum size that the buffer may grow to without allocating
+  /// segments.
+  std::size_t capacity() const BOOST_ASIO_NOEXCEPT
+  {
+    return buffer_.capacity();
+  }
+
+#if !defined(BOOST_ASIO_NO_DYNAMIC_BUFFER_V1)
+  /// @b DynamicBuffer_v1: Get a list of buffers that represents the input
+  /// sequence.
+  const_buffers_type data() const BOOST_ASIO_NOEXCEPT
+  {
+    return buffer_.data();
+  }
+#endif // !defined(BOOST_ASIO_NO_DYNAMIC_BUFFER_V1)
+
+  /// @b DynamicBuffer_v2: Get a sequence of buffers that represents the
+  /// underlying memory.
+  mutable_buffers_type data(std::size_t pos,
+      std::size_t n) BOOST_ASIO_NOEXCEPT
+  {
+    return buffer_.data(pos, n);
+  }
+
+  /// @b DynamicBuffer_v2: Get a sequence of buffers that represents the
+  /// underlying memory.
+  const_buffers_type data(std::size_t pos,
+      std::size_t n) const BOOST_ASIO_NOEXCEPT
+  {
+    return static_cast<const basic_segmented_buffer<Allocator>&>(
+        buffer_).data(pos, n);
+  }
+
+#if !defined(BOOST_ASIO_NO_DYNAMIC_BUFFER_V1)
+  /// @b DynamicBuffer_v1: Get a list of buffers that represents the output
+  /// sequence, with the given size.
+  /**
+   * @throws std::length_error If <tt>size() + n > max_size()</tt>.
+   */
+  mutable_buffers_type prepare(std::size_t n)
+  {
+    return buffer_.prepare(n);
+  }
+
+  /// @b DynamicBuffer_v1: Move bytes from the output sequence to the input
+  /// sequence.
+  void commit(std::size_t n)
+  {
+    buffer_.commit(n);
+  }
+#endif // !defined(BOOST_ASIO_NO_DYNAMIC_BUFFER_V1)
+
+  /// @b DynamicBuffer_v2: Grow the underlying memory by the specified number
+  /// of bytes.
+  /**
+   * @throws std::length_error If <tt>size() + n > max_size()</tt>.
+   */
+  void grow(std::size_t n)
+  {
+    buffer_.grow(n);
+  }
+
+  /// @b DynamicBuffer_v2: Shrink the underlying memory by the specified number
+  /// of bytes.
+  void shrink(std::size_t n)
+  {
+    buffer_.shrink(n);
+  }
+
+  /// @b DynamicBuffer_v1: Remove characters from the input sequence.
+  /// @b DynamicBuffer_v2: Consume the specified number of bytes from the
+  /// beginning of the underlying memory.
+  void consume(std::size_t n)
+  {
+    buffer_.consume(n);
+  }
+
+private:
+  basic_segmented_buffer<Allocator>& buffer_;
+};
+
+/// Create a new dynamic buffer that represents the given segmented buffer.
+/**
+ * @returns <tt>dynamic_segmented_buffer<Allocator>(data)</tt>.
+ */
+template <typename Allocator>
+inline dynamic_segmented_buffer<Allocator> dynamic_buffer(
+    basic_segmented_buffer<Allocator>& data) BOOST_ASIO_NOEXCEPT
+{
+  return dynamic_segmented_buffer<Allocator>(data);
+}
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_SEGMENTED_BUFFER_HPP
@@ -504,6 +504,51 @@ public:
     enable_connection_aborted;
 #endif
 
+  /// Socket option to wake only one waiting reactor when a socket is ready.
+  /**
+   * Implements a custom socket option that determines whether readiness of
+   * the socket wakes only one of the reactors waiting on it. The option is
+   * intended for a listening socket that is shared by several execution
+   * contexts, such as when each thread runs its own io_context with an
+   * acceptor for the same native socket. Without the option, each new
+   * connection wakes every context, and all but one find nothing to accept.
+   * By default the option is false.
+   *
+   * When the option is set, the socket's out-of-band data is not reported. On
+   * Linux the option requires a kernel that supports @c EPOLLEXCLUSIVE. On
+   * other platforms the option has no effect.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * boost::asio::ip::tcp::acceptor acceptor(my_context);
+   * ...
+   * boost::asio::socket_base::exclusive_wake option(true);
+   * acceptor.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * boost::asio::ip::tcp::acceptor acceptor(my_context);
+   * ...
+   * boost::asio::socket_base::exclusive_wake option;
+   * acceptor.get_option(option);
+   * bool is_set = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined exclusive_wake;
+#else
+  typedef boost::asio::detail::socket_option::boolean<
+    boost::asio::detail::custom_socket_option_level,
+    boost::asio::detail::exclusive_wake_option>
+    exclusive_wake;
+#endif
+
   /// IO control command to get the amount of data that can be read without
   /// blocking.
   /**
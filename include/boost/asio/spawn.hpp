@@ -188,6 +188,14 @@ typedef basic_yield_context<
  *     // ...
  *   }
  * } @endcode
+ *
+ * @par Coroutine Stacks
+ * On POSIX platforms, coroutine stacks are protected by a guard page and are
+ * reused rather than unmapped when a coroutine exits. Each thread keeps up to
+ * @c BOOST_ASIO_SPAWN_STACK_POOL_SIZE idle stacks (1024 by default), and a
+ * stack is reused only for a coroutine requesting the same size through its
+ * attributes. Define @c BOOST_ASIO_DISABLE_SPAWN_STACK_POOL to use the
+ * Boost.Coroutine default stack allocator instead.
  */
 /*@{*/
 
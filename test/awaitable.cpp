@@ -18,8 +18,180 @@
 
 #include "unit_test.hpp"
 
+#if defined(BOOST_ASIO_HAS_CO_AWAIT) \
+  && !defined(BOOST_ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
+
+#include <cstring>
+#include <thread>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+#if defined(__GLIBC__)
+# include <malloc.h>
+#endif // defined(__GLIBC__)
+
+using boost::asio::awaitable;
+using boost::asio::use_awaitable;
+using boost::asio::detail::awaitable_frame_pool;
+
+awaitable<int> leaf(int value)
+{
+  // Suspend, so that the whole call chain is live at once.
+  co_await boost::asio::post(co_await boost::asio::this_coro::executor,
+      use_awaitable);
+  co_return value;
+}
+
+awaitable<int> middle(int value)
+{
+  char padding[200] = { static_cast<char>(value) };
+  int result = co_await leaf(value);
+  co_return result + padding[0];
+}
+
+awaitable<int> outer(int value)
+{
+  char padding[1000] = { static_cast<char>(value) };
+  int result = co_await middle(value) + co_await leaf(value);
+  co_return result + padding[0];
+}
+
+awaitable<void> chain(int iterations, int* total)
+{
+  for (int i = 0; i < iterations; ++i)
+    *total += co_await outer(1);
+}
+
+void test_frame_pool()
+{
+  boost::asio::io_context ioc;
+  int total = 0;
+
+  // Warm up the pool for each of the frame sizes in the call chain.
+  boost::asio::co_spawn(ioc, chain(1, &total), boost::asio::detached);
+  ioc.run();
+  BOOST_ASIO_CHECK(total == 4);
+
+  awaitable_frame_pool::counters before =
+    awaitable_frame_pool::instance()->get_counters();
+  BOOST_ASIO_CHECK(before.idle > 0);
+
+  // Frames of different sizes are nested, and all are served from the pool.
+  boost::asio::co_spawn(ioc, chain(100, &total), boost::asio::detached);
+  ioc.restart();
+  ioc.run();
+  BOOST_ASIO_CHECK(total == 404);
+
+  awaitable_frame_pool::counters after =
+    awaitable_frame_pool::instance()->get_counters();
+  std::size_t allocations = after.allocations - before.allocations;
+  BOOST_ASIO_CHECK(allocations > 100);
+  BOOST_ASIO_CHECK(after.reuses - before.reuses == allocations);
+  BOOST_ASIO_CHECK(after.deallocations - before.deallocations == allocations);
+  BOOST_ASIO_CHECK(after.releases == before.releases);
+  BOOST_ASIO_CHECK(after.idle == before.idle);
+}
+
+void test_frame_pool_retention()
+{
+  awaitable_frame_pool pool;
+
+  // Each size class retains a limited number of idle frames.
+  void* blocks[BOOST_ASIO_AWAITABLE_FRAME_POOL_SIZE + 1];
+  for (int i = 0; i <= BOOST_ASIO_AWAITABLE_FRAME_POOL_SIZE; ++i)
+    blocks[i] = pool.allocate(100);
+  for (int i = 0; i <= BOOST_ASIO_AWAITABLE_FRAME_POOL_SIZE; ++i)
+    pool.deallocate(blocks[i], 100);
+  BOOST_ASIO_CHECK(pool.get_counters().idle
+      == BOOST_ASIO_AWAITABLE_FRAME_POOL_SIZE);
+  BOOST_ASIO_CHECK(pool.get_counters().releases == 1);
+
+  // Sizes within the same size class share idle frames.
+  void* p = pool.allocate(120);
+  BOOST_ASIO_CHECK(pool.get_counters().reuses == 1);
+  pool.deallocate(p, 120);
+
+  // Sizes in other classes do not.
+  p = pool.allocate(1000);
+  BOOST_ASIO_CHECK(pool.get_counters().reuses == 1);
+  pool.deallocate(p, 1000);
+
+  // Large frames are not cached.
+  p = pool.allocate(awaitable_frame_pool::max_cached_size + 1);
+  pool.deallocate(p, awaitable_frame_pool::max_cached_size + 1);
+  BOOST_ASIO_CHECK(pool.get_counters().releases == 2);
+
+  // Separately created pools do not affect the calling thread's pool.
+  {
+    awaitable_frame_pool other;
+  }
+  BOOST_ASIO_CHECK(awaitable_frame_pool::instance() != 0);
+}
+
+// Allocates a frame during thread exit, after the thread's pool is destroyed.
+struct late_allocation
+{
+  void** frame_;
+
+  ~late_allocation()
+  {
+    *frame_ = awaitable_frame_pool::thread_allocate(100);
+  }
+};
+
+void allocate_at_thread_exit(void** frame)
+{
+  // Constructed before the pool, and so destroyed after it.
+  static thread_local late_allocation late = { frame };
+  (void)late;
+  awaitable_frame_pool::thread_deallocate(
+      awaitable_frame_pool::thread_allocate(100), 100);
+}
+
+void test_frame_pool_fallback()
+{
+  // A frame allocated without a pool is freed into this thread's pool.
+  void* frame = 0;
+  std::thread(allocate_at_thread_exit, &frame).join();
+  BOOST_ASIO_CHECK(frame != 0);
+  awaitable_frame_pool::thread_deallocate(frame, 100);
+
+  // The pool hands the block out again for any size in its size class.
+  void* p = awaitable_frame_pool::thread_allocate(128);
+  BOOST_ASIO_CHECK(p == frame);
+#if defined(__GLIBC__)
+  BOOST_ASIO_CHECK(malloc_usable_size(p) >= 128);
+#endif // defined(__GLIBC__)
+  std::memset(p, 0, 128);
+  awaitable_frame_pool::thread_deallocate(p, 128);
+}
+
+#else // defined(BOOST_ASIO_HAS_CO_AWAIT)
+      //   && !defined(BOOST_ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
+
+void test_frame_pool()
+{
+}
+
+void test_frame_pool_fallback()
+{
+}
+
+void test_frame_pool_retention()
+{
+}
+
+#endif // defined(BOOST_ASIO_HAS_CO_AWAIT)
+       //   && !defined(BOOST_ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
+
 BOOST_ASIO_TEST_SUITE
 (
   "awaitable",
-  BOOST_ASIO_TEST_CASE(null_test)
+  BOOST_ASIO_TEST_CASE(test_frame_pool)
+  BOOST_ASIO_TEST_CASE(test_frame_pool_retention)
+  BOOST_ASIO_TEST_CASE(test_frame_pool_fallback)
 )
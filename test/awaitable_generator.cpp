@@ -0,0 +1,230 @@
+//
+// awaitable_generator.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/awaitable_generator.hpp>
+
+#include "unit_test.hpp"
+
+#if defined(BOOST_ASIO_HAS_CO_AWAIT) && defined(BOOST_ASIO_HAS_STD_OPTIONAL)
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+using boost::asio::awaitable;
+using boost::asio::awaitable_generator;
+using boost::asio::use_awaitable;
+
+template <typename T>
+void run(awaitable<T> a)
+{
+  boost::asio::io_context ioc;
+  boost::asio::co_spawn(ioc, std::move(a), boost::asio::detached);
+  ioc.run();
+}
+
+awaitable_generator<int> count_to(int n, int* started)
+{
+  ++*started;
+  for (int i = 0; i < n; ++i)
+    co_yield i;
+}
+
+awaitable<void> do_test_values()
+{
+  int started = 0;
+  awaitable_generator<int> gen = count_to(3, &started);
+  BOOST_ASIO_CHECK(gen.valid());
+
+  // The generator does not run until a value is requested.
+  BOOST_ASIO_CHECK(started == 0);
+
+  std::vector<int> values;
+  while (std::optional<int> v = co_await gen.next())
+  {
+    BOOST_ASIO_CHECK(started == 1);
+    values.push_back(*v);
+  }
+  BOOST_ASIO_CHECK(values == std::vector<int>({0, 1, 2}));
+
+  // A finished generator continues to produce empty results.
+  std::optional<int> v = co_await gen.next();
+  BOOST_ASIO_CHECK(!v);
+
+  awaitable_generator<int> moved(std::move(gen));
+  BOOST_ASIO_CHECK(!gen.valid());
+  BOOST_ASIO_CHECK(moved.valid());
+}
+
+void test_values()
+{
+  run(do_test_values());
+}
+
+awaitable<int> delayed(int ms, int value)
+{
+  boost::asio::steady_timer timer(co_await boost::asio::this_coro::executor);
+  timer.expires_after(boost::asio::chrono::milliseconds(ms));
+  co_await timer.async_wait(use_awaitable);
+  co_return value;
+}
+
+awaitable_generator<std::unique_ptr<std::string>> ticks(int n)
+{
+  boost::asio::steady_timer timer(co_await boost::asio::this_coro::executor);
+  for (int i = 0; i < n; ++i)
+  {
+    timer.expires_after(boost::asio::chrono::milliseconds(1));
+    co_await timer.async_wait(use_awaitable);
+    int value = co_await delayed(1, i);
+
+    // Move-only values are moved through the generator.
+    co_yield std::make_unique<std::string>(std::to_string(value));
+  }
+}
+
+awaitable<void> do_test_async()
+{
+  awaitable_generator<std::unique_ptr<std::string>> gen = ticks(3);
+
+  std::string result;
+  while (auto v = co_await gen.next())
+    result += **v;
+  BOOST_ASIO_CHECK(result == "012");
+}
+
+void test_async()
+{
+  run(do_test_async());
+}
+
+awaitable_generator<int> throw_after(int n)
+{
+  for (int i = 0; i < n; ++i)
+    co_yield i;
+  throw std::runtime_error("failed");
+}
+
+awaitable<void> do_test_exception()
+{
+  awaitable_generator<int> gen = throw_after(2);
+
+  int count = 0;
+  std::string what;
+  try
+  {
+    while (co_await gen.next())
+      ++count;
+  }
+  catch (const std::exception& e)
+  {
+    what = e.what();
+  }
+  BOOST_ASIO_CHECK(count == 2);
+  BOOST_ASIO_CHECK(what == "failed");
+
+  // The exception is reported once, after which the generator has finished.
+  std::optional<int> v = co_await gen.next();
+  BOOST_ASIO_CHECK(!v);
+}
+
+void test_exception()
+{
+  run(do_test_exception());
+}
+
+struct tracker
+{
+  int* destroyed_;
+  ~tracker() { ++*destroyed_; }
+};
+
+awaitable_generator<int> tracked(int* destroyed)
+{
+  tracker t = { destroyed };
+  for (int i = 0;; ++i)
+    co_yield i;
+}
+
+awaitable_generator<int> doubled(awaitable_generator<int> source)
+{
+  while (std::optional<int> v = co_await source.next())
+    co_yield *v * 2;
+}
+
+awaitable<void> do_test_destroy()
+{
+  int destroyed = 0;
+  {
+    // Destroying a suspended generator destroys its locals.
+    awaitable_generator<int> gen = tracked(&destroyed);
+    co_await gen.next();
+    co_await gen.next();
+    BOOST_ASIO_CHECK(destroyed == 0);
+  }
+  BOOST_ASIO_CHECK(destroyed == 1);
+
+  // Generators may consume other generators.
+  int started = 0;
+  awaitable_generator<int> gen = doubled(count_to(4, &started));
+  int sum = 0;
+  while (std::optional<int> v = co_await gen.next())
+    sum += *v;
+  BOOST_ASIO_CHECK(sum == 12);
+}
+
+void test_destroy()
+{
+  run(do_test_destroy());
+}
+
+#else // defined(BOOST_ASIO_HAS_CO_AWAIT)
+      //   && defined(BOOST_ASIO_HAS_STD_OPTIONAL)
+
+void test_values()
+{
+}
+
+void test_async()
+{
+}
+
+void test_exception()
+{
+}
+
+void test_destroy()
+{
+}
+
+#endif // defined(BOOST_ASIO_HAS_CO_AWAIT)
+       //   && defined(BOOST_ASIO_HAS_STD_OPTIONAL)
+
+BOOST_ASIO_TEST_SUITE
+(
+  "awaitable_generator",
+  BOOST_ASIO_TEST_CASE(test_values)
+  BOOST_ASIO_TEST_CASE(test_async)
+  BOOST_ASIO_TEST_CASE(test_exception)
+  BOOST_ASIO_TEST_CASE(test_destroy)
+)
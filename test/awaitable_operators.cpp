@@ -0,0 +1,367 @@
+//
+// awaitable_operators.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/awaitable_operators.hpp>
+
+#include "unit_test.hpp"
+
+#if defined(BOOST_ASIO_HAS_CO_AWAIT) && defined(BOOST_ASIO_HAS_STD_VARIANT)
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+using namespace boost::asio::awaitable_operators;
+using boost::asio::awaitable;
+using boost::asio::use_awaitable;
+
+awaitable<void> sleep_for(int ms)
+{
+  boost::asio::steady_timer timer(co_await boost::asio::this_coro::executor);
+  timer.expires_after(boost::asio::chrono::milliseconds(ms));
+  co_await timer.async_wait(use_awaitable);
+}
+
+awaitable<int> int_after(int ms, int value)
+{
+  co_await sleep_for(ms);
+  co_return value;
+}
+
+awaitable<std::string> string_after(int ms, std::string value)
+{
+  co_await sleep_for(ms);
+  co_return value;
+}
+
+awaitable<void> void_after(int ms, int* order, int* counter)
+{
+  co_await sleep_for(ms);
+  *order = ++*counter;
+}
+
+awaitable<int> throw_after(int ms)
+{
+  co_await sleep_for(ms);
+  throw std::runtime_error("failed");
+}
+
+awaitable<int> immediate(int value)
+{
+  co_return value;
+}
+
+// A value whose move constructor fails once a shared budget of moves is used.
+struct move_limited
+{
+  int* moves_left_;
+
+  explicit move_limited(int* moves_left)
+    : moves_left_(moves_left)
+  {
+  }
+
+  move_limited(move_limited&& other)
+    : moves_left_(other.moves_left_)
+  {
+    if ((*moves_left_)-- == 0)
+      throw std::length_error("moved");
+  }
+};
+
+awaitable<move_limited> move_limited_after(int ms, int* moves_left)
+{
+  co_await sleep_for(ms);
+  co_return move_limited(moves_left);
+}
+
+template <typename T>
+void run(awaitable<T> a)
+{
+  boost::asio::io_context ioc;
+  boost::asio::co_spawn(ioc, std::move(a), boost::asio::detached);
+  ioc.run();
+}
+
+awaitable<void> do_test_and()
+{
+  int counter = 0, o1 = 0, o2 = 0;
+
+  co_await (void_after(20, &o1, &counter) && void_after(10, &o2, &counter));
+  BOOST_ASIO_CHECK(o1 == 2);
+  BOOST_ASIO_CHECK(o2 == 1);
+
+  int i = co_await (int_after(10, 1) && void_after(5, &o1, &counter));
+  BOOST_ASIO_CHECK(i == 1);
+  BOOST_ASIO_CHECK(o1 == 3);
+
+  i = co_await (void_after(5, &o2, &counter) && int_after(1, 2));
+  BOOST_ASIO_CHECK(i == 2);
+  BOOST_ASIO_CHECK(o2 == 4);
+
+  std::tuple<int, std::string> t1 = co_await (
+      int_after(10, 3) && string_after(5, "four"));
+  BOOST_ASIO_CHECK(std::get<0>(t1) == 3);
+  BOOST_ASIO_CHECK(std::get<1>(t1) == "four");
+
+  // Chained operators flatten into a single tuple.
+  std::tuple<int, std::string, int> t2 = co_await (
+      int_after(5, 5) && string_after(15, "six")
+        && immediate(7) && void_after(1, &o1, &counter));
+  BOOST_ASIO_CHECK(std::get<0>(t2) == 5);
+  BOOST_ASIO_CHECK(std::get<1>(t2) == "six");
+  BOOST_ASIO_CHECK(std::get<2>(t2) == 7);
+  BOOST_ASIO_CHECK(o1 == 5);
+
+  // The operands run concurrently, so the total time is bounded by the
+  // slowest operand rather than their sum.
+  boost::asio::chrono::steady_clock::time_point start
+    = boost::asio::chrono::steady_clock::now();
+  co_await (sleep_for(100) && sleep_for(100) && sleep_for(100));
+  BOOST_ASIO_CHECK(boost::asio::chrono::steady_clock::now() - start
+      < boost::asio::chrono::milliseconds(250));
+}
+
+void test_and()
+{
+  run(do_test_and());
+}
+
+awaitable<void> do_test_and_exception()
+{
+  int counter = 0, o1 = 0;
+
+  bool caught = false;
+  try
+  {
+    co_await (throw_after(1) && void_after(20, &o1, &counter));
+  }
+  catch (const std::runtime_error&)
+  {
+    caught = true;
+  }
+  BOOST_ASIO_CHECK(caught);
+
+  // The exception is only rethrown once both operations have completed.
+  BOOST_ASIO_CHECK(o1 == 1);
+}
+
+void test_and_exception()
+{
+  run(do_test_and_exception());
+}
+
+awaitable<void> do_test_or()
+{
+  int counter = 0, o1 = 0, o2 = 0;
+
+  std::variant<int, std::string> v1 = co_await (
+      int_after(50, 1) || string_after(5, "two"));
+  BOOST_ASIO_CHECK(v1.index() == 1);
+  BOOST_ASIO_CHECK(std::get<1>(v1) == "two");
+
+  v1 = co_await (int_after(5, 3) || string_after(50, "four"));
+  BOOST_ASIO_CHECK(v1.index() == 0);
+  BOOST_ASIO_CHECK(std::get<0>(v1) == 3);
+
+  std::variant<std::monostate, std::monostate> v2 = co_await (
+      void_after(50, &o1, &counter) || void_after(5, &o2, &counter));
+  BOOST_ASIO_CHECK(v2.index() == 1);
+  BOOST_ASIO_CHECK(o2 == 1);
+
+  // Chained operators widen into a single variant.
+  std::variant<int, std::string, std::monostate, int> v3 = co_await (
+      int_after(50, 5) || string_after(50, "six")
+        || sleep_for(50) || immediate(8));
+  BOOST_ASIO_CHECK(v3.index() == 3);
+  BOOST_ASIO_CHECK(std::get<3>(v3) == 8);
+
+  v3 = co_await (int_after(50, 5) || string_after(50, "six")
+      || sleep_for(5) || int_after(50, 8));
+  BOOST_ASIO_CHECK(v3.index() == 2);
+
+  // The losing operations are cancelled before the coroutine resumes.
+  BOOST_ASIO_CHECK(o1 == 0);
+  co_await sleep_for(100);
+  BOOST_ASIO_CHECK(o1 == 0);
+
+  // The wait completes promptly even though the losers would take longer.
+  boost::asio::chrono::steady_clock::time_point start
+    = boost::asio::chrono::steady_clock::now();
+  v1 = co_await (int_after(1000, 9) || string_after(5, "ten"));
+  BOOST_ASIO_CHECK(v1.index() == 1);
+  v1 = co_await (immediate(11) || string_after(1000, "twelve"));
+  BOOST_ASIO_CHECK(v1.index() == 0);
+  BOOST_ASIO_CHECK(boost::asio::chrono::steady_clock::now() - start
+      < boost::asio::chrono::milliseconds(500));
+}
+
+void test_or()
+{
+  run(do_test_or());
+}
+
+awaitable<void> do_test_or_exception()
+{
+  // A failed operation does not complete the wait while the other may yet
+  // succeed.
+  std::variant<int, int> v = co_await (throw_after(1) || int_after(20, 2));
+  BOOST_ASIO_CHECK(v.index() == 1);
+  BOOST_ASIO_CHECK(std::get<1>(v) == 2);
+
+  // When both fail, the exception of the left hand operand is rethrown.
+  std::string what;
+  try
+  {
+    co_await (throw_after(10) || []() -> awaitable<int>
+        {
+          co_await sleep_for(1);
+          throw std::logic_error("right");
+        }());
+  }
+  catch (const std::runtime_error& e)
+  {
+    what = e.what();
+  }
+  BOOST_ASIO_CHECK(what == "failed");
+}
+
+void test_or_exception()
+{
+  run(do_test_or_exception());
+}
+
+awaitable<void> do_test_result_move_failure(int* completed)
+{
+  // An operation whose result cannot be stored counts as failed, wherever
+  // along the way the result's move constructor throws.
+  for (int moves = 0; moves < 10; ++moves)
+  {
+    int moves_left = moves;
+    try
+    {
+      std::variant<move_limited, int> v = co_await (
+          move_limited_after(1, &moves_left) || throw_after(20));
+      BOOST_ASIO_CHECK(v.index() == 0);
+    }
+    catch (const std::exception&)
+    {
+    }
+    ++*completed;
+
+    moves_left = moves;
+    try
+    {
+      co_await (move_limited_after(1, &moves_left) && sleep_for(20));
+    }
+    catch (const std::exception&)
+    {
+    }
+    ++*completed;
+  }
+}
+
+void test_result_move_failure()
+{
+  int completed = 0;
+  run(do_test_result_move_failure(&completed));
+  BOOST_ASIO_CHECK(completed == 20);
+}
+
+awaitable<void> do_test_or_multithreaded(std::atomic<int>* completed)
+{
+  // Operands that finish at about the same time, so that the loser is often
+  // still starting or finishing an operation when it is cancelled.
+  for (int i = 0; i < 200; ++i)
+  {
+    std::variant<int, int> v = co_await (int_after(0, 1) || int_after(0, 2));
+    BOOST_ASIO_CHECK(v.index() == 0
+        ? std::get<0>(v) == 1 : std::get<1>(v) == 2);
+
+    // The outer operator also forwards cancellation into the inner one.
+    co_await ((sleep_for(0) || sleep_for(1)) || sleep_for(0));
+    ++*completed;
+  }
+}
+
+void test_or_multithreaded()
+{
+  const int num_coroutines = 8;
+  const int num_threads = 4;
+
+  boost::asio::io_context ioc;
+  std::atomic<int> completed(0);
+  for (int i = 0; i < num_coroutines; ++i)
+    boost::asio::co_spawn(ioc,
+        do_test_or_multithreaded(&completed), boost::asio::detached);
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_threads; ++i)
+    threads.emplace_back([&ioc]{ ioc.run(); });
+  for (std::thread& t : threads)
+    t.join();
+
+  BOOST_ASIO_CHECK(completed == num_coroutines * 200);
+}
+
+#else // defined(BOOST_ASIO_HAS_CO_AWAIT)
+      //   && defined(BOOST_ASIO_HAS_STD_VARIANT)
+
+void test_and()
+{
+}
+
+void test_and_exception()
+{
+}
+
+void test_or()
+{
+}
+
+void test_or_exception()
+{
+}
+
+void test_result_move_failure()
+{
+}
+
+void test_or_multithreaded()
+{
+}
+
+#endif // defined(BOOST_ASIO_HAS_CO_AWAIT)
+       //   && defined(BOOST_ASIO_HAS_STD_VARIANT)
+
+BOOST_ASIO_TEST_SUITE
+(
+  "awaitable_operators",
+  BOOST_ASIO_TEST_CASE(test_and)
+  BOOST_ASIO_TEST_CASE(test_and_exception)
+  BOOST_ASIO_TEST_CASE(test_or)
+  BOOST_ASIO_TEST_CASE(test_or_exception)
+  BOOST_ASIO_TEST_CASE(test_result_move_failure)
+  BOOST_ASIO_TEST_CASE(test_or_multithreaded)
+)
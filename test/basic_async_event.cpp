@@ -0,0 +1,189 @@
+//
+// basic_async_event.cpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/basic_async_event.hpp>
+
+#include "unit_test.hpp"
+
+#if defined(BOOST_ASIO_HAS_MOVE) \
+  && defined(BOOST_ASIO_HAS_STD_ATOMIC)
+
+#include <atomic>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
+
+struct wait_result
+{
+  wait_result() : called(false) {}
+  bool called;
+  boost::system::error_code ec;
+};
+
+struct on_wait
+{
+  wait_result* r_;
+
+  void operator()(boost::system::error_code ec)
+  {
+    r_->called = true;
+    r_->ec = ec;
+  }
+};
+
+on_wait record(wait_result& r)
+{
+  on_wait h = { &r };
+  return h;
+}
+
+typedef boost::asio::basic_async_event<
+    boost::asio::io_context::executor_type> io_event;
+
+void test_set_reset()
+{
+  boost::asio::io_context ioc;
+  io_event e(ioc.get_executor());
+  BOOST_ASIO_CHECK(!e.is_set());
+
+  wait_result r1, r2;
+  e.async_wait(record(r1));
+  e.async_wait(record(r2));
+  ioc.poll();
+  BOOST_ASIO_CHECK(!r1.called);
+
+  // Setting the event releases all waiters.
+  e.set();
+  BOOST_ASIO_CHECK(e.is_set());
+  ioc.restart();
+  ioc.poll();
+  BOOST_ASIO_CHECK(r1.called);
+  BOOST_ASIO_CHECK(!r1.ec);
+  BOOST_ASIO_CHECK(r2.called);
+  BOOST_ASIO_CHECK(!r2.ec);
+
+  // Waits complete immediately while the event is set.
+  wait_result r3;
+  e.async_wait(record(r3));
+  BOOST_ASIO_CHECK(!r3.called);
+  ioc.restart();
+  ioc.poll();
+  BOOST_ASIO_CHECK(r3.called);
+
+  e.reset();
+  BOOST_ASIO_CHECK(!e.is_set());
+  wait_result r4;
+  e.async_wait(record(r4));
+  ioc.restart();
+  ioc.poll();
+  BOOST_ASIO_CHECK(!r4.called);
+  e.set();
+  ioc.restart();
+  ioc.poll();
+  BOOST_ASIO_CHECK(r4.called);
+}
+
+void test_initially_set()
+{
+  boost::asio::io_context ioc;
+  io_event e(ioc, true);
+  BOOST_ASIO_CHECK(e.is_set());
+
+  wait_result r1;
+  e.async_wait(record(r1));
+  ioc.poll();
+  BOOST_ASIO_CHECK(r1.called);
+}
+
+void test_cancel()
+{
+  boost::asio::io_context ioc;
+  io_event e(ioc);
+
+  wait_result r1;
+  e.async_wait(record(r1));
+  e.cancel();
+  ioc.poll();
+  BOOST_ASIO_CHECK(r1.called);
+  BOOST_ASIO_CHECK(r1.ec == boost::asio::error::operation_aborted);
+  BOOST_ASIO_CHECK(!e.is_set());
+}
+
+const int waiter_count = 64;
+
+struct waiter
+{
+  std::atomic<int>* woken_;
+
+  void operator()(boost::system::error_code ec)
+  {
+    if (!ec)
+      ++*woken_;
+  }
+};
+
+void test_contention()
+{
+  boost::asio::thread_pool pool(4);
+  boost::asio::async_event e(pool);
+  std::atomic<int> woken(0);
+
+  for (int i = 0; i < waiter_count; ++i)
+  {
+    boost::asio::post(pool,
+        [&]
+        {
+          waiter w = { &woken };
+          e.async_wait(w);
+        });
+  }
+  boost::asio::post(pool, [&]{ e.set(); });
+
+  pool.join();
+  BOOST_ASIO_CHECK(woken == waiter_count);
+  BOOST_ASIO_CHECK(e.is_set());
+}
+
+#else // defined(BOOST_ASIO_HAS_MOVE)
+       //   && defined(BOOST_ASIO_HAS_STD_ATOMIC)
+
+void test_set_reset()
+{
+}
+
+void test_initially_set()
+{
+}
+
+void test_cancel()
+{
+}
+
+void test_contention()
+{
+}
+
+#endif // defined(BOOST_ASIO_HAS_MOVE)
+       //   && defined(BOOST_ASIO_HAS_STD_ATOMIC)
+
+BOOST_ASIO_TEST_SUITE
+(
+  "basic_async_event",
+  BOOST_ASIO_TEST_CASE(test_set_reset)
+  BOOST_ASIO_TEST_CASE(test_initially_set)
+  BOOST_ASIO_TEST_CASE(test_cancel)
+  BOOST_ASIO_TEST_CASE(test_contention)
+)
@@ -0,0 +1,196 @@
+//
+// basic_async_latch.cpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/basic_async_latch.hpp>
+
+#include "unit_test.hpp"
+
+#if defined(BOOST_ASIO_HAS_MOVE) \
+  && defined(BOOST_ASIO_HAS_STD_ATOMIC)
+
+#include <atomic>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
+
+struct wait_result
+{
+  wait_result() : called(false) {}
+  bool called;
+  boost::system::error_code ec;
+};
+
+struct on_wait
+{
+  wait_result* r_;
+
+  void operator()(boost::system::error_code ec)
+  {
+    r_->called = true;
+    r_->ec = ec;
+  }
+};
+
+on_wait record(wait_result& r)
+{
+  on_wait h = { &r };
+  return h;
+}
+
+typedef boost::asio::basic_async_latch<
+    boost::asio::io_context::executor_type> io_latch;
+
+void test_count_down()
+{
+  boost::asio::io_context ioc;
+  io_latch l(ioc.get_executor(), 3);
+  BOOST_ASIO_CHECK(l.count() == 3);
+  BOOST_ASIO_CHECK(!l.try_wait());
+
+  wait_result r1, r2;
+  l.async_wait(record(r1));
+  l.async_wait(record(r2));
+  l.count_down(2);
+  ioc.poll();
+  BOOST_ASIO_CHECK(l.count() == 1);
+  BOOST_ASIO_CHECK(!r1.called);
+
+  // All waiters complete when the count reaches zero.
+  l.count_down();
+  BOOST_ASIO_CHECK(l.try_wait());
+  ioc.restart();
+  ioc.poll();
+  BOOST_ASIO_CHECK(r1.called);
+  BOOST_ASIO_CHECK(!r1.ec);
+  BOOST_ASIO_CHECK(r2.called);
+  BOOST_ASIO_CHECK(!r2.ec);
+
+  // Later waits complete immediately.
+  wait_result r3;
+  l.async_wait(record(r3));
+  BOOST_ASIO_CHECK(!r3.called);
+  ioc.restart();
+  ioc.poll();
+  BOOST_ASIO_CHECK(r3.called);
+}
+
+void test_arrive_and_wait()
+{
+  boost::asio::io_context ioc;
+  io_latch l(ioc, 2);
+
+  wait_result r1, r2;
+  l.async_arrive_and_wait(record(r1));
+  BOOST_ASIO_CHECK(l.count() == 1);
+  ioc.poll();
+  BOOST_ASIO_CHECK(!r1.called);
+
+  l.async_arrive_and_wait(record(r2));
+  BOOST_ASIO_CHECK(l.count() == 0);
+  ioc.restart();
+  ioc.poll();
+  BOOST_ASIO_CHECK(r1.called);
+  BOOST_ASIO_CHECK(r2.called);
+}
+
+void test_cancel()
+{
+  boost::asio::io_context ioc;
+  io_latch l(ioc, 1);
+
+  wait_result r1;
+  l.async_wait(record(r1));
+  l.cancel();
+  ioc.poll();
+  BOOST_ASIO_CHECK(r1.called);
+  BOOST_ASIO_CHECK(r1.ec == boost::asio::error::operation_aborted);
+  BOOST_ASIO_CHECK(l.count() == 1);
+}
+
+const int participant_count = 64;
+
+struct participant
+{
+  std::atomic<int>* arrived_;
+  std::atomic<int>* released_;
+  std::atomic<bool>* early_;
+
+  void operator()(boost::system::error_code ec)
+  {
+    if (!ec)
+    {
+      if (*arrived_ != participant_count)
+        *early_ = true;
+      ++*released_;
+    }
+  }
+};
+
+void test_contention()
+{
+  boost::asio::thread_pool pool(4);
+  boost::asio::async_latch l(pool, participant_count);
+  std::atomic<int> arrived(0);
+  std::atomic<int> released(0);
+  std::atomic<bool> early(false);
+
+  for (int i = 0; i < participant_count; ++i)
+  {
+    boost::asio::post(pool,
+        [&]
+        {
+          participant p = { &arrived, &released, &early };
+          ++arrived;
+          l.async_arrive_and_wait(p);
+        });
+  }
+
+  pool.join();
+  BOOST_ASIO_CHECK(released == participant_count);
+  BOOST_ASIO_CHECK(!early);
+  BOOST_ASIO_CHECK(l.try_wait());
+}
+
+#else // defined(BOOST_ASIO_HAS_MOVE)
+       //   && defined(BOOST_ASIO_HAS_STD_ATOMIC)
+
+void test_count_down()
+{
+}
+
+void test_arrive_and_wait()
+{
+}
+
+void test_cancel()
+{
+}
+
+void test_contention()
+{
+}
+
+#endif // defined(BOOST_ASIO_HAS_MOVE)
+       //   && defined(BOOST_ASIO_HAS_STD_ATOMIC)
+
+BOOST_ASIO_TEST_SUITE
+(
+  "basic_async_latch",
+  BOOST_ASIO_TEST_CASE(test_count_down)
+  BOOST_ASIO_TEST_CASE(test_arrive_and_wait)
+  BOOST_ASIO_TEST_CASE(test_cancel)
+  BOOST_ASIO_TEST_CASE(test_contention)
+)
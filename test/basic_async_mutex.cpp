@@ -0,0 +1,214 @@
+//
+// basic_async_mutex.cpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/basic_async_mutex.hpp>
+
+#include "unit_test.hpp"
+
+#if defined(BOOST_ASIO_HAS_MOVE) \
+  && defined(BOOST_ASIO_HAS_STD_ATOMIC)
+
+#include <atomic>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/thread_pool.hpp>
+
+struct wait_result
+{
+  wait_result() : called(false) {}
+  bool called;
+  boost::system::error_code ec;
+};
+
+struct on_wait
+{
+  wait_result* r_;
+
+  void operator()(boost::system::error_code ec)
+  {
+    r_->called = true;
+    r_->ec = ec;
+  }
+};
+
+on_wait record(wait_result& r)
+{
+  on_wait h = { &r };
+  return h;
+}
+
+typedef boost::asio::basic_async_mutex<
+    boost::asio::io_context::executor_type> io_mutex;
+
+void test_lock_unlock()
+{
+  boost::asio::io_context ioc;
+  io_mutex m(ioc.get_executor());
+  BOOST_ASIO_CHECK(!m.is_locked());
+
+  // Locking an unowned mutex completes, but never from within the initiating
+  // function.
+  wait_result r1;
+  m.async_lock(record(r1));
+  BOOST_ASIO_CHECK(m.is_locked());
+  BOOST_ASIO_CHECK(!r1.called);
+  ioc.poll();
+  BOOST_ASIO_CHECK(r1.called);
+  BOOST_ASIO_CHECK(!r1.ec);
+
+  BOOST_ASIO_CHECK(!m.try_lock());
+  m.unlock();
+  BOOST_ASIO_CHECK(!m.is_locked());
+  BOOST_ASIO_CHECK(m.try_lock());
+  m.unlock();
+}
+
+void test_handoff()
+{
+  boost::asio::io_context ioc;
+  io_mutex m(ioc);
+  BOOST_ASIO_CHECK(m.try_lock());
+
+  // Waiters acquire the mutex one at a time, in the order they started.
+  wait_result r1, r2;
+  m.async_lock(record(r1));
+  m.async_lock(record(r2));
+  ioc.poll();
+  BOOST_ASIO_CHECK(!r1.called);
+  BOOST_ASIO_CHECK(!r2.called);
+
+  m.unlock();
+  BOOST_ASIO_CHECK(m.is_locked());
+  ioc.restart();
+  ioc.poll();
+  BOOST_ASIO_CHECK(r1.called);
+  BOOST_ASIO_CHECK(!r1.ec);
+  BOOST_ASIO_CHECK(!r2.called);
+
+  m.unlock();
+  ioc.restart();
+  ioc.poll();
+  BOOST_ASIO_CHECK(r2.called);
+  BOOST_ASIO_CHECK(!r2.ec);
+
+  m.unlock();
+  BOOST_ASIO_CHECK(!m.is_locked());
+}
+
+void test_cancel()
+{
+  boost::asio::io_context ioc;
+  io_mutex m(ioc);
+  BOOST_ASIO_CHECK(m.try_lock());
+
+  wait_result r1;
+  m.async_lock(record(r1));
+  m.cancel();
+  ioc.poll();
+  BOOST_ASIO_CHECK(r1.called);
+  BOOST_ASIO_CHECK(r1.ec == boost::asio::error::operation_aborted);
+
+  // Cancellation does not affect the owner.
+  BOOST_ASIO_CHECK(m.is_locked());
+  m.unlock();
+  BOOST_ASIO_CHECK(!m.is_locked());
+
+  // Destroying the mutex cancels any waiters.
+  wait_result r2;
+  {
+    io_mutex m2(ioc);
+    BOOST_ASIO_CHECK(m2.try_lock());
+    m2.async_lock(record(r2));
+  }
+  ioc.restart();
+  ioc.poll();
+  BOOST_ASIO_CHECK(r2.called);
+  BOOST_ASIO_CHECK(r2.ec == boost::asio::error::operation_aborted);
+}
+
+const int worker_count = 8;
+const int increments_per_worker = 10000;
+
+struct incrementer
+{
+  boost::asio::async_mutex* m_;
+  long* counter_;
+  std::atomic<int>* inside_;
+  int remaining_;
+
+  void operator()(boost::system::error_code ec)
+  {
+    if (!ec)
+    {
+      // Deliberately non-atomic: the mutex provides the exclusion.
+      BOOST_ASIO_CHECK(++*inside_ == 1);
+      ++*counter_;
+      --*inside_;
+      m_->unlock();
+
+      if (--remaining_ > 0)
+        m_->async_lock(*this);
+    }
+  }
+};
+
+void test_contention()
+{
+  boost::asio::thread_pool pool(4);
+  boost::asio::async_mutex m(pool);
+  long counter = 0;
+  std::atomic<int> inside(0);
+
+  for (int i = 0; i < worker_count; ++i)
+  {
+    incrementer w = { &m, &counter, &inside, increments_per_worker };
+    m.async_lock(w);
+  }
+
+  pool.join();
+  BOOST_ASIO_CHECK(counter == worker_count * increments_per_worker);
+  BOOST_ASIO_CHECK(!m.is_locked());
+}
+
+#else // defined(BOOST_ASIO_HAS_MOVE)
+       //   && defined(BOOST_ASIO_HAS_STD_ATOMIC)
+
+void test_lock_unlock()
+{
+}
+
+void test_handoff()
+{
+}
+
+void test_cancel()
+{
+}
+
+void test_contention()
+{
+}
+
+#endif // defined(BOOST_ASIO_HAS_MOVE)
+       //   && defined(BOOST_ASIO_HAS_STD_ATOMIC)
+
+BOOST_ASIO_TEST_SUITE
+(
+  "basic_async_mutex",
+  BOOST_ASIO_TEST_CASE(test_lock_unlock)
+  BOOST_ASIO_TEST_CASE(test_handoff)
+  BOOST_ASIO_TEST_CASE(test_cancel)
+  BOOST_ASIO_TEST_CASE(test_contention)
+)
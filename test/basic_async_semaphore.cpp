@@ -0,0 +1,202 @@
+//
+// basic_async_semaphore.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/basic_async_semaphore.hpp>
+
+#include "unit_test.hpp"
+
+#if defined(BOOST_ASIO_HAS_MOVE) \
+  && defined(BOOST_ASIO_HAS_STD_ATOMIC)
+
+#include <atomic>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/thread_pool.hpp>
+
+struct wait_result
+{
+  wait_result() : called(false) {}
+  bool called;
+  boost::system::error_code ec;
+};
+
+struct on_wait
+{
+  wait_result* r_;
+
+  void operator()(boost::system::error_code ec)
+  {
+    r_->called = true;
+    r_->ec = ec;
+  }
+};
+
+on_wait record(wait_result& r)
+{
+  on_wait h = { &r };
+  return h;
+}
+
+typedef boost::asio::basic_async_semaphore<
+    boost::asio::io_context::executor_type> io_semaphore;
+
+void test_acquire_release()
+{
+  boost::asio::io_context ioc;
+  io_semaphore s(ioc.get_executor(), 2);
+  BOOST_ASIO_CHECK(s.available() == 2);
+
+  wait_result r1;
+  s.async_acquire(record(r1));
+  BOOST_ASIO_CHECK(s.available() == 1);
+  BOOST_ASIO_CHECK(!r1.called);
+  ioc.poll();
+  BOOST_ASIO_CHECK(r1.called);
+  BOOST_ASIO_CHECK(!r1.ec);
+
+  BOOST_ASIO_CHECK(s.try_acquire());
+  BOOST_ASIO_CHECK(!s.try_acquire());
+  BOOST_ASIO_CHECK(s.available() == 0);
+
+  s.release(2);
+  BOOST_ASIO_CHECK(s.available() == 2);
+}
+
+void test_handoff()
+{
+  boost::asio::io_context ioc;
+  io_semaphore s(ioc);
+
+  wait_result r1, r2, r3;
+  s.async_acquire(record(r1));
+  s.async_acquire(record(r2));
+  s.async_acquire(record(r3));
+  ioc.poll();
+  BOOST_ASIO_CHECK(!r1.called);
+
+  // Released permits go to waiters in the order they started, and only the
+  // excess becomes available.
+  s.release(2);
+  BOOST_ASIO_CHECK(s.available() == 0);
+  ioc.restart();
+  ioc.poll();
+  BOOST_ASIO_CHECK(r1.called);
+  BOOST_ASIO_CHECK(r2.called);
+  BOOST_ASIO_CHECK(!r3.called);
+
+  s.release(3);
+  BOOST_ASIO_CHECK(s.available() == 2);
+  ioc.restart();
+  ioc.poll();
+  BOOST_ASIO_CHECK(r3.called);
+  BOOST_ASIO_CHECK(!r3.ec);
+}
+
+void test_cancel()
+{
+  boost::asio::io_context ioc;
+  io_semaphore s(ioc);
+
+  wait_result r1;
+  s.async_acquire(record(r1));
+  s.cancel();
+  ioc.poll();
+  BOOST_ASIO_CHECK(r1.called);
+  BOOST_ASIO_CHECK(r1.ec == boost::asio::error::operation_aborted);
+
+  // A release after cancellation makes the permit available.
+  s.release();
+  BOOST_ASIO_CHECK(s.available() == 1);
+}
+
+const int permit_count = 3;
+const int worker_count = 8;
+const int acquisitions_per_worker = 5000;
+
+struct worker
+{
+  boost::asio::async_semaphore* s_;
+  std::atomic<int>* inside_;
+  std::atomic<int>* max_inside_;
+  std::atomic<int>* total_;
+  int remaining_;
+
+  void operator()(boost::system::error_code ec)
+  {
+    if (!ec)
+    {
+      int n = ++*inside_;
+      int max = max_inside_->load();
+      while (n > max && !max_inside_->compare_exchange_weak(max, n)) {}
+      ++*total_;
+      --*inside_;
+      s_->release();
+
+      if (--remaining_ > 0)
+        s_->async_acquire(*this);
+    }
+  }
+};
+
+void test_contention()
+{
+  boost::asio::thread_pool pool(4);
+  boost::asio::async_semaphore s(pool, permit_count);
+  std::atomic<int> inside(0);
+  std::atomic<int> max_inside(0);
+  std::atomic<int> total(0);
+
+  for (int i = 0; i < worker_count; ++i)
+  {
+    worker w = { &s, &inside, &max_inside, &total, acquisitions_per_worker };
+    s.async_acquire(w);
+  }
+
+  pool.join();
+  BOOST_ASIO_CHECK(total == worker_count * acquisitions_per_worker);
+  BOOST_ASIO_CHECK(max_inside <= permit_count);
+  BOOST_ASIO_CHECK(s.available() == permit_count);
+}
+
+#else // defined(BOOST_ASIO_HAS_MOVE)
+       //   && defined(BOOST_ASIO_HAS_STD_ATOMIC)
+
+void test_acquire_release()
+{
+}
+
+void test_handoff()
+{
+}
+
+void test_cancel()
+{
+}
+
+void test_contention()
+{
+}
+
+#endif // defined(BOOST_ASIO_HAS_MOVE)
+       //   && defined(BOOST_ASIO_HAS_STD_ATOMIC)
+
+BOOST_ASIO_TEST_SUITE
+(
+  "basic_async_semaphore",
+  BOOST_ASIO_TEST_CASE(test_acquire_release)
+  BOOST_ASIO_TEST_CASE(test_handoff)
+  BOOST_ASIO_TEST_CASE(test_cancel)
+  BOOST_ASIO_TEST_CASE(test_contention)
+)
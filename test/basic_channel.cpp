@@ -0,0 +1,362 @@
+//
+// basic_channel.cpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/basic_channel.hpp>
+
+#include "unit_test.hpp"
+
+#if defined(BOOST_ASIO_HAS_MOVE) \
+  && defined(BOOST_ASIO_HAS_VARIADIC_TEMPLATES)
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include <boost/asio/io_context.hpp>
+
+typedef boost::asio::basic_channel<boost::asio::io_context::executor_type,
+    void (boost::system::error_code, std::string)> string_channel;
+
+typedef boost::asio::basic_channel<boost::asio::io_context::executor_type,
+    void (boost::system::error_code)> signal_channel;
+
+struct send_result
+{
+  bool called = false;
+  boost::system::error_code ec;
+};
+
+struct receive_result
+{
+  bool called = false;
+  boost::system::error_code ec;
+  std::string value;
+};
+
+std::function<void(boost::system::error_code)> on_send(send_result& r)
+{
+  return [&r](boost::system::error_code ec)
+  {
+    r.called = true;
+    r.ec = ec;
+  };
+}
+
+std::function<void(boost::system::error_code, std::string)> on_receive(
+    receive_result& r)
+{
+  return [&r](boost::system::error_code ec, std::string value)
+  {
+    r.called = true;
+    r.ec = ec;
+    r.value = std::move(value);
+  };
+}
+
+void test_buffered()
+{
+  boost::asio::io_context ioc;
+  string_channel ch(ioc.get_executor(), 2);
+  BOOST_ASIO_CHECK(ch.capacity() == 2);
+  BOOST_ASIO_CHECK(ch.is_open());
+  BOOST_ASIO_CHECK(!ch.ready());
+
+  // Sends complete while there is space in the buffer, but never from within
+  // the initiating function.
+  send_result s1, s2, s3;
+  ch.async_send("one", on_send(s1));
+  ch.async_send("two", on_send(s2));
+  ch.async_send("three", on_send(s3));
+  BOOST_ASIO_CHECK(!s1.called);
+  BOOST_ASIO_CHECK(ch.ready());
+
+  ioc.poll();
+  BOOST_ASIO_CHECK(s1.called && !s1.ec);
+  BOOST_ASIO_CHECK(s2.called && !s2.ec);
+  BOOST_ASIO_CHECK(!s3.called);
+
+  // Receiving makes space for the waiting sender.
+  receive_result r1, r2, r3, r4;
+  ch.async_receive(on_receive(r1));
+  ioc.restart();
+  ioc.poll();
+  BOOST_ASIO_CHECK(r1.called && !r1.ec);
+  BOOST_ASIO_CHECK(r1.value == "one");
+  BOOST_ASIO_CHECK(s3.called && !s3.ec);
+
+  ch.async_receive(on_receive(r2));
+  ch.async_receive(on_receive(r3));
+  ch.async_receive(on_receive(r4));
+  ioc.restart();
+  ioc.poll();
+  BOOST_ASIO_CHECK(r2.value == "two");
+  BOOST_ASIO_CHECK(r3.value == "three");
+  BOOST_ASIO_CHECK(!r4.called);
+
+  // A waiting receiver is handed the message directly.
+  send_result s4;
+  ch.async_send("four", on_send(s4));
+  ioc.restart();
+  ioc.poll();
+  BOOST_ASIO_CHECK(s4.called && !s4.ec);
+  BOOST_ASIO_CHECK(r4.called && !r4.ec);
+  BOOST_ASIO_CHECK(r4.value == "four");
+  BOOST_ASIO_CHECK(!ch.ready());
+}
+
+void test_unbuffered()
+{
+  boost::asio::io_context ioc;
+  string_channel ch(ioc, 0);
+  BOOST_ASIO_CHECK(ch.capacity() == 0);
+
+  // A send waits for a receiver.
+  send_result s1;
+  ch.async_send("one", on_send(s1));
+  ioc.poll();
+  BOOST_ASIO_CHECK(!s1.called);
+  BOOST_ASIO_CHECK(ch.ready());
+
+  receive_result r1;
+  ch.async_receive(on_receive(r1));
+  ioc.restart();
+  ioc.poll();
+  BOOST_ASIO_CHECK(s1.called && !s1.ec);
+  BOOST_ASIO_CHECK(r1.called && r1.value == "one");
+
+  // Messages are delivered in order through a chain of handlers.
+  std::vector<std::string> received;
+  std::function<void(boost::system::error_code, std::string)> receiver =
+    [&](boost::system::error_code ec, std::string value)
+    {
+      if (!ec)
+      {
+        received.push_back(value);
+        ch.async_receive(receiver);
+      }
+    };
+  ch.async_receive(receiver);
+  for (int i = 0; i < 10; ++i)
+    ch.async_send(std::to_string(i), [](boost::system::error_code){});
+  ioc.restart();
+  ioc.poll();
+  BOOST_ASIO_CHECK(received.size() == 10);
+  BOOST_ASIO_CHECK(received.size() == 10 && received[0] == "0");
+  BOOST_ASIO_CHECK(received.size() == 10 && received[9] == "9");
+  ch.cancel();
+  ioc.restart();
+  ioc.run();
+}
+
+void test_close()
+{
+  boost::asio::io_context ioc;
+  string_channel ch(ioc, 1);
+
+  send_result s1, s2;
+  ch.async_send("one", on_send(s1));
+  ch.async_send("two", on_send(s2));
+  ch.close();
+  BOOST_ASIO_CHECK(!ch.is_open());
+
+  // The pending send fails, but the buffered message is kept.
+  ioc.poll();
+  BOOST_ASIO_CHECK(s1.called && !s1.ec);
+  BOOST_ASIO_CHECK(s2.called);
+  BOOST_ASIO_CHECK(s2.ec == boost::asio::error::channel_closed);
+
+  send_result s3;
+  ch.async_send("three", on_send(s3));
+  BOOST_ASIO_CHECK(!ch.try_send("four"));
+
+  receive_result r1, r2;
+  ch.async_receive(on_receive(r1));
+  ch.async_receive(on_receive(r2));
+  ioc.restart();
+  ioc.poll();
+  BOOST_ASIO_CHECK(s3.ec == boost::asio::error::channel_closed);
+  BOOST_ASIO_CHECK(r1.called && !r1.ec && r1.value == "one");
+  BOOST_ASIO_CHECK(r2.called);
+  BOOST_ASIO_CHECK(r2.ec == boost::asio::error::channel_closed);
+  BOOST_ASIO_CHECK(r2.value.empty());
+
+  // A pending receive fails when the channel is closed.
+  receive_result r3;
+  ch.reset();
+  BOOST_ASIO_CHECK(ch.is_open());
+  ch.async_receive(on_receive(r3));
+  ioc.restart();
+  ioc.poll();
+  BOOST_ASIO_CHECK(!r3.called);
+  ch.close();
+  ioc.restart();
+  ioc.poll();
+  BOOST_ASIO_CHECK(r3.ec == boost::asio::error::channel_closed);
+}
+
+void test_cancel()
+{
+  boost::asio::io_context ioc;
+  receive_result r1;
+  send_result s1;
+  {
+    string_channel ch(ioc);
+    ch.async_receive(on_receive(r1));
+    ch.cancel();
+    ioc.poll();
+    BOOST_ASIO_CHECK(r1.ec == boost::asio::error::operation_aborted);
+
+    // Destroying the channel cancels pending operations.
+    ch.async_send("one", on_send(s1));
+  }
+  ioc.restart();
+  ioc.poll();
+  BOOST_ASIO_CHECK(s1.called);
+  BOOST_ASIO_CHECK(s1.ec == boost::asio::error::operation_aborted);
+
+  // Pending operations keep the I/O executor's context running.
+  string_channel ch(ioc);
+  receive_result r2;
+  ch.async_receive(on_receive(r2));
+  ioc.restart();
+  BOOST_ASIO_CHECK(ioc.poll() == 0);
+  BOOST_ASIO_CHECK(!ioc.stopped());
+  ch.cancel();
+  ioc.run();
+  BOOST_ASIO_CHECK(r2.called);
+}
+
+void test_try()
+{
+  boost::asio::io_context ioc;
+  string_channel ch(ioc, 1);
+
+  std::string value;
+  BOOST_ASIO_CHECK(!ch.try_receive(
+        [&](boost::system::error_code, std::string v){ value = v; }));
+
+  BOOST_ASIO_CHECK(ch.try_send("one"));
+  BOOST_ASIO_CHECK(!ch.try_send("two"));
+  BOOST_ASIO_CHECK(ch.try_receive(
+        [&](boost::system::error_code, std::string v){ value = v; }));
+  BOOST_ASIO_CHECK(value == "one");
+
+  // A waiting sender's message moves into the buffer.
+  send_result s1;
+  BOOST_ASIO_CHECK(ch.try_send("two"));
+  ch.async_send("three", on_send(s1));
+  BOOST_ASIO_CHECK(ch.try_receive(
+        [&](boost::system::error_code, std::string v){ value = v; }));
+  BOOST_ASIO_CHECK(value == "two");
+  ioc.poll();
+  BOOST_ASIO_CHECK(s1.called && !s1.ec);
+  BOOST_ASIO_CHECK(ch.try_receive(
+        [&](boost::system::error_code, std::string v){ value = v; }));
+  BOOST_ASIO_CHECK(value == "three");
+
+  // A waiting receiver takes the message.
+  receive_result r1;
+  ch.async_receive(on_receive(r1));
+  BOOST_ASIO_CHECK(ch.try_send("four"));
+  ioc.restart();
+  ioc.poll();
+  BOOST_ASIO_CHECK(r1.value == "four");
+}
+
+void test_signal()
+{
+  boost::asio::io_context ioc;
+  signal_channel ch(ioc, 4);
+
+  int received = 0;
+  for (int i = 0; i < 3; ++i)
+    ch.async_send([](boost::system::error_code){});
+  for (int i = 0; i < 3; ++i)
+    ch.async_receive(
+        [&](boost::system::error_code ec)
+        {
+          if (!ec)
+            ++received;
+        });
+  ioc.run();
+  BOOST_ASIO_CHECK(received == 3);
+  BOOST_ASIO_CHECK(ch.try_send());
+  BOOST_ASIO_CHECK(ch.try_receive([](boost::system::error_code){}));
+}
+
+void test_move_only()
+{
+  boost::asio::io_context ioc;
+  boost::asio::basic_channel<boost::asio::io_context::executor_type,
+    void (boost::system::error_code, std::unique_ptr<int>)> ch(ioc, 1);
+
+  std::unique_ptr<int> value;
+  ch.async_send(std::unique_ptr<int>(new int(42)),
+      [](boost::system::error_code){});
+  ch.async_receive(
+      [&](boost::system::error_code, std::unique_ptr<int> v)
+      {
+        value = std::move(v);
+      });
+  ioc.run();
+  BOOST_ASIO_CHECK(value && *value == 42);
+}
+
+#else // defined(BOOST_ASIO_HAS_MOVE)
+      //   && defined(BOOST_ASIO_HAS_VARIADIC_TEMPLATES)
+
+void test_buffered()
+{
+}
+
+void test_unbuffered()
+{
+}
+
+void test_close()
+{
+}
+
+void test_cancel()
+{
+}
+
+void test_try()
+{
+}
+
+void test_signal()
+{
+}
+
+void test_move_only()
+{
+}
+
+#endif // defined(BOOST_ASIO_HAS_MOVE)
+       //   && defined(BOOST_ASIO_HAS_VARIADIC_TEMPLATES)
+
+BOOST_ASIO_TEST_SUITE
+(
+  "basic_channel",
+  BOOST_ASIO_TEST_CASE(test_buffered)
+  BOOST_ASIO_TEST_CASE(test_unbuffered)
+  BOOST_ASIO_TEST_CASE(test_close)
+  BOOST_ASIO_TEST_CASE(test_cancel)
+  BOOST_ASIO_TEST_CASE(test_try)
+  BOOST_ASIO_TEST_CASE(test_signal)
+  BOOST_ASIO_TEST_CASE(test_move_only)
+)
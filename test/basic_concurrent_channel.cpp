@@ -0,0 +1,154 @@
+//
+// basic_concurrent_channel.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/basic_concurrent_channel.hpp>
+
+#include "unit_test.hpp"
+
+#if defined(BOOST_ASIO_HAS_MOVE) \
+  && defined(BOOST_ASIO_HAS_VARIADIC_TEMPLATES)
+
+#include <atomic>
+#include <thread>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/thread_pool.hpp>
+
+typedef boost::asio::basic_concurrent_channel<
+    boost::asio::thread_pool::executor_type,
+    void (boost::system::error_code, int)> int_channel;
+
+const int producer_count = 4;
+const int consumer_count = 4;
+const int messages_per_producer = 10000;
+
+struct producer
+{
+  int_channel* ch_;
+  int next_;
+  int end_;
+
+  void operator()(boost::system::error_code ec)
+  {
+    if (!ec && next_ < end_)
+    {
+      int value = next_++;
+      ch_->async_send(value, *this);
+    }
+  }
+};
+
+struct consumer
+{
+  int_channel* ch_;
+  std::atomic<long long>* sum_;
+  std::atomic<int>* count_;
+
+  void operator()(boost::system::error_code ec, int value)
+  {
+    if (!ec)
+    {
+      *sum_ += value;
+      ++*count_;
+      ch_->async_receive(*this);
+    }
+  }
+};
+
+void run_producers_and_consumers(std::size_t max_buffer_size)
+{
+  boost::asio::thread_pool pool(4);
+  int_channel ch(pool.get_executor(), max_buffer_size);
+
+  std::atomic<long long> sum(0);
+  std::atomic<int> count(0);
+
+  for (int i = 0; i < consumer_count; ++i)
+  {
+    consumer c = { &ch, &sum, &count };
+    ch.async_receive(c);
+  }
+
+  for (int i = 0; i < producer_count; ++i)
+  {
+    producer p = { &ch, i * messages_per_producer,
+      (i + 1) * messages_per_producer };
+    p(boost::system::error_code());
+  }
+
+  // Wait for all messages to arrive, then stop the consumers.
+  const int total = producer_count * messages_per_producer;
+  while (count < total)
+    std::this_thread::yield();
+  ch.close();
+  pool.join();
+
+  BOOST_ASIO_CHECK(count == total);
+  BOOST_ASIO_CHECK(sum == static_cast<long long>(total) * (total - 1) / 2);
+  BOOST_ASIO_CHECK(!ch.ready());
+}
+
+void test_buffered()
+{
+  run_producers_and_consumers(64);
+}
+
+void test_unbuffered()
+{
+  run_producers_and_consumers(0);
+}
+
+void test_try()
+{
+  boost::asio::io_context ioc;
+  boost::asio::basic_concurrent_channel<boost::asio::io_context::executor_type,
+    void (boost::system::error_code, int)> ch(ioc, 1);
+
+  BOOST_ASIO_CHECK(ch.try_send(1));
+  BOOST_ASIO_CHECK(!ch.try_send(2));
+
+  int value = 0;
+  BOOST_ASIO_CHECK(ch.try_receive(
+        [&](boost::system::error_code, int v){ value = v; }));
+  BOOST_ASIO_CHECK(value == 1);
+  BOOST_ASIO_CHECK(!ch.try_receive(
+        [&](boost::system::error_code, int v){ value = v; }));
+}
+
+#else // defined(BOOST_ASIO_HAS_MOVE)
+      //   && defined(BOOST_ASIO_HAS_VARIADIC_TEMPLATES)
+
+void test_buffered()
+{
+}
+
+void test_unbuffered()
+{
+}
+
+void test_try()
+{
+}
+
+#endif // defined(BOOST_ASIO_HAS_MOVE)
+       //   && defined(BOOST_ASIO_HAS_VARIADIC_TEMPLATES)
+
+BOOST_ASIO_TEST_SUITE
+(
+  "basic_concurrent_channel",
+  BOOST_ASIO_TEST_CASE(test_buffered)
+  BOOST_ASIO_TEST_CASE(test_unbuffered)
+  BOOST_ASIO_TEST_CASE(test_try)
+)
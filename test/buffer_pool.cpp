@@ -0,0 +1,238 @@
+//
+// buffer_pool.cpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/buffer_pool.hpp>
+
+#include <boost/asio/read_pooled.hpp>
+
+#include <cstring>
+#include <string>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/write.hpp>
+#include "unit_test.hpp"
+
+#if defined(BOOST_ASIO_HAS_MOVE)
+
+void test_pool()
+{
+  boost::asio::buffer_pool pool(32, 2);
+  BOOST_ASIO_CHECK(pool.buffer_size() == 32);
+  BOOST_ASIO_CHECK(pool.idle() == 0);
+
+  boost::asio::pooled_buffer b1 = pool.acquire();
+  BOOST_ASIO_CHECK(!b1.empty());
+  BOOST_ASIO_CHECK(b1.size() == 32);
+  BOOST_ASIO_CHECK(b1.capacity() == 32);
+  b1.resize(10);
+  BOOST_ASIO_CHECK(b1.data().size() == 10);
+  b1.resize(100);
+  BOOST_ASIO_CHECK(b1.size() == 32);
+
+  // Ownership moves with the object.
+  void* p = b1.data().data();
+  boost::asio::pooled_buffer b2(std::move(b1));
+  BOOST_ASIO_CHECK(b1.empty());
+  BOOST_ASIO_CHECK(b1.capacity() == 0);
+  BOOST_ASIO_CHECK(b2.data().data() == p);
+
+  // Released buffers are reused.
+  b2.reset();
+  BOOST_ASIO_CHECK(b2.empty());
+  BOOST_ASIO_CHECK(pool.idle() == 1);
+  b1 = pool.acquire();
+  BOOST_ASIO_CHECK(b1.data().data() == p);
+  BOOST_ASIO_CHECK(pool.idle() == 0);
+
+  // No more than the maximum number of idle buffers are retained.
+  {
+    boost::asio::pooled_buffer b3 = pool.acquire();
+    boost::asio::pooled_buffer b4 = pool.acquire();
+    b1 = boost::asio::pooled_buffer();
+  }
+  BOOST_ASIO_CHECK(pool.idle() == 2);
+}
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+typedef boost::asio::local::stream_protocol::socket socket_type;
+
+struct read_handler
+{
+  read_handler(boost::asio::buffer_pool& pool, boost::system::error_code& ec,
+      std::string& data, std::size_t& idle, bool& called)
+    : pool_(&pool), ec_(&ec), data_(&data), idle_(&idle), called_(&called)
+  {
+  }
+
+  void operator()(const boost::system::error_code& ec,
+      boost::asio::pooled_buffer buffer)
+  {
+    *ec_ = ec;
+    *data_ = std::string(static_cast<const char*>(buffer.data().data()),
+        buffer.size());
+    *idle_ = pool_->idle();
+    *called_ = true;
+  }
+
+  boost::asio::buffer_pool* pool_;
+  boost::system::error_code* ec_;
+  std::string* data_;
+  std::size_t* idle_;
+  bool* called_;
+};
+
+void test_async_read_pooled()
+{
+  boost::asio::io_context ioc;
+  socket_type s1(ioc), s2(ioc);
+  boost::asio::local::connect_pair(s1, s2);
+
+  boost::asio::buffer_pool pool(64);
+  boost::system::error_code ec;
+  std::string data;
+  std::size_t idle = 0;
+  bool called = false;
+
+  // Seed the pool with one buffer.
+  pool.acquire();
+  BOOST_ASIO_CHECK(pool.idle() == 1);
+
+  // A pending read holds no buffer while it waits.
+  boost::asio::async_read_pooled(s1, pool,
+      read_handler(pool, ec, data, idle, called));
+  ioc.poll();
+  BOOST_ASIO_CHECK(!called);
+  BOOST_ASIO_CHECK(pool.idle() == 1);
+
+  boost::asio::write(s2, boost::asio::buffer("hello", 5));
+  ioc.restart();
+  ioc.run();
+  BOOST_ASIO_CHECK(called);
+  BOOST_ASIO_CHECK(!ec);
+  BOOST_ASIO_CHECK(data == "hello");
+  BOOST_ASIO_CHECK(idle == 0);
+  BOOST_ASIO_CHECK(pool.idle() == 1);
+
+  // The read leaves the socket's non-blocking mode unchanged, and the native
+  // socket in the non-blocking mode used by asynchronous operations, so that
+  // no system call is needed to restore either.
+  BOOST_ASIO_CHECK(!s1.non_blocking());
+  BOOST_ASIO_CHECK(s1.native_non_blocking());
+
+  // Cancellation completes without a buffer.
+  called = false;
+  boost::asio::async_read_pooled(s1, pool,
+      read_handler(pool, ec, data, idle, called));
+  ioc.restart();
+  ioc.poll();
+  s1.cancel();
+  ioc.run();
+  BOOST_ASIO_CHECK(called);
+  BOOST_ASIO_CHECK(ec == boost::asio::error::operation_aborted);
+  BOOST_ASIO_CHECK(data.empty());
+
+  // End of file completes without a buffer.
+  called = false;
+  boost::asio::async_read_pooled(s1, pool,
+      read_handler(pool, ec, data, idle, called));
+  s2.close();
+  ioc.restart();
+  ioc.run();
+  BOOST_ASIO_CHECK(called);
+  BOOST_ASIO_CHECK(ec == boost::asio::error::eof);
+  BOOST_ASIO_CHECK(data.empty());
+  BOOST_ASIO_CHECK(pool.idle() == 1);
+}
+
+void test_async_read_pooled_shared()
+{
+  boost::asio::io_context ioc;
+  socket_type s1(ioc), s2(ioc);
+  boost::asio::local::connect_pair(s1, s2);
+
+  boost::asio::buffer_pool pool(64);
+  boost::system::error_code ec1, ec2;
+  std::string data1, data2;
+  std::size_t idle1 = 0, idle2 = 0;
+  bool called1 = false, called2 = false;
+
+  // Both readers wake when data arrives on the blocking socket, but only one
+  // of them receives it. The other returns its buffer and waits again rather
+  // than blocking in the read.
+  boost::asio::async_read_pooled(s1, pool,
+      read_handler(pool, ec1, data1, idle1, called1));
+  boost::asio::async_read_pooled(s1, pool,
+      read_handler(pool, ec2, data2, idle2, called2));
+  ioc.poll();
+  BOOST_ASIO_CHECK(!called1 && !called2);
+
+  boost::asio::write(s2, boost::asio::buffer("hello", 5));
+  while (!called1 && !called2)
+    ioc.run_one();
+  ioc.poll();
+  BOOST_ASIO_CHECK(called1 != called2);
+  BOOST_ASIO_CHECK(called1 ? data1 == "hello" : data2 == "hello");
+  BOOST_ASIO_CHECK(!ec1 && !ec2);
+  BOOST_ASIO_CHECK(!s1.non_blocking());
+
+  // The remaining reader receives the next data.
+  boost::asio::write(s2, boost::asio::buffer("world", 5));
+  ioc.run();
+  BOOST_ASIO_CHECK(called1 && called2);
+  BOOST_ASIO_CHECK(data1 == "hello" ? data2 == "world" : data1 == "world");
+  BOOST_ASIO_CHECK(!ec1 && !ec2);
+
+  // The readers took buffers one at a time, and returned them.
+  BOOST_ASIO_CHECK(pool.idle() == 1);
+}
+
+#else // defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+void test_async_read_pooled()
+{
+}
+
+void test_async_read_pooled_shared()
+{
+}
+
+#endif // defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+#else // defined(BOOST_ASIO_HAS_MOVE)
+
+void test_pool()
+{
+}
+
+void test_async_read_pooled()
+{
+}
+
+void test_async_read_pooled_shared()
+{
+}
+
+#endif // defined(BOOST_ASIO_HAS_MOVE)
+
+BOOST_ASIO_TEST_SUITE
+(
+  "buffer_pool",
+  BOOST_ASIO_TEST_CASE(test_pool)
+  BOOST_ASIO_TEST_CASE(test_async_read_pooled)
+  BOOST_ASIO_TEST_CASE(test_async_read_pooled_shared)
+)
@@ -0,0 +1,190 @@
+//
+// cancellation_signal.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/cancellation_signal.hpp>
+
+#include <boost/asio/associated_cancellation_slot.hpp>
+#include <boost/asio/bind_cancellation_slot.hpp>
+#include <boost/asio/cancellation_state.hpp>
+#include "unit_test.hpp"
+
+struct record_handler
+{
+  explicit record_handler(boost::asio::cancellation_type_t* result)
+    : result_(result)
+  {
+  }
+
+  void operator()(boost::asio::cancellation_type_t type)
+  {
+    *result_ = type;
+  }
+
+  boost::asio::cancellation_type_t* result_;
+};
+
+struct destroy_handler
+{
+  explicit destroy_handler(int* destroyed)
+    : destroyed_(destroyed)
+  {
+  }
+
+  ~destroy_handler()
+  {
+    ++*destroyed_;
+  }
+
+  void operator()(boost::asio::cancellation_type_t)
+  {
+  }
+
+  int* destroyed_;
+};
+
+struct completion_handler
+{
+  void operator()()
+  {
+  }
+};
+
+void test_signal()
+{
+  using boost::asio::cancellation_type_t;
+
+  boost::asio::cancellation_slot unconnected;
+  BOOST_ASIO_CHECK(!unconnected.is_connected());
+  BOOST_ASIO_CHECK(!unconnected.has_handler());
+  unconnected.clear();
+
+  boost::asio::cancellation_signal sig;
+  boost::asio::cancellation_slot slot = sig.slot();
+  BOOST_ASIO_CHECK(slot.is_connected());
+  BOOST_ASIO_CHECK(!slot.has_handler());
+  BOOST_ASIO_CHECK(slot == sig.slot());
+  BOOST_ASIO_CHECK(slot != unconnected);
+
+  // Emitting without a handler has no effect.
+  sig.emit(boost::asio::cancellation_type::terminal);
+
+  cancellation_type_t result = boost::asio::cancellation_type::none;
+  record_handler& h = slot.emplace<record_handler>(&result);
+  BOOST_ASIO_CHECK(h.result_ == &result);
+  BOOST_ASIO_CHECK(slot.has_handler());
+  sig.emit(boost::asio::cancellation_type::partial);
+  BOOST_ASIO_CHECK(result == boost::asio::cancellation_type::partial);
+
+  // Installing a new handler destroys the old one and reuses its memory.
+  int destroyed = 0;
+  void* p = &slot.emplace<destroy_handler>(&destroyed);
+  BOOST_ASIO_CHECK(destroyed == 0);
+  BOOST_ASIO_CHECK(p == &slot.emplace<destroy_handler>(&destroyed));
+  BOOST_ASIO_CHECK(destroyed == 1);
+  slot.clear();
+  BOOST_ASIO_CHECK(destroyed == 2);
+  BOOST_ASIO_CHECK(!slot.has_handler());
+
+  // Destroying the signal destroys the installed handler.
+  {
+    boost::asio::cancellation_signal sig2;
+    sig2.slot().assign(destroy_handler(&destroyed));
+    destroyed = 0;
+  }
+  BOOST_ASIO_CHECK(destroyed == 1);
+}
+
+void test_type()
+{
+  using boost::asio::cancellation_type_t;
+
+  cancellation_type_t t = boost::asio::cancellation_type::terminal;
+  t |= boost::asio::cancellation_type::partial;
+  BOOST_ASIO_CHECK(!!(t & boost::asio::cancellation_type::terminal));
+  BOOST_ASIO_CHECK(!!(t & boost::asio::cancellation_type::partial));
+  BOOST_ASIO_CHECK(!(t & boost::asio::cancellation_type::total));
+  t &= ~cancellation_type_t(boost::asio::cancellation_type::terminal);
+  BOOST_ASIO_CHECK(t == boost::asio::cancellation_type::partial);
+  t ^= boost::asio::cancellation_type::partial;
+  BOOST_ASIO_CHECK(t == boost::asio::cancellation_type::none);
+}
+
+void test_state()
+{
+  using boost::asio::cancellation_type_t;
+
+  // A state attached to an unconnected slot has an unconnected child slot.
+  boost::asio::cancellation_state s0((boost::asio::cancellation_slot()));
+  BOOST_ASIO_CHECK(!s0.slot().is_connected());
+  BOOST_ASIO_CHECK(s0.cancelled() == boost::asio::cancellation_type::none);
+
+  boost::asio::cancellation_signal sig;
+  boost::asio::cancellation_state s1(sig.slot());
+  cancellation_type_t result = boost::asio::cancellation_type::none;
+  s1.slot().emplace<record_handler>(&result);
+
+  // The default filter passes terminal cancellation only.
+  sig.emit(boost::asio::cancellation_type::partial);
+  BOOST_ASIO_CHECK(s1.cancelled() == boost::asio::cancellation_type::none);
+  BOOST_ASIO_CHECK(result == boost::asio::cancellation_type::none);
+  sig.emit(boost::asio::cancellation_type::all);
+  BOOST_ASIO_CHECK(s1.cancelled() == boost::asio::cancellation_type::terminal);
+  BOOST_ASIO_CHECK(result == boost::asio::cancellation_type::terminal);
+  s1.clear();
+  BOOST_ASIO_CHECK(s1.cancelled() == boost::asio::cancellation_type::none);
+
+  boost::asio::cancellation_state s2(sig.slot(),
+      boost::asio::enable_partial_cancellation());
+  s2.slot().emplace<record_handler>(&result);
+  sig.emit(boost::asio::cancellation_type::partial);
+  BOOST_ASIO_CHECK(s2.cancelled() == boost::asio::cancellation_type::partial);
+  BOOST_ASIO_CHECK(result == boost::asio::cancellation_type::partial);
+
+  boost::asio::cancellation_state s3(sig.slot(),
+      boost::asio::disable_cancellation());
+  result = boost::asio::cancellation_type::none;
+  s3.slot().emplace<record_handler>(&result);
+  sig.emit(boost::asio::cancellation_type::all);
+  BOOST_ASIO_CHECK(s3.cancelled() == boost::asio::cancellation_type::none);
+  BOOST_ASIO_CHECK(result == boost::asio::cancellation_type::none);
+}
+
+void test_bind()
+{
+  boost::asio::cancellation_signal sig;
+
+  BOOST_ASIO_CHECK(!boost::asio::get_associated_cancellation_slot(
+        completion_handler()).is_connected());
+  BOOST_ASIO_CHECK(boost::asio::get_associated_cancellation_slot(
+        completion_handler(), sig.slot()) == sig.slot());
+
+  boost::asio::cancellation_slot_binder<completion_handler,
+    boost::asio::cancellation_slot> h = boost::asio::bind_cancellation_slot(
+        sig.slot(), completion_handler());
+  BOOST_ASIO_CHECK(h.get_cancellation_slot() == sig.slot());
+  BOOST_ASIO_CHECK(boost::asio::get_associated_cancellation_slot(h)
+      == sig.slot());
+  h();
+}
+
+BOOST_ASIO_TEST_SUITE
+(
+  "cancellation_signal",
+  BOOST_ASIO_TEST_CASE(test_signal)
+  BOOST_ASIO_TEST_CASE(test_type)
+  BOOST_ASIO_TEST_CASE(test_state)
+  BOOST_ASIO_TEST_CASE(test_bind)
+)
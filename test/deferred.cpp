@@ -0,0 +1,279 @@
+//
+// deferred.cpp
+// ~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/deferred.hpp>
+
+#include "unit_test.hpp"
+
+#if defined(BOOST_ASIO_HAS_DEFERRED)
+
+#include <cstring>
+#include <string>
+#include <boost/asio/bind_cancellation_slot.hpp>
+#include <boost/asio/bind_executor.hpp>
+#include <boost/asio/cancellation_signal.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/asio/write.hpp>
+
+using boost::asio::deferred;
+using boost::system::error_code;
+
+void test_values()
+{
+  int result_int = 0;
+  std::string result_string;
+  auto op = deferred.values(42, std::string("hello"));
+
+  // A deferred operation may be launched more than once if it is an lvalue.
+  op([&](int i, std::string s){ result_int = i; result_string = s; });
+  BOOST_ASIO_CHECK(result_int == 42);
+  BOOST_ASIO_CHECK(result_string == "hello");
+
+  result_int = 0;
+  result_string.clear();
+  std::move(op)([&](int i, std::string s)
+      {
+        result_int = i;
+        result_string = s;
+      });
+  BOOST_ASIO_CHECK(result_int == 42);
+  BOOST_ASIO_CHECK(result_string == "hello");
+
+  int count = 0;
+  deferred.values(1).then(
+      [&](int i)
+      {
+        ++count;
+        return deferred.values(i + 1);
+      })(
+        [&](int i)
+        {
+          ++count;
+          result_int = i;
+        });
+  BOOST_ASIO_CHECK(count == 2);
+  BOOST_ASIO_CHECK(result_int == 2);
+}
+
+void test_lazy_start()
+{
+  boost::asio::io_context ioc;
+  boost::asio::steady_timer timer(ioc,
+      boost::asio::steady_timer::time_point());
+
+  int count = 0;
+  auto op = timer.async_wait(deferred);
+  BOOST_ASIO_CHECK(ioc.run() == 0);
+
+  std::move(op)([&](error_code ec)
+      {
+        BOOST_ASIO_CHECK(!ec);
+        ++count;
+      });
+  BOOST_ASIO_CHECK(count == 0);
+
+  ioc.restart();
+  BOOST_ASIO_CHECK(ioc.run() == 1);
+  BOOST_ASIO_CHECK(count == 1);
+
+  // Operations may be deferred as arguments of composed operations.
+  auto post_op = boost::asio::post(ioc, deferred);
+  post_op([&]{ ++count; });
+  post_op([&]{ ++count; });
+
+  ioc.restart();
+  BOOST_ASIO_CHECK(ioc.run() == 2);
+  BOOST_ASIO_CHECK(count == 3);
+}
+
+void test_sequence()
+{
+  boost::asio::io_context ioc;
+  boost::asio::steady_timer timer1(ioc,
+      boost::asio::steady_timer::time_point());
+  boost::asio::steady_timer timer2(ioc,
+      boost::asio::steady_timer::time_point());
+
+  int steps = 0;
+  int result = 0;
+
+  auto op = timer1.async_wait(
+      deferred([&](error_code ec)
+        {
+          BOOST_ASIO_CHECK(!ec);
+          ++steps;
+          return timer2.async_wait(deferred);
+        })).then(
+      [&](error_code ec)
+      {
+        BOOST_ASIO_CHECK(!ec);
+        ++steps;
+        return deferred.values(ec, steps);
+      });
+
+  BOOST_ASIO_CHECK(ioc.run() == 0);
+  BOOST_ASIO_CHECK(steps == 0);
+
+  std::move(op)([&](error_code ec, int n)
+      {
+        BOOST_ASIO_CHECK(!ec);
+        result = n;
+      });
+
+  ioc.restart();
+  ioc.run();
+  BOOST_ASIO_CHECK(steps == 2);
+  BOOST_ASIO_CHECK(result == 2);
+}
+
+void test_associations()
+{
+  boost::asio::io_context ioc;
+  boost::asio::strand<boost::asio::io_context::executor_type> s =
+    boost::asio::make_strand(ioc);
+  boost::asio::steady_timer timer(ioc,
+      boost::asio::steady_timer::time_point::max());
+
+  // The completion handler's associated executor applies to every step.
+  bool in_strand = false;
+  timer.expires_at(boost::asio::steady_timer::time_point());
+  timer.async_wait(deferred).then(
+      [&](error_code ec)
+      {
+        in_strand = s.running_in_this_thread();
+        return deferred.values(ec);
+      })(boost::asio::bind_executor(s, [](error_code){}));
+
+  ioc.run();
+  BOOST_ASIO_CHECK(in_strand);
+
+  // The completion handler's cancellation slot is connected to whichever step
+  // of the sequence is outstanding.
+  boost::asio::cancellation_signal sig;
+  error_code result;
+  bool tail_called = false;
+  timer.expires_at(boost::asio::steady_timer::time_point::max());
+  timer.async_wait(deferred).then(
+      [&](error_code ec)
+      {
+        tail_called = true;
+        return deferred.values(ec);
+      })(boost::asio::bind_cancellation_slot(sig.slot(),
+        [&](error_code ec){ result = ec; }));
+
+  ioc.restart();
+  ioc.poll();
+  sig.emit(boost::asio::cancellation_type::terminal);
+  ioc.run();
+  BOOST_ASIO_CHECK(tail_called);
+  BOOST_ASIO_CHECK(result == boost::asio::error::operation_aborted);
+}
+
+void test_exchange()
+{
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+  boost::asio::io_context ioc;
+  boost::asio::local::stream_protocol::socket s1(ioc);
+  boost::asio::local::stream_protocol::socket s2(ioc);
+  boost::asio::local::connect_pair(s1, s2);
+
+  // Write a request, read the reply, and check it, as a single deferred
+  // operation.
+  const char request[] = "ping";
+  const char reply[] = "pong";
+  char request_data[sizeof(request)] = "";
+  char reply_data[sizeof(reply)] = "";
+
+  auto exchange = boost::asio::async_write(s1,
+      boost::asio::buffer(request), deferred).then(
+      [&](error_code ec, std::size_t)
+      {
+        BOOST_ASIO_CHECK(!ec);
+        return boost::asio::async_read(s1,
+            boost::asio::buffer(reply_data), deferred);
+      }).then(
+      [&](error_code ec, std::size_t n)
+      {
+        return deferred.values(ec,
+            n == sizeof(reply) && memcmp(reply_data, reply, n) == 0);
+      });
+
+  auto serve = boost::asio::async_read(s2,
+      boost::asio::buffer(request_data), deferred).then(
+      [&](error_code ec, std::size_t)
+      {
+        BOOST_ASIO_CHECK(!ec);
+        return boost::asio::async_write(s2,
+            boost::asio::buffer(reply), deferred);
+      });
+
+  bool exchanged = false;
+  bool served = false;
+  std::move(serve)([&](error_code ec, std::size_t)
+      {
+        served = !ec;
+      });
+  std::move(exchange)([&](error_code ec, bool matched)
+      {
+        exchanged = !ec && matched;
+      });
+
+  ioc.run();
+  BOOST_ASIO_CHECK(served);
+  BOOST_ASIO_CHECK(exchanged);
+  BOOST_ASIO_CHECK(memcmp(request_data, request, sizeof(request)) == 0);
+#endif // defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+}
+
+#else // defined(BOOST_ASIO_HAS_DEFERRED)
+
+void test_values()
+{
+}
+
+void test_lazy_start()
+{
+}
+
+void test_sequence()
+{
+}
+
+void test_associations()
+{
+}
+
+void test_exchange()
+{
+}
+
+#endif // defined(BOOST_ASIO_HAS_DEFERRED)
+
+BOOST_ASIO_TEST_SUITE
+(
+  "deferred",
+  BOOST_ASIO_TEST_CASE(test_values)
+  BOOST_ASIO_TEST_CASE(test_lazy_start)
+  BOOST_ASIO_TEST_CASE(test_sequence)
+  BOOST_ASIO_TEST_CASE(test_associations)
+  BOOST_ASIO_TEST_CASE(test_exchange)
+)
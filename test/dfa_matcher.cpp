@@ -0,0 +1,294 @@
+//
+// dfa_matcher.cpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/dfa_matcher.hpp>
+
+#include <cstring>
+#include <string>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/streambuf.hpp>
+#include <boost/system/system_error.hpp>
+#include "unit_test.hpp"
+
+#if defined(BOOST_ASIO_HAS_BOOST_BIND)
+# include <boost/bind/bind.hpp>
+#else // defined(BOOST_ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(BOOST_ASIO_HAS_BOOST_BIND)
+
+class test_stream
+{
+public:
+  typedef boost::asio::io_context::executor_type executor_type;
+
+  test_stream(boost::asio::io_context& io_context)
+    : io_context_(io_context),
+      length_(0),
+      position_(0),
+      next_read_length_(0)
+  {
+  }
+
+  executor_type get_executor() BOOST_ASIO_NOEXCEPT
+  {
+    return io_context_.get_executor();
+  }
+
+  void reset(const void* data, size_t length)
+  {
+    using namespace std; // For memcpy.
+
+    BOOST_ASIO_CHECK(length <= max_length);
+
+    memcpy(data_, data, length);
+    length_ = length;
+    position_ = 0;
+    next_read_length_ = length;
+  }
+
+  void next_read_length(size_t length)
+  {
+    next_read_length_ = length;
+  }
+
+  template <typename Mutable_Buffers>
+  size_t read_some(const Mutable_Buffers& buffers,
+      boost::system::error_code& ec)
+  {
+    size_t n = boost::asio::buffer_copy(buffers,
+        boost::asio::buffer(data_, length_) + position_,
+        next_read_length_);
+    position_ += n;
+    ec = n == 0 ? boost::asio::error::eof : boost::system::error_code();
+    return n;
+  }
+
+  template <typename Mutable_Buffers, typename Handler>
+  void async_read_some(const Mutable_Buffers& buffers, Handler handler)
+  {
+    boost::system::error_code ec;
+    size_t bytes_transferred = read_some(buffers, ec);
+    boost::asio::post(get_executor(),
+        boost::asio::detail::bind_handler(
+          BOOST_ASIO_MOVE_CAST(Handler)(handler),
+          ec, bytes_transferred));
+  }
+
+private:
+  boost::asio::io_context& io_context_;
+  enum { max_length = 8192 };
+  char data_[max_length];
+  size_t length_;
+  size_t position_;
+  size_t next_read_length_;
+};
+
+// Returns the number of bytes up to and including the first match, feeding
+// the matcher the data in chunks of the given size, or 0 if there is no match.
+std::size_t match_length(boost::asio::dfa_matcher m,
+    const std::string& data, std::size_t chunk_size)
+{
+  std::string::const_iterator begin = data.begin();
+  std::string::const_iterator end = data.end();
+  for (std::string::const_iterator pos = begin; pos != end;)
+  {
+    std::string::const_iterator chunk_end = (std::size_t)(end - pos)
+      > chunk_size ? pos + chunk_size : end;
+    std::pair<std::string::const_iterator, bool> result = m(pos, chunk_end);
+    if (result.second)
+      return result.first - begin;
+    BOOST_ASIO_CHECK(result.first == chunk_end);
+    pos = chunk_end;
+  }
+  return 0;
+}
+
+void test_patterns()
+{
+  static const std::size_t chunk_sizes[] = { 1, 2, 3, 1000 };
+  for (std::size_t i = 0;
+      i < sizeof(chunk_sizes) / sizeof(chunk_sizes[0]); ++i)
+  {
+    std::size_t n = chunk_sizes[i];
+
+    BOOST_ASIO_CHECK(match_length(
+          boost::asio::dfa_matcher("\r\n\r\n"),
+          "GET / HTTP/1.0\r\nHost: x\r\n\r\nbody", n) == 27);
+    BOOST_ASIO_CHECK(match_length(
+          boost::asio::dfa_matcher("\r?\n\r?\n"),
+          "line 1\nline 2\n\nrest", n) == 15);
+    BOOST_ASIO_CHECK(match_length(
+          boost::asio::dfa_matcher("abab"), "abaabababab", n) == 7);
+    BOOST_ASIO_CHECK(match_length(
+          boost::asio::dfa_matcher("a+"), "xxaaa", n) == 3);
+    BOOST_ASIO_CHECK(match_length(
+          boost::asio::dfa_matcher("cat|dog"), "hotdog cat", n) == 6);
+    BOOST_ASIO_CHECK(match_length(
+          boost::asio::dfa_matcher("[0-9]{3}-\\d{4}"), "x 12-3456 555-1234",
+          n) == 18);
+    BOOST_ASIO_CHECK(match_length(
+          boost::asio::dfa_matcher("(?:ab){2,3}c"), "abcababc", n) == 8);
+    BOOST_ASIO_CHECK(match_length(
+          boost::asio::dfa_matcher("[^a-z]"), "abc!", n) == 4);
+    BOOST_ASIO_CHECK(match_length(
+          boost::asio::dfa_matcher("\\x41\\.\\w"), "A:A.b", n) == 5);
+    BOOST_ASIO_CHECK(match_length(
+          boost::asio::dfa_matcher("a.c"), "a\ncabc", n) == 6);
+    BOOST_ASIO_CHECK(match_length(
+          boost::asio::dfa_matcher("xyz"), "xyxyxy", n) == 0);
+  }
+
+  // A pattern that matches the empty string is satisfied immediately.
+  std::string empty_data("abc");
+  boost::asio::dfa_matcher star("x*");
+  std::pair<std::string::iterator, bool> result
+    = star(empty_data.begin(), empty_data.end());
+  BOOST_ASIO_CHECK(result.second);
+  BOOST_ASIO_CHECK(result.first == empty_data.begin());
+
+  // Copies share the automaton but have independent search states.
+  boost::asio::dfa_matcher m1("abc");
+  std::string partial("ab");
+  m1(partial.begin(), partial.end());
+  boost::asio::dfa_matcher m2(m1);
+  m1.reset();
+  std::string tail("c");
+  BOOST_ASIO_CHECK(!m1(tail.begin(), tail.end()).second);
+  BOOST_ASIO_CHECK(m2(tail.begin(), tail.end()).second);
+  BOOST_ASIO_CHECK(m1.state_count() == m2.state_count());
+}
+
+void test_invalid_patterns()
+{
+  static const char* const patterns[] =
+  {
+    "(abc", "abc)", "[abc", "*a", "a{2", "a{3,2}", "a{99999}",
+    "\\q", "\\x4", "[z-a]", "[\\d-z]", "^abc", "abc$", "a\\"
+  };
+
+  for (std::size_t i = 0; i < sizeof(patterns) / sizeof(patterns[0]); ++i)
+  {
+    bool thrown = false;
+    try
+    {
+      boost::asio::dfa_matcher m(patterns[i]);
+    }
+    catch (boost::system::system_error& e)
+    {
+      thrown = true;
+      BOOST_ASIO_CHECK(e.code() == boost::asio::error::invalid_argument);
+    }
+    BOOST_ASIO_CHECK(thrown);
+  }
+}
+
+static const char read_data[]
+  = "HTTP/1.0 200 OK\r\nContent-Length: 4\r\n\r\nbody";
+
+void test_read_until()
+{
+  boost::asio::io_context ioc;
+  test_stream s(ioc);
+  boost::asio::streambuf sb;
+  boost::asio::dfa_matcher end_of_header("\r?\n\r?\n");
+  boost::system::error_code ec;
+
+  static const std::size_t read_lengths[] = { 1, 3, 10, sizeof(read_data) };
+  for (std::size_t i = 0;
+      i < sizeof(read_lengths) / sizeof(read_lengths[0]); ++i)
+  {
+    s.reset(read_data, sizeof(read_data) - 1);
+    s.next_read_length(read_lengths[i]);
+    sb.consume(sb.size());
+    std::size_t length = boost::asio::read_until(s, sb, end_of_header, ec);
+    BOOST_ASIO_CHECK(!ec);
+    BOOST_ASIO_CHECK(length == 38);
+
+    std::string data;
+    s.reset(read_data, sizeof(read_data) - 1);
+    s.next_read_length(read_lengths[i]);
+    length = boost::asio::read_until(s,
+        boost::asio::dynamic_buffer(data), end_of_header, ec);
+    BOOST_ASIO_CHECK(!ec);
+    BOOST_ASIO_CHECK(length == 38);
+  }
+
+  s.reset(read_data, sizeof(read_data) - 1);
+  s.next_read_length(5);
+  sb.consume(sb.size());
+  std::size_t length = boost::asio::read_until(s, sb,
+      boost::asio::dfa_matcher("\r\n\r\n\r\n"), ec);
+  BOOST_ASIO_CHECK(ec == boost::asio::error::eof);
+  BOOST_ASIO_CHECK(length == 0);
+}
+
+void async_read_handler(const boost::system::error_code& err,
+    boost::system::error_code* err_out, std::size_t bytes_transferred,
+    std::size_t* bytes_out, bool* called)
+{
+  *err_out = err;
+  *bytes_out = bytes_transferred;
+  *called = true;
+}
+
+void test_async_read_until()
+{
+#if defined(BOOST_ASIO_HAS_BOOST_BIND)
+  namespace bindns = boost;
+#else // defined(BOOST_ASIO_HAS_BOOST_BIND)
+  namespace bindns = std;
+#endif // defined(BOOST_ASIO_HAS_BOOST_BIND)
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  boost::asio::io_context ioc;
+  test_stream s(ioc);
+  boost::asio::streambuf sb;
+  boost::asio::dfa_matcher end_of_header("\r?\n\r?\n");
+  boost::system::error_code ec;
+  std::size_t length;
+  bool called;
+
+  static const std::size_t read_lengths[] = { 1, 3, 10, sizeof(read_data) };
+  for (std::size_t i = 0;
+      i < sizeof(read_lengths) / sizeof(read_lengths[0]); ++i)
+  {
+    s.reset(read_data, sizeof(read_data) - 1);
+    s.next_read_length(read_lengths[i]);
+    sb.consume(sb.size());
+    ec = boost::system::error_code();
+    length = 0;
+    called = false;
+    boost::asio::async_read_until(s, sb, end_of_header,
+        bindns::bind(async_read_handler, _1, &ec,
+          _2, &length, &called));
+    ioc.restart();
+    ioc.run();
+    BOOST_ASIO_CHECK(called);
+    BOOST_ASIO_CHECK(!ec);
+    BOOST_ASIO_CHECK(length == 38);
+  }
+}
+
+BOOST_ASIO_TEST_SUITE
+(
+  "dfa_matcher",
+  BOOST_ASIO_TEST_CASE(test_patterns)
+  BOOST_ASIO_TEST_CASE(test_invalid_patterns)
+  BOOST_ASIO_TEST_CASE(test_read_until)
+  BOOST_ASIO_TEST_CASE(test_async_read_until)
+)
@@ -52,6 +52,7 @@ void error_test()
   test_error_code(boost::asio::error::connection_refused);
   test_error_code(boost::asio::error::connection_reset);
   test_error_code(boost::asio::error::bad_descriptor);
+  test_error_code(boost::asio::error::channel_closed);
   test_error_code(boost::asio::error::eof);
   test_error_code(boost::asio::error::fault);
   test_error_code(boost::asio::error::host_not_found);
@@ -17,9 +17,12 @@
 #include <boost/asio/io_context.hpp>
 
 #include <sstream>
+#include <vector>
 #include <boost/asio/bind_executor.hpp>
 #include <boost/asio/dispatch.hpp>
 #include <boost/asio/post.hpp>
+#include <boost/asio/detail/atomic_count.hpp>
+#include <boost/asio/detail/thread_group.hpp>
 #include <boost/asio/detail/thread.hpp>
 #include "unit_test.hpp"
 
@@ -296,6 +299,40 @@ private:
 
 boost::asio::io_context::id test_service::id;
 
+class colliding_service : public boost::asio::io_context::service
+{
+public:
+  static boost::asio::io_context::id id;
+  colliding_service(boost::asio::io_context& s)
+    : boost::asio::io_context::service(s) {}
+private:
+  virtual void shutdown_service() {}
+};
+
+boost::asio::io_context::id colliding_service::id;
+
+#if defined(BOOST_ASIO_HAS_STD_ATOMIC)
+namespace boost {
+namespace asio {
+namespace detail {
+
+// Give the service the same index as test_service, as can happen when the
+// indexes are allocated by different modules.
+template <>
+class service_index<colliding_service>
+{
+public:
+  static std::size_t value()
+  {
+    return service_index<test_service>::value();
+  }
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+#endif // defined(BOOST_ASIO_HAS_STD_ATOMIC)
+
 void io_context_service_test()
 {
   boost::asio::io_context ioc1;
@@ -352,6 +389,25 @@ void io_context_service_test()
   delete svc4;
 
   BOOST_ASIO_CHECK(!boost::asio::has_service<test_service>(ioc3));
+
+  // Each context has its own service object, which later lookups find again.
+
+  test_service& svc5 = boost::asio::use_service<test_service>(ioc3);
+
+  BOOST_ASIO_CHECK(boost::asio::has_service<test_service>(ioc3));
+  BOOST_ASIO_CHECK(&boost::asio::use_service<test_service>(ioc3) == &svc5);
+  BOOST_ASIO_CHECK(&boost::asio::use_service<test_service>(ioc2) == svc2);
+  BOOST_ASIO_CHECK(&boost::asio::use_service<test_service>(ioc1) != &svc5);
+
+  // Services whose type indexes collide are still told apart.
+
+  BOOST_ASIO_CHECK(!boost::asio::has_service<colliding_service>(ioc3));
+  colliding_service& svc6 = boost::asio::use_service<colliding_service>(ioc3);
+  BOOST_ASIO_CHECK(static_cast<void*>(&svc6) != static_cast<void*>(&svc5));
+  BOOST_ASIO_CHECK(&boost::asio::use_service<test_service>(ioc3) == &svc5);
+  BOOST_ASIO_CHECK(&boost::asio::use_service<colliding_service>(ioc3)
+      == &svc6);
+  BOOST_ASIO_CHECK(boost::asio::has_service<colliding_service>(ioc3));
 }
 
 void io_context_executor_query_test()
@@ -575,6 +631,327 @@ void io_context_executor_execute_test()
   BOOST_ASIO_CHECK(count == 1);
 }
 
+struct increment_function
+{
+  int* count;
+
+  void operator()() const
+  {
+    ++(*count);
+  }
+};
+
+void stop_context(io_context* ioc)
+{
+  ioc->stop();
+}
+
+void io_context_executor_post_batch_test()
+{
+  io_context ioc;
+  int count = 0;
+
+  std::vector<increment_function> functions;
+  for (int i = 0; i < 10; ++i)
+  {
+    increment_function f = { &count };
+    functions.push_back(f);
+  }
+
+  ioc.get_executor().post_batch(functions.begin(), functions.end());
+
+  // No handlers can be called until run() is called.
+  BOOST_ASIO_CHECK(!ioc.stopped());
+  BOOST_ASIO_CHECK(count == 0);
+
+  ioc.run();
+
+  // The run() call will not return until all work has finished.
+  BOOST_ASIO_CHECK(ioc.stopped());
+  BOOST_ASIO_CHECK(count == 10);
+
+  // An empty batch does not count as work.
+  count = 0;
+  ioc.restart();
+  ioc.get_executor().post_batch(functions.begin(), functions.begin());
+  BOOST_ASIO_CHECK(ioc.run() == 0);
+  BOOST_ASIO_CHECK(count == 0);
+}
+
+struct run_one_nested
+{
+  io_context* ioc_;
+  timer* timer_;
+  int* count_;
+  int* count_after_;
+
+  void operator()()
+  {
+    // The nested call must run the next handler from the outer call's batch,
+    // rather than block waiting for the timer.
+    BOOST_ASIO_CHECK(ioc_->run_one() == 1);
+    *count_after_ = *count_;
+    timer_->cancel();
+  }
+};
+
+void io_context_batched_run_test()
+{
+  // A single-threaded io_context runs ready handlers in batches.
+  io_context ioc(1);
+  int count = 0;
+
+  // A handler that stops the io_context prevents the rest of its batch from
+  // running, and those handlers remain queued in order.
+  boost::asio::post(ioc, bindns::bind(increment, &count));
+  boost::asio::post(ioc, bindns::bind(stop_context, &ioc));
+  boost::asio::post(ioc, bindns::bind(increment, &count));
+  boost::asio::post(ioc, bindns::bind(increment, &count));
+
+  BOOST_ASIO_CHECK(ioc.run() == 2);
+  BOOST_ASIO_CHECK(ioc.stopped());
+  BOOST_ASIO_CHECK(count == 1);
+
+  ioc.restart();
+  BOOST_ASIO_CHECK(ioc.run() == 2);
+  BOOST_ASIO_CHECK(count == 3);
+
+  // A handler that throws an exception leaves the rest of its batch queued.
+  count = 0;
+  ioc.restart();
+  boost::asio::post(ioc, bindns::bind(increment, &count));
+  boost::asio::post(ioc, throw_exception);
+  boost::asio::post(ioc, bindns::bind(increment, &count));
+  boost::asio::post(ioc, bindns::bind(increment, &count));
+
+  bool exception_caught = false;
+  try
+  {
+    ioc.run();
+  }
+  catch (int)
+  {
+    exception_caught = true;
+  }
+
+  BOOST_ASIO_CHECK(exception_caught);
+  BOOST_ASIO_CHECK(count == 1);
+
+  BOOST_ASIO_CHECK(ioc.run() == 2);
+  BOOST_ASIO_CHECK(count == 3);
+
+  // A nested run function can run handlers from the outer call's batch.
+  count = 0;
+  ioc.restart();
+  int count_after = 0;
+  int timer_count = 0;
+  timer t(ioc, chronons::seconds(3));
+  t.async_wait(bindns::bind(increment, &timer_count));
+  run_one_nested nested = { &ioc, &t, &count, &count_after };
+  boost::asio::post(ioc, nested);
+  boost::asio::post(ioc, bindns::bind(increment, &count));
+
+  ioc.run();
+  BOOST_ASIO_CHECK(count_after == 1);
+  BOOST_ASIO_CHECK(count == 1);
+  BOOST_ASIO_CHECK(timer_count == 1);
+}
+
+void io_context_unsafe_test()
+{
+  io_context ioc(BOOST_ASIO_CONCURRENCY_HINT_UNSAFE);
+  int count = 0;
+
+  // Outstanding work is counted without atomic operations.
+  executor_work_guard<io_context::executor_type> work = make_work_guard(ioc);
+  boost::asio::post(ioc, bindns::bind(increment, &count));
+  boost::asio::post(ioc, bindns::bind(increment, &count));
+
+  BOOST_ASIO_CHECK(ioc.poll() == 2);
+  BOOST_ASIO_CHECK(!ioc.stopped());
+  BOOST_ASIO_CHECK(count == 2);
+
+  work.reset();
+  ioc.run();
+
+  // The run() call will not return until all work has finished.
+  BOOST_ASIO_CHECK(ioc.stopped());
+}
+
+void io_context_busy_poll_test()
+{
+  io_context ioc(BOOST_ASIO_CONCURRENCY_HINT_SAFE_BUSY_POLL);
+  int count = 0;
+
+  // Timers expire while the reactor is being polled.
+  timer t(ioc, chronons::milliseconds(10));
+  t.async_wait(bindns::bind(increment, &count));
+  boost::asio::post(ioc, bindns::bind(increment, &count));
+
+  ioc.run();
+
+  // The run() call will not return until all work has finished.
+  BOOST_ASIO_CHECK(ioc.stopped());
+  BOOST_ASIO_CHECK(count == 2);
+
+  // Handlers posted from another thread are run without interrupting the
+  // reactor.
+  count = 0;
+  ioc.restart();
+  executor_work_guard<io_context::executor_type> work = make_work_guard(ioc);
+  boost::asio::detail::thread th(bindns::bind(io_context_run, &ioc));
+  for (int i = 0; i < 10; ++i)
+    boost::asio::post(ioc, bindns::bind(increment, &count));
+  work.reset();
+  th.join();
+
+  BOOST_ASIO_CHECK(ioc.stopped());
+  BOOST_ASIO_CHECK(count == 10);
+}
+
+#if defined(BOOST_ASIO_HAS_CHRONO)
+
+struct stress_handler
+{
+  io_context* ioc_;
+  boost::asio::detail::atomic_count* count_;
+  int hops_;
+
+  void operator()()
+  {
+    ++*count_;
+    if (hops_ > 0)
+    {
+      stress_handler next = { ioc_, count_, hops_ - 1 };
+      boost::asio::post(*ioc_, next);
+    }
+  }
+};
+
+struct stress_thread
+{
+  io_context* ioc_;
+  boost::asio::detail::atomic_count* count_;
+
+  void operator()()
+  {
+    // Alternate between posting from outside the run functions and running
+    // briefly, so that threads repeatedly become idle and are woken.
+    for (int i = 0; i < stress_iterations; ++i)
+    {
+      for (int j = 0; j < stress_posts; ++j)
+      {
+        stress_handler handler = { ioc_, count_, stress_hops };
+        boost::asio::post(*ioc_, handler);
+      }
+      ioc_->run_for(boost::asio::chrono::microseconds(100 * (i % 5)));
+    }
+  }
+
+  enum
+  {
+    stress_threads = 8,
+    stress_iterations = 200,
+    stress_posts = 4,
+    stress_hops = 3
+  };
+};
+
+void io_context_run_for_stress_test()
+{
+  io_context ioc;
+  boost::asio::detail::atomic_count count(0);
+
+  executor_work_guard<io_context::executor_type> work = make_work_guard(ioc);
+  stress_thread t = { &ioc, &count };
+  boost::asio::detail::thread_group threads;
+  threads.create_threads(t, stress_thread::stress_threads);
+  threads.join();
+
+  // Handlers still queued when the threads finished are run here.
+  work.reset();
+  ioc.run();
+
+  BOOST_ASIO_CHECK(ioc.stopped());
+  BOOST_ASIO_CHECK(count == stress_thread::stress_threads
+      * stress_thread::stress_iterations * stress_thread::stress_posts
+      * (stress_thread::stress_hops + 1));
+}
+
+#else // defined(BOOST_ASIO_HAS_CHRONO)
+
+void io_context_run_for_stress_test()
+{
+}
+
+#endif // defined(BOOST_ASIO_HAS_CHRONO)
+
+#if defined(BOOST_ASIO_HAS_IO_SENDERS)
+
+struct schedule_receiver
+{
+  int* count_;
+
+  void set_value()
+  {
+    ++(*count_);
+  }
+
+  template <typename E>
+  void set_error(E) BOOST_ASIO_NOEXCEPT
+  {
+  }
+
+  void set_done() BOOST_ASIO_NOEXCEPT
+  {
+  }
+};
+
+void io_context_executor_schedule_test()
+{
+  io_context ioc;
+  int count = 0;
+
+  BOOST_ASIO_CHECK(
+      boost::asio::execution::is_scheduler<io_context::executor_type>::value);
+
+  schedule_receiver r = { &count };
+  auto op1 = boost::asio::execution::connect(
+      boost::asio::execution::schedule(ioc.get_executor()), r);
+  auto op2 = boost::asio::execution::connect(
+      boost::asio::execution::schedule(ioc.get_executor()), r);
+  boost::asio::execution::start(op1);
+  boost::asio::execution::start(op2);
+
+  // No receivers can be called until run() is called.
+  BOOST_ASIO_CHECK(!ioc.stopped());
+  BOOST_ASIO_CHECK(count == 0);
+
+  ioc.run();
+
+  // The run() call will not return until all operations have completed.
+  BOOST_ASIO_CHECK(ioc.stopped());
+  BOOST_ASIO_CHECK(count == 2);
+
+  // Operations that are pending when the io_context is destroyed are
+  // abandoned without invoking their receivers.
+  {
+    io_context ioc2;
+    auto op3 = boost::asio::execution::connect(
+        boost::asio::execution::schedule(ioc2.get_executor()), r);
+    boost::asio::execution::start(op3);
+  }
+  BOOST_ASIO_CHECK(count == 2);
+}
+
+#else // defined(BOOST_ASIO_HAS_IO_SENDERS)
+
+void io_context_executor_schedule_test()
+{
+}
+
+#endif // defined(BOOST_ASIO_HAS_IO_SENDERS)
+
 BOOST_ASIO_TEST_SUITE
 (
   "io_context",
@@ -582,4 +959,10 @@ BOOST_ASIO_TEST_SUITE
   BOOST_ASIO_TEST_CASE(io_context_service_test)
   BOOST_ASIO_TEST_CASE(io_context_executor_query_test)
   BOOST_ASIO_TEST_CASE(io_context_executor_execute_test)
+  BOOST_ASIO_TEST_CASE(io_context_executor_post_batch_test)
+  BOOST_ASIO_TEST_CASE(io_context_batched_run_test)
+  BOOST_ASIO_TEST_CASE(io_context_unsafe_test)
+  BOOST_ASIO_TEST_CASE(io_context_busy_poll_test)
+  BOOST_ASIO_TEST_CASE(io_context_run_for_stress_test)
+  BOOST_ASIO_TEST_CASE(io_context_executor_schedule_test)
 )
@@ -20,6 +20,9 @@
 #include <boost/asio/ip/tcp.hpp>
 
 #include <cstring>
+#include <vector>
+#include <boost/asio/bind_cancellation_slot.hpp>
+#include <boost/asio/cancellation_signal.hpp>
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/read.hpp>
 #include <boost/asio/write.hpp>
@@ -575,6 +578,14 @@ void handle_read_cancel(const boost::system::error_code& err,
   BOOST_ASIO_CHECK(bytes_transferred == 0);
 }
 
+void handle_read_timeout(const boost::system::error_code& err,
+    size_t bytes_transferred, bool* called)
+{
+  *called = true;
+  BOOST_ASIO_CHECK(err == boost::asio::error::timed_out);
+  BOOST_ASIO_CHECK(bytes_transferred == 0);
+}
+
 void handle_read_eof(const boost::system::error_code& err,
     size_t bytes_transferred, bool* called)
 {
@@ -671,6 +682,80 @@ void test()
   ioc.run();
   BOOST_ASIO_CHECK(read_cancel_completed);
 
+  // Read cancelled through its own cancellation slot. A write on the same
+  // socket is not affected.
+
+  cancellation_signal read_signal;
+  bool read_slot_cancel_completed = false;
+  boost::asio::async_read(server_side_socket,
+      boost::asio::buffer(read_buffer),
+      bind_cancellation_slot(read_signal.slot(),
+        bindns::bind(handle_read_cancel,
+          _1, _2, &read_slot_cancel_completed)));
+
+  ioc.restart();
+  ioc.poll();
+  BOOST_ASIO_CHECK(!read_slot_cancel_completed);
+
+  write_completed = false;
+  boost::asio::async_write(server_side_socket,
+      boost::asio::buffer(write_data),
+      bindns::bind(handle_write,
+        _1, _2, &write_completed));
+
+  read_signal.emit(cancellation_type::partial);
+
+  ioc.restart();
+  ioc.run();
+  BOOST_ASIO_CHECK(read_slot_cancel_completed);
+  BOOST_ASIO_CHECK(write_completed);
+
+  boost::asio::read(client_side_socket, boost::asio::buffer(read_buffer));
+
+#if defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+  // A read that is not satisfied by its deadline fails with timed_out.
+
+  typedef boost::asio::chrono::steady_clock clock_type;
+  clock_type::time_point start = clock_type::now();
+  bool read_timeout_completed = false;
+  server_side_socket.async_read_some_until(
+      boost::asio::buffer(read_buffer),
+      start + boost::asio::chrono::milliseconds(100),
+      bindns::bind(handle_read_timeout,
+        _1, _2, &read_timeout_completed));
+
+  ioc.restart();
+  ioc.run();
+  BOOST_ASIO_CHECK(read_timeout_completed);
+  BOOST_ASIO_CHECK(clock_type::now() - start
+      >= boost::asio::chrono::milliseconds(100));
+
+  // Operations that complete before their deadlines are unaffected, and the
+  // deadlines do not keep the io_context running once they have completed.
+
+  start = clock_type::now();
+  read_completed = false;
+  client_side_socket.async_read_some_until(
+      boost::asio::buffer(read_buffer),
+      start + boost::asio::chrono::seconds(30),
+      bindns::bind(handle_read,
+        _1, _2, &read_completed));
+
+  write_completed = false;
+  server_side_socket.async_write_some_until(
+      boost::asio::buffer(write_data),
+      start + boost::asio::chrono::seconds(30),
+      bindns::bind(handle_write,
+        _1, _2, &write_completed));
+
+  ioc.restart();
+  ioc.run();
+  BOOST_ASIO_CHECK(read_completed);
+  BOOST_ASIO_CHECK(write_completed);
+  BOOST_ASIO_CHECK(clock_type::now() - start
+      < boost::asio::chrono::seconds(10));
+#endif // defined(BOOST_ASIO_HAS_OPERATION_DEADLINES)
+
   // A read when the peer closes socket should fail with eof.
 
   bool read_eof_completed = false;
@@ -686,6 +771,236 @@ void test()
   BOOST_ASIO_CHECK(read_eof_completed);
 }
 
+// Closing a socket with an outstanding operation, and then opening another
+// socket that usually reuses the same descriptor number, must not deliver the
+// old socket's state or events to the new socket.
+void test_descriptor_reuse()
+{
+  using namespace std; // For memcmp.
+  using namespace boost::asio;
+  namespace ip = boost::asio::ip;
+
+#if defined(BOOST_ASIO_HAS_BOOST_BIND)
+  namespace bindns = boost;
+#else // defined(BOOST_ASIO_HAS_BOOST_BIND)
+  namespace bindns = std;
+#endif // defined(BOOST_ASIO_HAS_BOOST_BIND)
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  io_context ioc;
+
+  ip::tcp::acceptor acceptor(ioc, ip::tcp::endpoint(ip::tcp::v4(), 0));
+  ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(ip::address_v4::loopback());
+
+  for (int i = 0; i < 200; ++i)
+  {
+    ip::tcp::socket client_side_socket(ioc);
+    ip::tcp::socket server_side_socket(ioc);
+    client_side_socket.connect(server_endpoint);
+    acceptor.accept(server_side_socket);
+
+    char read_buffer[sizeof(write_data)];
+    bool read_cancel_completed = false;
+    server_side_socket.async_read_some(boost::asio::buffer(read_buffer),
+        bindns::bind(handle_read_cancel,
+          _1, _2, &read_cancel_completed));
+
+    boost::asio::write(client_side_socket, boost::asio::buffer(write_data));
+    server_side_socket.close();
+
+    ip::tcp::socket client_side_socket2(ioc);
+    ip::tcp::socket server_side_socket2(ioc);
+    client_side_socket2.connect(server_endpoint);
+    acceptor.accept(server_side_socket2);
+
+    char read_buffer2[sizeof(write_data)];
+    memset(read_buffer2, 0, sizeof(read_buffer2));
+    bool read_completed = false;
+    boost::asio::async_read(server_side_socket2,
+        boost::asio::buffer(read_buffer2),
+        bindns::bind(handle_read,
+          _1, _2, &read_completed));
+
+    ioc.restart();
+    ioc.poll();
+    BOOST_ASIO_CHECK(read_cancel_completed);
+    BOOST_ASIO_CHECK(!read_completed);
+
+    boost::asio::write(client_side_socket2, boost::asio::buffer(write_data));
+
+    ioc.restart();
+    ioc.run();
+    BOOST_ASIO_CHECK(read_completed);
+    BOOST_ASIO_CHECK(memcmp(read_buffer2, write_data, sizeof(write_data)) == 0);
+  }
+}
+
+struct inline_read_chain
+{
+  boost::asio::ip::tcp::socket* socket_;
+  char* data_;
+  int* remaining_;
+  int* depth_;
+  int* max_depth_;
+
+  void start()
+  {
+    ++*depth_;
+    *max_depth_ = (std::max)(*max_depth_, *depth_);
+    socket_->async_read_some(boost::asio::buffer(data_, 1), *this);
+    --*depth_;
+  }
+
+  void operator()(const boost::system::error_code& err, size_t)
+  {
+    BOOST_ASIO_CHECK(!err);
+    if (--*remaining_ > 0)
+      start();
+  }
+};
+
+void start_inline_read(boost::asio::ip::tcp::socket* s,
+    char* data, bool* called, bool* called_before_return)
+{
+#if defined(BOOST_ASIO_HAS_BOOST_BIND)
+  namespace bindns = boost;
+#else // defined(BOOST_ASIO_HAS_BOOST_BIND)
+  namespace bindns = std;
+#endif // defined(BOOST_ASIO_HAS_BOOST_BIND)
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  s->async_read_some(boost::asio::buffer(data, sizeof(write_data)),
+      bindns::bind(handle_read, _1, _2, called));
+  *called_before_return = *called;
+}
+
+#if defined(BOOST_ASIO_HAS_STD_EXCEPTION_PTR)
+struct throwing_read_handler
+{
+  void operator()(const boost::system::error_code&, size_t)
+  {
+    throw 42;
+  }
+};
+
+void start_throwing_read(boost::asio::ip::tcp::socket* s,
+    char* data, bool* returned)
+{
+  s->async_read_some(boost::asio::buffer(data, 1), throwing_read_handler());
+  *returned = true;
+}
+#endif // defined(BOOST_ASIO_HAS_STD_EXCEPTION_PTR)
+
+// With inline completion enabled, an operation that completes immediately
+// invokes its handler before the initiating function returns, but only when
+// initiated from a thread that is running the io_context. Inline completion
+// needs std::exception_ptr, and the select reactor never completes operations
+// immediately.
+#if defined(BOOST_ASIO_HAS_STD_EXCEPTION_PTR) \
+  && (defined(BOOST_ASIO_HAS_EPOLL) || defined(BOOST_ASIO_HAS_KQUEUE) \
+    || defined(BOOST_ASIO_HAS_DEV_POLL))
+# define BOOST_ASIO_TEST_INLINE_COMPLETION 1
+#endif // defined(BOOST_ASIO_HAS_STD_EXCEPTION_PTR)
+       //   && (defined(BOOST_ASIO_HAS_EPOLL) || defined(BOOST_ASIO_HAS_KQUEUE)
+       //     || defined(BOOST_ASIO_HAS_DEV_POLL))
+
+void test_inline_completion()
+{
+  using namespace boost::asio;
+  namespace ip = boost::asio::ip;
+
+#if defined(BOOST_ASIO_HAS_BOOST_BIND)
+  namespace bindns = boost;
+#else // defined(BOOST_ASIO_HAS_BOOST_BIND)
+  namespace bindns = std;
+#endif // defined(BOOST_ASIO_HAS_BOOST_BIND)
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  io_context ioc(BOOST_ASIO_CONCURRENCY_HINT_SAFE_INLINE);
+
+  ip::tcp::acceptor acceptor(ioc, ip::tcp::endpoint(ip::tcp::v4(), 0));
+  ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(ip::address_v4::loopback());
+
+  ip::tcp::socket client_side_socket(ioc);
+  ip::tcp::socket server_side_socket(ioc);
+  client_side_socket.connect(server_endpoint);
+  acceptor.accept(server_side_socket);
+
+  // Initiated from outside the run functions, the handler is queued.
+  char read_buffer[sizeof(write_data)];
+  bool read_completed = false;
+  boost::asio::write(client_side_socket, boost::asio::buffer(write_data));
+  server_side_socket.async_read_some(boost::asio::buffer(read_buffer),
+      bindns::bind(handle_read, _1, _2, &read_completed));
+  BOOST_ASIO_CHECK(!read_completed);
+
+  ioc.run();
+  BOOST_ASIO_CHECK(read_completed);
+
+  // Initiated from within a handler, the handler is invoked inline.
+  bool read_completed_inline = false;
+  read_completed = false;
+  boost::asio::write(client_side_socket, boost::asio::buffer(write_data));
+  boost::asio::post(ioc, bindns::bind(start_inline_read, &server_side_socket,
+        read_buffer, &read_completed, &read_completed_inline));
+
+  ioc.restart();
+  ioc.run();
+  BOOST_ASIO_CHECK(read_completed);
+#if defined(BOOST_ASIO_TEST_INLINE_COMPLETION)
+  BOOST_ASIO_CHECK(read_completed_inline);
+#else // defined(BOOST_ASIO_TEST_INLINE_COMPLETION)
+  (void)read_completed_inline;
+#endif // defined(BOOST_ASIO_TEST_INLINE_COMPLETION)
+
+  // A chain of immediate completions is nested only to a bounded depth.
+  const int chain_length = 100;
+  char chain_data[chain_length] = "";
+  boost::asio::write(client_side_socket, boost::asio::buffer(chain_data));
+  int remaining = chain_length;
+  int depth = 0;
+  int max_depth = 0;
+  inline_read_chain chain = { &server_side_socket,
+    chain_data, &remaining, &depth, &max_depth };
+  boost::asio::post(ioc, bindns::bind(&inline_read_chain::start, chain));
+
+  ioc.restart();
+  ioc.run();
+  BOOST_ASIO_CHECK(remaining == 0);
+  BOOST_ASIO_CHECK(max_depth <= BOOST_ASIO_SCHEDULER_INLINE_DEPTH + 1);
+
+#if defined(BOOST_ASIO_TEST_INLINE_COMPLETION)
+  BOOST_ASIO_CHECK(max_depth > 1);
+#endif // defined(BOOST_ASIO_TEST_INLINE_COMPLETION)
+
+#if defined(BOOST_ASIO_HAS_STD_EXCEPTION_PTR)
+  // An exception thrown by an inline handler does not escape the initiating
+  // function, and is instead rethrown from the run function.
+  bool returned = false;
+  bool caught = false;
+  boost::asio::write(client_side_socket, boost::asio::buffer(write_data, 1));
+  boost::asio::post(ioc, bindns::bind(start_throwing_read,
+        &server_side_socket, read_buffer, &returned));
+
+  ioc.restart();
+  try
+  {
+    ioc.run();
+  }
+  catch (int)
+  {
+    caught = true;
+  }
+  BOOST_ASIO_CHECK(returned);
+  BOOST_ASIO_CHECK(caught);
+#endif // defined(BOOST_ASIO_HAS_STD_EXCEPTION_PTR)
+}
+
 } // namespace ip_tcp_socket_runtime
 
 //------------------------------------------------------------------------------
@@ -740,6 +1055,27 @@ struct move_accept_ioc_handler
 private:
   move_accept_ioc_handler(const move_accept_handler&) {}
 };
+
+struct accept_many_handler
+{
+  accept_many_handler() {}
+  void operator()(const boost::system::error_code&,
+      std::vector<boost::asio::ip::tcp::socket>) {}
+  accept_many_handler(accept_many_handler&&) {}
+private:
+  accept_many_handler(const accept_many_handler&) {}
+};
+
+struct accept_many_ioc_handler
+{
+  accept_many_ioc_handler() {}
+  void operator()(const boost::system::error_code&,
+      std::vector<boost::asio::basic_stream_socket<boost::asio::ip::tcp,
+        boost::asio::io_context::executor_type> >) {}
+  accept_many_ioc_handler(accept_many_ioc_handler&&) {}
+private:
+  accept_many_ioc_handler(const accept_many_ioc_handler&) {}
+};
 #endif // defined(BOOST_ASIO_HAS_MOVE)
 
 void test()
@@ -930,6 +1266,12 @@ void test()
     acceptor1.async_accept(ioc, peer_endpoint, move_accept_handler());
     acceptor1.async_accept(ioc_ex, peer_endpoint, move_accept_handler());
     acceptor1.async_accept(ioc_ex, peer_endpoint, move_accept_ioc_handler());
+
+# if !defined(BOOST_ASIO_HAS_IOCP) && !defined(BOOST_ASIO_WINDOWS_RUNTIME)
+    acceptor1.async_accept_many(16, accept_many_handler());
+    acceptor1.async_accept_many(ioc_ex, 16, accept_many_ioc_handler());
+# endif // !defined(BOOST_ASIO_HAS_IOCP)
+      //   && !defined(BOOST_ASIO_WINDOWS_RUNTIME)
 #endif // defined(BOOST_ASIO_HAS_MOVE)
   }
   catch (std::exception&)
@@ -1014,12 +1356,298 @@ void test()
   server_side_remote_endpoint = server_side_socket.remote_endpoint();
   BOOST_ASIO_CHECK(server_side_remote_endpoint.port()
       == client_endpoint.port());
+
+  client_side_socket.close();
+  server_side_socket.close();
+
+  // Waiting and accepting with the exclusive_wake option set. The option is
+  // not supported by all kernels.
+
+  boost::system::error_code ec;
+  acceptor.set_option(ip::tcp::acceptor::exclusive_wake(true), ec);
+  BOOST_ASIO_CHECK(!ec || ec == boost::asio::error::invalid_argument);
+
+  acceptor.async_wait(ip::tcp::acceptor::wait_read, &handle_accept);
+  client_side_socket.async_connect(server_endpoint, &handle_connect);
+
+  ioc.restart();
+  ioc.run();
+
+  acceptor.async_accept(server_side_socket, &handle_accept);
+
+  ioc.restart();
+  ioc.run();
+
+  BOOST_ASIO_CHECK(server_side_socket.is_open());
+  server_side_remote_endpoint = server_side_socket.remote_endpoint();
+  BOOST_ASIO_CHECK(server_side_remote_endpoint.port()
+      == client_side_socket.local_endpoint().port());
+}
+
+#if defined(BOOST_ASIO_HAS_MOVE) \
+  && !defined(BOOST_ASIO_HAS_IOCP) && !defined(BOOST_ASIO_WINDOWS_RUNTIME)
+
+struct accept_many_handler
+{
+  std::vector<boost::asio::ip::tcp::socket>* peers_;
+  int* calls_;
+
+  void operator()(const boost::system::error_code& err,
+      std::vector<boost::asio::ip::tcp::socket> peers)
+  {
+    BOOST_ASIO_CHECK(!err);
+    ++*calls_;
+    for (std::size_t i = 0; i < peers.size(); ++i)
+      peers_->push_back(std::move(peers[i]));
+  }
+};
+
+void handle_read(const boost::system::error_code& err, std::size_t n)
+{
+  BOOST_ASIO_CHECK(!err);
+  BOOST_ASIO_CHECK(n == 1);
 }
 
+void test_accept_many()
+{
+  using namespace boost::asio;
+  namespace ip = boost::asio::ip;
+
+  io_context ioc;
+
+  ip::tcp::acceptor acceptor(ioc, ip::tcp::endpoint(ip::tcp::v4(), 0));
+  ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(ip::address_v4::loopback());
+
+  ip::tcp::socket client_side_sockets[3] =
+  {
+    ip::tcp::socket(ioc),
+    ip::tcp::socket(ioc),
+    ip::tcp::socket(ioc)
+  };
+  for (int i = 0; i < 3; ++i)
+    client_side_sockets[i].connect(server_endpoint);
+
+  // All waiting connections are accepted by one operation, up to the limit.
+
+  std::vector<ip::tcp::socket> peers;
+  int calls = 0;
+  accept_many_handler handler = { &peers, &calls };
+  acceptor.async_accept_many(2, handler);
+
+  ioc.run();
+
+  BOOST_ASIO_CHECK(calls == 1);
+  BOOST_ASIO_CHECK(peers.size() == 2);
+
+  acceptor.async_accept_many(16, handler);
+
+  ioc.restart();
+  ioc.run();
+
+  BOOST_ASIO_CHECK(calls == 2);
+  BOOST_ASIO_CHECK(peers.size() == 3);
+
+  // The accepted sockets are usable for both synchronous and asynchronous
+  // operations.
+
+  for (std::size_t i = 0; i < peers.size(); ++i)
+  {
+    BOOST_ASIO_CHECK(peers[i].is_open());
+    BOOST_ASIO_CHECK(!peers[i].non_blocking());
+
+    char data = 'x';
+    boost::asio::write(peers[i], boost::asio::buffer(&data, 1));
+  }
+
+  char data[3] = { 0, 0, 0 };
+  for (int i = 0; i < 3; ++i)
+  {
+    boost::asio::read(client_side_sockets[i], boost::asio::buffer(data, 1));
+    BOOST_ASIO_CHECK(data[0] == 'x');
+    boost::asio::write(client_side_sockets[i], boost::asio::buffer("y", 1));
+  }
+
+  for (std::size_t i = 0; i < peers.size(); ++i)
+    boost::asio::async_read(peers[i],
+        boost::asio::buffer(data + i, 1), &handle_read);
+
+  ioc.restart();
+  ioc.run();
+
+  BOOST_ASIO_CHECK(data[0] == 'y' && data[1] == 'y' && data[2] == 'y');
+}
+
+#else // defined(BOOST_ASIO_HAS_MOVE)
+      //   && !defined(BOOST_ASIO_HAS_IOCP)
+      //   && !defined(BOOST_ASIO_WINDOWS_RUNTIME)
+
+void test_accept_many()
+{
+}
+
+#endif // defined(BOOST_ASIO_HAS_MOVE)
+       //   && !defined(BOOST_ASIO_HAS_IOCP)
+       //   && !defined(BOOST_ASIO_WINDOWS_RUNTIME)
+
 } // namespace ip_tcp_acceptor_runtime
 
 //------------------------------------------------------------------------------
 
+// ip_tcp_sender_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the senders returned by
+// the ip::tcp::socket and ip::tcp::acceptor classes.
+
+namespace ip_tcp_sender_runtime {
+
+#if defined(BOOST_ASIO_HAS_IO_SENDERS)
+
+struct result
+{
+  int values;
+  int errors;
+  int dones;
+  std::size_t bytes_transferred;
+  boost::system::error_code ec;
+};
+
+struct receiver
+{
+  result* result_;
+
+  void set_value()
+  {
+    ++result_->values;
+  }
+
+  void set_value(std::size_t n)
+  {
+    ++result_->values;
+    result_->bytes_transferred = n;
+  }
+
+  void set_error(const boost::system::error_code& ec) BOOST_ASIO_NOEXCEPT
+  {
+    ++result_->errors;
+    result_->ec = ec;
+  }
+
+  void set_error(std::exception_ptr) BOOST_ASIO_NOEXCEPT
+  {
+    ++result_->errors;
+  }
+
+  void set_done() BOOST_ASIO_NOEXCEPT
+  {
+    ++result_->dones;
+  }
+};
+
+void test()
+{
+  using namespace boost::asio;
+  namespace ip = boost::asio::ip;
+
+  io_context ioc;
+
+  ip::tcp::acceptor acceptor(ioc, ip::tcp::endpoint(ip::tcp::v4(), 0));
+  ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(ip::address_v4::loopback());
+
+  ip::tcp::socket client_side_socket(ioc);
+  ip::tcp::socket server_side_socket(ioc);
+
+  result accept_result = result();
+  receiver accept_receiver = { &accept_result };
+  ip::tcp::endpoint client_endpoint;
+  auto accept_op = execution::connect(
+      acceptor.accept_sender(server_side_socket, client_endpoint),
+      accept_receiver);
+  execution::start(accept_op);
+
+  client_side_socket.connect(server_endpoint);
+
+  ioc.run();
+
+  BOOST_ASIO_CHECK(accept_result.values == 1);
+  BOOST_ASIO_CHECK(server_side_socket.is_open());
+  BOOST_ASIO_CHECK(client_endpoint.port()
+      == client_side_socket.local_endpoint().port());
+
+  const char write_data[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+  char read_data[sizeof(write_data)] = { 0 };
+
+  result write_result = result();
+  receiver write_receiver = { &write_result };
+  auto write_op = execution::connect(
+      client_side_socket.write_some_sender(buffer(write_data)),
+      write_receiver);
+  execution::start(write_op);
+
+  ioc.restart();
+  ioc.run();
+
+  BOOST_ASIO_CHECK(write_result.values == 1);
+  BOOST_ASIO_CHECK(write_result.bytes_transferred == sizeof(write_data));
+
+  result read_result = result();
+  receiver read_receiver = { &read_result };
+  auto read_op = execution::connect(
+      server_side_socket.read_some_sender(buffer(read_data)),
+      read_receiver);
+  execution::start(read_op);
+
+  ioc.restart();
+  ioc.run();
+
+  BOOST_ASIO_CHECK(read_result.values == 1);
+  BOOST_ASIO_CHECK(read_result.bytes_transferred == sizeof(write_data));
+  BOOST_ASIO_CHECK(memcmp(read_data, write_data, sizeof(write_data)) == 0);
+
+  // Cancelling a pending read completes its receiver with set_done.
+  result cancel_result = result();
+  receiver cancel_receiver = { &cancel_result };
+  auto cancel_op = execution::connect(
+      server_side_socket.read_some_sender(buffer(read_data)),
+      cancel_receiver);
+  execution::start(cancel_op);
+  server_side_socket.cancel();
+
+  ioc.restart();
+  ioc.run();
+
+  BOOST_ASIO_CHECK(cancel_result.values == 0);
+  BOOST_ASIO_CHECK(cancel_result.dones == 1);
+
+  // Other failures are delivered to the receiver's set_error.
+  result eof_result = result();
+  receiver eof_receiver = { &eof_result };
+  auto eof_op = execution::connect(
+      server_side_socket.read_some_sender(buffer(read_data)),
+      eof_receiver);
+  execution::start(eof_op);
+  client_side_socket.close();
+
+  ioc.restart();
+  ioc.run();
+
+  BOOST_ASIO_CHECK(eof_result.errors == 1);
+  BOOST_ASIO_CHECK(eof_result.ec == boost::asio::error::eof);
+}
+
+#else // defined(BOOST_ASIO_HAS_IO_SENDERS)
+
+void test()
+{
+}
+
+#endif // defined(BOOST_ASIO_HAS_IO_SENDERS)
+
+} // namespace ip_tcp_sender_runtime
+
+//------------------------------------------------------------------------------
+
 // ip_tcp_resolver_compile test
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // The following test checks that all public member functions on the class
@@ -1337,8 +1965,12 @@ BOOST_ASIO_TEST_SUITE
   BOOST_ASIO_TEST_CASE(ip_tcp_runtime::test)
   BOOST_ASIO_TEST_CASE(ip_tcp_socket_compile::test)
   BOOST_ASIO_TEST_CASE(ip_tcp_socket_runtime::test)
+  BOOST_ASIO_TEST_CASE(ip_tcp_socket_runtime::test_descriptor_reuse)
+  BOOST_ASIO_TEST_CASE(ip_tcp_socket_runtime::test_inline_completion)
   BOOST_ASIO_TEST_CASE(ip_tcp_acceptor_compile::test)
   BOOST_ASIO_TEST_CASE(ip_tcp_acceptor_runtime::test)
+  BOOST_ASIO_TEST_CASE(ip_tcp_acceptor_runtime::test_accept_many)
+  BOOST_ASIO_TEST_CASE(ip_tcp_sender_runtime::test)
   BOOST_ASIO_TEST_CASE(ip_tcp_resolver_compile::test)
   BOOST_ASIO_TEST_CASE(ip_tcp_resolver_entry_compile::test)
   BOOST_ASIO_TEST_CASE(ip_tcp_resolver_entry_compile::test)
@@ -0,0 +1,207 @@
+//
+// accept_wake.cpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Measures how many threads are woken by each incoming connection when one
+// listening socket is shared by several threads, each running its own
+// io_context, with and without the exclusive_wake option.
+//
+// A thread that is woken after another thread has already accepted the
+// connection may find that epoll reports no event, so the number of times
+// that each thread blocked is counted using its context switches.
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/detail/atomic_count.hpp>
+#include <boost/asio/detail/thread_group.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <sys/resource.h>
+#include <unistd.h>
+
+using boost::asio::ip::tcp;
+
+class waiter
+{
+public:
+  waiter(int listen_fd, bool exclusive,
+      boost::asio::detail::atomic_count& total_accepted)
+    : acceptor_(io_context_, tcp::v4(), ::dup(listen_fd)),
+      total_accepted_(total_accepted),
+      wakeups_(0),
+      spurious_wakeups_(0),
+      context_switches_(0)
+  {
+    acceptor_.non_blocking(true);
+    acceptor_.set_option(tcp::acceptor::exclusive_wake(exclusive));
+    wait();
+  }
+
+  void run()
+  {
+    io_context_.run();
+
+    rusage usage;
+    if (::getrusage(RUSAGE_THREAD, &usage) == 0)
+      context_switches_ = usage.ru_nvcsw;
+  }
+
+  void stop()
+  {
+    io_context_.stop();
+  }
+
+  std::size_t wakeups() const
+  {
+    return wakeups_;
+  }
+
+  std::size_t spurious_wakeups() const
+  {
+    return spurious_wakeups_;
+  }
+
+  std::size_t context_switches() const
+  {
+    return context_switches_;
+  }
+
+private:
+  struct ready_handler
+  {
+    waiter* this_;
+
+    void operator()(const boost::system::error_code& ec)
+    {
+      this_->on_ready(ec);
+    }
+  };
+
+  void wait()
+  {
+    ready_handler handler = { this };
+    acceptor_.async_wait(tcp::acceptor::wait_read, handler);
+  }
+
+  // Accept all pending connections. A wakeup that finds none is spurious.
+  void on_ready(const boost::system::error_code& ec)
+  {
+    if (ec)
+      return;
+
+    ++wakeups_;
+    std::size_t accepted = 0;
+    for (;;)
+    {
+      tcp::socket socket(io_context_);
+      boost::system::error_code accept_ec;
+      acceptor_.accept(socket, accept_ec);
+      if (accept_ec)
+        break;
+      ++accepted;
+      ++total_accepted_;
+    }
+
+    if (accepted == 0)
+      ++spurious_wakeups_;
+
+    wait();
+  }
+
+  boost::asio::io_context io_context_;
+  tcp::acceptor acceptor_;
+  boost::asio::detail::atomic_count& total_accepted_;
+  std::size_t wakeups_;
+  std::size_t spurious_wakeups_;
+  std::size_t context_switches_;
+};
+
+struct run_waiter
+{
+  waiter* waiter_;
+
+  void operator()()
+  {
+    waiter_->run();
+  }
+};
+
+void run_test(int num_threads, int num_connections, int burst, bool exclusive)
+{
+  boost::asio::io_context io_context;
+  tcp::acceptor listener(io_context,
+      tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+  listener.listen(tcp::acceptor::max_listen_connections);
+  tcp::endpoint endpoint = listener.local_endpoint();
+
+  boost::asio::detail::atomic_count total_accepted(0);
+  std::vector<waiter*> waiters;
+  boost::asio::detail::thread_group threads;
+  for (int i = 0; i < num_threads; ++i)
+  {
+    waiters.push_back(new waiter(
+          listener.native_handle(), exclusive, total_accepted));
+    run_waiter f = { waiters.back() };
+    threads.create_thread(f);
+  }
+
+  // Connect in bursts, pausing between them so that the threads go back to
+  // waiting.
+  for (int i = 0; i < num_connections; ++i)
+  {
+    tcp::socket socket(io_context);
+    socket.connect(endpoint);
+    if ((i + 1) % burst == 0)
+      ::usleep(1000);
+  }
+
+  for (int i = 0; i < 10000 && total_accepted < num_connections; ++i)
+    ::usleep(1000);
+
+  for (std::size_t i = 0; i < waiters.size(); ++i)
+    waiters[i]->stop();
+  threads.join();
+
+  std::size_t wakeups = 0;
+  std::size_t spurious_wakeups = 0;
+  std::size_t context_switches = 0;
+  for (std::size_t i = 0; i < waiters.size(); ++i)
+  {
+    wakeups += waiters[i]->wakeups();
+    spurious_wakeups += waiters[i]->spurious_wakeups();
+    context_switches += waiters[i]->context_switches();
+    delete waiters[i];
+  }
+
+  std::printf("%s\n", exclusive ? "exclusive" : "shared");
+  std::printf("  accepted\t%ld\n", static_cast<long>(total_accepted));
+  std::printf("  wakeups\t%u\n", static_cast<unsigned>(wakeups));
+  std::printf("  spurious\t%u\n", static_cast<unsigned>(spurious_wakeups));
+  std::printf("  switches\t%u\n", static_cast<unsigned>(context_switches));
+  std::printf("  switches per connection\t%f\n",
+      static_cast<double>(context_switches) / num_connections);
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 4)
+  {
+    std::fprintf(stderr,
+        "Usage: accept_wake <nthreads> <nconnections> <burst>\n");
+    return 1;
+  }
+
+  int num_threads = std::atoi(argv[1]);
+  int num_connections = std::atoi(argv[2]);
+  int burst = std::atoi(argv[3]);
+
+  run_test(num_threads, num_connections, burst, false);
+  run_test(num_threads, num_connections, burst, true);
+}
@@ -0,0 +1,141 @@
+//
+// buffer_search.cpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/buffers_iterator.hpp>
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/detail/buffer_search.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "high_res_clock.hpp"
+
+typedef std::vector<boost::asio::const_buffer> buffer_sequence;
+typedef boost::asio::buffers_iterator<buffer_sequence> iterator;
+
+const int num_samples = 1000;
+
+// Count the delimited lines using the byte-wise iterator search. As in
+// read_until, each search restarts from an offset into the sequence.
+std::size_t bytewise_lines(const buffer_sequence& buffers,
+    const std::string& delim)
+{
+  std::size_t lines = 0;
+  std::size_t pos = 0;
+  for (;;)
+  {
+    iterator begin = iterator::begin(buffers);
+    iterator start_pos = begin + pos;
+    iterator end = iterator::end(buffers);
+    if (delim.length() == 1)
+    {
+      iterator iter = std::find(start_pos, end, delim[0]);
+      if (iter == end)
+        return lines;
+      pos = iter - begin;
+    }
+    else
+    {
+      std::pair<iterator, bool> result =
+        boost::asio::detail::partial_search(
+            start_pos, end, delim.begin(), delim.end());
+      if (!result.second)
+        return lines;
+      pos = result.first - begin;
+    }
+    ++lines;
+    pos += delim.length();
+  }
+}
+
+// Count the delimited lines using the segment-wise search.
+std::size_t segmented_lines(const buffer_sequence& buffers,
+    const std::string& delim)
+{
+  std::size_t lines = 0;
+  std::size_t pos = 0;
+  for (;;)
+  {
+    std::pair<std::size_t, bool> result = boost::asio::detail::buffer_search(
+        buffers, pos, delim.data(), delim.length());
+    if (!result.second)
+      return lines;
+    ++lines;
+    pos = result.first + delim.length();
+  }
+}
+
+template <typename Function>
+boost::uint64_t time_search(Function f, const buffer_sequence& buffers,
+    const std::string& delim, std::size_t& lines)
+{
+  boost::uint64_t best = ~boost::uint64_t(0);
+  for (int i = 0; i < num_samples; ++i)
+  {
+    boost::uint64_t t = high_res_clock();
+    lines = f(buffers, delim);
+    t = high_res_clock() - t;
+    best = (std::min)(best, t);
+  }
+  return best;
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 4)
+  {
+    std::fprintf(stderr,
+        "Usage: buffer_search <linelen> <segsize> {lf|crlf}\n");
+    return 1;
+  }
+
+  std::size_t line_length = static_cast<std::size_t>(std::atoi(argv[1]));
+  std::size_t segment_size = static_cast<std::size_t>(std::atoi(argv[2]));
+  std::string delim = (std::strcmp(argv[3], "crlf") == 0) ? "\r\n" : "\n";
+
+  // Build 1MB of lines and split them across segments of the given size.
+  std::string data;
+  while (data.size() < 1024 * 1024)
+  {
+    data.append(line_length, 'x');
+    data.append(delim);
+  }
+
+  buffer_sequence buffers;
+  for (std::size_t pos = 0; pos < data.size(); pos += segment_size)
+  {
+    buffers.push_back(boost::asio::buffer(data.data() + pos,
+          (std::min)(segment_size, data.size() - pos)));
+  }
+
+  std::size_t bytewise_count = 0;
+  boost::uint64_t bytewise_time = time_search(
+      bytewise_lines, buffers, delim, bytewise_count);
+
+  std::size_t segmented_count = 0;
+  boost::uint64_t segmented_time = time_search(
+      segmented_lines, buffers, delim, segmented_count);
+
+  if (bytewise_count != segmented_count)
+  {
+    std::fprintf(stderr, "Line counts differ: %u != %u\n",
+        static_cast<unsigned>(bytewise_count),
+        static_cast<unsigned>(segmented_count));
+    return 1;
+  }
+
+  std::printf("  lines\t%u\n", static_cast<unsigned>(segmented_count));
+  std::printf("  bytewise\t%f\n", static_cast<double>(bytewise_time));
+  std::printf("  segmented\t%f\n", static_cast<double>(segmented_time));
+  std::printf("  speedup\t%f\n", 1.0 * bytewise_time / segmented_time);
+}
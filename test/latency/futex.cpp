@@ -0,0 +1,174 @@
+//
+// futex.cpp
+// ~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Measures the cost of the futex-based mutex and event used by the scheduler,
+// comparing them with the POSIX threads primitives that they replace.
+//
+// The uncontended test locks and unlocks the mutex from a single thread. The
+// contended test has two threads repeatedly lock and unlock the same mutex.
+// The handoff test has two threads take turns, each signalling an event on
+// which the other waits, and reports the time per round trip.
+
+#include <boost/asio/detail/config.hpp>
+#include <cstdio>
+#include <cstdlib>
+
+#if defined(BOOST_ASIO_HAS_FUTEX) && defined(BOOST_ASIO_HAS_PTHREADS)
+
+#include <boost/asio/detail/futex_event.hpp>
+#include <boost/asio/detail/futex_mutex.hpp>
+#include <boost/asio/detail/posix_event.hpp>
+#include <boost/asio/detail/posix_mutex.hpp>
+#include <boost/asio/detail/thread.hpp>
+#include <algorithm>
+#include "high_res_clock.hpp"
+
+const int num_samples = 10;
+
+template <typename Mutex>
+struct lock_loop
+{
+  Mutex* mutex_;
+  int n_;
+  int* counter_;
+
+  void operator()()
+  {
+    for (int i = 0; i < n_; ++i)
+    {
+      typename Mutex::scoped_lock lock(*mutex_);
+      ++*counter_;
+    }
+  }
+};
+
+template <typename Mutex, typename Event>
+struct handoff
+{
+  Mutex* mutex_;
+  Event* events_;
+  int* turn_;
+  int self_;
+  int n_;
+
+  void operator()()
+  {
+    typename Mutex::scoped_lock lock(*mutex_);
+    for (int i = 0; i < n_; ++i)
+    {
+      while (*turn_ != self_)
+      {
+        events_[self_].wait(lock);
+        events_[self_].clear(lock);
+      }
+      *turn_ = 1 - self_;
+      events_[1 - self_].unlock_and_signal_one(lock);
+      lock.lock();
+    }
+  }
+};
+
+void no_op()
+{
+}
+
+template <typename Mutex>
+void uncontended(int n)
+{
+  Mutex mutex;
+  int counter = 0;
+  lock_loop<Mutex> loop = { &mutex, n, &counter };
+  loop();
+}
+
+template <typename Mutex>
+void contended(int n)
+{
+  Mutex mutex;
+  int counter = 0;
+  lock_loop<Mutex> loop = { &mutex, n / 2, &counter };
+  boost::asio::detail::thread t(loop);
+  loop();
+  t.join();
+}
+
+template <typename Mutex, typename Event>
+void round_trip(int n)
+{
+  Mutex mutex;
+  Event events[2];
+  int turn = 0;
+  handoff<Mutex, Event> h0 = { &mutex, events, &turn, 0, n / 2 };
+  handoff<Mutex, Event> h1 = { &mutex, events, &turn, 1, n / 2 };
+  boost::asio::detail::thread t(h1);
+  h0();
+  t.join();
+}
+
+double time_per_op(void (*f)(int), int n)
+{
+  boost::uint64_t best = ~boost::uint64_t(0);
+  for (int i = 0; i < num_samples; ++i)
+  {
+    boost::uint64_t t = high_res_clock();
+    f(n);
+    t = high_res_clock() - t;
+    best = (std::min)(best, t);
+  }
+  return static_cast<double>(best) / n;
+}
+
+void run_test(const char* name,
+    void (*posix)(int), void (*futex)(int), int n)
+{
+  double posix_time = time_per_op(posix, n);
+  double futex_time = time_per_op(futex, n);
+  std::printf("%s\n", name);
+  std::printf("  pthread\t%f\n", posix_time);
+  std::printf("  futex\t%f\n", futex_time);
+  std::printf("  speedup\t%f\n", posix_time / futex_time);
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 2)
+  {
+    std::fprintf(stderr, "Usage: futex <nops>\n");
+    return 1;
+  }
+
+  using boost::asio::detail::futex_event;
+  using boost::asio::detail::futex_mutex;
+  using boost::asio::detail::posix_event;
+  using boost::asio::detail::posix_mutex;
+
+  int n = std::atoi(argv[1]);
+
+  // The C library may use cheaper non-atomic locking until the process has
+  // created a thread, which the scheduler's users always will have.
+  boost::asio::detail::thread(no_op).join();
+
+  run_test("uncontended",
+      uncontended<posix_mutex>, uncontended<futex_mutex>, n);
+  run_test("contended",
+      contended<posix_mutex>, contended<futex_mutex>, n);
+  run_test("handoff",
+      round_trip<posix_mutex, posix_event>,
+      round_trip<futex_mutex, futex_event>, n / 10);
+}
+
+#else // defined(BOOST_ASIO_HAS_FUTEX) && defined(BOOST_ASIO_HAS_PTHREADS)
+
+int main()
+{
+  std::printf("The futex primitives are not supported on this platform.\n");
+}
+
+#endif // defined(BOOST_ASIO_HAS_FUTEX) && defined(BOOST_ASIO_HAS_PTHREADS)
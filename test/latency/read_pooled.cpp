@@ -0,0 +1,114 @@
+//
+// read_pooled.cpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Measures the cost of a read made with async_read_pooled, comparing it with
+// async_read_some into a buffer held for the duration of the operation.
+//
+// Each read waits for a single byte written to a local socket. Both kinds of
+// read make the same wait and receive system calls, so any difference is the
+// cost of the pooled read's own work, including any system calls it makes to
+// change the socket's mode.
+
+#include <boost/asio/detail/config.hpp>
+#include <cstdio>
+#include <cstdlib>
+
+#if defined(BOOST_ASIO_HAS_MOVE) && defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+#include <boost/asio/buffer_pool.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/read_pooled.hpp>
+#include <boost/asio/write.hpp>
+#include <algorithm>
+#include "high_res_clock.hpp"
+
+typedef boost::asio::local::stream_protocol::socket socket_type;
+
+const int num_samples = 10;
+
+void handle_read_some(const boost::system::error_code&, std::size_t)
+{
+}
+
+void handle_read_pooled(const boost::system::error_code&,
+    boost::asio::pooled_buffer)
+{
+}
+
+void read_some(int n)
+{
+  boost::asio::io_context ioc;
+  socket_type s1(ioc), s2(ioc);
+  boost::asio::local::connect_pair(s1, s2);
+  char data[1024];
+  for (int i = 0; i < n; ++i)
+  {
+    boost::asio::write(s2, boost::asio::buffer("x", 1));
+    s1.async_read_some(boost::asio::buffer(data), handle_read_some);
+    ioc.restart();
+    ioc.run();
+  }
+}
+
+void read_pooled(int n)
+{
+  boost::asio::io_context ioc;
+  socket_type s1(ioc), s2(ioc);
+  boost::asio::local::connect_pair(s1, s2);
+  boost::asio::buffer_pool pool(1024);
+  for (int i = 0; i < n; ++i)
+  {
+    boost::asio::write(s2, boost::asio::buffer("x", 1));
+    boost::asio::async_read_pooled(s1, pool, handle_read_pooled);
+    ioc.restart();
+    ioc.run();
+  }
+}
+
+double time_per_op(void (*f)(int), int n)
+{
+  boost::uint64_t best = ~boost::uint64_t(0);
+  for (int i = 0; i < num_samples; ++i)
+  {
+    boost::uint64_t t = high_res_clock();
+    f(n);
+    t = high_res_clock() - t;
+    best = (std::min)(best, t);
+  }
+  return static_cast<double>(best) / n;
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 2)
+  {
+    std::fprintf(stderr, "Usage: read_pooled <nops>\n");
+    return 1;
+  }
+
+  int n = std::atoi(argv[1]);
+
+  double read_some_time = time_per_op(read_some, n);
+  double read_pooled_time = time_per_op(read_pooled, n);
+  std::printf("async_read_some\t%f\n", read_some_time);
+  std::printf("async_read_pooled\t%f\n", read_pooled_time);
+  std::printf("overhead\t%f\n", read_pooled_time / read_some_time);
+}
+
+#else // defined(BOOST_ASIO_HAS_MOVE) && defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+int main()
+{
+  std::printf("Pooled reads are not supported on this platform.\n");
+}
+
+#endif // defined(BOOST_ASIO_HAS_MOVE) && defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
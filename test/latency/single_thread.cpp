@@ -0,0 +1,153 @@
+//
+// single_thread.cpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Measures the per-operation cost of an io_context that is used from a single
+// thread, comparing the default concurrency hint of 1 with the hint that
+// disables locking and atomic work counting.
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include "high_res_clock.hpp"
+
+const int num_samples = 10;
+
+struct chain_handler
+{
+  boost::asio::io_context* io_context_;
+  int* remaining_;
+
+  void operator()()
+  {
+    if (--*remaining_ > 0)
+      boost::asio::post(*io_context_, *this);
+  }
+};
+
+struct count_handler
+{
+  int* count_;
+
+  void operator()()
+  {
+    ++*count_;
+  }
+};
+
+struct timer_handler
+{
+  boost::asio::steady_timer* timer_;
+  int* remaining_;
+
+  void operator()(const boost::system::error_code&)
+  {
+    if (--*remaining_ > 0)
+    {
+      timer_->expires_at(boost::asio::steady_timer::time_point());
+      timer_->async_wait(*this);
+    }
+  }
+};
+
+// Each handler posts the next from inside the run loop.
+void post_chain(boost::asio::io_context& io_context, int n)
+{
+  int remaining = n;
+  chain_handler handler = { &io_context, &remaining };
+  boost::asio::post(io_context, handler);
+  io_context.restart();
+  io_context.run();
+}
+
+// All handlers are posted before the run loop starts.
+void post_outside(boost::asio::io_context& io_context, int n)
+{
+  int count = 0;
+  count_handler handler = { &count };
+  for (int i = 0; i < n; ++i)
+    boost::asio::post(io_context, handler);
+  io_context.restart();
+  io_context.run();
+}
+
+// Copy an executor that tracks outstanding work.
+void tracked_copies(boost::asio::io_context& io_context, int n)
+{
+  typedef boost::asio::io_context::executor_type executor_type;
+  typedef boost::asio::prefer_result<executor_type,
+    boost::asio::execution::outstanding_work_t::tracked_t>::type
+      tracked_executor_type;
+
+  tracked_executor_type ex = boost::asio::prefer(io_context.get_executor(),
+      boost::asio::execution::outstanding_work.tracked);
+  tracked_executor_type copies[16] = { ex, ex, ex, ex, ex, ex, ex, ex,
+    ex, ex, ex, ex, ex, ex, ex, ex };
+  for (int i = 0; i < n; ++i)
+    copies[i % 16] = ex;
+}
+
+// Each handler starts a wait on an expired timer.
+void timer_chain(boost::asio::io_context& io_context, int n)
+{
+  boost::asio::steady_timer timer(io_context);
+  int remaining = n;
+  timer_handler handler = { &timer, &remaining };
+  timer.expires_at(boost::asio::steady_timer::time_point());
+  timer.async_wait(handler);
+  io_context.restart();
+  io_context.run();
+}
+
+double time_per_op(void (*f)(boost::asio::io_context&, int),
+    int concurrency_hint, int n)
+{
+  boost::asio::io_context io_context(concurrency_hint);
+  f(io_context, n);
+
+  boost::uint64_t best = ~boost::uint64_t(0);
+  for (int i = 0; i < num_samples; ++i)
+  {
+    boost::uint64_t t = high_res_clock();
+    f(io_context, n);
+    t = high_res_clock() - t;
+    best = (std::min)(best, t);
+  }
+  return static_cast<double>(best) / n;
+}
+
+void run_test(const char* name,
+    void (*f)(boost::asio::io_context&, int), int n)
+{
+  double hinted = time_per_op(f, 1, n);
+  double unsafe = time_per_op(f, BOOST_ASIO_CONCURRENCY_HINT_UNSAFE, n);
+  std::printf("%s\n", name);
+  std::printf("  hint=1\t%f\n", hinted);
+  std::printf("  unsafe\t%f\n", unsafe);
+  std::printf("  speedup\t%f\n", hinted / unsafe);
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 2)
+  {
+    std::fprintf(stderr, "Usage: single_thread <nops>\n");
+    return 1;
+  }
+
+  int n = std::atoi(argv[1]);
+
+  run_test("post_chain", post_chain, n);
+  run_test("post_outside", post_outside, n);
+  run_test("tracked_copies", tracked_copies, n);
+  run_test("timer_chain", timer_chain, n / 100);
+}
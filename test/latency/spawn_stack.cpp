@@ -0,0 +1,103 @@
+//
+// spawn_stack.cpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Measures the cost of creating, entering and destroying a stackful coroutine
+// that uses part of its stack, comparing the stack pool used by spawn() with
+// the default Boost.Coroutine stack allocator, which uses the heap, and the
+// protected stack allocator, which maps a fresh stack with a guard page.
+
+#include <boost/asio/spawn.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "high_res_clock.hpp"
+
+#if defined(BOOST_ASIO_HAS_SPAWN_STACK_POOL)
+
+#include <alloca.h>
+
+typedef boost::coroutines::coroutine<void>::pull_type coroutine_type;
+
+const int num_samples = 10;
+
+struct stack_toucher
+{
+  std::size_t depth_;
+
+  void operator()(boost::coroutines::coroutine<void>::push_type&)
+  {
+    // Dirty the given amount of stack, as a handler call chain would.
+    char* buffer = static_cast<char*>(alloca(depth_));
+    std::memset(buffer, 1, depth_);
+    volatile char sink = buffer[depth_ - 1];
+    (void)sink;
+  }
+};
+
+template <typename StackAllocator>
+double time_per_coroutine(std::size_t stack_size, std::size_t depth, int n)
+{
+  boost::coroutines::attributes attributes(stack_size);
+  stack_toucher toucher = { depth };
+
+  boost::uint64_t best = ~boost::uint64_t(0);
+  for (int i = 0; i < num_samples; ++i)
+  {
+    boost::uint64_t t = high_res_clock();
+    for (int j = 0; j < n; ++j)
+      coroutine_type coro(toucher, attributes, StackAllocator());
+    t = high_res_clock() - t;
+    best = (std::min)(best, t);
+  }
+  return static_cast<double>(best) / n;
+}
+
+void run_test(std::size_t stack_size, std::size_t depth, int n)
+{
+  double standard = time_per_coroutine<
+    boost::coroutines::standard_stack_allocator>(stack_size, depth, n);
+  double protected_ = time_per_coroutine<
+    boost::coroutines::protected_stack_allocator>(stack_size, depth, n);
+  double pooled = time_per_coroutine<
+    boost::asio::detail::spawn_stack_allocator>(stack_size, depth, n);
+  std::printf("stack=%lu touched=%lu\n",
+      static_cast<unsigned long>(stack_size),
+      static_cast<unsigned long>(depth));
+  std::printf("  standard\t%f\n", standard);
+  std::printf("  protected\t%f\n", protected_);
+  std::printf("  pooled\t%f\n", pooled);
+  std::printf("  speedup\t%f (standard)\t%f (protected)\n",
+      standard / pooled, protected_ / pooled);
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 2)
+  {
+    std::fprintf(stderr, "Usage: spawn_stack <ncoroutines>\n");
+    return 1;
+  }
+
+  int n = std::atoi(argv[1]);
+
+  run_test(64 * 1024, 4 * 1024, n);
+  run_test(64 * 1024, 32 * 1024, n);
+  run_test(256 * 1024, 128 * 1024, n);
+}
+
+#else // defined(BOOST_ASIO_HAS_SPAWN_STACK_POOL)
+
+int main()
+{
+  std::printf("The spawn stack pool is not supported on this platform.\n");
+}
+
+#endif // defined(BOOST_ASIO_HAS_SPAWN_STACK_POOL)
@@ -20,6 +20,7 @@
 #include "archetypes/async_result.hpp"
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/post.hpp>
+#include <boost/asio/segmented_buffer.hpp>
 #include <boost/asio/streambuf.hpp>
 #include "unit_test.hpp"
 
@@ -487,6 +488,46 @@ namespace asio {
 } // namespace asio
 } // namespace boost
 
+void test_dynamic_string_read_until_long_data()
+{
+  boost::asio::io_context ioc;
+  test_stream s(ioc);
+  std::string data;
+  boost::asio::dynamic_string_buffer<char, std::string::traits_type,
+    std::string::allocator_type> sb = boost::asio::dynamic_buffer(data);
+  boost::system::error_code ec;
+
+  // Long runs of near-matches exercise the vectorised search paths.
+  std::string long_data(1000, '\r');
+  long_data.replace(997, 3, "\r\n\n");
+
+  static const std::size_t read_lengths[] = { 1, 7, 16, 31, 33, 1000 };
+  for (std::size_t i = 0;
+      i < sizeof(read_lengths) / sizeof(read_lengths[0]); ++i)
+  {
+    s.reset(long_data.data(), long_data.size());
+    s.next_read_length(read_lengths[i]);
+    sb.consume(sb.size());
+    std::size_t length = boost::asio::read_until(s, sb, '\n', ec);
+    BOOST_ASIO_CHECK(!ec);
+    BOOST_ASIO_CHECK(length == 999);
+
+    s.reset(long_data.data(), long_data.size());
+    s.next_read_length(read_lengths[i]);
+    sb.consume(sb.size());
+    length = boost::asio::read_until(s, sb, "\r\n", ec);
+    BOOST_ASIO_CHECK(!ec);
+    BOOST_ASIO_CHECK(length == 999);
+
+    s.reset(long_data.data(), long_data.size());
+    s.next_read_length(read_lengths[i]);
+    sb.consume(sb.size());
+    length = boost::asio::read_until(s, sb, "\r\r\n\n", ec);
+    BOOST_ASIO_CHECK(!ec);
+    BOOST_ASIO_CHECK(length == 1000);
+  }
+}
+
 void test_dynamic_string_read_until_match_condition()
 {
   boost::asio::io_context ioc;
@@ -673,6 +714,92 @@ void async_read_handler(
   *called = true;
 }
 
+void test_segmented_read_until_boundary()
+{
+#if defined(BOOST_ASIO_HAS_BOOST_BIND)
+  namespace bindns = boost;
+#else // defined(BOOST_ASIO_HAS_BOOST_BIND)
+  namespace bindns = std;
+#endif // defined(BOOST_ASIO_HAS_BOOST_BIND)
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  boost::asio::io_context ioc;
+  test_stream s(ioc);
+  boost::system::error_code ec;
+  std::size_t length;
+  bool called;
+
+  // The segmented buffer's data is a sequence of many small buffers. Place
+  // the delimiter at every offset relative to the segment boundaries, after
+  // filler made of partial matches.
+  static const char* delims[] = { "\n", "\r\n", "\r\n\r\n", "abcdefgh" };
+  static const std::size_t segment_sizes[] = { 1, 3, 7, 16 };
+  for (std::size_t i = 0; i < sizeof(delims) / sizeof(delims[0]); ++i)
+  {
+    std::string delim(delims[i]);
+    std::string partial = delim.size() > 1
+      ? delim.substr(0, delim.size() - 1) : std::string("x");
+
+    for (std::size_t j = 0;
+        j < sizeof(segment_sizes) / sizeof(segment_sizes[0]); ++j)
+    {
+      for (std::size_t pos = 0;
+          pos < 2 * segment_sizes[j] + delim.size(); ++pos)
+      {
+        std::string data;
+        while (data.size() < pos)
+          data += partial;
+        data.resize(pos);
+        data += delim;
+        data += "tail";
+        std::size_t expected = data.find(delim) + delim.size();
+
+        boost::asio::segmented_buffer b(8192, segment_sizes[j]);
+        s.reset(data.data(), data.size());
+        length = boost::asio::read_until(s,
+            boost::asio::dynamic_buffer(b), delim, ec);
+        BOOST_ASIO_CHECK(!ec);
+        BOOST_ASIO_CHECK(length == expected);
+
+        b.consume(b.size());
+        s.reset(data.data(), data.size());
+        s.next_read_length(1);
+        length = boost::asio::read_until(s,
+            boost::asio::dynamic_buffer(b), delim, ec);
+        BOOST_ASIO_CHECK(!ec);
+        BOOST_ASIO_CHECK(length == expected);
+
+        if (delim.size() == 1)
+        {
+          b.consume(b.size());
+          s.reset(data.data(), data.size());
+          s.next_read_length(1);
+          length = boost::asio::read_until(s,
+              boost::asio::dynamic_buffer(b), delim[0], ec);
+          BOOST_ASIO_CHECK(!ec);
+          BOOST_ASIO_CHECK(length == expected);
+        }
+
+        b.consume(b.size());
+        s.reset(data.data(), data.size());
+        s.next_read_length(1);
+        ec = boost::system::error_code();
+        length = 0;
+        called = false;
+        boost::asio::async_read_until(s, boost::asio::dynamic_buffer(b),
+            delim, bindns::bind(async_read_handler, _1, &ec,
+              _2, &length, &called));
+        ioc.restart();
+        ioc.run();
+        BOOST_ASIO_CHECK(called);
+        BOOST_ASIO_CHECK(!ec);
+        BOOST_ASIO_CHECK(length == expected);
+      }
+    }
+  }
+}
+
 void test_dynamic_string_async_read_until_char()
 {
 #if defined(BOOST_ASIO_HAS_BOOST_BIND)
@@ -1649,6 +1776,8 @@ BOOST_ASIO_TEST_SUITE
   BOOST_ASIO_TEST_CASE(test_streambuf_read_until_char)
   BOOST_ASIO_TEST_CASE(test_dynamic_string_read_until_string)
   BOOST_ASIO_TEST_CASE(test_streambuf_read_until_string)
+  BOOST_ASIO_TEST_CASE(test_dynamic_string_read_until_long_data)
+  BOOST_ASIO_TEST_CASE(test_segmented_read_until_boundary)
   BOOST_ASIO_TEST_CASE(test_dynamic_string_read_until_match_condition)
   BOOST_ASIO_TEST_CASE(test_streambuf_read_until_match_condition)
   BOOST_ASIO_TEST_CASE(test_dynamic_string_async_read_until_char)
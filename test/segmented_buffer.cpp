@@ -0,0 +1,372 @@
+//
+// segmented_buffer.cpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/segmented_buffer.hpp>
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <boost/asio/buffers_iterator.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/write.hpp>
+#include "unit_test.hpp"
+
+#if defined(BOOST_ASIO_HAS_BOOST_BIND)
+# include <boost/bind/bind.hpp>
+#else // defined(BOOST_ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(BOOST_ASIO_HAS_BOOST_BIND)
+
+class test_stream
+{
+public:
+  typedef boost::asio::io_context::executor_type executor_type;
+
+  test_stream(boost::asio::io_context& io_context)
+    : io_context_(io_context),
+      length_(0),
+      position_(0),
+      next_length_(max_length)
+  {
+  }
+
+  executor_type get_executor() BOOST_ASIO_NOEXCEPT
+  {
+    return io_context_.get_executor();
+  }
+
+  void reset(const void* data, size_t length)
+  {
+    using namespace std; // For memcpy.
+
+    BOOST_ASIO_CHECK(length <= max_length);
+
+    memcpy(data_, data, length);
+    length_ = length;
+    position_ = 0;
+  }
+
+  void next_length(size_t length)
+  {
+    next_length_ = length;
+  }
+
+  bool check_buffers(const void* data, size_t length)
+  {
+    using namespace std; // For memcmp.
+    return length == position_ && memcmp(data, data_, length) == 0;
+  }
+
+  template <typename Mutable_Buffers>
+  size_t read_some(const Mutable_Buffers& buffers,
+      boost::system::error_code& ec)
+  {
+    size_t n = boost::asio::buffer_copy(buffers,
+        boost::asio::buffer(data_, length_) + position_,
+        next_length_);
+    position_ += n;
+    ec = n == 0 ? boost::asio::error::eof : boost::system::error_code();
+    return n;
+  }
+
+  template <typename Mutable_Buffers, typename Handler>
+  void async_read_some(const Mutable_Buffers& buffers, Handler handler)
+  {
+    boost::system::error_code ec;
+    size_t bytes_transferred = read_some(buffers, ec);
+    boost::asio::post(get_executor(),
+        boost::asio::detail::bind_handler(
+          BOOST_ASIO_MOVE_CAST(Handler)(handler),
+          ec, bytes_transferred));
+  }
+
+  template <typename Const_Buffers>
+  size_t write_some(const Const_Buffers& buffers,
+      boost::system::error_code& ec)
+  {
+    size_t n = boost::asio::buffer_copy(
+        boost::asio::buffer(data_) + position_,
+        buffers, next_length_);
+    position_ += n;
+    ec = boost::system::error_code();
+    return n;
+  }
+
+  template <typename Const_Buffers, typename Handler>
+  void async_write_some(const Const_Buffers& buffers, Handler handler)
+  {
+    boost::system::error_code ec;
+    size_t bytes_transferred = write_some(buffers, ec);
+    boost::asio::post(get_executor(),
+        boost::asio::detail::bind_handler(
+          BOOST_ASIO_MOVE_CAST(Handler)(handler),
+          ec, bytes_transferred));
+  }
+
+private:
+  boost::asio::io_context& io_context_;
+  enum { max_length = 8192 };
+  char data_[max_length];
+  size_t length_;
+  size_t position_;
+  size_t next_length_;
+};
+
+// Copy the input sequence into a string.
+std::string contents(const boost::asio::segmented_buffer& b)
+{
+  typedef boost::asio::segmented_buffer::const_buffers_type buffers_type;
+  buffers_type bufs = b.data();
+  return std::string(boost::asio::buffers_begin(bufs),
+      boost::asio::buffers_end(bufs));
+}
+
+void test_prepare_commit_consume()
+{
+  boost::asio::segmented_buffer b(64, 8);
+  BOOST_ASIO_CHECK(b.size() == 0);
+  BOOST_ASIO_CHECK(b.capacity() == 0);
+  BOOST_ASIO_CHECK(b.segment_size() == 8);
+
+  // A prepared sequence has one element per segment.
+  boost::asio::segmented_buffer::mutable_buffers_type out = b.prepare(20);
+  BOOST_ASIO_CHECK(boost::asio::buffer_size(out) == 20);
+  BOOST_ASIO_CHECK(std::distance(out.begin(), out.end()) == 3);
+  BOOST_ASIO_CHECK(b.capacity() == 24);
+  boost::asio::buffer_copy(out,
+      boost::asio::buffer("0123456789abcdefghij", 20));
+  b.commit(15);
+  BOOST_ASIO_CHECK(b.size() == 15);
+  BOOST_ASIO_CHECK(contents(b) == "0123456789abcde");
+
+  // Consuming part of a segment leaves the remainder in place.
+  b.consume(3);
+  BOOST_ASIO_CHECK(b.size() == 12);
+  BOOST_ASIO_CHECK(contents(b) == "3456789abcde");
+  boost::asio::segmented_buffer::const_buffers_type in = b.data();
+  BOOST_ASIO_CHECK(std::distance(in.begin(), in.end()) == 2);
+  BOOST_ASIO_CHECK((*in.begin()).size() == 5);
+
+  // Iterators can be walked backwards from the end.
+  boost::asio::segmented_buffer::const_buffers_type::const_iterator
+    iter = in.end();
+  --iter;
+  BOOST_ASIO_CHECK((*iter).size() == 7);
+  --iter;
+  BOOST_ASIO_CHECK(iter == in.begin());
+
+  // Appending data does not move existing data.
+  const void* first = (*b.data().begin()).data();
+  out = b.prepare(30);
+  boost::asio::buffer_copy(out, boost::asio::buffer(std::string(30, 'x')));
+  b.commit(30);
+  BOOST_ASIO_CHECK(b.size() == 42);
+  BOOST_ASIO_CHECK((*b.data().begin()).data() == first);
+  BOOST_ASIO_CHECK(contents(b) == "3456789abcde" + std::string(30, 'x'));
+
+  // Segments released by consume are reused by later operations.
+  b.consume(b.size());
+  BOOST_ASIO_CHECK(b.size() == 0);
+  std::size_t capacity = b.capacity();
+  BOOST_ASIO_CHECK(capacity == 48);
+  out = b.prepare(40);
+  BOOST_ASIO_CHECK(boost::asio::buffer_size(out) == 40);
+  BOOST_ASIO_CHECK(b.capacity() == capacity);
+  b.commit(0);
+
+  b.shrink_to_fit();
+  BOOST_ASIO_CHECK(b.capacity() == 0);
+
+  bool thrown = false;
+  try
+  {
+    b.prepare(65);
+  }
+  catch (std::length_error&)
+  {
+    thrown = true;
+  }
+  BOOST_ASIO_CHECK(thrown);
+}
+
+void test_grow_shrink()
+{
+  // The templates' allocator defaults to std::allocator<char>.
+  boost::asio::basic_segmented_buffer<> b(64, 8);
+  boost::asio::dynamic_segmented_buffer<> db = boost::asio::dynamic_buffer(b);
+
+  db.grow(10);
+  boost::asio::buffer_copy(db.data(0, 10),
+      boost::asio::buffer("0123456789", 10));
+  BOOST_ASIO_CHECK(db.size() == 10);
+  BOOST_ASIO_CHECK(contents(b) == "0123456789");
+
+  db.grow(10);
+  boost::asio::buffer_copy(db.data(10, 10),
+      boost::asio::buffer("abcdefghij", 10));
+  db.shrink(4);
+  BOOST_ASIO_CHECK(contents(b) == "0123456789abcdef");
+
+  db.consume(9);
+  BOOST_ASIO_CHECK(contents(b) == "9abcdef");
+
+  const boost::asio::dynamic_segmented_buffer<
+    std::allocator<char> >& cdb = db;
+  boost::asio::segmented_buffer::const_buffers_type part = cdb.data(2, 100);
+  BOOST_ASIO_CHECK(boost::asio::buffer_size(part) == 5);
+  BOOST_ASIO_CHECK(std::string(boost::asio::buffers_begin(part),
+        boost::asio::buffers_end(part)) == "bcdef");
+
+  db.shrink(100);
+  BOOST_ASIO_CHECK(db.size() == 0);
+}
+
+static const char read_data[]
+  = "ABCDEFGHIJKLMNOPQRSTUVWXYZ\r\nabcdefghijklmnopqrstuvwxyz\r\n";
+
+void test_read()
+{
+  boost::asio::io_context ioc;
+  test_stream s(ioc);
+  boost::asio::segmented_buffer b(1024, 16);
+  boost::system::error_code ec;
+
+  static const std::size_t read_lengths[] = { 1, 7, 16, sizeof(read_data) };
+  for (std::size_t i = 0;
+      i < sizeof(read_lengths) / sizeof(read_lengths[0]); ++i)
+  {
+    s.reset(read_data, sizeof(read_data) - 1);
+    s.next_length(read_lengths[i]);
+    b.consume(b.size());
+
+    std::size_t length = boost::asio::read_until(s,
+        boost::asio::dynamic_buffer(b), "\r\n", ec);
+    BOOST_ASIO_CHECK(!ec);
+    BOOST_ASIO_CHECK(length == 28);
+    b.consume(length);
+
+    length = boost::asio::read_until(s,
+        boost::asio::dynamic_buffer(b), '\n', ec);
+    BOOST_ASIO_CHECK(!ec);
+    BOOST_ASIO_CHECK(length == 28);
+    BOOST_ASIO_CHECK(contents(b).substr(0, length) == read_data + 28);
+    b.consume(length);
+
+    s.reset(read_data, sizeof(read_data) - 1);
+    s.next_length(read_lengths[i]);
+    length = boost::asio::read(s, boost::asio::dynamic_buffer(b), ec);
+    BOOST_ASIO_CHECK(ec == boost::asio::error::eof);
+    BOOST_ASIO_CHECK(length == sizeof(read_data) - 1);
+    BOOST_ASIO_CHECK(contents(b) == read_data);
+  }
+}
+
+void test_write()
+{
+  boost::asio::io_context ioc;
+  test_stream s(ioc);
+  boost::asio::segmented_buffer b(1024, 16);
+  boost::system::error_code ec;
+
+  boost::asio::buffer_copy(b.prepare(sizeof(read_data) - 1),
+      boost::asio::buffer(read_data, sizeof(read_data) - 1));
+  b.commit(sizeof(read_data) - 1);
+
+  s.reset(0, 0);
+  s.next_length(5);
+  std::size_t length = boost::asio::write(s, b.data(), ec);
+  BOOST_ASIO_CHECK(!ec);
+  BOOST_ASIO_CHECK(length == sizeof(read_data) - 1);
+  BOOST_ASIO_CHECK(s.check_buffers(read_data, sizeof(read_data) - 1));
+
+  s.reset(0, 0);
+  length = boost::asio::write(s, boost::asio::dynamic_buffer(b), ec);
+  BOOST_ASIO_CHECK(!ec);
+  BOOST_ASIO_CHECK(length == sizeof(read_data) - 1);
+  BOOST_ASIO_CHECK(s.check_buffers(read_data, sizeof(read_data) - 1));
+  BOOST_ASIO_CHECK(b.size() == 0);
+}
+
+void async_handler(const boost::system::error_code& err,
+    boost::system::error_code* err_out, std::size_t bytes_transferred,
+    std::size_t* bytes_out, bool* called)
+{
+  *err_out = err;
+  *bytes_out = bytes_transferred;
+  *called = true;
+}
+
+void test_async_read_write()
+{
+#if defined(BOOST_ASIO_HAS_BOOST_BIND)
+  namespace bindns = boost;
+#else // defined(BOOST_ASIO_HAS_BOOST_BIND)
+  namespace bindns = std;
+#endif // defined(BOOST_ASIO_HAS_BOOST_BIND)
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  boost::asio::io_context ioc;
+  test_stream s(ioc);
+  boost::asio::segmented_buffer b(1024, 16);
+  boost::system::error_code ec;
+  std::size_t length = 0;
+  bool called = false;
+
+  s.reset(read_data, sizeof(read_data) - 1);
+  s.next_length(7);
+  boost::asio::async_read_until(s, boost::asio::dynamic_buffer(b), "\r\n",
+      bindns::bind(async_handler, _1, &ec, _2, &length, &called));
+  ioc.run();
+  BOOST_ASIO_CHECK(called);
+  BOOST_ASIO_CHECK(!ec);
+  BOOST_ASIO_CHECK(length == 28);
+
+  called = false;
+  boost::asio::async_read(s, boost::asio::dynamic_buffer(b),
+      bindns::bind(async_handler, _1, &ec, _2, &length, &called));
+  ioc.restart();
+  ioc.run();
+  BOOST_ASIO_CHECK(called);
+  BOOST_ASIO_CHECK(ec == boost::asio::error::eof);
+  BOOST_ASIO_CHECK(contents(b) == read_data);
+
+  s.reset(0, 0);
+  s.next_length(5);
+  called = false;
+  boost::asio::async_write(s, boost::asio::dynamic_buffer(b),
+      bindns::bind(async_handler, _1, &ec, _2, &length, &called));
+  ioc.restart();
+  ioc.run();
+  BOOST_ASIO_CHECK(called);
+  BOOST_ASIO_CHECK(!ec);
+  BOOST_ASIO_CHECK(length == sizeof(read_data) - 1);
+  BOOST_ASIO_CHECK(s.check_buffers(read_data, sizeof(read_data) - 1));
+  BOOST_ASIO_CHECK(b.size() == 0);
+}
+
+BOOST_ASIO_TEST_SUITE
+(
+  "segmented_buffer",
+  BOOST_ASIO_TEST_CASE(test_prepare_commit_consume)
+  BOOST_ASIO_TEST_CASE(test_grow_shrink)
+  BOOST_ASIO_TEST_CASE(test_read)
+  BOOST_ASIO_TEST_CASE(test_write)
+  BOOST_ASIO_TEST_CASE(test_async_read_write)
+)
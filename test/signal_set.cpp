@@ -88,8 +88,97 @@ void test()
 
 //------------------------------------------------------------------------------
 
+// signal_set_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the signal_set class.
+
+namespace signal_set_runtime {
+
+#if !defined(BOOST_ASIO_WINDOWS)
+
+struct signal_handler
+{
+  int* signals_;
+  int* count_;
+
+  void operator()(const boost::system::error_code& err, int signal_number)
+  {
+    BOOST_ASIO_CHECK(!err);
+    signals_[(*count_)++] = signal_number;
+  }
+};
+
+void test()
+{
+  using namespace boost::asio;
+
+#if defined(BOOST_ASIO_HAS_SIGNALFD)
+  // Signals are received through signalfd only while they are blocked.
+  sigset_t mask;
+  sigemptyset(&mask);
+  sigaddset(&mask, SIGUSR1);
+  sigaddset(&mask, SIGUSR2);
+  sigset_t old_mask;
+  pthread_sigmask(SIG_BLOCK, &mask, &old_mask);
+#endif // defined(BOOST_ASIO_HAS_SIGNALFD)
+
+  io_context ioc;
+  signal_set set(ioc, SIGUSR1, SIGUSR2);
+
+  int signals[3] = { 0, 0, 0 };
+  int count = 0;
+  signal_handler handler = { signals, &count };
+
+  set.async_wait(handler);
+  ::raise(SIGUSR2);
+
+  ioc.run();
+
+  BOOST_ASIO_CHECK(count == 1);
+  BOOST_ASIO_CHECK(signals[0] == SIGUSR2);
+
+  // A signal that occurs with no waiting handler is queued until the next
+  // wait.
+  set.async_wait(handler);
+  ::raise(SIGUSR1);
+  ::raise(SIGUSR2);
+
+  ioc.restart();
+  ioc.run();
+
+  BOOST_ASIO_CHECK(count == 2);
+
+  set.async_wait(handler);
+
+  ioc.restart();
+  ioc.run();
+
+  BOOST_ASIO_CHECK(count == 3);
+  BOOST_ASIO_CHECK(signals[1] + signals[2] == SIGUSR1 + SIGUSR2);
+  BOOST_ASIO_CHECK(signals[1] != signals[2]);
+
+  set.clear();
+
+#if defined(BOOST_ASIO_HAS_SIGNALFD)
+  pthread_sigmask(SIG_SETMASK, &old_mask, 0);
+#endif // defined(BOOST_ASIO_HAS_SIGNALFD)
+}
+
+#else // !defined(BOOST_ASIO_WINDOWS)
+
+void test()
+{
+}
+
+#endif // !defined(BOOST_ASIO_WINDOWS)
+
+} // namespace signal_set_runtime
+
+//------------------------------------------------------------------------------
+
 BOOST_ASIO_TEST_SUITE
 (
   "signal_set",
   BOOST_ASIO_TEST_CASE(signal_set_compile::test)
+  BOOST_ASIO_TEST_CASE(signal_set_runtime::test)
 )
@@ -177,6 +177,17 @@ void test()
     (void)static_cast<bool>(!enable_connection_aborted1);
     (void)static_cast<bool>(enable_connection_aborted1.value());
 
+    // exclusive_wake class.
+
+    socket_base::exclusive_wake exclusive_wake1(true);
+    sock.set_option(exclusive_wake1);
+    socket_base::exclusive_wake exclusive_wake2;
+    sock.get_option(exclusive_wake2);
+    exclusive_wake1 = true;
+    (void)static_cast<bool>(exclusive_wake1);
+    (void)static_cast<bool>(!exclusive_wake1);
+    (void)static_cast<bool>(exclusive_wake1.value());
+
     // bytes_readable class.
 
     socket_base::bytes_readable bytes_readable;
@@ -631,6 +642,40 @@ void test()
   BOOST_ASIO_CHECK(!static_cast<bool>(enable_connection_aborted4));
   BOOST_ASIO_CHECK(!enable_connection_aborted4);
 
+  // exclusive_wake class.
+
+  socket_base::exclusive_wake exclusive_wake1(true);
+  BOOST_ASIO_CHECK(exclusive_wake1.value());
+  BOOST_ASIO_CHECK(static_cast<bool>(exclusive_wake1));
+  BOOST_ASIO_CHECK(!!exclusive_wake1);
+  tcp_acceptor.set_option(exclusive_wake1, ec);
+  BOOST_ASIO_CHECK_MESSAGE(!ec || ec == boost::asio::error::invalid_argument,
+      ec.value() << ", " << ec.message());
+
+  if (!ec)
+  {
+    socket_base::exclusive_wake exclusive_wake2;
+    tcp_acceptor.get_option(exclusive_wake2, ec);
+    BOOST_ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+    BOOST_ASIO_CHECK(exclusive_wake2.value());
+    BOOST_ASIO_CHECK(static_cast<bool>(exclusive_wake2));
+    BOOST_ASIO_CHECK(!!exclusive_wake2);
+  }
+
+  socket_base::exclusive_wake exclusive_wake3(false);
+  BOOST_ASIO_CHECK(!exclusive_wake3.value());
+  BOOST_ASIO_CHECK(!static_cast<bool>(exclusive_wake3));
+  BOOST_ASIO_CHECK(!exclusive_wake3);
+  tcp_acceptor.set_option(exclusive_wake3, ec);
+  BOOST_ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+
+  socket_base::exclusive_wake exclusive_wake4;
+  tcp_acceptor.get_option(exclusive_wake4, ec);
+  BOOST_ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+  BOOST_ASIO_CHECK(!exclusive_wake4.value());
+  BOOST_ASIO_CHECK(!static_cast<bool>(exclusive_wake4));
+  BOOST_ASIO_CHECK(!exclusive_wake4);
+
   // bytes_readable class.
 
   socket_base::bytes_readable bytes_readable;
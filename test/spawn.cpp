@@ -0,0 +1,170 @@
+//
+// spawn.cpp
+// ~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Keep the stack cache small so that its limit is cheap to reach.
+#define BOOST_ASIO_SPAWN_STACK_POOL_SIZE 4
+
+// Test that header file is self-contained.
+#include <boost/asio/spawn.hpp>
+
+#include "unit_test.hpp"
+
+#if defined(BOOST_ASIO_HAS_SPAWN_STACK_POOL)
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+
+using boost::asio::detail::spawn_stack_pool;
+
+struct stack_user
+{
+  int* count_;
+
+  void operator()(boost::asio::yield_context yield)
+  {
+    // Suspend, so that all coroutines spawned together are live at once.
+    boost::asio::post(yield);
+    ++*count_;
+  }
+};
+
+void spawn_stack_users(boost::asio::io_context& ioc,
+    std::size_t stack_size, int n, int* count)
+{
+  for (int i = 0; i < n; ++i)
+  {
+    stack_user user = { count };
+    boost::asio::spawn(ioc, user,
+        boost::coroutines::attributes(stack_size));
+  }
+}
+
+void test_stack_reuse()
+{
+  boost::asio::io_context ioc;
+  int count = 0;
+  const std::size_t small_size = 64 * 1024;
+  const std::size_t large_size = 256 * 1024;
+
+  // Warm up the pool with a stack of each size.
+  spawn_stack_users(ioc, small_size, 1, &count);
+  spawn_stack_users(ioc, large_size, 1, &count);
+  ioc.run();
+  BOOST_ASIO_CHECK(count == 2);
+
+  spawn_stack_pool::counters before =
+    spawn_stack_pool::instance()->get_counters();
+  BOOST_ASIO_CHECK(before.idle == 2);
+
+  // Coroutines of the same size are served from the pool.
+  for (int i = 0; i < 10; ++i)
+  {
+    spawn_stack_users(ioc, small_size, 1, &count);
+    ioc.restart();
+    ioc.run();
+  }
+  BOOST_ASIO_CHECK(count == 12);
+
+  spawn_stack_pool::counters after =
+    spawn_stack_pool::instance()->get_counters();
+  BOOST_ASIO_CHECK(after.allocations - before.allocations == 10);
+  BOOST_ASIO_CHECK(after.reuses - before.reuses == 10);
+  BOOST_ASIO_CHECK(after.deallocations - before.deallocations == 10);
+  BOOST_ASIO_CHECK(after.idle == 2);
+
+  // Two live coroutines of the small size cannot both use the single idle
+  // small stack, and the idle large stack is not used in its place.
+  before = after;
+  spawn_stack_users(ioc, small_size, 2, &count);
+  ioc.restart();
+  ioc.run();
+  BOOST_ASIO_CHECK(count == 14);
+
+  after = spawn_stack_pool::instance()->get_counters();
+  BOOST_ASIO_CHECK(after.allocations - before.allocations == 2);
+  BOOST_ASIO_CHECK(after.reuses - before.reuses == 1);
+  BOOST_ASIO_CHECK(after.idle == 3);
+
+  // The large stack is still available for a coroutine of its own size.
+  before = after;
+  spawn_stack_users(ioc, large_size, 1, &count);
+  ioc.restart();
+  ioc.run();
+  BOOST_ASIO_CHECK(count == 15);
+
+  after = spawn_stack_pool::instance()->get_counters();
+  BOOST_ASIO_CHECK(after.reuses - before.reuses == 1);
+  BOOST_ASIO_CHECK(after.idle == 3);
+}
+
+void test_stack_retention()
+{
+  boost::asio::io_context ioc;
+  int count = 0;
+  const std::size_t stack_size = 128 * 1024;
+
+  spawn_stack_pool::counters before =
+    spawn_stack_pool::instance()->get_counters();
+
+  // The pool retains a limited number of idle stacks.
+  const int n = BOOST_ASIO_SPAWN_STACK_POOL_SIZE + 2;
+  spawn_stack_users(ioc, stack_size, n, &count);
+  ioc.run();
+  BOOST_ASIO_CHECK(count == n);
+
+  spawn_stack_pool::counters after =
+    spawn_stack_pool::instance()->get_counters();
+  BOOST_ASIO_CHECK(after.deallocations - before.deallocations
+      == static_cast<std::size_t>(n));
+  BOOST_ASIO_CHECK(after.idle == BOOST_ASIO_SPAWN_STACK_POOL_SIZE);
+  BOOST_ASIO_CHECK(after.releases - before.releases
+      == n - (BOOST_ASIO_SPAWN_STACK_POOL_SIZE - before.idle));
+
+  // A separately created pool reuses and releases stacks in the same way.
+  spawn_stack_pool pool;
+  boost::coroutines::stack_context ctx[BOOST_ASIO_SPAWN_STACK_POOL_SIZE + 1];
+  for (int i = 0; i <= BOOST_ASIO_SPAWN_STACK_POOL_SIZE; ++i)
+    pool.allocate(ctx[i], stack_size);
+  for (int i = 0; i <= BOOST_ASIO_SPAWN_STACK_POOL_SIZE; ++i)
+    pool.deallocate(ctx[i]);
+  BOOST_ASIO_CHECK(pool.get_counters().idle
+      == BOOST_ASIO_SPAWN_STACK_POOL_SIZE);
+  BOOST_ASIO_CHECK(pool.get_counters().releases == 1);
+
+  boost::coroutines::stack_context other;
+  pool.allocate(other, stack_size);
+  BOOST_ASIO_CHECK(pool.get_counters().reuses == 1);
+  BOOST_ASIO_CHECK(other.size == stack_size);
+  pool.deallocate(other);
+}
+
+#else // defined(BOOST_ASIO_HAS_SPAWN_STACK_POOL)
+
+void test_stack_reuse()
+{
+}
+
+void test_stack_retention()
+{
+}
+
+#endif // defined(BOOST_ASIO_HAS_SPAWN_STACK_POOL)
+
+BOOST_ASIO_TEST_SUITE
+(
+  "spawn",
+  BOOST_ASIO_TEST_CASE(test_stack_reuse)
+  BOOST_ASIO_TEST_CASE(test_stack_retention)
+)
@@ -25,6 +25,8 @@
 
 #if defined(BOOST_ASIO_HAS_STD_CHRONO)
 
+#include <boost/asio/bind_cancellation_slot.hpp>
+#include <boost/asio/cancellation_signal.hpp>
 #include <boost/asio/executor_work_guard.hpp>
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/detail/thread.hpp>
@@ -265,6 +267,48 @@ void system_timer_cancel_test()
     BOOST_ASIO_CHECK(timers[i].t.cancel() == 1);
 }
 
+struct slot_cancel_handler
+{
+  explicit slot_cancel_handler(boost::system::error_code* ec) : ec_(ec) {}
+  void operator()(const boost::system::error_code& ec) { *ec_ = ec; }
+  boost::system::error_code* ec_;
+};
+
+void system_timer_slot_cancel_test()
+{
+  boost::asio::io_context ioc;
+  boost::asio::system_timer t(ioc, boost::asio::chrono::seconds(60));
+
+  boost::asio::cancellation_signal sig1, sig2;
+  boost::system::error_code ec1, ec2;
+  t.async_wait(boost::asio::bind_cancellation_slot(
+        sig1.slot(), slot_cancel_handler(&ec1)));
+  t.async_wait(boost::asio::bind_cancellation_slot(
+        sig2.slot(), slot_cancel_handler(&ec2)));
+  BOOST_ASIO_CHECK(sig1.slot().has_handler());
+
+  // Only the wait associated with the emitted signal is cancelled.
+  sig1.emit(boost::asio::cancellation_type::terminal);
+  ioc.poll();
+  BOOST_ASIO_CHECK(ec1 == boost::asio::error::operation_aborted);
+  BOOST_ASIO_CHECK(!sig1.slot().has_handler());
+  BOOST_ASIO_CHECK(!ec2);
+  BOOST_ASIO_CHECK(t.cancel() == 1);
+  ioc.poll();
+  BOOST_ASIO_CHECK(ec2 == boost::asio::error::operation_aborted);
+  BOOST_ASIO_CHECK(!sig2.slot().has_handler());
+
+  // Emitting the signal after completion has no effect.
+  ec1 = boost::system::error_code();
+  t.expires_after(boost::asio::chrono::seconds(0));
+  t.async_wait(boost::asio::bind_cancellation_slot(
+        sig1.slot(), slot_cancel_handler(&ec1)));
+  ioc.restart();
+  ioc.run();
+  BOOST_ASIO_CHECK(!ec1);
+  sig1.emit(boost::asio::cancellation_type::terminal);
+}
+
 struct custom_allocation_timer_handler
 {
   custom_allocation_timer_handler(int* count) : count_(count) {}
@@ -466,14 +510,126 @@ void system_timer_move_test()
 #endif // defined(BOOST_ASIO_HAS_MOVE)
 }
 
+void record_expiry(boost::asio::system_timer* t,
+    boost::asio::system_timer::time_point* expired)
+{
+  *expired = boost::asio::system_timer::clock_type::now();
+  BOOST_ASIO_CHECK(*expired >= t->expiry());
+}
+
+void system_timer_slack_test()
+{
+  using boost::asio::chrono::milliseconds;
+  typedef boost::asio::system_timer::time_point time_point;
+
+  boost::asio::io_context ioc;
+
+  boost::asio::system_timer t1(ioc);
+  BOOST_ASIO_CHECK(t1.slack() == boost::asio::system_timer::duration());
+  t1.slack(milliseconds(1000));
+  BOOST_ASIO_CHECK(t1.slack() == milliseconds(1000));
+
+  // The earliest timer lies within its slack of the pending timeout, so the
+  // timeout need not be moved earlier.
+  boost::asio::system_timer t2(ioc, milliseconds(1000));
+  time_point t2_expired;
+  t2.async_wait(bindns::bind(record_expiry, &t2, &t2_expired));
+
+  t1.expires_after(milliseconds(100));
+  time_point t1_expired;
+  t1.async_wait(bindns::bind(record_expiry, &t1, &t1_expired));
+
+  // A later timer without slack must still fire before the pending timeout.
+  boost::asio::system_timer t3(ioc, milliseconds(200));
+  time_point t3_expired;
+  t3.async_wait(bindns::bind(record_expiry, &t3, &t3_expired));
+
+#if defined(BOOST_ASIO_HAS_EPOLL) && defined(BOOST_ASIO_HAS_TIMERFD)
+  boost::asio::detail::epoll_reactor& reactor =
+    boost::asio::use_service<boost::asio::detail::epoll_reactor>(ioc);
+  BOOST_ASIO_CHECK(reactor.get_counters().timeout_updates_avoided == 1);
+#endif // defined(BOOST_ASIO_HAS_EPOLL) && defined(BOOST_ASIO_HAS_TIMERFD)
+
+  ioc.run();
+
+  BOOST_ASIO_CHECK(t1_expired <= t3_expired);
+  BOOST_ASIO_CHECK(t3_expired < t2.expiry());
+  BOOST_ASIO_CHECK(t2_expired >= t2.expiry());
+
+#if defined(BOOST_ASIO_HAS_MOVE)
+  boost::asio::system_timer t4(std::move(t1));
+  BOOST_ASIO_CHECK(t4.slack() == milliseconds(1000));
+#endif // defined(BOOST_ASIO_HAS_MOVE)
+}
+
+#if defined(BOOST_ASIO_HAS_IO_SENDERS)
+struct wait_receiver
+{
+  int* values_;
+  int* dones_;
+
+  void set_value()
+  {
+    ++(*values_);
+  }
+
+  template <typename E>
+  void set_error(E) BOOST_ASIO_NOEXCEPT
+  {
+  }
+
+  void set_done() BOOST_ASIO_NOEXCEPT
+  {
+    ++(*dones_);
+  }
+};
+#endif // defined(BOOST_ASIO_HAS_IO_SENDERS)
+
+void system_timer_sender_test()
+{
+#if defined(BOOST_ASIO_HAS_IO_SENDERS)
+  boost::asio::io_context ioc;
+  int values = 0;
+  int dones = 0;
+  wait_receiver r = { &values, &dones };
+
+  boost::asio::system_timer t1(ioc, boost::asio::chrono::milliseconds(10));
+  auto op1 = boost::asio::execution::connect(t1.wait_sender(), r);
+  boost::asio::execution::start(op1);
+
+  boost::asio::system_timer t2(ioc, boost::asio::chrono::seconds(10));
+  auto op2 = boost::asio::execution::connect(t2.wait_sender(), r);
+  boost::asio::execution::start(op2);
+
+  // No receivers can be called until run() is called.
+  BOOST_ASIO_CHECK(values == 0);
+  BOOST_ASIO_CHECK(dones == 0);
+
+  ioc.run_one();
+
+  BOOST_ASIO_CHECK(values == 1);
+  BOOST_ASIO_CHECK(dones == 0);
+
+  // Cancelling a pending wait completes its receiver with set_done.
+  t2.cancel();
+  ioc.run();
+
+  BOOST_ASIO_CHECK(values == 1);
+  BOOST_ASIO_CHECK(dones == 1);
+#endif // defined(BOOST_ASIO_HAS_IO_SENDERS)
+}
+
 BOOST_ASIO_TEST_SUITE
 (
   "system_timer",
   BOOST_ASIO_TEST_CASE(system_timer_test)
   BOOST_ASIO_TEST_CASE(system_timer_cancel_test)
+  BOOST_ASIO_TEST_CASE(system_timer_slot_cancel_test)
   BOOST_ASIO_TEST_CASE(system_timer_custom_allocation_test)
   BOOST_ASIO_TEST_CASE(system_timer_thread_test)
   BOOST_ASIO_TEST_CASE(system_timer_move_test)
+  BOOST_ASIO_TEST_CASE(system_timer_slack_test)
+  BOOST_ASIO_TEST_CASE(system_timer_sender_test)
 )
 #else // defined(BOOST_ASIO_HAS_STD_CHRONO)
 BOOST_ASIO_TEST_SUITE